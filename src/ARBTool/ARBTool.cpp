@@ -0,0 +1,720 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Command line tool for batch processing of ARB files.
+ * @author David Connet
+ *
+ * Everything the GUI does to a file on open/save, without the GUI:
+ *   arbtool [options] <file.arb>
+ * The file is always loaded (and validated). Other operations are selected
+ * by options and done in this order: configuration update, points, exports,
+ * save. Each phase is timed and the peak memory use is reported, so the tool
+ * can be used for performance regression runs.
+ *
+ * Files ending in .json are read/written with ARBJson, anything else is XML.
+ * Reading/writing the file and converting between the element tree and the
+ * book are timed separately ("read"/"load", "tree"/"write"), so the two
+ * formats can be compared:
+ *   arbtool -o book.json book.arb
+ *   arbtool -o copy.arb book.arb
+ *   arbtool -o copy.json book.json
+ *
+ * Exit code: 0 success, 1 bad command line, 2 file failed to load,
+ * 3 an operation failed.
+ *
+ * Revision History
+ * 2026-10-19 Read/write JSON, time file and tree phases separately.
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+
+#include "../Win/ConfigHandler.h"
+#include "../Win/Localization.h"
+
+#include "ARB/ARBAgilityRecordBook.h"
+#include "ARB/ARBConfigScoring.h"
+#include "ARB/ARBDog.h"
+#include "ARB/ARBDogRun.h"
+#include "ARB/ARBDogTrial.h"
+#include "ARB/ARBJson.h"
+#include "ARB/ARBSqlExport.h"
+#include "ARBCommon/ARBUtils.h"
+#include "ARBCommon/BreakLine.h"
+#include "ARBCommon/Element.h"
+#include "ARBCommon/StringUtil.h"
+#include "ARBCommon/VersionNum.h"
+#include "LibARBWin/LanguageManager.h"
+#include "LibARBWin/ResourceManager.h"
+#include "VersionNumber.h"
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <wx/app.h>
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+#include <wx/fs_arc.h>
+#include <wx/fs_mem.h>
+#include <wx/stdpaths.h>
+#include <wx/stdstream.h>
+#include <wx/wfstream.h>
+
+#if defined(__WXMSW__)
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+using namespace ARB;
+using namespace ARBCommon;
+using namespace ARBWin;
+
+namespace
+{
+constexpr int RC_OK = 0;
+constexpr int RC_USAGE = 1;
+constexpr int RC_LOAD = 2;
+constexpr int RC_FAILED = 3;
+// Same as the program's default for CAgilityBookOptions::CalendarOpeningNear.
+constexpr long sc_CalOpeningNear = 4;
+constexpr wchar_t sc_Delim = L',';
+
+
+void Print(std::ostream& ioStream, wxString const& inMsg)
+{
+	ioStream << inMsg.utf8_string() << "\n";
+}
+
+
+// Peak resident memory of this process in KB.
+size_t GetPeakMemoryKB()
+{
+#if defined(__WXMSW__)
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+		return 0;
+	return pmc.PeakWorkingSetSize / 1024;
+#else
+	struct rusage usage;
+	if (0 != getrusage(RUSAGE_SELF, &usage))
+		return 0;
+#if defined(__WXMAC__)
+	// Mac reports bytes, Linux reports KB.
+	return static_cast<size_t>(usage.ru_maxrss) / 1024;
+#else
+	return static_cast<size_t>(usage.ru_maxrss);
+#endif
+#endif
+}
+
+
+class CPhaseTimer
+{
+	DECLARE_NO_COPY_IMPLEMENTED(CPhaseTimer)
+public:
+	CPhaseTimer()
+		: m_Phases()
+		, m_Total()
+	{
+	}
+
+	template <typename FUNC> bool Run(wxString const& inName, FUNC inFunc)
+	{
+		wxStopWatch timer;
+		bool bOk = inFunc();
+		m_Phases.push_back({inName, timer.Time(), GetPeakMemoryKB(), bOk});
+		return bOk;
+	}
+
+	void Report(std::ostream& ioStream) const
+	{
+		ioStream << "\n";
+		Print(ioStream, wxString::Format(L"%-12s %10s %12s", L"Phase", L"Time (ms)", L"Peak (KB)"));
+		for (auto const& phase : m_Phases)
+		{
+			Print(
+				ioStream,
+				wxString::Format(
+					L"%-12s %10ld %12zu%s",
+					phase.name,
+					phase.ms,
+					phase.peakKB,
+					phase.ok ? L"" : L" FAILED"));
+		}
+		Print(ioStream, wxString::Format(L"%-12s %10ld", L"Total", m_Total.Time()));
+	}
+
+private:
+	struct Phase
+	{
+		wxString name;
+		long ms;
+		size_t peakKB;
+		bool ok;
+	};
+	std::vector<Phase> m_Phases;
+	wxStopWatch m_Total;
+};
+
+
+class CConfigActionCallback : public IConfigActionCallback
+{
+public:
+	CConfigActionCallback()
+	{
+	}
+	// Batch updates never stop to ask; data loss is reported after the fact.
+	void PreDelete(wxString const& inMsg) override
+	{
+		Print(std::cerr, inMsg);
+	}
+	void PostDelete(wxString const& inMsg) const override
+	{
+		Print(std::cerr, inMsg);
+	}
+};
+
+
+bool OpenOutput(wxString const& inFileName, std::function<bool(std::ostream&)> const& inWrite)
+{
+	wxFFileOutputStream file(inFileName, L"wb");
+	if (!file.IsOk())
+	{
+		Print(std::cerr, wxString::Format(L"ERROR: Cannot open '%s'.", inFileName));
+		return false;
+	}
+	wxStdOutputStream stdfile(file);
+	return inWrite(stdfile);
+}
+
+
+ARBConfigScoringPtr FindScoring(ARBAgilityRecordBook const& inBook, ARBDogRunPtr const& inRun)
+{
+	ARBConfigScoringPtr pScoring;
+	ARBDogClubPtr club = inRun->GetClub();
+	if (club)
+	{
+		inBook.GetConfig().GetVenues().FindEvent(
+			club->GetVenue(),
+			inRun->GetEvent(),
+			inRun->GetDivision(),
+			inRun->GetLevel(),
+			inRun->GetDate(),
+			nullptr,
+			&pScoring);
+	}
+	return pScoring;
+}
+
+
+bool IsJsonFile(wxString const& inFileName)
+{
+	return L"json" == wxFileName(inFileName).GetExt().Lower();
+}
+
+
+bool ReadTree(wxString const& inFileName, ElementNodePtr const& outTree)
+{
+	wxString errMsg;
+	bool bOk = false;
+	if (IsJsonFile(inFileName))
+	{
+		wxFFileInputStream file(inFileName, L"rb");
+		if (file.IsOk())
+		{
+			wxStdInputStream stdfile(file);
+			bOk = ARBJson::Load(outTree, stdfile, errMsg);
+		}
+	}
+	else
+		bOk = outTree->LoadXML(inFileName, errMsg);
+	if (!bOk)
+	{
+		Print(std::cerr, wxString::Format(L"ERROR: Cannot open file '%s'.", inFileName));
+		if (!errMsg.empty())
+			Print(std::cerr, errMsg);
+	}
+	return bOk;
+}
+
+
+bool LoadBook(
+	wxString const& inFileName,
+	ElementNodePtr const& inTree,
+	ARBAgilityRecordBook& outBook,
+	bool inVerbose)
+{
+	wxString errMsg;
+	ARBErrorCallback err(errMsg);
+	if (!outBook.Load(inTree, err))
+	{
+		Print(std::cerr, wxString::Format(L"ERROR: Invalid file '%s'.", inFileName));
+		if (!errMsg.empty())
+			Print(std::cerr, errMsg);
+		return false;
+	}
+	// Non-fatal problems: the file loaded, but the GUI would have warned.
+	if (!errMsg.empty())
+		Print(std::cerr, errMsg);
+
+	if (inVerbose)
+	{
+		size_t nTrials = 0;
+		size_t nRuns = 0;
+		for (auto const& dog : outBook.GetDogs())
+		{
+			nTrials += dog->GetTrials().size();
+			for (auto const& trial : dog->GetTrials())
+				nRuns += trial->GetRuns().size();
+		}
+		Print(
+			std::cout,
+			wxString::Format(
+				L"%s: config %d, %zu dogs, %zu trials, %zu runs, %zu calendar, %zu training",
+				inFileName,
+				static_cast<int>(outBook.GetConfig().GetVersion()),
+				outBook.GetDogs().size(),
+				nTrials,
+				nRuns,
+				outBook.GetCalendar().size(),
+				outBook.GetTraining().size()));
+	}
+	return true;
+}
+
+
+bool UpdateConfig(ARBAgilityRecordBook& ioBook, wxString const& inConfigFile, bool& outChanged)
+{
+	ARBAgilityRecordBook update;
+	if (inConfigFile.empty())
+	{
+		CConfigHandler handler;
+		update.GetConfig().Default(&handler);
+	}
+	else
+	{
+		wxString errMsg;
+		ElementNodePtr tree(ElementNode::New());
+		if (!tree->LoadXML(inConfigFile, errMsg))
+		{
+			Print(std::cerr, wxString::Format(L"ERROR: Cannot open file '%s'.", inConfigFile));
+			if (!errMsg.empty())
+				Print(std::cerr, errMsg);
+			return false;
+		}
+		ARBErrorCallback err(errMsg);
+		if (!update.Load(tree, false, false, true, false, false, err))
+		{
+			Print(std::cerr, wxString::Format(L"ERROR: Invalid configuration '%s'.", inConfigFile));
+			if (!errMsg.empty())
+				Print(std::cerr, errMsg);
+			return false;
+		}
+	}
+
+	wxString info;
+	CConfigActionCallback callback;
+	outChanged = ioBook.Update(0, update.GetConfig(), info, callback);
+	if (outChanged)
+		Print(std::cout, info);
+	else
+		Print(std::cout, L"Configuration is up to date.");
+	return true;
+}
+
+
+// Title/speed points are what the points view starts from. Lifetime,
+// placement and multiQ tallies are view specific and not redone here.
+void ComputePoints(ARBAgilityRecordBook const& inBook, bool inPrint)
+{
+	struct Totals
+	{
+		size_t runs = 0;
+		size_t qs = 0;
+		double title = 0.0;
+		long speed = 0;
+	};
+
+	for (auto const& dog : inBook.GetDogs())
+	{
+		std::map<wxString, Totals> venues;
+		for (auto const& trial : dog->GetTrials())
+		{
+			for (auto const& run : trial->GetRuns())
+			{
+				ARBDogClubPtr club = run->GetClub();
+				Totals& totals = venues[club ? club->GetVenue() : wxString()];
+				++totals.runs;
+				if (!run->GetQ().Qualified())
+					continue;
+				++totals.qs;
+				ARBConfigScoringPtr pScoring = FindScoring(inBook, run);
+				if (pScoring)
+				{
+					totals.title += run->GetTitlePoints(pScoring);
+					if (pScoring->HasSpeedPts())
+						totals.speed += run->GetSpeedPoints(pScoring);
+				}
+			}
+		}
+		if (!inPrint)
+			continue;
+		Print(std::cout, dog->GetCallName());
+		for (auto const& venue : venues)
+		{
+			Print(
+				std::cout,
+				wxString::Format(
+					L"  %-10s %6zu runs %6zu Q %10s title %6ld speed",
+					venue.first,
+					venue.second.runs,
+					venue.second.qs,
+					ARBDouble::ToString(venue.second.title),
+					venue.second.speed));
+		}
+	}
+}
+
+
+bool ExportCSV(ARBAgilityRecordBook const& inBook, std::ostream& ioStream)
+{
+	static wchar_t const* const sc_Columns[] = {
+		L"Dog",
+		L"Date",
+		L"Venue",
+		L"Club",
+		L"Location",
+		L"Division",
+		L"Level",
+		L"Event",
+		L"Subname",
+		L"Height",
+		L"Judge",
+		L"Handler",
+		L"Q",
+		L"Place",
+		L"In Class",
+		L"Time",
+		L"Faults",
+		L"Score",
+		L"Title Points",
+		L"Speed Points",
+	};
+
+	auto writeLine = [&ioStream](std::vector<wxString> const& cols) {
+		wxString line;
+		for (size_t i = 0; i < cols.size(); ++i)
+		{
+			if (0 < i)
+				line += sc_Delim;
+			line += WriteCSVField(sc_Delim, cols[i]);
+		}
+		line += L"\r\n";
+		ioStream << line.utf8_string();
+	};
+
+	writeLine(std::vector<wxString>(std::begin(sc_Columns), std::end(sc_Columns)));
+	std::vector<wxString> cols;
+	for (auto const& dog : inBook.GetDogs())
+	{
+		for (auto const& trial : dog->GetTrials())
+		{
+			for (auto const& run : trial->GetRuns())
+			{
+				ARBDogClubPtr club = run->GetClub();
+				ARBConfigScoringPtr pScoring = FindScoring(inBook, run);
+				ARBDogRunScoring const& scoring = run->GetScoring();
+				cols.clear();
+				cols.push_back(dog->GetCallName());
+				cols.push_back(run->GetDate().GetString(ARBDateFormat::ISO));
+				cols.push_back(club ? club->GetVenue() : wxString());
+				cols.push_back(club ? club->GetName() : wxString());
+				cols.push_back(trial->GetLocation());
+				cols.push_back(run->GetDivision());
+				cols.push_back(run->GetLevel());
+				cols.push_back(run->GetEvent());
+				cols.push_back(run->GetSubName());
+				cols.push_back(run->GetHeight());
+				cols.push_back(run->GetJudge());
+				cols.push_back(run->GetHandler());
+				cols.push_back(run->GetQ().str());
+				cols.push_back(0 < run->GetPlace() ? wxString::Format(L"%hd", run->GetPlace()) : wxString());
+				cols.push_back(0 < run->GetInClass() ? wxString::Format(L"%hd", run->GetInClass()) : wxString());
+				cols.push_back(ARBDouble::ToString(scoring.GetTime()));
+				cols.push_back(wxString::Format(L"%hd", scoring.GetCourseFaults()));
+				wxString score;
+				wxString title;
+				wxString speed;
+				if (pScoring)
+				{
+					score = ARBDouble::ToString(run->GetScore(pScoring));
+					if (run->GetQ().Qualified())
+					{
+						title = ARBDouble::ToString(run->GetTitlePoints(pScoring));
+						if (pScoring->HasSpeedPts())
+							speed = wxString::Format(L"%hd", run->GetSpeedPoints(pScoring));
+					}
+				}
+				cols.push_back(score);
+				cols.push_back(title);
+				cols.push_back(speed);
+				writeLine(cols);
+			}
+		}
+	}
+	return ioStream.good();
+}
+
+
+bool ExportICal(ARBAgilityRecordBook const& inBook, long inAlarm, std::ostream& ioStream)
+{
+	std::vector<ARBCalendarPtr> entries(inBook.GetCalendar().begin(), inBook.GetCalendar().end());
+	std::string feed;
+	ICalendar::iCalendarFeed(std::string(), entries, static_cast<int>(inAlarm), feed);
+	ioStream.write(feed.data(), static_cast<std::streamsize>(feed.size()));
+	return ioStream.good();
+}
+
+
+bool SaveBook(ARBAgilityRecordBook const& inBook, ElementNodePtr const& outTree)
+{
+	CVersionNum ver(ARB_VER_MAJOR, ARB_VER_MINOR, ARB_VER_DOT, ARB_VER_BUILD);
+	return inBook.Save(outTree, ver.GetVersionString(), true, true, true, true, true);
+}
+
+
+bool WriteTree(ElementNodePtr const& inTree, wxString const& inFileName)
+{
+	if (IsJsonFile(inFileName))
+		return OpenOutput(inFileName, [&inTree](std::ostream& out) { return ARBJson::Save(inTree, out); });
+	if (!inTree->SaveXML(inFileName))
+	{
+		Print(std::cerr, wxString::Format(L"ERROR: Cannot open '%s'.", inFileName));
+		return false;
+	}
+	return true;
+}
+
+
+wxString GetDataFile()
+{
+	wxFileName fileName(wxStandardPaths::Get().GetExecutablePath());
+	return GetARBResourceDir() + wxFileName::GetPathSeparator() + fileName.GetName() + L".dat";
+}
+} // namespace
+
+
+class CCallbackManager
+	: public ILanguageCallback
+	, public IResourceManagerCallback
+{
+	DECLARE_NO_COPY_IMPLEMENTED(CCallbackManager);
+
+public:
+	CCallbackManager(CLocalization& localization)
+		: m_Localization(localization)
+		, m_langMgr(nullptr)
+	{
+		auto datafile = GetDataFile();
+		CResourceManager::Get()->Initialize(this, &datafile);
+
+		m_langMgr = std::make_unique<CLanguageManager>(this);
+		m_langMgr->InitLanguage();
+	}
+	virtual ~CCallbackManager()
+	{
+		CResourceManager::Get()->Cleanup();
+	}
+
+	bool SetLang(wxLanguage langId)
+	{
+		return m_langMgr->SetLang(langId);
+	}
+
+private:
+	CLocalization& m_Localization;
+
+	// ILanguageCallback interface
+	wxLanguage OnGetLanguage() const override
+	{
+		return m_langMgr->GetDefaultLanguage();
+	}
+	wxString OnGetCatalogName() const override
+	{
+		return m_langMgr->GetDefaultCatalogName();
+	}
+	wxString OnGetLangConfigName() const override
+	{
+		return wxEmptyString;
+	}
+	void OnSetLanguage(wxLanguage langId) override
+	{
+		if (!m_Localization.Load())
+		{
+			auto msg = wxString::Format(L"ERROR: Unable to load '%s.mo'.", OnGetCatalogName()).utf8_string();
+			std::cerr << msg << "\n";
+			throw std::runtime_error(msg);
+		}
+	}
+	void OnErrorMessage(wxString const& msg) const override
+	{
+		Print(std::cerr, msg);
+	}
+	std::unique_ptr<CLanguageManager> m_langMgr;
+
+	// IResourceManagerCallback
+	wxWindow* GetResourceWindow() override
+	{
+		return nullptr;
+	}
+	bool GetResImageName(wxArtID const& id, wxArtClient const& client, wxString& outName, bool& outSvg) const override
+	{
+		return false;
+	}
+};
+
+} // namespace dconSoft
+
+using namespace dconSoft;
+
+
+int main(int argc, char** argv)
+{
+	wxInitializer initializer(argc, argv);
+#if defined(__WXMSW__)
+	// By default, the path directories are tweaked to remove debug/release.
+	// The data file is in the same location as the binary.
+	wxStandardPaths::Get().DontIgnoreAppSubDir();
+#endif
+
+	static const wxCmdLineEntryDesc cmdLineDesc[] = {
+		{wxCMD_LINE_SWITCH, "u", "update", "Update the configuration to the current default"},
+		{wxCMD_LINE_OPTION, "c", "config", "Update the configuration from this file (implies -u)"},
+		{wxCMD_LINE_SWITCH, "p", "points", "Compute and print title/speed points per dog"},
+		{wxCMD_LINE_OPTION, nullptr, "csv", "Export all runs to this CSV file"},
+		{wxCMD_LINE_OPTION, nullptr, "ical", "Export the calendar to this iCalendar file"},
+		{wxCMD_LINE_OPTION,
+		 nullptr,
+		 "alarm",
+		 "Days before the opening date to set iCalendar alarms",
+		 wxCMD_LINE_VAL_NUMBER},
+		{wxCMD_LINE_OPTION, nullptr, "sql", "Export the record book to this SQL script"},
+		{wxCMD_LINE_OPTION, "o", "output", "Save the record book to this file (.json: JSON)"},
+		{wxCMD_LINE_SWITCH, "q", "quiet", "Do not print the summary and timings"},
+		{wxCMD_LINE_PARAM, nullptr, nullptr, "Agility Record Book file (.json: JSON)", wxCMD_LINE_VAL_STRING},
+		{wxCMD_LINE_NONE},
+	};
+	wxCmdLineParser cmdline(cmdLineDesc, argc, argv);
+	if (0 != cmdline.Parse(true))
+		return RC_USAGE;
+
+	wxString errs;
+	if (!Element::Initialize(errs))
+	{
+		Print(std::cerr, errs);
+		return RC_FAILED;
+	}
+
+	wxFileSystem::AddHandler(new wxArchiveFSHandler);
+	wxFileSystem::AddHandler(new wxMemoryFSHandler);
+
+	static CLocalization localization;
+	ARB::IARBLocalization::Init(&localization);
+
+	int rc = RC_OK;
+	auto callbackMgr = std::make_unique<CCallbackManager>(localization);
+	try
+	{
+		callbackMgr->SetLang(wxLANGUAGE_ENGLISH_US);
+	}
+	catch (std::runtime_error const&)
+	{
+		rc = RC_FAILED;
+	}
+
+	if (RC_OK == rc)
+	{
+		bool bQuiet = cmdline.Found(L"q");
+		wxString fileName = cmdline.GetParam(0);
+		wxString configFile, csvFile, icalFile, sqlFile, outFile;
+		cmdline.Found(L"c", &configFile);
+		cmdline.Found(L"csv", &csvFile);
+		cmdline.Found(L"ical", &icalFile);
+		cmdline.Found(L"sql", &sqlFile);
+		cmdline.Found(L"o", &outFile);
+		long alarm = sc_CalOpeningNear;
+		cmdline.Found(L"alarm", &alarm);
+
+		CPhaseTimer timer;
+		ARBAgilityRecordBook book;
+		{
+			ElementNodePtr tree(ElementNode::New());
+			if (!timer.Run(L"read", [&]() { return ReadTree(fileName, tree); })
+				|| !timer.Run(L"load", [&]() { return LoadBook(fileName, tree, book, !bQuiet); }))
+				rc = RC_LOAD;
+		}
+		if (RC_OK == rc)
+		{
+			if (cmdline.Found(L"u") || !configFile.empty())
+			{
+				bool bChanged = false;
+				if (!timer.Run(L"update", [&]() { return UpdateConfig(book, configFile, bChanged); }))
+					rc = RC_FAILED;
+			}
+			if (cmdline.Found(L"p"))
+			{
+				timer.Run(L"points", [&]() {
+					ComputePoints(book, !bQuiet);
+					return true;
+				});
+			}
+			if (!csvFile.empty()
+				&& !timer.Run(L"csv", [&]() {
+					   return OpenOutput(csvFile, [&book](std::ostream& out) { return ExportCSV(book, out); });
+				   }))
+				rc = RC_FAILED;
+			if (!icalFile.empty()
+				&& !timer.Run(L"ical", [&]() {
+					   return OpenOutput(icalFile, [&book, alarm](std::ostream& out) {
+						   return ExportICal(book, alarm, out);
+					   });
+				   }))
+				rc = RC_FAILED;
+			if (!sqlFile.empty()
+				&& !timer.Run(L"sql", [&]() {
+					   return OpenOutput(sqlFile, [&book](std::ostream& out) {
+						   return ARBSqlExport::Write(book, false, out);
+					   });
+				   }))
+				rc = RC_FAILED;
+			if (!outFile.empty())
+			{
+				ElementNodePtr tree(ElementNode::New());
+				if (!timer.Run(L"tree", [&]() { return SaveBook(book, tree); })
+					|| !timer.Run(L"write", [&]() { return WriteTree(tree, outFile); }))
+					rc = RC_FAILED;
+			}
+		}
+		if (!bQuiet)
+			timer.Report(std::cout);
+	}
+
+	Element::Terminate();
+	callbackMgr.reset();
+
+	return rc;
+}
@@ -0,0 +1,8 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+#include "stdafx.h"
+#include "Platform/SetupMessages.h"
@@ -0,0 +1,9 @@
+#pragma once
+
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+#include "Platform/SetupWX.h"
@@ -12,6 +12,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2009-08-15 Added IsAnyFiltered.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
@@ -67,6 +68,16 @@ public:
 	 */
 	virtual size_t GetSearchStrings(std::set<wxString>& ioStrings) const = 0;
 
+	/**
+	 * Enumerate all the strings to search in an object.
+	 * Unlike GetSearchStrings, nothing is accumulated (or copied) so a search
+	 * can stop at the first match. The default implementation enumerates the
+	 * results of GetSearchStrings.
+	 * @param inCallback Called for each string, return false to stop.
+	 * @return false if the callback stopped the enumeration.
+	 */
+	virtual bool ForEachSearchString(ARBSearchStringCallback const& inCallback) const;
+
 	/**
 	 * Get the filtered state of this object.
 	 * @param inFilterType The filtered type to check.
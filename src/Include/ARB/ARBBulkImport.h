@@ -0,0 +1,175 @@
+#pragma once
+
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Add many runs (or a whole imported book) to a book in one pass.
+ * @author David Connet
+ *
+ * Finding where imported data goes used to be a linear scan of the book for
+ * every row (dogs, then trials, titles, ...). The importer indexes what it
+ * needs the first time it needs it and keeps the indexes current as data is
+ * added. Nothing is sorted and no MultiQs are computed until Finish(), which
+ * only touches the dogs and trials that actually changed.
+ *
+ * The book must not be modified by anyone else while an importer is alive.
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "ARBTypes2.h"
+#include "LibwxARB.h"
+
+#include "ARBCommon/ARBDate.h"
+#include <map>
+#include <set>
+#include <utility>
+#include <vector>
+
+
+namespace dconSoft
+{
+namespace ARB
+{
+class ARBAgilityRecordBook;
+
+
+class ARB_API ARBBulkImport
+{
+public:
+	/**
+	 * What MergeDog did.
+	 */
+	struct MergeCounts
+	{
+		int dogs = 0;
+		int regNumsAdded = 0;
+		int regNumsUpdated = 0;
+		int existingPts = 0;
+		int titlesAdded = 0;
+		int titlesUpdated = 0;
+		int trials = 0;
+	};
+
+	explicit ARBBulkImport(ARBAgilityRecordBook& ioBook);
+	~ARBBulkImport();
+
+	/**
+	 * Find the scoring for an event. Imported rows tend to repeat the same
+	 * few events, so lookups are remembered.
+	 * @param inVenue Venue event is in.
+	 * @param inEvent Event name.
+	 * @param inDivision Division name.
+	 * @param inLevel True Level name (sublevel).
+	 * @param inDate Date for requested scoring.
+	 * @param outScoring Scoring, NULL if not found.
+	 * @return Whether the event was found.
+	 */
+	bool FindEvent(
+		wxString const& inVenue,
+		wxString const& inEvent,
+		wxString const& inDivision,
+		wxString const& inLevel,
+		ARBCommon::ARBDate const& inDate,
+		ARBConfigScoringPtr* outScoring = nullptr);
+
+	/**
+	 * Find a dog. If both names are given, both must match. Otherwise the one
+	 * that is given must match.
+	 * @param inRegName Registered name.
+	 * @param inCallName Call name.
+	 * @return First matching dog in the book.
+	 */
+	ARBDogPtr FindDog(wxString const& inRegName, wxString const& inCallName);
+
+	/**
+	 * Add a dog to the book.
+	 * @param inDog Dog to add.
+	 */
+	void AddDog(ARBDogPtr const& inDog);
+
+	/**
+	 * Find the trial a run belongs in: same location and clubs, and the run
+	 * is during the trial. Failing that, a run on the day before or after
+	 * the trial joins it (so a multi-day trial ends up as one trial).
+	 * @param inDog Dog to look in.
+	 * @param inDate Date of run.
+	 * @param inLocation Trial location.
+	 * @param inClubs Club names.
+	 * @param inVenues Venues (same size as inClubs).
+	 * @return First matching trial of the dog.
+	 */
+	ARBDogTrialPtr FindTrial(
+		ARBDogPtr const& inDog,
+		ARBCommon::ARBDate const& inDate,
+		wxString const& inLocation,
+		std::vector<wxString> const& inClubs,
+		std::vector<wxString> const& inVenues);
+
+	/**
+	 * Add a trial to a dog. It is sorted in Finish().
+	 * @param inDog Dog to add to.
+	 * @param inTrial Trial to add.
+	 */
+	void AddTrial(ARBDogPtr const& inDog, ARBDogTrialPtr const& inTrial);
+
+	/**
+	 * Add a run to a trial. MultiQs and run order are set in Finish().
+	 * @param inDog Dog that owns the trial.
+	 * @param inTrial Trial to add to.
+	 * @param inRun Run to add.
+	 */
+	void AddRun(ARBDogPtr const& inDog, ARBDogTrialPtr const& inTrial, ARBDogRunPtr const& inRun);
+
+	/**
+	 * Merge a dog from another book. A new dog (by call name) is added. For
+	 * an existing dog, only registration numbers, existing points, titles and
+	 * trials are merged.
+	 * @param inDog Dog to merge.
+	 * @param ioCounts What was merged.
+	 */
+	void MergeDog(ARBDogPtr const& inDog, MergeCounts& ioCounts);
+
+	/**
+	 * Set the MultiQs and sort the runs of every trial that was added to,
+	 * then sort the trials of every dog that was added to.
+	 * @param inDescending Trial sort order.
+	 */
+	void Finish(bool inDescending);
+
+	/**
+	 * Dogs that were added or modified, in book order.
+	 */
+	std::vector<ARBDogPtr> GetModifiedDogs() const;
+
+private:
+	typedef std::map<wxString, std::vector<ARBDogTrialPtr>> TrialIndex;
+
+	static wxString TrialKey(
+		wxString const& inLocation,
+		std::vector<wxString> const& inClubs,
+		std::vector<wxString> const& inVenues);
+	static wxString TrialKey(ARBDogTrialPtr const& inTrial);
+
+	void IndexDogs();
+	TrialIndex& GetTrialIndex(ARBDogPtr const& inDog);
+
+	ARBAgilityRecordBook& m_Book;
+	bool m_bDogsIndexed;
+	std::map<wxString, ARBDogPtr> m_RegNames;
+	std::map<wxString, ARBDogPtr> m_CallNames;
+	std::map<std::pair<wxString, wxString>, ARBDogPtr> m_Names;
+	std::map<ARBDog const*, TrialIndex> m_Trials;
+	std::map<wxString, std::pair<bool, ARBConfigScoringPtr>> m_Events;
+	std::set<ARBDogPtr> m_ModifiedDogs;
+	std::set<ARBDogTrialPtr> m_ModifiedTrials;
+};
+
+} // namespace ARB
+} // namespace dconSoft
@@ -12,6 +12,10 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Index the list on the match fields.
+ * 2026-10-19 Added iCalendarRead and ImportICalendar.
+ * 2026-10-19 Added iCalendarFeed.
+ * 2026-10-19 Added ForEachSearchString.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
  * 2005-07-05 Added iCalendar support.
@@ -27,6 +31,12 @@
 #include "LibwxARB.h"
 
 #include "ARBCommon/ARBDate.h"
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 
 namespace dconSoft
@@ -74,6 +84,38 @@ public:
 	 * @param inVersion Either 1 (vCal) or 2 (iCal).
 	 */
 	static ICalendarPtr iCalendarBegin(std::ostream& ioStream, int inVersion);
+
+	/**
+	 * Regenerate an iCalendar (version 2) feed. Events in the previous feed
+	 * whose entry has not changed (same UID and content) are copied as is,
+	 * including their DTSTAMP. Only new or changed entries are generated.
+	 * @param inFeed Previous feed, may be empty.
+	 * @param inEntries Entries to put in the feed.
+	 * @param inAlarm See ARBCalendar::iCalendar.
+	 * @param outFeed New feed.
+	 * @return Whether the new feed differs from the previous one.
+	 */
+	static bool iCalendarFeed(
+		std::string const& inFeed,
+		std::vector<ARBCalendarPtr> const& inEntries,
+		int inAlarm,
+		std::string& outFeed);
+
+	/**
+	 * Read the events (VEVENT) of an iCalendar (RFC 5545) or vCalendar
+	 * stream. Each event is passed on as soon as it is parsed, so the file is
+	 * never held in memory. The summary is split back into venue and club the
+	 * way ARBCalendar::iCalendar writes it, if it starts with a venue in the
+	 * configuration. Otherwise it becomes the club.
+	 * @param ioStream Stream to read.
+	 * @param inConfig Configuration, used to recognize venues.
+	 * @param inCallback Called for each event. Return false to stop reading.
+	 * @return Number of events read.
+	 */
+	static size_t iCalendarRead(
+		std::istream& ioStream,
+		ARBConfig const& inConfig,
+		std::function<bool(ARBCalendarPtr const&)> const& inCallback);
 };
 
 
@@ -154,6 +196,7 @@ public:
 	 * @return Number of strings accumulated in this object.
 	 */
 	size_t GetSearchStrings(std::set<wxString>& ioStrings) const override;
+	bool ForEachSearchString(ARBSearchStringCallback const& inCallback) const override;
 
 	/**
 	 * Load a calendar entry
@@ -246,6 +289,7 @@ public:
 	void SetStartDate(ARBCommon::ARBDate const& inDate)
 	{
 		m_DateStart = inDate;
+		MatchChanged();
 	}
 	ARBCommon::ARBDate const& GetEndDate() const
 	{
@@ -254,6 +298,7 @@ public:
 	void SetEndDate(ARBCommon::ARBDate const& inDate)
 	{
 		m_DateEnd = inDate;
+		MatchChanged();
 	}
 	ARBCommon::ARBDate const& GetOpeningDate() const
 	{
@@ -302,6 +347,7 @@ public:
 	void SetClub(wxString const& inClub)
 	{
 		m_Club = inClub;
+		MatchChanged();
 	}
 	wxString const& GetVenue() const
 	{
@@ -310,6 +356,7 @@ public:
 	void SetVenue(wxString const& inVenue)
 	{
 		m_Venue = inVenue;
+		MatchChanged();
 	}
 	ARBCalendarEntry GetEntered() const
 	{
@@ -369,6 +416,15 @@ public:
 	}
 
 private:
+	friend class ARBCalendarList;
+	// A match field (see IsMatch) of an entry in an ARBCalendarList index
+	// changed, so that list's index is out of date.
+	void MatchChanged()
+	{
+		if (auto pGeneration = m_IndexedBy.lock())
+			++(*pGeneration);
+	}
+
 	ARBCommon::ARBDate m_DateStart;
 	ARBCommon::ARBDate m_DateEnd;
 	ARBCommon::ARBDate m_DateOpening;
@@ -385,6 +441,7 @@ private:
 	wxString m_PremiumURL;
 	wxString m_OnlineURL;
 	wxString m_Note;
+	std::weak_ptr<unsigned int> m_IndexedBy; ///< Generation of the list that last indexed this entry.
 };
 
 /////////////////////////////////////////////////////////////////////////////
@@ -395,6 +452,30 @@ private:
 class ARB_API ARBCalendarList : public ARBVector<ARBCalendarPtr>
 {
 public:
+	ARBCalendarList();
+
+	/**
+	 * Remove all entries.
+	 */
+	void clear()
+	{
+		ARBVector<ARBCalendarPtr>::clear();
+		m_Index.clear();
+		m_bIndexValid = false;
+	}
+
+	/**
+	 * Make a copy of everything.
+	 * @param outList Object being copied to.
+	 */
+	size_t Clone(ARBCalendarList& outList) const
+	{
+		size_t n = ARBVector<ARBCalendarPtr>::Clone(outList);
+		outList.m_Index.clear();
+		outList.m_bIndexValid = false;
+		return n;
+	}
+
 	/**
 	 * Load the information from XML (the tree).
 	 * @pre inTree is the actual T element.
@@ -434,7 +515,17 @@ public:
 	 * @param inMatchExact Match the entire entry, or just start end dates, venue, clubname.
 	 * @param outCal The object that was found.
 	 * @return Whether the object was found.
-	 * @note Equality is tested by value, not pointer.
+	 * @note Equality is tested by value, not pointer. Entries are looked up
+	 *       in an index on the match fields, which is rebuilt after the list
+	 *       is loaded, sorted, trimmed, cleared or cloned, or a match field of
+	 *       an entry is changed. Add and delete entries using the list methods.
+	 *       The index can go stale (and miss entries) if:
+	 *       - an entry is replaced through the std::vector interface without
+	 *         changing the list size (assigning an element, swap, ...),
+	 *       - the list is cleared or cloned into through an ARBVector
+	 *         reference, which does not see this class's clear/Clone,
+	 *       - an entry shared by two lists is edited: only the list that
+	 *         indexed it last is told.
 	 */
 	bool FindCalendar(ARBCalendarPtr const& inCal, bool inMatchExact, ARBCalendarPtr* outCal = nullptr) const;
 
@@ -445,6 +536,29 @@ public:
 	 */
 	bool AddCalendar(ARBCalendarPtr const& inCal);
 
+	/**
+	 * Merge the events of an iCalendar stream into the list. Events that
+	 * match an existing entry (see FindCalendar) update it instead (see
+	 * ARBCalendar::Update).
+	 * @param ioStream Stream to read.
+	 * @param inConfig Configuration, used to recognize venues.
+	 * @param inSkipBefore Don't add events that end before this date (if valid).
+	 * @param nAdded Number of entries added.
+	 * @param nUpdated Number of entries updated.
+	 * @param nDuplicate Number of events that matched an entry exactly.
+	 * @param nSkipped Number of events not added.
+	 * @return Whether the list was changed.
+	 * @note The list is not sorted.
+	 */
+	bool ImportICalendar(
+		std::istream& ioStream,
+		ARBConfig const& inConfig,
+		ARBCommon::ARBDate const& inSkipBefore,
+		long& nAdded,
+		long& nUpdated,
+		long& nDuplicate,
+		long& nSkipped);
+
 	/**
 	 * Delete a calendar entry.
 	 * @param inCal Object to delete.
@@ -452,6 +566,21 @@ public:
 	 * @note Equality is tested by value, not pointer.
 	 */
 	bool DeleteCalendar(ARBCalendarPtr const& inCal);
+
+private:
+	typedef std::unordered_map<std::wstring, std::vector<ARBCalendarPtr>> MatchIndex;
+
+	static std::wstring MatchKey(ARBCalendar const& inCal);
+	bool IsIndexCurrent() const;
+	MatchIndex const& GetIndex() const;
+
+	// Entries by match fields, in list order.
+	mutable MatchIndex m_Index;
+	mutable size_t m_IndexSize;
+	// Bumped by indexed entries when a match field changes.
+	std::shared_ptr<unsigned int> m_pGeneration;
+	mutable unsigned int m_IndexGeneration;
+	mutable bool m_bIndexValid;
 };
 
 } // namespace ARB
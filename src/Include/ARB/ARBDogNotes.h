@@ -12,6 +12,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
  * 2004-09-28 Changed how error reporting is done when loading.
@@ -84,6 +85,7 @@ public:
 	 * @return Number of strings accumulated in this object.
 	 */
 	virtual size_t GetSearchStrings(std::set<wxString>& ioStrings) const;
+	virtual bool ForEachSearchString(ARBSearchStringCallback const& inCallback) const;
 
 	/**
 	 * Load an existing point.
@@ -12,6 +12,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
  * 2005-06-25 Cleaned up reference counting when returning a pointer.
@@ -70,6 +71,7 @@ public:
 	 * @return Number of strings accumulated in this object.
 	 */
 	size_t GetSearchStrings(std::set<wxString>& ioStrings) const override;
+	bool ForEachSearchString(ARBSearchStringCallback const& inCallback) const override;
 
 	/**
 	 * Load an existing point.
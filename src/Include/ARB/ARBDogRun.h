@@ -12,6 +12,8 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
+ * 2026-10-19 Added InsertRun/RepositionRun.
  * 2016-01-06 Add support for named lifetime points.
  * 2015-05-19 Added GetName (generic name without date).
  * 2012-09-09 Added 'titlePts' to 'Placement'.
@@ -86,6 +88,7 @@ public:
 	 * @return Number of strings accumulated in this object.
 	 */
 	size_t GetSearchStrings(std::set<wxString>& ioStrings) const override;
+	bool ForEachSearchString(ARBSearchStringCallback const& inCallback) const override;
 
 	/**
 	 * Load a run.
@@ -461,6 +464,23 @@ public:
 	 */
 	bool AddRun(ARBDogRunPtr const& inRun);
 
+	/**
+	 * Add a run, keeping the list sorted.
+	 * @param inRun Run to add.
+	 * @return Whether the object was added.
+	 * @pre The list is sorted.
+	 */
+	bool InsertRun(ARBDogRunPtr const& inRun);
+
+	/**
+	 * Move a run to its sorted position after its date changed.
+	 * @param inRun Run to move.
+	 * @return Whether the run was found.
+	 * @pre All other runs are sorted.
+	 * @note Equality is tested by pointer, not value.
+	 */
+	bool RepositionRun(ARBDogRunPtr const& inRun);
+
 	/**
 	 * Delete a run.
 	 * @param inRun Object to delete.
@@ -12,6 +12,8 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
+ * 2026-10-19 Added sorted insertion (AddTrial, RepositionTrial).
  * 2013-05-25 Implement a default date for a trial.
  * 2012-09-09 Added 'titlePts' to 'Placement'.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
@@ -72,6 +74,7 @@ public:
 	 * @return Number of strings accumulated in this object.
 	 */
 	size_t GetSearchStrings(std::set<wxString>& ioStrings) const override;
+	bool ForEachSearchString(ARBSearchStringCallback const& inCallback) const override;
 
 	/**
 	 * Load a trial.
@@ -372,13 +375,24 @@ public:
 	bool AddTrial(ARBDogTrialPtr const& inTrial);
 
 	/**
-	 * Add a trial and sort.
+	 * Add a trial, keeping the list sorted.
 	 * @param inTrial Trial to add.
 	 * @param inDescending Sort in descending or ascending order.
 	 * @return Whether the object was added.
+	 * @pre The list is sorted (see sort()) in the same order.
 	 */
 	bool AddTrial(ARBDogTrialPtr const& inTrial, bool inDescending);
 
+	/**
+	 * Move a trial to its sorted position after it (or its runs) changed.
+	 * @param inTrial Trial to move.
+	 * @param inDescending Sort in descending or ascending order.
+	 * @return Whether the trial was found.
+	 * @pre All other trials are sorted in the same order.
+	 * @note Equality is tested by pointer, not value.
+	 */
+	bool RepositionTrial(ARBDogTrialPtr const& inTrial, bool inDescending);
+
 	/**
 	 * Delete a trial.
 	 * @param inTrial Object to delete.
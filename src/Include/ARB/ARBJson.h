@@ -0,0 +1,67 @@
+#pragma once
+
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Read and write element trees as JSON.
+ * @author David Connet
+ *
+ * This is the same tree ARBAgilityRecordBook::Save/Load use for XML, so
+ * the data (and its ARBVersion handling) is identical. Each element is an
+ * object:
+ *   {"name": "Dog", "attrib": {"CallName": "Wolf"}, "value": "text", "children": [...]}
+ * "attrib", "value" and "children" are left out when empty. ARB documents
+ * never mix text and child elements, so the text of an element is written
+ * as one value.
+ *
+ * Neither direction builds an intermediate document: the writer streams the
+ * tree and the reader creates elements as it parses. The book itself is
+ * still converted to/from the element tree (as for XML), so JSON only
+ * replaces the text layer; serializing the objects directly would need a
+ * writer in every ARB class. 'arbtool' times the file read/write and the
+ * tree conversion separately, so the two formats can be compared.
+ *
+ * Revision History
+ * 2026-10-19 Document that only the text layer differs from XML.
+ * 2026-10-19 Created
+ */
+
+#include "LibwxARB.h"
+
+#include "ARBCommon/ARBTypes.h"
+#include <iosfwd>
+
+
+namespace dconSoft
+{
+namespace ARB
+{
+
+class ARB_API ARBJson
+{
+public:
+	/**
+	 * Write a tree.
+	 * @param inTree Tree to write.
+	 * @param outStream Stream to write to (UTF-8).
+	 * @return Success.
+	 */
+	static bool Save(ARBCommon::ElementNodePtr const& inTree, std::ostream& outStream);
+
+	/**
+	 * Read a tree.
+	 * @param outTree Root element, replaced by the data read.
+	 * @param inStream Stream to read (UTF-8).
+	 * @param ioErrMsg Where parsing failed.
+	 * @return Success.
+	 */
+	static bool Load(ARBCommon::ElementNodePtr const& outTree, std::istream& inStream, wxString& ioErrMsg);
+};
+
+} // namespace ARB
+} // namespace dconSoft
@@ -0,0 +1,118 @@
+#pragma once
+
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Full-text index of the searchable objects in a book.
+ * @author David Connet
+ *
+ * The index maps case-folded words to the objects whose search strings
+ * contain them. It is used to narrow a Find to the objects that might match;
+ * the caller still verifies each candidate, so the index never needs to know
+ * how the caller compares (case, whole word, etc).
+ *
+ * The index only uses object addresses as keys, it never dereferences them.
+ * When an object is deleted, it must be removed (or the index cleared) before
+ * a new object could be allocated at the same address.
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "ARBBase.h"
+#include "ARBTypes2.h"
+#include "LibwxARB.h"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+
+namespace dconSoft
+{
+namespace ARB
+{
+class ARBAgilityRecordBook;
+
+
+class ARB_API ARBSearchIndex
+{
+public:
+	ARBSearchIndex();
+	~ARBSearchIndex();
+
+	/**
+	 * Get all the objects in a book that should be indexed: dogs, trials,
+	 * runs, calendar entries, training entries and info items.
+	 * This is cheap (just pointers), so a caller can index the returned
+	 * objects in pieces.
+	 * @param inBook Book to index.
+	 * @param outObjects Objects to index.
+	 */
+	static void GetIndexableObjects(ARBAgilityRecordBook const& inBook, std::vector<ARBBasePtr>& outObjects);
+
+	/**
+	 * Split a string into case-folded words (runs of alphanumeric characters).
+	 * @param inStr String to split.
+	 * @param outTokens Words, in order.
+	 */
+	static void Tokenize(wxString const& inStr, std::vector<wxString>& outTokens);
+
+	/**
+	 * Remove everything from the index.
+	 */
+	void Clear();
+
+	/**
+	 * Number of objects in the index.
+	 */
+	size_t GetCount() const
+	{
+		return m_Objects.size();
+	}
+
+	/**
+	 * Add an object to the index, replacing any existing entry.
+	 * @param inObject Object to (re)index.
+	 */
+	void Update(ARBBasePtr const& inObject);
+
+	/**
+	 * Remove an object from the index.
+	 * @param inObject Object to remove.
+	 */
+	void Remove(ARBBase const* inObject);
+
+	/**
+	 * Find the objects that may contain a string (case insensitive).
+	 * The result is a superset of the objects that contain the string: words
+	 * in the middle of the search must match exactly, the last word matches
+	 * as a prefix, the first as a suffix (or anywhere, for a single word).
+	 * @param inSearch String being searched for.
+	 * @param outObjects Candidate objects.
+	 * @return false if the search has no words, so the index cannot narrow
+	 *         the search (outObjects is not set).
+	 */
+	bool Find(wxString const& inSearch, std::unordered_set<ARBBase const*>& outObjects) const;
+
+private:
+	typedef std::set<ARBBase const*> ObjectSet;
+
+	void FindExact(wxString const& inToken, ObjectSet& outObjects) const;
+	void FindPrefix(wxString const& inToken, ObjectSet& outObjects) const;
+	void FindSuffix(wxString const& inToken, ObjectSet& outObjects) const;
+	void FindSubstring(wxString const& inToken, ObjectSet& outObjects) const;
+
+	std::map<wxString, ObjectSet> m_Tokens;
+	std::unordered_map<ARBBase const*, std::vector<wxString>> m_Objects;
+};
+
+} // namespace ARB
+} // namespace dconSoft
@@ -0,0 +1,179 @@
+#pragma once
+
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Precomputed sort keys.
+ * @author David Connet
+ *
+ * Sorting with StringUtil::CompareNoCase folds both strings on every
+ * comparison. These helpers compute a collation key for each element once per
+ * sort (decorate, sort, undecorate) so the comparisons themselves are simple
+ * ordinal compares.
+ *
+ * Revision History
+ * 2026-10-19 Sort keys are locale collation keys.
+ * 2026-10-19 Added sorted insertion.
+ * 2026-10-19 Created
+ */
+
+#include "LibwxARB.h"
+
+#include <algorithm>
+#include <locale>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace dconSoft
+{
+namespace ARB
+{
+
+/**
+ * Create a case-insensitive collation key using the user's locale.
+ * The string is lowered, then transformed with the locale's collation, so
+ * accented characters sort next to their base letter.
+ * @param inStr String to fold.
+ * @return Sort key. Only meaningful to CompareSortKey.
+ */
+ARB_API std::wstring MakeSortKey(wxString const& inStr);
+
+/**
+ * Create a case-insensitive collation key.
+ * @param inStr String to fold.
+ * @param inLocale Locale whose collation is used.
+ * @return Sort key. Only meaningful to CompareSortKey.
+ */
+ARB_API std::wstring MakeSortKey(wxString const& inStr, std::locale const& inLocale);
+
+/**
+ * Compare two keys created by MakeSortKey.
+ * @return <0, 0, >0 (ordinal compare of the collation keys).
+ */
+inline int CompareSortKey(std::wstring const& inKey1, std::wstring const& inKey2)
+{
+	return inKey1.compare(inKey2);
+}
+
+
+/**
+ * Stable sort of a list, computing each element's key exactly once.
+ * @param ioList List to sort (any random access container).
+ * @param inMakeKey Functor returning the key for an element.
+ * @param inLess Strict weak ordering on keys.
+ */
+template <typename List, typename MakeKey, typename Less>
+void SortByKey(List& ioList, MakeKey inMakeKey, Less inLess)
+{
+	typedef typename List::value_type Item;
+	typedef typename std::decay<decltype(inMakeKey(std::declval<Item const&>()))>::type Key;
+
+	if (2 > ioList.size())
+		return;
+
+	std::vector<std::pair<Key, Item>> keyed;
+	keyed.reserve(ioList.size());
+	for (auto& item : ioList)
+		keyed.emplace_back(inMakeKey(item), std::move(item));
+
+	std::stable_sort(
+		keyed.begin(),
+		keyed.end(),
+		[&inLess](std::pair<Key, Item> const& one, std::pair<Key, Item> const& two) {
+			return inLess(one.first, two.first);
+		});
+
+	size_t n = 0;
+	for (auto& item : keyed)
+		ioList[n++] = std::move(item.second);
+}
+
+
+/**
+ * Insert an item into a sorted list. The item goes after any equal items,
+ * which is where a stable sort would put an appended item.
+ * @param ioList Sorted list.
+ * @param inItem Item to insert.
+ * @param inLess Strict weak ordering on items (the one the list is sorted by).
+ */
+template <typename List, typename Less>
+void InsertSorted(List& ioList, typename List::value_type const& inItem, Less inLess)
+{
+	ioList.insert(std::upper_bound(ioList.begin(), ioList.end(), inItem, inLess), inItem);
+}
+
+
+/**
+ * Move a modified item to its sorted position. An item that is still in
+ * order with its neighbors is left alone so equal items keep their order.
+ * The item's current position is found with a linear scan (O(n) pointer
+ * compares): its key has changed, so a binary search on it cannot find the
+ * old slot. Only the reinsertion is a binary search, so the expensive
+ * comparisons are O(log n).
+ * @param ioList List that is sorted except for inItem.
+ * @param inItem Item to move (found by value of the element, ie pointer).
+ * @param inLess Strict weak ordering on items (the one the list is sorted by).
+ * @return Whether the item was found.
+ */
+template <typename List, typename Less>
+bool RepositionSorted(List& ioList, typename List::value_type const& inItem, Less inLess)
+{
+	auto iter = std::find(ioList.begin(), ioList.end(), inItem);
+	if (iter == ioList.end())
+		return false;
+	bool bInOrder = (iter == ioList.begin() || !inLess(inItem, *(iter - 1)))
+					&& (iter + 1 == ioList.end() || !inLess(*(iter + 1), inItem));
+	if (!bInOrder)
+	{
+		// Copy first: inItem may refer to the element being erased.
+		typename List::value_type item(inItem);
+		ioList.erase(iter);
+		InsertSorted(ioList, item, inLess);
+	}
+	return true;
+}
+
+
+/**
+ * Lazily computed sort keys for a single list row, one per column.
+ * List controls sort through a callback, so the key is computed the first
+ * time a column is compared and reused for the lifetime of the row.
+ * Call Clear() if the underlying object is modified.
+ */
+class ARBSortKeyCache
+{
+public:
+	/**
+	 * Get the key for a column, computing it if needed.
+	 * @param inCol Column identifier.
+	 * @param inGetString Functor returning the unfolded string.
+	 * @return Sort key.
+	 */
+	template <typename GetString> std::wstring const& Get(long inCol, GetString inGetString)
+	{
+		auto iter = m_Keys.find(inCol);
+		if (iter == m_Keys.end())
+			iter = m_Keys.insert(std::make_pair(inCol, MakeSortKey(inGetString()))).first;
+		return iter->second;
+	}
+
+	void Clear()
+	{
+		m_Keys.clear();
+	}
+
+private:
+	std::map<long, std::wstring> m_Keys;
+};
+
+} // namespace ARB
+} // namespace dconSoft
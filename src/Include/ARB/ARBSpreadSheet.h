@@ -0,0 +1,116 @@
+#pragma once
+
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Read and write XLSX and ODS files directly.
+ * @author David Connet
+ *
+ * Both formats are a zip of XML parts. Only what import/export needs is
+ * supported: a single sheet of text. The writer streams the sheet, so rows
+ * are never held in memory. The reader only decompresses the parts it needs.
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "LibwxARB.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+class wxInputStream;
+class wxOutputStream;
+class wxZipOutputStream;
+
+
+namespace dconSoft
+{
+namespace ARB
+{
+
+enum class ARBSpreadSheetFormat
+{
+	Xlsx,
+	Ods
+};
+
+
+class ARB_API ARBSpreadSheetWriter
+{
+public:
+	ARBSpreadSheetWriter(ARBSpreadSheetFormat inFormat, wxOutputStream& ioStream);
+	~ARBSpreadSheetWriter();
+
+	/**
+	 * Set column widths. Must be called before the first row is added.
+	 * @param inWidths Width of each column, in characters.
+	 */
+	void SetColumnWidths(std::vector<size_t> const& inWidths);
+
+	/**
+	 * Add the next row.
+	 * @param inRow Cell text.
+	 * @return Success.
+	 */
+	bool AddRow(std::vector<wxString> const& inRow);
+
+	/**
+	 * Finish the file. This is also done when the writer is destroyed, but
+	 * then any error is lost.
+	 * @return Success.
+	 */
+	bool Close();
+
+private:
+	bool Start();
+	bool Write(std::string const& inData);
+	void AppendCellXlsx(wxString const& inText, size_t inCol);
+	void AppendCellOds(wxString const& inText);
+
+	ARBSpreadSheetFormat m_Format;
+	std::unique_ptr<wxZipOutputStream> m_Zip;
+	std::vector<size_t> m_Widths;
+	std::string m_Buffer;
+	size_t m_Row;
+	bool m_bStarted;
+	bool m_bOk;
+
+	ARBSpreadSheetWriter(ARBSpreadSheetWriter const&) = delete;
+	ARBSpreadSheetWriter& operator=(ARBSpreadSheetWriter const&) = delete;
+};
+
+
+class ARB_API ARBSpreadSheetReader
+{
+public:
+	/**
+	 * Read the first sheet of an XLSX or ODS file (determined from the
+	 * content, not the name). Dates are returned as yyyy-mm-dd.
+	 * @param ioStream Stream to read, must be seekable.
+	 * @param outData Cells, by row. Trailing empty rows/cells are dropped.
+	 * @return Success.
+	 */
+	static bool Read(wxInputStream& ioStream, std::vector<std::vector<wxString>>& outData);
+
+	/**
+	 * Read a file.
+	 * @param inFileName File to read.
+	 * @param outData Cells, by row.
+	 * @return Success.
+	 */
+	static bool Read(wxString const& inFileName, std::vector<std::vector<wxString>>& outData);
+
+	/**
+	 * Whether a file name has an extension the reader supports.
+	 */
+	static bool IsSupportedFile(wxString const& inFileName);
+};
+
+} // namespace ARB
+} // namespace dconSoft
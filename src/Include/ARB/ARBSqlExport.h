@@ -0,0 +1,54 @@
+#pragma once
+
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Export the record book as an SQL script.
+ * @author David Connet
+ *
+ * The script creates a normalized schema (dogs, registration numbers,
+ * titles, existing points, trials, trial clubs, runs, calendar, training)
+ * and fills it in a single transaction. It is written for SQLite:
+ *   sqlite3 book.db < book.sql
+ * Running it again replaces the tables, so the database can be used as a
+ * mirror of the record book.
+ *
+ * Run scores, title and speed points are computed from the configuration
+ * so they can be queried without ARB.
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "LibwxARB.h"
+
+#include <iosfwd>
+
+
+namespace dconSoft
+{
+namespace ARB
+{
+class ARBAgilityRecordBook;
+
+
+class ARB_API ARBSqlExport
+{
+public:
+	/**
+	 * Write the script.
+	 * @param inBook Book to export.
+	 * @param inTableInYPS Include table time in YPS computation.
+	 * @param outStream Stream to write to (UTF-8).
+	 * @return Success.
+	 */
+	static bool Write(ARBAgilityRecordBook const& inBook, bool inTableInYPS, std::ostream& outStream);
+};
+
+} // namespace ARB
+} // namespace dconSoft
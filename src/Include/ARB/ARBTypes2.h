@@ -12,6 +12,8 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Skip deep compare of identical list items.
+ * 2026-10-19 Added ARBSearchStringCallback.
  * 2016-01-06 Added ARBConfigLifetimeName.
  * 2013-04-15 Moved ARB specific things out of ARBTypes.h
  * 2012-09-09 Added ARBVectorNoSave.
@@ -21,6 +23,7 @@
 
 #include "ARBCommon/ARBTypes.h"
 #include "ARBCommon/Element.h"
+#include <functional>
 #include <set>
 
 namespace dconSoft
@@ -76,6 +79,32 @@ ARB_TYPEDEF_LIST(ARBInfoItem)
 ARB_TYPEDEF_LIST(ARBTraining)
 
 
+/**
+ * Callback used to enumerate search strings (see ARBBase::ForEachSearchString).
+ * Return false to stop the enumeration.
+ */
+typedef std::function<bool(wxString const&)> ARBSearchStringCallback;
+
+
+/**
+ * Accumulate an object's search strings into a set.
+ * This is how GetSearchStrings is implemented on objects that enumerate.
+ * @param inObj Object that implements ForEachSearchString.
+ * @param ioStrings Accumulated list of strings to be used during a search.
+ * @return Number of strings accumulated.
+ */
+template <typename T> size_t CollectSearchStrings(T const& inObj, std::set<wxString>& ioStrings)
+{
+	size_t nItems = 0;
+	inObj.ForEachSearchString([&ioStrings, &nItems](wxString const& str) {
+		ioStrings.insert(str);
+		++nItems;
+		return true;
+	});
+	return nItems;
+}
+
+
 /**
  * Extend some common functionality.
  */
@@ -99,7 +128,9 @@ public:
 		for (iter1 = ARBVectorNoSave<T>::begin(), iter2 = rhs.begin(); iter1 != ARBVectorNoSave<T>::end();
 			 ++iter1, ++iter2)
 		{
-			if (*(*iter1) != *(*iter2))
+			// Lists may share items (config updates add the new object).
+			// Only different objects need a deep compare.
+			if (*iter1 != *iter2 && *(*iter1) != *(*iter2))
 				return false;
 		}
 		return true;
@@ -145,6 +176,23 @@ public:
 		return nItems;
 	}
 
+	/**
+	 * Enumerate all the strings to search in this list.
+	 * @param inCallback Called for each string, return false to stop.
+	 * @return false if the callback stopped the enumeration.
+	 */
+	bool ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+	{
+		for (typename ARBVectorNoSave<T>::const_iterator iter = ARBVectorNoSave<T>::begin();
+			 iter != ARBVectorNoSave<T>::end();
+			 ++iter)
+		{
+			if (!(*iter)->ForEachSearchString(inCallback))
+				return false;
+		}
+		return true;
+	}
+
 	/**
 	 * Reorder a list.
 	 * @param inItem Object to be moved.
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
  * 2003-08-24 Optimized filtering by adding boolean into ARBBase to
  *            prevent constant re-evaluation.
@@ -66,6 +67,19 @@ ARBBase::~ARBBase()
 }
 
 
+bool ARBBase::ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+{
+	std::set<wxString> strings;
+	GetSearchStrings(strings);
+	for (auto const& str : strings)
+	{
+		if (!inCallback(str))
+			return false;
+	}
+	return true;
+}
+
+
 bool ARBBase::IsFiltered(ARBFilterType inFilterType) const
 {
 	return m_bFiltered[FilterToIndex(inFilterType)];
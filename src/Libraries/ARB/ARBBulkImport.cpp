@@ -0,0 +1,385 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Add many runs (or a whole imported book) to a book in one pass.
+ * @author David Connet
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "ARB/ARBBulkImport.h"
+
+#include "ARB/ARBAgilityRecordBook.h"
+#include <unordered_map>
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+using namespace ARBCommon;
+namespace ARB
+{
+
+ARBBulkImport::ARBBulkImport(ARBAgilityRecordBook& ioBook)
+	: m_Book(ioBook)
+	, m_bDogsIndexed(false)
+	, m_RegNames()
+	, m_CallNames()
+	, m_Names()
+	, m_Trials()
+	, m_Events()
+	, m_ModifiedDogs()
+	, m_ModifiedTrials()
+{
+}
+
+
+ARBBulkImport::~ARBBulkImport()
+{
+}
+
+
+bool ARBBulkImport::FindEvent(
+	wxString const& inVenue,
+	wxString const& inEvent,
+	wxString const& inDivision,
+	wxString const& inLevel,
+	ARBDate const& inDate,
+	ARBConfigScoringPtr* outScoring)
+{
+	wxString key;
+	key << inVenue << L'\n' << inEvent << L'\n' << inDivision << L'\n' << inLevel << L'\n' << inDate.GetJulianDay();
+	auto iter = m_Events.find(key);
+	if (iter == m_Events.end())
+	{
+		ARBConfigScoringPtr pScoring;
+		bool bFound = m_Book.GetConfig().GetVenues().FindEvent(
+			inVenue,
+			inEvent,
+			inDivision,
+			inLevel,
+			inDate,
+			nullptr,
+			&pScoring);
+		iter = m_Events.insert(std::make_pair(key, std::make_pair(bFound, pScoring))).first;
+	}
+	if (outScoring)
+		*outScoring = iter->second.second;
+	return iter->second.first;
+}
+
+
+ARBDogPtr ARBBulkImport::FindDog(wxString const& inRegName, wxString const& inCallName)
+{
+	IndexDogs();
+	ARBDogPtr pDog;
+	if (!inRegName.empty() && !inCallName.empty())
+	{
+		auto iter = m_Names.find(std::make_pair(inRegName, inCallName));
+		if (iter != m_Names.end())
+			pDog = iter->second;
+	}
+	else if (!inRegName.empty())
+	{
+		auto iter = m_RegNames.find(inRegName);
+		if (iter != m_RegNames.end())
+			pDog = iter->second;
+	}
+	else if (!inCallName.empty())
+	{
+		auto iter = m_CallNames.find(inCallName);
+		if (iter != m_CallNames.end())
+			pDog = iter->second;
+	}
+	return pDog;
+}
+
+
+void ARBBulkImport::AddDog(ARBDogPtr const& inDog)
+{
+	IndexDogs();
+	if (!m_Book.GetDogs().AddDog(inDog))
+		return;
+	// Existing dogs win: the lookups return the first dog in the book.
+	m_RegNames.insert(std::make_pair(inDog->GetRegisteredName(), inDog));
+	m_CallNames.insert(std::make_pair(inDog->GetCallName(), inDog));
+	m_Names.insert(std::make_pair(std::make_pair(inDog->GetRegisteredName(), inDog->GetCallName()), inDog));
+	m_ModifiedDogs.insert(inDog);
+	for (auto const& pTrial : inDog->GetTrials())
+		m_ModifiedTrials.insert(pTrial);
+}
+
+
+ARBDogTrialPtr ARBBulkImport::FindTrial(
+	ARBDogPtr const& inDog,
+	ARBDate const& inDate,
+	wxString const& inLocation,
+	std::vector<wxString> const& inClubs,
+	std::vector<wxString> const& inVenues)
+{
+	TrialIndex& trials = GetTrialIndex(inDog);
+	auto iter = trials.find(TrialKey(inLocation, inClubs, inVenues));
+	if (iter == trials.end())
+		return ARBDogTrialPtr();
+	// Loop two times - first time, try to match.
+	// Then straddle the date.
+	for (int iLoop = 0; iLoop < 2; ++iLoop)
+	{
+		for (auto const& pTrial : iter->second)
+		{
+			ARBDate startDate = pTrial->GetStartDate();
+			ARBDate endDate = pTrial->GetEndDate();
+			if (1 == iLoop)
+			{
+				--startDate;
+				++endDate;
+			}
+			if (inDate.isBetween(startDate, endDate))
+				return pTrial;
+		}
+	}
+	return ARBDogTrialPtr();
+}
+
+
+void ARBBulkImport::AddTrial(ARBDogPtr const& inDog, ARBDogTrialPtr const& inTrial)
+{
+	TrialIndex& trials = GetTrialIndex(inDog);
+	if (!inDog->GetTrials().AddTrial(inTrial))
+		return;
+	trials[TrialKey(inTrial)].push_back(inTrial);
+	m_ModifiedDogs.insert(inDog);
+	m_ModifiedTrials.insert(inTrial);
+}
+
+
+void ARBBulkImport::AddRun(ARBDogPtr const& inDog, ARBDogTrialPtr const& inTrial, ARBDogRunPtr const& inRun)
+{
+	if (!inTrial->GetRuns().AddRun(inRun))
+		return;
+	// The trial dates may have changed, so the dog's trials need sorting too.
+	m_ModifiedDogs.insert(inDog);
+	m_ModifiedTrials.insert(inTrial);
+}
+
+
+void ARBBulkImport::MergeDog(ARBDogPtr const& inDog, MergeCounts& ioCounts)
+{
+	IndexDogs();
+	ARBDogPtr pExisting;
+	auto iterDog = m_CallNames.find(inDog->GetCallName());
+	if (iterDog != m_CallNames.end())
+		pExisting = iterDog->second;
+
+	if (!pExisting)
+	{
+		++ioCounts.dogs;
+		AddDog(inDog);
+		return;
+	}
+	if (*pExisting == *inDog)
+		return;
+
+	// If the dog exists, only update the existing points,
+	// registration numbers, titles and trials.
+	bool bModified = false;
+	if (pExisting->GetRegNums() != inDog->GetRegNums())
+	{
+		for (auto const& pRegNum : inDog->GetRegNums())
+		{
+			ARBDogRegNumPtr pRegExist;
+			if (pExisting->GetRegNums().FindRegNum(pRegNum->GetVenue(), &pRegExist))
+			{
+				if (*pRegExist != *pRegNum)
+				{
+					++ioCounts.regNumsUpdated;
+					*pRegExist = *pRegNum;
+					bModified = true;
+				}
+			}
+			else
+			{
+				++ioCounts.regNumsAdded;
+				pExisting->GetRegNums().AddRegNum(pRegNum);
+				bModified = true;
+			}
+		}
+	}
+
+	if (pExisting->GetExistingPoints() != inDog->GetExistingPoints())
+	{
+		// Only points on the same date can be equal.
+		std::unordered_multimap<long, ARBDogExistingPointsPtr> existing;
+		for (auto const& pPts : pExisting->GetExistingPoints())
+			existing.insert(std::make_pair(pPts->GetDate().GetJulianDay(), pPts));
+		for (auto const& pPts : inDog->GetExistingPoints())
+		{
+			bool bFound = false;
+			auto range = existing.equal_range(pPts->GetDate().GetJulianDay());
+			for (auto iter = range.first; !bFound && iter != range.second; ++iter)
+			{
+				if (*pPts == *iter->second)
+					bFound = true;
+			}
+			if (!bFound)
+			{
+				++ioCounts.existingPts;
+				pExisting->GetExistingPoints().AddExistingPoints(pPts);
+				existing.insert(std::make_pair(pPts->GetDate().GetJulianDay(), pPts));
+				bModified = true;
+			}
+		}
+	}
+
+	if (pExisting->GetTitles() != inDog->GetTitles())
+	{
+		// Same as FindTitle: the highest instance of a venue's title.
+		std::map<std::pair<wxString, wxString>, ARBDogTitlePtr> titles;
+		for (auto const& pTitle : pExisting->GetTitles())
+		{
+			ARBDogTitlePtr& pMax = titles[std::make_pair(pTitle->GetVenue(), pTitle->GetRawName())];
+			if (!pMax || pMax->GetInstance() < pTitle->GetInstance())
+				pMax = pTitle;
+		}
+		for (auto const& pTitle : inDog->GetTitles())
+		{
+			auto key = std::make_pair(pTitle->GetVenue(), pTitle->GetRawName());
+			auto iter = titles.find(key);
+			if (iter != titles.end())
+			{
+				if (*pTitle != *iter->second)
+				{
+					++ioCounts.titlesUpdated;
+					*iter->second = *pTitle;
+					bModified = true;
+					// The instance may have changed.
+					pExisting->GetTitles().FindTitle(key.first, key.second, &iter->second);
+				}
+			}
+			else
+			{
+				++ioCounts.titlesAdded;
+				ARBDogTitlePtr pNewTitle = pTitle->Clone();
+				pExisting->GetTitles().AddTitle(pNewTitle);
+				titles[key] = pNewTitle;
+				bModified = true;
+			}
+		}
+	}
+
+	if (pExisting->GetTrials() != inDog->GetTrials())
+	{
+		TrialIndex& trials = GetTrialIndex(pExisting);
+		for (auto const& pTrial : inDog->GetTrials())
+		{
+			// Only trials at the same place can be equal.
+			bool bFound = false;
+			auto iter = trials.find(TrialKey(pTrial));
+			if (iter != trials.end())
+			{
+				for (auto const& pTrialExist : iter->second)
+				{
+					if (*pTrial == *pTrialExist)
+					{
+						bFound = true;
+						break;
+					}
+				}
+			}
+			if (!bFound)
+			{
+				++ioCounts.trials;
+				AddTrial(pExisting, pTrial);
+			}
+		}
+	}
+
+	if (bModified)
+		m_ModifiedDogs.insert(pExisting);
+}
+
+
+void ARBBulkImport::Finish(bool inDescending)
+{
+	for (auto const& pTrial : m_ModifiedTrials)
+	{
+		pTrial->SetMultiQs(m_Book.GetConfig());
+		pTrial->GetRuns().sort();
+	}
+	for (auto const& pDog : m_ModifiedDogs)
+		pDog->GetTrials().sort(inDescending);
+	m_ModifiedTrials.clear();
+}
+
+
+std::vector<ARBDogPtr> ARBBulkImport::GetModifiedDogs() const
+{
+	std::vector<ARBDogPtr> dogs;
+	for (auto const& pDog : m_Book.GetDogs())
+	{
+		if (0 < m_ModifiedDogs.count(pDog))
+			dogs.push_back(pDog);
+	}
+	return dogs;
+}
+
+
+wxString ARBBulkImport::TrialKey(
+	wxString const& inLocation,
+	std::vector<wxString> const& inClubs,
+	std::vector<wxString> const& inVenues)
+{
+	wxString key(inLocation);
+	for (size_t idx = 0; idx < inClubs.size() && idx < inVenues.size(); ++idx)
+		key << L'\n' << inVenues[idx] << L'\t' << inClubs[idx];
+	return key;
+}
+
+
+wxString ARBBulkImport::TrialKey(ARBDogTrialPtr const& inTrial)
+{
+	wxString key(inTrial->GetLocation());
+	for (auto const& pClub : inTrial->GetClubs())
+		key << L'\n' << pClub->GetVenue() << L'\t' << pClub->GetName();
+	return key;
+}
+
+
+void ARBBulkImport::IndexDogs()
+{
+	if (m_bDogsIndexed)
+		return;
+	m_bDogsIndexed = true;
+	for (auto const& pDog : m_Book.GetDogs())
+	{
+		m_RegNames.insert(std::make_pair(pDog->GetRegisteredName(), pDog));
+		m_CallNames.insert(std::make_pair(pDog->GetCallName(), pDog));
+		m_Names.insert(std::make_pair(std::make_pair(pDog->GetRegisteredName(), pDog->GetCallName()), pDog));
+	}
+}
+
+
+ARBBulkImport::TrialIndex& ARBBulkImport::GetTrialIndex(ARBDogPtr const& inDog)
+{
+	auto iter = m_Trials.find(inDog.get());
+	if (iter == m_Trials.end())
+	{
+		iter = m_Trials.insert(std::make_pair(inDog.get(), TrialIndex())).first;
+		for (auto const& pTrial : inDog->GetTrials())
+			iter->second[TrialKey(pTrial)].push_back(pTrial);
+	}
+	return iter->second;
+}
+
+} // namespace ARB
+} // namespace dconSoft
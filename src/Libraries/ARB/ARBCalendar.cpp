@@ -10,6 +10,11 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Index the list on the match fields.
+ * 2026-10-19 Added iCalendarRead and ImportICalendar.
+ * 2026-10-19 Buffer iCalendar output, added iCalendarFeed.
+ * 2026-10-19 Added ForEachSearchString.
+ * 2026-10-19 Sort using precomputed keys.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2007-08-11 Changed usage of FindCalendar.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
@@ -32,10 +37,15 @@
 
 #include "ARB/ARBAgilityRecordBook.h"
 #include "ARB/ARBLocalization.h"
+#include "ARB/ARBSortKey.h"
 #include "ARBCommon/ARBTypes.h"
 #include "ARBCommon/Element.h"
 #include "ARBCommon/StringUtil.h"
 #include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <sstream>
+#include <unordered_map>
 
 #ifdef __WXMSW__
 #include <wx/msw/msvcrt.h>
@@ -65,24 +75,321 @@ constexpr wchar_t ACCOM_CONFIRMED[] = L"C";
 // See RFC2445. (http://tools.ietf.org/html/rfc2445)
 // Note: EOL sequence is defined as "\r\n"
 
+namespace
+{
+constexpr size_t ICAL_BUFFER_SIZE = 64 * 1024;
+constexpr char ICAL_BEGIN_EVENT[] = "BEGIN:VEVENT\r\n";
+constexpr char ICAL_END_EVENT[] = "END:VEVENT\r\n";
+// Identifies the content an event in a feed was generated from.
+constexpr char ICAL_FINGERPRINT[] = "X-ARB-FINGERPRINT";
+
+
+// Value of a property in an event, empty if not found.
+std::string GetEventProperty(std::string const& inEvent, char const* inName)
+{
+	std::string line("\r\n");
+	line += inName;
+	line += ':';
+	size_t pos = inEvent.find(line);
+	if (std::string::npos == pos)
+		return std::string();
+	pos += line.length();
+	return inEvent.substr(pos, inEvent.find("\r\n", pos) - pos);
+}
+
+
+void ICalToUpper(std::string& ioStr)
+{
+	for (auto& c : ioStr)
+	{
+		if ('a' <= c && c <= 'z')
+			c = static_cast<char>(c - 'a' + 'A');
+	}
+}
+
+
+// Decode a TEXT value. RFC 5545, section 3.3.11
+wxString ICalUnescape(std::string const& inValue)
+{
+	std::string str;
+	str.reserve(inValue.length());
+	for (size_t i = 0; i < inValue.length(); ++i)
+	{
+		if ('\\' == inValue[i] && i + 1 < inValue.length())
+		{
+			++i;
+			if ('n' == inValue[i] || 'N' == inValue[i])
+				str += '\n';
+			else
+				str += inValue[i];
+		}
+		else
+			str += inValue[i];
+	}
+	return wxString::FromUTF8(str);
+}
+
+
+int ICalHexDigit(char c)
+{
+	if ('0' <= c && c <= '9')
+		return c - '0';
+	if ('A' <= c && c <= 'F')
+		return c - 'A' + 10;
+	if ('a' <= c && c <= 'f')
+		return c - 'a' + 10;
+	return -1;
+}
+
+
+// vCalendar QUOTED-PRINTABLE value.
+std::string ICalDecodeQP(std::string const& inValue)
+{
+	std::string str;
+	str.reserve(inValue.length());
+	for (size_t i = 0; i < inValue.length(); ++i)
+	{
+		if ('=' == inValue[i] && i + 2 < inValue.length() && 0 <= ICalHexDigit(inValue[i + 1])
+			&& 0 <= ICalHexDigit(inValue[i + 2]))
+		{
+			str += static_cast<char>(ICalHexDigit(inValue[i + 1]) * 16 + ICalHexDigit(inValue[i + 2]));
+			i += 2;
+		}
+		else
+			str += inValue[i];
+	}
+	return str;
+}
+
+
+// DATE or DATE-TIME value, only the date is used. outMidnight is set if the
+// value is the very start of the day (a non-inclusive end).
+ARBDate ICalDate(std::string const& inValue, bool& outMidnight)
+{
+	outMidnight = false;
+	if (8 > inValue.length())
+		return ARBDate();
+	int ymd[3] = {0, 0, 0};
+	for (size_t i = 0; i < 8; ++i)
+	{
+		if (inValue[i] < '0' || '9' < inValue[i])
+			return ARBDate();
+		int& val = ymd[i < 4 ? 0 : (i < 6 ? 1 : 2)];
+		val = val * 10 + (inValue[i] - '0');
+	}
+	outMidnight = 8 == inValue.length() || 0 == inValue.compare(8, 7, "T000000");
+	return ARBDate(ymd[0], ymd[1], ymd[2]);
+}
+
+
+// Number of days in a DURATION ("P2D", "P1W", "PT12H" is 0).
+int ICalDurationDays(std::string const& inValue)
+{
+	if (inValue.empty() || 'P' != inValue[0])
+		return 0;
+	int days = 0;
+	size_t pos = 1;
+	for (; pos < inValue.length() && '0' <= inValue[pos] && inValue[pos] <= '9'; ++pos)
+		days = days * 10 + (inValue[pos] - '0');
+	if (pos == inValue.length())
+		days = 0;
+	else if ('W' == inValue[pos])
+		days *= 7;
+	else if ('D' != inValue[pos])
+		days = 0;
+	return days;
+}
+
+
+// Undo the status and dates ARBCalendar::iCalendar puts in front of the note.
+void ICalSetDescription(ARBCalendar& ioCal, wxString const& inDesc)
+{
+	wxString desc(inDesc);
+	wxString rest;
+	bool bTentative = desc.StartsWith(Localization()->CalendarTentative() + L" ", &rest);
+	if (bTentative)
+		desc = rest;
+	std::pair<wxString, ARBCalendarEntry> const status[] = {
+		{Localization()->CalendarStatusN(), ARBCalendarEntry::Not},
+		{Localization()->CalendarStatusE(), ARBCalendarEntry::Entered},
+		{Localization()->CalendarStatusO(), ARBCalendarEntry::Pending},
+		{Localization()->CalendarStatusP(), ARBCalendarEntry::Planning},
+	};
+	bool bStatus = false;
+	for (auto const& entry : status)
+	{
+		if (desc.StartsWith(entry.first + L" ", &rest))
+		{
+			bStatus = true;
+			ioCal.SetEntered(entry.second);
+			desc = rest;
+			break;
+		}
+	}
+	// Not one of ours.
+	if (!bStatus)
+	{
+		ioCal.SetNote(inDesc);
+		return;
+	}
+	if (bTentative)
+		ioCal.SetIsTentative(true);
+	std::pair<wxString, void (ARBCalendar::*)(ARBDate const&)> const dates[] = {
+		{Localization()->CalendarOpens(), &ARBCalendar::SetOpeningDate},
+		{Localization()->CalendarDraw(), &ARBCalendar::SetDrawDate},
+		{Localization()->CalendarCloses(), &ARBCalendar::SetClosingDate},
+	};
+	for (auto const& entry : dates)
+	{
+		if (desc.StartsWith(entry.first, &rest) && 10 < rest.length() && L' ' == rest[10])
+		{
+			ARBDate date = ARBDate::FromString(rest.Left(10), ARBDateFormat::ISO);
+			if (date.IsValid())
+			{
+				(ioCal.*entry.second)(date);
+				desc = rest.Mid(11);
+			}
+		}
+	}
+	ioCal.SetNote(desc);
+}
+
+
+// Reads the unfolded content lines of an iCalendar stream.
+class CICalReader
+{
+public:
+	CICalReader(std::istream& ioStream)
+		: m_ioStream(ioStream)
+		, m_Next()
+		, m_bHasNext(false)
+		, m_bFirst(true)
+	{
+	}
+
+	// outName is uppercased. Returns false at the end of the stream.
+	bool GetLine(std::string& outName, std::string& outParams, std::string& outValue);
+
+private:
+	bool ReadLine(std::string& outLine);
+
+	std::istream& m_ioStream;
+	std::string m_Next;
+	bool m_bHasNext;
+	bool m_bFirst;
+};
+
+
+bool CICalReader::ReadLine(std::string& outLine)
+{
+	if (!std::getline(m_ioStream, outLine))
+		return false;
+	if (!outLine.empty() && '\r' == outLine.back())
+		outLine.pop_back();
+	if (m_bFirst)
+	{
+		m_bFirst = false;
+		if (0 == outLine.compare(0, 3, "\xEF\xBB\xBF"))
+			outLine.erase(0, 3);
+	}
+	return true;
+}
+
+
+bool CICalReader::GetLine(std::string& outName, std::string& outParams, std::string& outValue)
+{
+	std::string line;
+	do
+	{
+		if (m_bHasNext)
+		{
+			line.swap(m_Next);
+			m_bHasNext = false;
+		}
+		else if (!ReadLine(line))
+			return false;
+	} while (line.empty());
+
+	// The value starts at the first colon that isn't in a quoted parameter.
+	auto findValue = [](std::string const& inLine) {
+		bool bQuoted = false;
+		for (size_t i = 0; i < inLine.length(); ++i)
+		{
+			if ('"' == inLine[i])
+				bQuoted = !bQuoted;
+			else if (':' == inLine[i] && !bQuoted)
+				return i;
+		}
+		return std::string::npos;
+	};
+	size_t posValue = findValue(line);
+	std::string prefix(line, 0, posValue);
+	ICalToUpper(prefix);
+	bool bQP = std::string::npos != prefix.find("QUOTED-PRINTABLE");
+
+	// Unfold. RFC 5545, section 3.1 (vCalendar also uses soft line breaks)
+	while (ReadLine(m_Next))
+	{
+		if (!m_Next.empty() && (' ' == m_Next[0] || '\t' == m_Next[0]))
+			line.append(m_Next, 1, std::string::npos);
+		else if (bQP && !line.empty() && '=' == line.back())
+		{
+			line.pop_back();
+			line += m_Next;
+		}
+		else
+		{
+			m_bHasNext = true;
+			break;
+		}
+	}
+	if (std::string::npos == posValue)
+		posValue = findValue(line);
+
+	size_t posParams = line.find(';');
+	if (posParams > posValue)
+		posParams = posValue;
+	outName = line.substr(0, posParams);
+	ICalToUpper(outName);
+	outParams.clear();
+	outValue.clear();
+	if (posParams < posValue)
+	{
+		outParams = line.substr(posParams + 1, posValue - posParams - 1);
+		ICalToUpper(outParams);
+	}
+	if (std::string::npos != posValue)
+		outValue = line.substr(posValue + 1);
+	if (bQP)
+		outValue = ICalDecodeQP(outValue);
+	return true;
+}
+} // namespace
+
+
 class ARBiCal : public ICalendar
 {
 public:
-	ARBiCal(std::ostream& ioStream, int inVersion);
+	ARBiCal(std::ostream& ioStream, int inVersion, bool inFeed = false);
 	~ARBiCal()
 	{
 		Write("END:VCALENDAR\r\n");
+		Flush();
 	}
 
 	void BeginEvent()
 	{
-		Write("BEGIN:VEVENT\r\n");
+		Write(ICAL_BEGIN_EVENT);
 	}
 	void DoUID(wxString const& inUID)
 	{
 		WriteText("UID", inUID, false);
 	}
-	void DoDTSTAMP();
+	void DoFingerprint(ARBCalendar const& inCal, int inAlarm);
+	void DoDTSTAMP()
+	{
+		Write(m_DTStamp);
+	}
 	void DoDTSTART(ARBDate inDate)
 	{
 		Write("DTSTART", inDate, true);
@@ -111,35 +418,63 @@ public:
 		if (1 < m_Version)
 		{
 			Write("BEGIN:VALARM\r\nACTION:DISPLAY\r\nTRIGGER:-PT");
-			Write(wxString::Format("%d", inDaysBefore * 24 * 60).utf8_string());
+			Write(std::to_string(inDaysBefore * 24 * 60));
 			Write("M\r\nDESCRIPTION:Reminder\r\nEND:VALARM\r\n");
 		}
 	}
 	void EndEvent()
 	{
-		Write("END:VEVENT\r\n");
+		Write(ICAL_END_EVENT);
+		if (ICAL_BUFFER_SIZE <= m_Buffer.length())
+			Flush();
+	}
+	// Copy an event (from BEGIN to END) from a previous feed.
+	void CopyEvent(std::string const& inEvent)
+	{
+		Write(inEvent);
+		if (ICAL_BUFFER_SIZE <= m_Buffer.length())
+			Flush();
 	}
 
+	static std::string Fingerprint(ARBCalendar const& inCal, int inAlarm);
+
 private:
-	void Write(char inVal);
-	void Write(char const* const inVal);
-	void Write(std::string const& inVal);
+	void Flush();
+	void Write(char inVal)
+	{
+		m_Buffer += inVal;
+	}
+	void Write(char const* const inVal)
+	{
+		if (inVal)
+			m_Buffer += inVal;
+	}
+	void Write(std::string const& inVal)
+	{
+		m_Buffer += inVal;
+	}
 	void Write(char const* const inVal, ARBDate inDate, bool inStartOfDay);
-	void WriteSafeChar(std::string const& inText);
 	void WriteText(char const* const inToken, wxString const& inText, bool bQuotedPrint);
 
 	std::ostream& m_ioStream;
 	int m_Version;
+	bool m_bFeed;
+	std::string m_Buffer;
+	std::string m_DTStamp;
 	DECLARE_NO_COPY_IMPLEMENTED(ARBiCal);
 };
 
 typedef std::shared_ptr<ARBiCal> ARBiCalPtr;
 
 
-ARBiCal::ARBiCal(std::ostream& ioStream, int inVersion)
+ARBiCal::ARBiCal(std::ostream& ioStream, int inVersion, bool inFeed)
 	: m_ioStream(ioStream)
 	, m_Version(inVersion)
+	, m_bFeed(inFeed)
+	, m_Buffer()
+	, m_DTStamp()
 {
+	m_Buffer.reserve(ICAL_BUFFER_SIZE + 1024);
 	// All V1.0 syntax was figured out by exporting an entry from Outlook2003.
 	Write("BEGIN:VCALENDAR\r\n");
 	Write("PRODID:-//dcon Software//Agility Record Book//EN\r\n");
@@ -156,29 +491,69 @@ ARBiCal::ARBiCal(std::ostream& ioStream, int inVersion)
 	default:
 		break;
 	}
+
+	// Every event in one export has the same stamp.
+	if (1 < m_Version)
+	{
+		time_t t;
+		time(&t);
+#if defined(ARB_HAS_SECURE_LOCALTIME)
+		struct tm l;
+		_localtime64_s(&l, &t);
+		struct tm* pTime = &l;
+#else
+		struct tm* pTime = localtime(&t);
+#endif
+		m_DTStamp = wxString::Format(
+						"DTSTAMP:%04d%02d%02dT%02d%02d%02d\r\n",
+						pTime->tm_year + 1900,
+						pTime->tm_mon + 1,
+						pTime->tm_mday,
+						pTime->tm_hour,
+						pTime->tm_min,
+						pTime->tm_sec)
+						.utf8_string();
+	}
 }
 
 
-void ARBiCal::Write(char inVal)
+void ARBiCal::DoFingerprint(ARBCalendar const& inCal, int inAlarm)
 {
-	m_ioStream.write(&inVal, 1);
+	if (m_bFeed)
+	{
+		Write(ICAL_FINGERPRINT);
+		Write(':');
+		Write(Fingerprint(inCal, inAlarm));
+		Write("\r\n");
+	}
 }
 
 
-void ARBiCal::Write(char const* const inVal)
+std::string ARBiCal::Fingerprint(ARBCalendar const& inCal, int inAlarm)
 {
-	if (inVal && *inVal)
-	{
-		size_t len = strlen(inVal);
-		m_ioStream.write(inVal, len);
-	}
+	// Everything iCalendar() writes, hashed with FNV-1a.
+	wxString data;
+	data << inCal.GetUID(ARBCalendar::UidType::vEvent) << L'\n' << inCal.GetVenue() << L'\n' << inCal.GetClub()
+		 << L'\n' << inCal.GetLocation() << L'\n' << inCal.GetNote() << L'\n' << (inCal.IsTentative() ? 1 : 0) << L'\n'
+		 << static_cast<int>(inCal.GetEntered()) << L'\n' << inAlarm;
+	std::string utf8(data.utf8_string());
+	uint64_t hash = 14695981039346656037ULL;
+	for (unsigned char c : utf8)
+	{
+		hash ^= c;
+		hash *= 1099511628211ULL;
+	}
+	return wxString::Format("%016llx", static_cast<unsigned long long>(hash)).utf8_string();
 }
 
 
-void ARBiCal::Write(std::string const& inVal)
+void ARBiCal::Flush()
 {
-	if (!inVal.empty())
-		m_ioStream.write(inVal.c_str(), inVal.length());
+	if (!m_Buffer.empty())
+	{
+		m_ioStream.write(m_Buffer.c_str(), m_Buffer.length());
+		m_Buffer.clear();
+	}
 }
 
 
@@ -204,41 +579,12 @@ void ARBiCal::Write(char const* const inVal, ARBDate inDate, bool inStartOfDay)
 }
 
 
-void ARBiCal::WriteSafeChar(std::string const& inText)
-{
-	for (std::string::const_iterator iter = inText.begin(); iter != inText.end(); ++iter)
-	{
-		unsigned char c = *iter;
-		// See the RFC...
-		if ((0x21 <= c && c <= 0x7e)    // ASCII
-			|| (0x80 <= c && c <= 0xf8) // NON-US-ASCII
-			|| 0x20 == c || 0x09 == c)  // WSP
-		{
-			if (1 == m_Version && '=' == c)
-				Write("=3D");
-			else if (1 < m_Version && (';' == c || ',' == c || '\\' == c))
-				Write('\\');
-			else
-				Write(c);
-		}
-		else if ('\n' == c)
-		{
-			if (1 == m_Version)
-				Write("=0A");
-			else
-				Write("\\n");
-		}
-		else
-			Write('?');
-	}
-}
-
-
 void ARBiCal::WriteText(char const* const inToken, wxString const& inText, bool bQuotedPrint)
 {
 	if (0 < inText.length())
 	{
-		size_t nLineLength = 75 - strlen(inToken);
+		// The ':' after the token counts too.
+		size_t nLineLength = 74 - strlen(inToken);
 		Write(inToken);
 		if (1 == m_Version && bQuotedPrint)
 		{
@@ -246,53 +592,76 @@ void ARBiCal::WriteText(char const* const inToken, wxString const& inText, bool
 			nLineLength -= 26;
 		}
 		Write(':');
-		// "Fold" a long line. RFC 2445, section 4.1
 		std::string tmp(inText.utf8_string());
-		while (nLineLength < tmp.length())
+		m_Buffer.reserve(m_Buffer.length() + tmp.length() + tmp.length() / 16 + 8);
+		// "Fold" a long line. RFC 2445, section 4.1
+		// Lines are folded after escaping and never inside an escape sequence
+		// or a UTF-8 character. Version 1 stuff is a best-guess.
+		size_t nLine = 0;
+		for (size_t pos = 0; pos < tmp.length();)
 		{
-			// Version 1 stuff is a best-guess.
-			WriteSafeChar(tmp.substr(0, nLineLength));
-			if (1 == m_Version)
-				Write("=\r\n");
+			unsigned char c = tmp[pos];
+			char escaped[2] = {static_cast<char>(c), 0};
+			char const* piece = escaped;
+			size_t nPiece = 1;
+			size_t nSource = 1;
+			// See the RFC...
+			if (0xc0 <= c && c <= 0xf8)
+			{
+				// NON-US-ASCII: keep the whole sequence together.
+				piece = tmp.c_str() + pos;
+				while (pos + nSource < tmp.length() && 0x80 == (tmp[pos + nSource] & 0xc0))
+					++nSource;
+				nPiece = nSource;
+			}
+			else if ((0x21 <= c && c <= 0x7e) // ASCII
+					 || (0x80 <= c && c <= 0xf8)
+					 || 0x20 == c || 0x09 == c) // WSP
+			{
+				if (1 == m_Version && '=' == c)
+				{
+					piece = "=3D";
+					nPiece = 3;
+				}
+				else if (1 < m_Version && (';' == c || ',' == c || '\\' == c))
+				{
+					escaped[0] = '\\';
+					escaped[1] = c;
+					nPiece = 2;
+				}
+			}
+			else if ('\n' == c)
+			{
+				piece = (1 == m_Version) ? "=0A" : "\\n";
+				nPiece = strlen(piece);
+			}
 			else
-				Write("\r\n\t");
-			tmp = tmp.substr(nLineLength);
-			nLineLength = 75;
+				escaped[0] = '?';
+
+			if (0 < nLine && nLine + nPiece > nLineLength)
+			{
+				// The leading tab of a folded line counts.
+				if (1 == m_Version)
+				{
+					Write("=\r\n");
+					nLineLength = 75;
+				}
+				else
+				{
+					Write("\r\n\t");
+					nLineLength = 74;
+				}
+				nLine = 0;
+			}
+			m_Buffer.append(piece, nPiece);
+			nLine += nPiece;
+			pos += nSource;
 		}
-		if (0 < tmp.length())
-			WriteSafeChar(tmp);
 		Write("\r\n");
 	}
 }
 
 
-void ARBiCal::DoDTSTAMP()
-{
-	if (1 < m_Version)
-	{
-		time_t t;
-		time(&t);
-#if defined(ARB_HAS_SECURE_LOCALTIME)
-		struct tm l;
-		_localtime64_s(&l, &t);
-		struct tm* pTime = &l;
-#else
-		struct tm* pTime = localtime(&t);
-#endif
-		std::string buffer = wxString::Format(
-								 "DTSTAMP:%04d%02d%02dT%02d%02d%02d\r\n",
-								 pTime->tm_year + 1900,
-								 pTime->tm_mon + 1,
-								 pTime->tm_mday,
-								 pTime->tm_hour,
-								 pTime->tm_min,
-								 pTime->tm_sec)
-								 .utf8_string();
-		Write(buffer);
-	}
-}
-
-
 ICalendar::ICalendar()
 {
 }
@@ -311,6 +680,155 @@ ICalendarPtr ICalendar::iCalendarBegin(std::ostream& ioStream, int inVersion)
 	return pCal;
 }
 
+
+bool ICalendar::iCalendarFeed(
+	std::string const& inFeed,
+	std::vector<ARBCalendarPtr> const& inEntries,
+	int inAlarm,
+	std::string& outFeed)
+{
+	// Index the events of the previous feed. (Entries on the same dates share
+	// a UID, so the content must match too.)
+	std::unordered_multimap<std::string, std::string> events;
+	for (size_t pos = inFeed.find(ICAL_BEGIN_EVENT); std::string::npos != pos;
+		 pos = inFeed.find(ICAL_BEGIN_EVENT, pos))
+	{
+		size_t end = inFeed.find(ICAL_END_EVENT, pos);
+		if (std::string::npos == end)
+			break;
+		end += strlen(ICAL_END_EVENT);
+		std::string event(inFeed, pos, end - pos);
+		std::string key = GetEventProperty(event, "UID") + '\n' + GetEventProperty(event, ICAL_FINGERPRINT);
+		events.insert(std::make_pair(key, std::move(event)));
+		pos = end;
+	}
+
+	std::ostringstream output;
+	{
+		ARBiCalPtr iCal = std::make_shared<ARBiCal>(output, 2, true);
+		for (auto const& pCal : inEntries)
+		{
+			std::string key = pCal->GetUID(ARBCalendar::UidType::vEvent).utf8_string() + '\n'
+							  + ARBiCal::Fingerprint(*pCal, inAlarm);
+			auto iter = events.find(key);
+			if (iter != events.end())
+			{
+				iCal->CopyEvent(iter->second);
+				events.erase(iter);
+			}
+			else
+				pCal->iCalendar(iCal, inAlarm);
+		}
+	}
+	outFeed = output.str();
+	return outFeed != inFeed;
+}
+
+
+size_t ICalendar::iCalendarRead(
+	std::istream& ioStream,
+	ARBConfig const& inConfig,
+	std::function<bool(ARBCalendarPtr const&)> const& inCallback)
+{
+	size_t nEvents = 0;
+	CICalReader reader(ioStream);
+	// Nesting of components. Only properties directly in a VEVENT are used.
+	std::vector<std::string> components;
+	ARBCalendarPtr cal;
+	wxString summary;
+	ARBDate dateEnd;
+	bool bEndExclusive = false;
+	int durationDays = 0;
+	std::string name, params, value;
+	while (reader.GetLine(name, params, value))
+	{
+		if ("BEGIN" == name)
+		{
+			ICalToUpper(value);
+			components.push_back(value);
+			if (!cal && "VEVENT" == value)
+			{
+				cal = ARBCalendar::New();
+				summary.clear();
+				dateEnd = ARBDate();
+				bEndExclusive = false;
+				durationDays = 0;
+			}
+		}
+		else if ("END" == name)
+		{
+			if (components.empty())
+				continue;
+			bool bEvent = ("VEVENT" == components.back());
+			components.pop_back();
+			if (!bEvent || !cal)
+				continue;
+			ARBCalendarPtr pCal;
+			pCal.swap(cal);
+			if (!pCal->GetStartDate().IsValid())
+				continue;
+
+			// DTEND is the non-inclusive end for dates (and midnight).
+			if (!dateEnd.IsValid())
+			{
+				dateEnd = pCal->GetStartDate();
+				if (1 < durationDays)
+					dateEnd += durationDays - 1;
+			}
+			else if (bEndExclusive && pCal->GetStartDate() < dateEnd)
+				dateEnd -= 1;
+			if (dateEnd < pCal->GetStartDate())
+				dateEnd = pCal->GetStartDate();
+			pCal->SetEndDate(dateEnd);
+
+			// ARBCalendar::iCalendar writes "venue club location".
+			summary.Trim().Trim(false);
+			wxString rest;
+			if (!pCal->GetLocation().empty() && summary.EndsWith(L" " + pCal->GetLocation(), &rest))
+				summary = rest.Trim();
+			wxString club;
+			wxString venue = summary.BeforeFirst(L' ', &club);
+			if (inConfig.GetVenues().FindVenue(venue))
+			{
+				pCal->SetVenue(venue);
+				pCal->SetClub(club.Trim(false));
+			}
+			else
+				pCal->SetClub(summary);
+
+			++nEvents;
+			if (!inCallback(pCal))
+				break;
+		}
+		else if (cal && !components.empty() && "VEVENT" == components.back())
+		{
+			bool bMidnight = false;
+			if ("DTSTART" == name)
+				cal->SetStartDate(ICalDate(value, bMidnight));
+			else if ("DTEND" == name)
+			{
+				dateEnd = ICalDate(value, bMidnight);
+				bEndExclusive = bMidnight;
+			}
+			else if ("DURATION" == name)
+				durationDays = ICalDurationDays(value);
+			else if ("SUMMARY" == name)
+				summary = ICalUnescape(value);
+			else if ("LOCATION" == name)
+				cal->SetLocation(ICalUnescape(value));
+			else if ("DESCRIPTION" == name)
+				ICalSetDescription(*cal, ICalUnescape(value));
+			else if ("STATUS" == name)
+			{
+				ICalToUpper(value);
+				if ("TENTATIVE" == value)
+					cal->SetIsTentative(true);
+			}
+		}
+	}
+	return nEvents;
+}
+
 /////////////////////////////////////////////////////////////////////////////
 
 class ARBCalendar_concrete : public ARBCalendar
@@ -349,6 +867,7 @@ ARBCalendar::ARBCalendar()
 	, m_PremiumURL()
 	, m_OnlineURL()
 	, m_Note()
+	, m_IndexedBy()
 {
 }
 
@@ -370,6 +889,7 @@ ARBCalendar::ARBCalendar(ARBCalendar const& rhs)
 	, m_PremiumURL(rhs.m_PremiumURL)
 	, m_OnlineURL(rhs.m_OnlineURL)
 	, m_Note(rhs.m_Note)
+	, m_IndexedBy()
 {
 }
 
@@ -391,6 +911,7 @@ ARBCalendar::ARBCalendar(ARBCalendar&& rhs)
 	, m_PremiumURL(std::move(rhs.m_PremiumURL))
 	, m_OnlineURL(std::move(rhs.m_OnlineURL))
 	, m_Note(std::move(rhs.m_Note))
+	, m_IndexedBy()
 {
 }
 
@@ -426,6 +947,7 @@ ARBCalendar& ARBCalendar::operator=(ARBCalendar const& rhs)
 		m_PremiumURL = rhs.m_PremiumURL;
 		m_OnlineURL = rhs.m_OnlineURL;
 		m_Note = rhs.m_Note;
+		MatchChanged();
 	}
 	return *this;
 }
@@ -451,6 +973,7 @@ ARBCalendar& ARBCalendar::operator=(ARBCalendar&& rhs)
 		m_PremiumURL = std::move(rhs.m_PremiumURL);
 		m_OnlineURL = std::move(rhs.m_OnlineURL);
 		m_Note = std::move(rhs.m_Note);
+		MatchChanged();
 	}
 	return *this;
 }
@@ -500,81 +1023,52 @@ wxString ARBCalendar::GetUID(UidType inType) const
 
 size_t ARBCalendar::GetSearchStrings(std::set<wxString>& ioStrings) const
 {
-	size_t nItems = 0;
+	return CollectSearchStrings(*this, ioStrings);
+}
 
-	ioStrings.insert(m_DateStart.GetString(ARBDateFormat::DashYMD));
-	++nItems;
 
-	ioStrings.insert(m_DateEnd.GetString(ARBDateFormat::DashYMD));
-	++nItems;
+bool ARBCalendar::ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+{
+	if (!inCallback(m_DateStart.GetString(ARBDateFormat::DashYMD)))
+		return false;
 
-	if (m_DateOpening.IsValid())
-	{
-		ioStrings.insert(m_DateOpening.GetString(ARBDateFormat::DashYMD));
-		++nItems;
-	}
+	if (!inCallback(m_DateEnd.GetString(ARBDateFormat::DashYMD)))
+		return false;
 
-	if (m_DateDraw.IsValid())
-	{
-		ioStrings.insert(m_DateDraw.GetString(ARBDateFormat::DashYMD));
-		++nItems;
-	}
+	if (m_DateOpening.IsValid() && !inCallback(m_DateOpening.GetString(ARBDateFormat::DashYMD)))
+		return false;
 
-	if (m_DateClosing.IsValid())
-	{
-		ioStrings.insert(m_DateClosing.GetString(ARBDateFormat::DashYMD));
-		++nItems;
-	}
+	if (m_DateDraw.IsValid() && !inCallback(m_DateDraw.GetString(ARBDateFormat::DashYMD)))
+		return false;
 
-	if (0 < m_Location.length())
-	{
-		ioStrings.insert(m_Location);
-		++nItems;
-	}
+	if (m_DateClosing.IsValid() && !inCallback(m_DateClosing.GetString(ARBDateFormat::DashYMD)))
+		return false;
 
-	if (0 < m_Club.length())
-	{
-		ioStrings.insert(m_Club);
-		++nItems;
-	}
+	if (0 < m_Location.length() && !inCallback(m_Location))
+		return false;
 
-	if (0 < m_Venue.length())
-	{
-		ioStrings.insert(m_Venue);
-		++nItems;
-	}
+	if (0 < m_Club.length() && !inCallback(m_Club))
+		return false;
 
-	if (0 < m_Confirmation.length())
-	{
-		ioStrings.insert(m_Confirmation);
-		++nItems;
-	}
+	if (0 < m_Venue.length() && !inCallback(m_Venue))
+		return false;
 
-	if (0 < m_SecEmail.length())
-	{
-		ioStrings.insert(m_SecEmail);
-		++nItems;
-	}
+	if (0 < m_Confirmation.length() && !inCallback(m_Confirmation))
+		return false;
 
-	if (0 < m_PremiumURL.length())
-	{
-		ioStrings.insert(m_PremiumURL);
-		++nItems;
-	}
+	if (0 < m_SecEmail.length() && !inCallback(m_SecEmail))
+		return false;
 
-	if (0 < m_OnlineURL.length())
-	{
-		ioStrings.insert(m_OnlineURL);
-		++nItems;
-	}
+	if (0 < m_PremiumURL.length() && !inCallback(m_PremiumURL))
+		return false;
 
-	if (0 < m_Note.length())
-	{
-		ioStrings.insert(m_Note);
-		++nItems;
-	}
+	if (0 < m_OnlineURL.length() && !inCallback(m_OnlineURL))
+		return false;
+
+	if (0 < m_Note.length() && !inCallback(m_Note))
+		return false;
 
-	return nItems;
+	return true;
 }
 
 
@@ -729,6 +1223,7 @@ bool ARBCalendar::Load(ElementNodePtr const& inTree, ARBVersion const& inVersion
 	inTree->GetAttrib(ATTRIB_CAL_ONLINEURL, m_OnlineURL);
 
 	m_Note = inTree->GetValue();
+	MatchChanged();
 	return true;
 }
 
@@ -795,6 +1290,7 @@ void ARBCalendar::iCalendar(ICalendarPtr inIoStream, int inAlarm) const
 	ARBiCalPtr ioStream = std::dynamic_pointer_cast<ARBiCal, ICalendar>(inIoStream);
 	ioStream->BeginEvent();
 	ioStream->DoUID(GetUID(UidType::vEvent));
+	ioStream->DoFingerprint(*this, inAlarm);
 	ioStream->DoDTSTAMP();
 	ioStream->DoDTSTART(m_DateStart);
 	ioStream->DoDTEND(m_DateEnd);
@@ -874,11 +1370,13 @@ bool ARBCalendar::Update(ARBCalendarPtr const& inCal)
 	{
 		bChanged = true;
 		m_DateStart = inCal->GetStartDate();
+		MatchChanged();
 	}
 	if (inCal->GetEndDate().IsValid() && m_DateEnd != inCal->GetEndDate())
 	{
 		bChanged = true;
 		m_DateEnd = inCal->GetEndDate();
+		MatchChanged();
 	}
 	if (inCal->GetOpeningDate().IsValid() && m_DateOpening != inCal->GetOpeningDate())
 	{
@@ -909,11 +1407,13 @@ bool ARBCalendar::Update(ARBCalendarPtr const& inCal)
 	{
 		bChanged = true;
 		m_Club = inCal->GetClub();
+		MatchChanged();
 	}
 	if (!inCal->GetVenue().empty() && m_Venue != inCal->GetVenue())
 	{
 		bChanged = true;
 		m_Venue = inCal->GetVenue();
+		MatchChanged();
 	}
 	if (!inCal->GetSecEmail().empty() && m_SecEmail != inCal->GetSecEmail())
 	{
@@ -940,12 +1440,23 @@ bool ARBCalendar::Update(ARBCalendarPtr const& inCal)
 
 /////////////////////////////////////////////////////////////////////////////
 
+ARBCalendarList::ARBCalendarList()
+	: m_Index()
+	, m_IndexSize(0)
+	, m_pGeneration(std::make_shared<unsigned int>(0))
+	, m_IndexGeneration(0)
+	, m_bIndexValid(false)
+{
+}
+
+
 bool ARBCalendarList::Load(ElementNodePtr const& inTree, ARBVersion const& inVersion, ARBErrorCallback& ioCallback)
 {
 	ARBCalendarPtr thing(ARBCalendar::New());
 	if (!thing->Load(inTree, inVersion, ioCallback))
 		return false;
 	push_back(thing);
+	m_bIndexValid = false;
 	return true;
 }
 
@@ -954,9 +1465,12 @@ void ARBCalendarList::sort()
 {
 	if (2 > size())
 		return;
-	std::stable_sort(begin(), end(), [](ARBCalendarPtr const& one, ARBCalendarPtr const& two) {
-		return one->GetStartDate() < two->GetStartDate();
-	});
+	SortByKey(
+		*this,
+		[](ARBCalendarPtr const& inCal) { return inCal->GetStartDate(); },
+		[](ARBDate const& one, ARBDate const& two) { return one < two; });
+	// The index keeps entries in list order.
+	m_bIndexValid = false;
 }
 
 
@@ -978,35 +1492,77 @@ int ARBCalendarList::TrimEntries(ARBDate const& inDate)
 	int trimmed = 0;
 	if (inDate.IsValid())
 	{
-		for (iterator iter = begin(); iter != end();)
+		iterator iter = std::remove_if(begin(), end(), [&inDate](ARBCalendarPtr const& inCal) {
+			return inCal->IsBefore(inDate);
+		});
+		trimmed = static_cast<int>(end() - iter);
+		if (0 < trimmed)
 		{
-			if ((*iter)->IsBefore(inDate))
-			{
-				++trimmed;
-				erase(iter);
-				iter = begin();
-			}
-			else
-				++iter;
+			erase(iter, end());
+			m_bIndexValid = false;
 		}
 	}
 	return trimmed;
 }
 
 
+std::wstring ARBCalendarList::MatchKey(ARBCalendar const& inCal)
+{
+	// The fields IsMatch compares when not matching exactly.
+	wxString key;
+	key << inCal.GetStartDate().GetString(ARBDateFormat::YYYYMMDD) << L'\n'
+		<< inCal.GetEndDate().GetString(ARBDateFormat::YYYYMMDD) << L'\n' << inCal.GetVenue() << L'\n'
+		<< inCal.GetClub();
+	return key.ToStdWstring();
+}
+
+
+bool ARBCalendarList::IsIndexCurrent() const
+{
+	return m_bIndexValid && m_IndexSize == size() && m_IndexGeneration == *m_pGeneration;
+}
+
+
+ARBCalendarList::MatchIndex const& ARBCalendarList::GetIndex() const
+{
+	if (!IsIndexCurrent())
+	{
+		m_Index.clear();
+		m_Index.reserve(size());
+		for (auto const& pCal : *this)
+		{
+			if (!pCal)
+				continue;
+			pCal->m_IndexedBy = m_pGeneration;
+			m_Index[MatchKey(*pCal)].push_back(pCal);
+		}
+		m_IndexSize = size();
+		m_IndexGeneration = *m_pGeneration;
+		m_bIndexValid = true;
+	}
+	return m_Index;
+}
+
+
 bool ARBCalendarList::FindCalendar(ARBCalendarPtr const& inCal, bool inMatchExact, ARBCalendarPtr* outCal) const
 {
 	if (outCal)
 		outCal->reset();
 	if (inCal)
 	{
-		for (const_iterator iter = begin(); iter != end(); ++iter)
+		// An exact match is also a match on the indexed fields.
+		MatchIndex const& index = GetIndex();
+		auto found = index.find(MatchKey(*inCal));
+		if (found != index.end())
 		{
-			if ((*iter)->IsMatch(inCal, inMatchExact))
+			for (auto const& pCal : found->second)
 			{
-				if (outCal)
-					*outCal = *iter;
-				return true;
+				if (pCal->IsMatch(inCal, inMatchExact))
+				{
+					if (outCal)
+						*outCal = pCal;
+					return true;
+				}
 			}
 		}
 	}
@@ -1022,24 +1578,69 @@ bool ARBCalendarList::AddCalendar(ARBCalendarPtr const& inCal)
 		if (!inCal->GetStartDate().IsValid() || !inCal->GetEndDate().IsValid())
 			return false;
 		bAdded = true;
+		bool bIndexed = IsIndexCurrent();
 		push_back(inCal);
+		if (bIndexed)
+		{
+			inCal->m_IndexedBy = m_pGeneration;
+			m_Index[MatchKey(*inCal)].push_back(inCal);
+			m_IndexSize = size();
+		}
 	}
 	return bAdded;
 }
 
 
-bool ARBCalendarList::DeleteCalendar(ARBCalendarPtr const& inCal)
+bool ARBCalendarList::ImportICalendar(
+	std::istream& ioStream,
+	ARBConfig const& inConfig,
+	ARBDate const& inSkipBefore,
+	long& nAdded,
+	long& nUpdated,
+	long& nDuplicate,
+	long& nSkipped)
 {
-	if (inCal)
-	{
-		for (iterator iter = begin(); iter != end(); ++iter)
+	bool bModified = false;
+	ICalendar::iCalendarRead(ioStream, inConfig, [&](ARBCalendarPtr const& pCal) {
+		// Duplicates within the file are merged too.
+		ARBCalendarPtr calFound;
+		if (!FindCalendar(pCal, false, &calFound))
 		{
-			if ((*iter) && *(*iter) == *inCal)
+			if ((inSkipBefore.IsValid() && pCal->GetEndDate() < inSkipBefore) || !AddCalendar(pCal))
+				++nSkipped;
+			else
 			{
-				erase(iter);
-				return true;
+				++nAdded;
+				bModified = true;
 			}
 		}
+		else if (calFound->Update(pCal))
+		{
+			++nUpdated;
+			bModified = true;
+		}
+		else
+			++nDuplicate;
+		return true;
+	});
+	return bModified;
+}
+
+
+bool ARBCalendarList::DeleteCalendar(ARBCalendarPtr const& inCal)
+{
+	ARBCalendarPtr pCal;
+	if (FindCalendar(inCal, true, &pCal))
+	{
+		bool bIndexed = IsIndexCurrent();
+		erase(std::find(begin(), end(), pCal));
+		if (bIndexed)
+		{
+			std::vector<ARBCalendarPtr>& entries = m_Index[MatchKey(*pCal)];
+			entries.erase(std::find(entries.begin(), entries.end(), pCal));
+			m_IndexSize = size();
+		}
+		return true;
 	}
 	return false;
 }
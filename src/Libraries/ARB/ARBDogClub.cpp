@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
  * 2005-06-25 Cleaned up reference counting when returning a pointer.
@@ -134,21 +135,19 @@ bool ARBDogClub::operator==(ARBDogClub const& rhs) const
 
 size_t ARBDogClub::GetSearchStrings(std::set<wxString>& ioStrings) const
 {
-	size_t nItems = 0;
+	return CollectSearchStrings(*this, ioStrings);
+}
 
-	if (0 < m_Name.length())
-	{
-		ioStrings.insert(m_Name);
-		++nItems;
-	}
 
-	if (0 < m_Venue.length())
-	{
-		ioStrings.insert(m_Venue);
-		++nItems;
-	}
+bool ARBDogClub::ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+{
+	if (0 < m_Name.length() && !inCallback(m_Name))
+		return false;
 
-	return nItems;
+	if (0 < m_Venue.length() && !inCallback(m_Venue))
+		return false;
+
+	return true;
 }
 
 
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2009-02-12 Clearing the metadata encoded a 0-length string
  *            causing the program to think it still had metadata.
@@ -150,18 +151,20 @@ bool ARBDogNotes::operator==(ARBDogNotes const& rhs) const
 
 size_t ARBDogNotes::GetSearchStrings(std::set<wxString>& ioStrings) const
 {
-	size_t nItems = 0;
+	return CollectSearchStrings(*this, ioStrings);
+}
+
+
+bool ARBDogNotes::ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+{
 	for (ARBDogFaultList::const_iterator iter = m_Faults.begin(); iter != m_Faults.end(); ++iter)
 	{
-		ioStrings.insert(*iter);
-		++nItems;
+		if (!inCallback(*iter))
+			return false;
 	}
-	if (0 < m_Note.length())
-	{
-		ioStrings.insert(m_Note);
-		++nItems;
-	}
-	return nItems;
+	if (0 < m_Note.length() && !inCallback(m_Note))
+		return false;
+	return true;
 }
 
 
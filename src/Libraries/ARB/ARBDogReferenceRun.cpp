@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
  * 2005-06-25 Cleaned up reference counting when returning a pointer.
@@ -160,33 +161,25 @@ bool ARBDogReferenceRun::operator==(ARBDogReferenceRun const& rhs) const
 
 size_t ARBDogReferenceRun::GetSearchStrings(std::set<wxString>& ioStrings) const
 {
-	size_t nItems = 0;
+	return CollectSearchStrings(*this, ioStrings);
+}
 
-	if (0 < m_Name.length())
-	{
-		ioStrings.insert(m_Name);
-		++nItems;
-	}
 
-	if (0 < m_Height.length())
-	{
-		ioStrings.insert(m_Height);
-		++nItems;
-	}
+bool ARBDogReferenceRun::ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+{
+	if (0 < m_Name.length() && !inCallback(m_Name))
+		return false;
 
-	if (0 < m_Breed.length())
-	{
-		ioStrings.insert(m_Breed);
-		++nItems;
-	}
+	if (0 < m_Height.length() && !inCallback(m_Height))
+		return false;
 
-	if (0 < m_Note.length())
-	{
-		ioStrings.insert(m_Note);
-		++nItems;
-	}
+	if (0 < m_Breed.length() && !inCallback(m_Breed))
+		return false;
 
-	return nItems;
+	if (0 < m_Note.length() && !inCallback(m_Note))
+		return false;
+
+	return true;
 }
 
 
@@ -10,6 +10,8 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
+ * 2026-10-19 Added InsertRun/RepositionRun.
  * 2020-10-07 Fix issue were we could save bad data (set a blank Q with a place)
  * 2020-07-31 On Faults[12]00ThenTime, don't allow score to go negative.
  * 2017-12-31 Add support for using raw faults when determining title points.
@@ -51,6 +53,7 @@
 #include "ARB/ARBAgilityRecordBook.h"
 #include "ARB/ARBConfig.h"
 #include "ARB/ARBLocalization.h"
+#include "ARB/ARBSortKey.h"
 #include "ARBCommon/Element.h"
 #include <algorithm>
 
@@ -296,74 +299,55 @@ wxString ARBDogRun::GetGenericName() const
 
 size_t ARBDogRun::GetSearchStrings(std::set<wxString>& ioStrings) const
 {
-	size_t nItems = 0;
+	return CollectSearchStrings(*this, ioStrings);
+}
 
-	ioStrings.insert(m_Date.GetString(ARBDateFormat::SlashMDY));
-	++nItems;
 
-	if (0 < m_Club->GetName().length())
-	{
-		ioStrings.insert(m_Club->GetName());
-		++nItems;
-	}
+bool ARBDogRun::ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+{
+	if (!inCallback(m_Date.GetString(ARBDateFormat::SlashMDY)))
+		return false;
 
-	if (0 < m_Division.length())
-	{
-		ioStrings.insert(m_Division);
-		++nItems;
-	}
+	if (0 < m_Club->GetName().length() && !inCallback(m_Club->GetName()))
+		return false;
 
-	if (0 < m_Level.length())
-	{
-		ioStrings.insert(m_Level);
-		++nItems;
-	}
+	if (0 < m_Division.length() && !inCallback(m_Division))
+		return false;
 
-	if (0 < m_Height.length())
-	{
-		ioStrings.insert(m_Height);
-		++nItems;
-	}
+	if (0 < m_Level.length() && !inCallback(m_Level))
+		return false;
 
-	if (0 < m_Event.length())
-	{
-		ioStrings.insert(m_Event);
-		++nItems;
-	}
+	if (0 < m_Height.length() && !inCallback(m_Height))
+		return false;
 
-	if (0 < m_SubName.length())
-	{
-		ioStrings.insert(m_SubName);
-		++nItems;
-	}
+	if (0 < m_Event.length() && !inCallback(m_Event))
+		return false;
 
-	if (0 < m_Conditions.length())
-	{
-		ioStrings.insert(m_Conditions);
-		++nItems;
-	}
+	if (0 < m_SubName.length() && !inCallback(m_SubName))
+		return false;
 
-	if (0 < m_Judge.length())
-	{
-		ioStrings.insert(m_Judge);
-		++nItems;
-	}
+	if (0 < m_Conditions.length() && !inCallback(m_Conditions))
+		return false;
 
-	if (0 < m_Handler.length())
-	{
-		ioStrings.insert(m_Handler);
-		++nItems;
-	}
+	if (0 < m_Judge.length() && !inCallback(m_Judge))
+		return false;
+
+	if (0 < m_Handler.length() && !inCallback(m_Handler))
+		return false;
 
-	nItems += m_Partners.GetSearchStrings(ioStrings);
+	if (!m_Partners.ForEachSearchString(inCallback))
+		return false;
 
-	nItems += m_OtherPoints.GetSearchStrings(ioStrings);
+	if (!m_OtherPoints.ForEachSearchString(inCallback))
+		return false;
 
-	nItems += m_Notes.GetSearchStrings(ioStrings);
+	if (!m_Notes.ForEachSearchString(inCallback))
+		return false;
 
-	nItems += m_RefRuns.GetSearchStrings(ioStrings);
+	if (!m_RefRuns.ForEachSearchString(inCallback))
+		return false;
 
-	return nItems;
+	return true;
 }
 
 
@@ -1129,13 +1113,20 @@ bool ARBDogRunList::Save(ElementNodePtr const& ioTree, ARBDogTrial const* pTrial
 }
 
 
+namespace
+{
+bool SortRuns(ARBDogRunPtr const& one, ARBDogRunPtr const& two)
+{
+	return one->GetDate() < two->GetDate();
+}
+} // namespace
+
+
 void ARBDogRunList::sort()
 {
 	if (2 > size())
 		return;
-	std::stable_sort(begin(), end(), [](ARBDogRunPtr const& one, ARBDogRunPtr const& two) {
-		return one->GetDate() < two->GetDate();
-	});
+	std::stable_sort(begin(), end(), SortRuns);
 }
 
 
@@ -1177,6 +1168,26 @@ bool ARBDogRunList::AddRun(ARBDogRunPtr const& inRun)
 }
 
 
+bool ARBDogRunList::InsertRun(ARBDogRunPtr const& inRun)
+{
+	bool bAdded = false;
+	if (inRun)
+	{
+		bAdded = true;
+		InsertSorted(*this, inRun, SortRuns);
+	}
+	return bAdded;
+}
+
+
+bool ARBDogRunList::RepositionRun(ARBDogRunPtr const& inRun)
+{
+	if (!inRun)
+		return false;
+	return RepositionSorted(*this, inRun, SortRuns);
+}
+
+
 bool ARBDogRunList::DeleteRun(ARBDogRunPtr const& inRun)
 {
 	if (inRun)
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
  * 2005-06-25 Cleaned up reference counting when returning a pointer.
@@ -120,8 +121,13 @@ bool ARBDogRunOtherPoints::operator==(ARBDogRunOtherPoints const& rhs) const
 
 size_t ARBDogRunOtherPoints::GetSearchStrings(std::set<wxString>& ioStrings) const
 {
-	ioStrings.insert(m_Name);
-	return 1;
+	return CollectSearchStrings(*this, ioStrings);
+}
+
+
+bool ARBDogRunOtherPoints::ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+{
+	return inCallback(m_Name);
 }
 
 
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
  * 2005-06-25 Cleaned up reference counting when returning a pointer.
@@ -127,27 +128,22 @@ bool ARBDogRunPartner::operator==(ARBDogRunPartner const& rhs) const
 
 size_t ARBDogRunPartner::GetSearchStrings(std::set<wxString>& ioStrings) const
 {
-	size_t nItems = 0;
+	return CollectSearchStrings(*this, ioStrings);
+}
 
-	if (0 < m_Handler.length())
-	{
-		ioStrings.insert(m_Handler);
-		++nItems;
-	}
 
-	if (0 < m_Dog.length())
-	{
-		ioStrings.insert(m_Dog);
-		++nItems;
-	}
+bool ARBDogRunPartner::ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+{
+	if (0 < m_Handler.length() && !inCallback(m_Handler))
+		return false;
 
-	if (0 < m_RegNum.length())
-	{
-		ioStrings.insert(m_RegNum);
-		++nItems;
-	}
+	if (0 < m_Dog.length() && !inCallback(m_Dog))
+		return false;
 
-	return nItems;
+	if (0 < m_RegNum.length() && !inCallback(m_RegNum))
+		return false;
+
+	return true;
 }
 
 
@@ -16,6 +16,8 @@
  * run, saving it, reloading, and deleting that run. This is by-design.
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
+ * 2026-10-19 Sort trials using precomputed keys, add sorted insertion.
  * 2013-05-25 Implement a default date for a trial.
  * 2012-09-09 Added 'titlePts' to 'Placement'.
  * 2012-02-16 Fixed an issue in co-sanctioned trial detection.
@@ -41,6 +43,7 @@
 #include "ARB/ARBCalendar.h"
 #include "ARB/ARBConfig.h"
 #include "ARB/ARBLocalization.h"
+#include "ARB/ARBSortKey.h"
 #include "ARBCommon/ARBDate.h"
 #include "ARBCommon/Element.h"
 #include "ARBCommon/StringUtil.h"
@@ -204,23 +207,22 @@ wxString ARBDogTrial::GetGenericName() const
 
 size_t ARBDogTrial::GetSearchStrings(std::set<wxString>& ioStrings) const
 {
-	size_t nItems = 0;
+	return CollectSearchStrings(*this, ioStrings);
+}
 
-	if (0 < m_Location.length())
-	{
-		ioStrings.insert(m_Location);
-		++nItems;
-	}
 
-	if (0 < m_Note.length())
-	{
-		ioStrings.insert(m_Note);
-		++nItems;
-	}
+bool ARBDogTrial::ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+{
+	if (0 < m_Location.length() && !inCallback(m_Location))
+		return false;
+
+	if (0 < m_Note.length() && !inCallback(m_Note))
+		return false;
 
-	nItems += m_Clubs.GetSearchStrings(ioStrings);
+	if (!m_Clubs.ForEachSearchString(inCallback))
+		return false;
 
-	return nItems;
+	return true;
 }
 
 
@@ -462,68 +464,75 @@ bool ARBDogTrialList::Load(
 }
 
 
-class SortTrials
+namespace
 {
-public:
-	SortTrials(bool bDescending)
-		: m_bDescending(bDescending)
-	{
+// Everything a trial is sorted on, computed once per trial per sort.
+struct TrialSortKey
+{
+	ARBDate date;
+	std::wstring name;
+	std::wstring clubName;
+	std::wstring clubVenue;
+
+	explicit TrialSortKey(ARBDogTrialPtr const& inTrial)
+		: date(inTrial->GetStartDate())
+		, name(MakeSortKey(inTrial->GetGenericName()))
+		, clubName()
+		, clubVenue()
+	{
+		// Both trials are compared on their main (first) club.
+		ARBDogClubPtr club = inTrial->GetClubs().GetMainClub();
+		if (club)
+		{
+			clubName = MakeSortKey(club->GetName());
+			clubVenue = MakeSortKey(club->GetVenue());
+		}
 	}
-	bool operator()(ARBDogTrialPtr const& one, ARBDogTrialPtr const& two) const
+
+	int Compare(TrialSortKey const& rhs) const
 	{
 		int iCompare = 0;
-		ARBDate d1 = one->GetStartDate();
-		ARBDate d2 = two->GetStartDate();
-		if (d1.IsValid() && d2.IsValid())
+		if (date.IsValid() && rhs.date.IsValid())
 		{
-			if (d1 < d2)
+			if (date < rhs.date)
 				iCompare = -1;
-			else if (d1 > d2)
+			else if (date > rhs.date)
 				iCompare = 1;
 		}
-		else if (d1.IsValid())
+		else if (date.IsValid())
 			iCompare = 1;
-		else if (d2.IsValid())
+		else if (rhs.date.IsValid())
 			iCompare = -1;
 		if (0 == iCompare)
 		{
-			iCompare = StringUtil::CompareNoCase(one->GetGenericName(), two->GetGenericName());
+			iCompare = CompareSortKey(name, rhs.name);
 			if (0 == iCompare)
 			{
-				ARBDogClubPtr club1 = one->GetClubs().GetMainClub();
-				wxString name1, venue1;
-				if (club1)
-				{
-					name1 = club1->GetName();
-					venue1 = club1->GetVenue();
-				}
-				ARBDogClubPtr club2 = two->GetClubs().GetMainClub();
-				if (0 < two->GetClubs().size())
-					club2 = two->GetClubs()[0];
-				wxString name2, venue2;
-				if (club2)
-				{
-					name2 = club2->GetName();
-					venue2 = club2->GetVenue();
-				}
-				iCompare = StringUtil::CompareNoCase(name1, name2);
+				iCompare = CompareSortKey(clubName, rhs.clubName);
 				if (0 == iCompare)
-					iCompare = StringUtil::CompareNoCase(venue1, venue2);
+					iCompare = CompareSortKey(clubVenue, rhs.clubVenue);
 			}
 		}
-		return m_bDescending ? iCompare < 0 : iCompare > 0;
+		return iCompare;
 	}
-
-private:
-	bool m_bDescending;
 };
 
+bool IsBefore(TrialSortKey const& one, TrialSortKey const& two, bool inDescending)
+{
+	int iCompare = one.Compare(two);
+	return inDescending ? iCompare < 0 : iCompare > 0;
+}
+} // namespace
+
 
 void ARBDogTrialList::sort(bool inDescending)
 {
 	if (2 > size())
 		return;
-	std::stable_sort(begin(), end(), SortTrials(inDescending));
+	SortByKey(
+		*this,
+		[](ARBDogTrialPtr const& inTrial) { return TrialSortKey(inTrial); },
+		[inDescending](TrialSortKey const& one, TrialSortKey const& two) { return IsBefore(one, two, inDescending); });
 }
 
 
@@ -924,13 +933,29 @@ bool ARBDogTrialList::AddTrial(ARBDogTrialPtr const& inTrial)
 
 bool ARBDogTrialList::AddTrial(ARBDogTrialPtr const& inTrial, bool inDescending)
 {
-	bool bAdded = AddTrial(inTrial);
-	if (bAdded)
-		sort(inDescending);
+	bool bAdded = false;
+	if (inTrial)
+	{
+		bAdded = true;
+		// Only log(n) trials are compared, so build keys as we go.
+		InsertSorted(*this, inTrial, [inDescending](ARBDogTrialPtr const& one, ARBDogTrialPtr const& two) {
+			return IsBefore(TrialSortKey(one), TrialSortKey(two), inDescending);
+		});
+	}
 	return bAdded;
 }
 
 
+bool ARBDogTrialList::RepositionTrial(ARBDogTrialPtr const& inTrial, bool inDescending)
+{
+	if (!inTrial)
+		return false;
+	return RepositionSorted(*this, inTrial, [inDescending](ARBDogTrialPtr const& one, ARBDogTrialPtr const& two) {
+		return IsBefore(TrialSortKey(one), TrialSortKey(two), inDescending);
+	});
+}
+
+
 bool ARBDogTrialList::DeleteTrial(ARBDogTrialPtr const& inTrial)
 {
 	if (inTrial)
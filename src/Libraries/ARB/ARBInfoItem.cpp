@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
  * 2005-06-25 Cleaned up reference counting when returning a pointer.
@@ -128,18 +129,19 @@ bool ARBInfoItem::operator==(ARBInfoItem const& rhs) const
 
 size_t ARBInfoItem::GetSearchStrings(std::set<wxString>& ioStrings) const
 {
-	size_t nItems = 0;
+	return CollectSearchStrings(*this, ioStrings);
+}
 
-	ioStrings.insert(m_Name);
-	++nItems;
 
-	if (0 < m_Comment.length())
-	{
-		ioStrings.insert(m_Comment);
-		++nItems;
-	}
+bool ARBInfoItem::ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+{
+	if (!inCallback(m_Name))
+		return false;
+
+	if (0 < m_Comment.length() && !inCallback(m_Comment))
+		return false;
 
-	return nItems;
+	return true;
 }
 
 
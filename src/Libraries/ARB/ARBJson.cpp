@@ -0,0 +1,587 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Read and write element trees as JSON.
+ * @author David Connet
+ *
+ * See RFC 8259.
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "ARB/ARBJson.h"
+
+#include "ARBCommon/Element.h"
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+using namespace ARBCommon;
+namespace ARB
+{
+
+namespace
+{
+constexpr size_t JSON_BUFFER_SIZE = 64 * 1024;
+// ARB documents are about 8 deep, this only guards against garbage.
+constexpr int JSON_MAX_DEPTH = 128;
+
+
+class CJsonWriter
+{
+public:
+	explicit CJsonWriter(std::ostream& ioStream)
+		: m_ioStream(ioStream)
+		, m_Buffer()
+	{
+		m_Buffer.reserve(JSON_BUFFER_SIZE + 1024);
+	}
+
+	void WriteNode(ElementNodePtr const& inNode);
+	bool Flush();
+
+private:
+	void WriteString(wxString const& inStr);
+
+	std::ostream& m_ioStream;
+	std::string m_Buffer;
+};
+
+
+void CJsonWriter::WriteNode(ElementNodePtr const& inNode)
+{
+	m_Buffer += "{\"name\":";
+	WriteString(inNode->GetName());
+
+	int nAttribs = inNode->GetAttribCount();
+	if (0 < nAttribs)
+	{
+		m_Buffer += ",\"attrib\":{";
+		for (int i = 0; i < nAttribs; ++i)
+		{
+			wxString name, value;
+			inNode->GetNthAttrib(i, name, value);
+			if (0 < i)
+				m_Buffer += ',';
+			WriteString(name);
+			m_Buffer += ':';
+			WriteString(value);
+		}
+		m_Buffer += '}';
+	}
+
+	wxString value = inNode->GetValue();
+	if (!value.empty())
+	{
+		m_Buffer += ",\"value\":";
+		WriteString(value);
+	}
+
+	bool bChildren = false;
+	for (int i = 0; i < inNode->GetElementCount(); ++i)
+	{
+		ElementNodePtr child = inNode->GetElementNode(i);
+		if (!child)
+			continue;
+		m_Buffer += bChildren ? "," : ",\"children\":[";
+		bChildren = true;
+		WriteNode(child);
+	}
+	if (bChildren)
+		m_Buffer += ']';
+	m_Buffer += '}';
+
+	if (JSON_BUFFER_SIZE <= m_Buffer.length())
+		Flush();
+}
+
+
+bool CJsonWriter::Flush()
+{
+	if (!m_Buffer.empty())
+	{
+		m_ioStream.write(m_Buffer.c_str(), m_Buffer.length());
+		m_Buffer.clear();
+	}
+	return m_ioStream.good();
+}
+
+
+void CJsonWriter::WriteString(wxString const& inStr)
+{
+	std::string str(inStr.utf8_string());
+	m_Buffer += '"';
+	size_t start = 0;
+	for (size_t pos = 0; pos < str.length(); ++pos)
+	{
+		unsigned char c = str[pos];
+		if ('"' != c && '\\' != c && 0x20 <= c)
+			continue;
+		m_Buffer.append(str, start, pos - start);
+		start = pos + 1;
+		switch (c)
+		{
+		case '"':
+			m_Buffer += "\\\"";
+			break;
+		case '\\':
+			m_Buffer += "\\\\";
+			break;
+		case '\n':
+			m_Buffer += "\\n";
+			break;
+		case '\r':
+			m_Buffer += "\\r";
+			break;
+		case '\t':
+			m_Buffer += "\\t";
+			break;
+		default:
+		{
+			constexpr char hex[] = "0123456789abcdef";
+			m_Buffer += "\\u00";
+			m_Buffer += hex[c >> 4];
+			m_Buffer += hex[c & 0x0f];
+		}
+		break;
+		}
+	}
+	m_Buffer.append(str, start, std::string::npos);
+	m_Buffer += '"';
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+class CJsonReader
+{
+public:
+	explicit CJsonReader(std::istream& ioStream)
+		: m_ioStream(ioStream)
+		, m_Buffer(JSON_BUFFER_SIZE)
+		, m_Pos(0)
+		, m_End(0)
+		, m_Offset(0)
+		, m_Depth(0)
+		, m_Error()
+	{
+	}
+
+	bool ReadNode(ElementNodePtr const& ioNode);
+	bool AtEnd();
+
+	wxString const& GetError() const
+	{
+		return m_Error;
+	}
+
+private:
+	int Peek()
+	{
+		if (m_Pos == m_End && !Fill())
+			return EOF;
+		return static_cast<unsigned char>(m_Buffer[m_Pos]);
+	}
+	int Get()
+	{
+		int c = Peek();
+		if (EOF != c)
+			++m_Pos;
+		return c;
+	}
+	bool Fill();
+	void SkipWhitespace();
+	bool Expect(char inChar);
+	bool ReadString(std::string& outStr);
+	bool ReadLiteral(std::string& outStr);
+	bool ReadAttribs(ElementNodePtr const& ioNode);
+	bool ReadChildren(ElementNodePtr const& ioNode);
+	bool SkipValue();
+	bool Fail(wchar_t const* inMsg);
+
+	std::istream& m_ioStream;
+	std::vector<char> m_Buffer;
+	size_t m_Pos;
+	size_t m_End;
+	size_t m_Offset; // Of the start of the buffer in the stream
+	int m_Depth;
+	wxString m_Error;
+};
+
+
+bool CJsonReader::Fill()
+{
+	m_Offset += m_End;
+	m_Pos = m_End = 0;
+	if (!m_ioStream.read(m_Buffer.data(), m_Buffer.size()) && 0 == m_ioStream.gcount())
+		return false;
+	m_End = static_cast<size_t>(m_ioStream.gcount());
+	return 0 < m_End;
+}
+
+
+void CJsonReader::SkipWhitespace()
+{
+	for (int c = Peek(); ' ' == c || '\t' == c || '\n' == c || '\r' == c; c = Peek())
+		++m_Pos;
+}
+
+
+bool CJsonReader::Expect(char inChar)
+{
+	SkipWhitespace();
+	if (inChar == Get())
+		return true;
+	wchar_t msg[] = L"Expected ' '";
+	msg[10] = inChar;
+	return Fail(msg);
+}
+
+
+bool CJsonReader::AtEnd()
+{
+	SkipWhitespace();
+	return EOF == Peek();
+}
+
+
+bool CJsonReader::ReadString(std::string& outStr)
+{
+	outStr.clear();
+	if (!Expect('"'))
+		return false;
+	for (;;)
+	{
+		// Copy everything up to the next quote or escape in one go.
+		size_t start = m_Pos;
+		while (m_Pos < m_End && '"' != m_Buffer[m_Pos] && '\\' != m_Buffer[m_Pos]
+			   && 0x20 <= static_cast<unsigned char>(m_Buffer[m_Pos]))
+			++m_Pos;
+		outStr.append(m_Buffer.data() + start, m_Pos - start);
+
+		int c = Get();
+		if ('"' == c)
+			return true;
+		if (EOF == c)
+			return Fail(L"Unterminated string");
+		if ('\\' != c)
+		{
+			if (0x20 > c)
+				return Fail(L"Control character in string");
+			// The buffer ran out, this is the first character of the next one.
+			outStr += static_cast<char>(c);
+			continue;
+		}
+		c = Get();
+		switch (c)
+		{
+		case '"':
+		case '\\':
+		case '/':
+			outStr += static_cast<char>(c);
+			break;
+		case 'b':
+			outStr += '\b';
+			break;
+		case 'f':
+			outStr += '\f';
+			break;
+		case 'n':
+			outStr += '\n';
+			break;
+		case 'r':
+			outStr += '\r';
+			break;
+		case 't':
+			outStr += '\t';
+			break;
+		case 'u':
+		{
+			auto readHex = [this](unsigned int& outVal) {
+				outVal = 0;
+				for (int i = 0; i < 4; ++i)
+				{
+					int h = Get();
+					outVal <<= 4;
+					if ('0' <= h && h <= '9')
+						outVal |= h - '0';
+					else if ('a' <= h && h <= 'f')
+						outVal |= h - 'a' + 10;
+					else if ('A' <= h && h <= 'F')
+						outVal |= h - 'A' + 10;
+					else
+						return false;
+				}
+				return true;
+			};
+			unsigned int ch;
+			if (!readHex(ch))
+				return Fail(L"Invalid \\u escape");
+			if (0xd800 <= ch && ch < 0xdc00)
+			{
+				unsigned int low;
+				if ('\\' != Get() || 'u' != Get() || !readHex(low) || low < 0xdc00 || 0xdfff < low)
+					return Fail(L"Invalid surrogate pair");
+				ch = 0x10000 + ((ch - 0xd800) << 10) + (low - 0xdc00);
+			}
+			// Encode as UTF-8
+			if (ch < 0x80)
+				outStr += static_cast<char>(ch);
+			else if (ch < 0x800)
+			{
+				outStr += static_cast<char>(0xc0 | (ch >> 6));
+				outStr += static_cast<char>(0x80 | (ch & 0x3f));
+			}
+			else if (ch < 0x10000)
+			{
+				outStr += static_cast<char>(0xe0 | (ch >> 12));
+				outStr += static_cast<char>(0x80 | ((ch >> 6) & 0x3f));
+				outStr += static_cast<char>(0x80 | (ch & 0x3f));
+			}
+			else
+			{
+				outStr += static_cast<char>(0xf0 | (ch >> 18));
+				outStr += static_cast<char>(0x80 | ((ch >> 12) & 0x3f));
+				outStr += static_cast<char>(0x80 | ((ch >> 6) & 0x3f));
+				outStr += static_cast<char>(0x80 | (ch & 0x3f));
+			}
+		}
+		break;
+		default:
+			return Fail(L"Invalid escape");
+		}
+	}
+}
+
+
+// Numbers, true, false and null. The text is returned as is.
+bool CJsonReader::ReadLiteral(std::string& outStr)
+{
+	outStr.clear();
+	SkipWhitespace();
+	for (int c = Peek(); ('0' <= c && c <= '9') || ('a' <= c && c <= 'z') || '-' == c || '+' == c || '.' == c
+						 || 'E' == c;
+		 c = Peek())
+	{
+		outStr += static_cast<char>(c);
+		++m_Pos;
+	}
+	if (outStr.empty())
+		return Fail(L"Expected a value");
+	return true;
+}
+
+
+bool CJsonReader::ReadNode(ElementNodePtr const& ioNode)
+{
+	if (JSON_MAX_DEPTH < ++m_Depth)
+		return Fail(L"Too deeply nested");
+	if (!Expect('{'))
+		return false;
+	bool bName = false;
+	SkipWhitespace();
+	if ('}' != Peek())
+	{
+		std::string key;
+		std::string value;
+		for (;;)
+		{
+			if (!ReadString(key) || !Expect(':'))
+				return false;
+			SkipWhitespace();
+			if ("name" == key)
+			{
+				if (!ReadString(value))
+					return false;
+				ioNode->SetName(wxString::FromUTF8(value));
+				bName = true;
+			}
+			else if ("attrib" == key)
+			{
+				if (!ReadAttribs(ioNode))
+					return false;
+			}
+			else if ("value" == key)
+			{
+				if (!ReadString(value))
+					return false;
+				ioNode->SetValue(wxString::FromUTF8(value));
+			}
+			else if ("children" == key)
+			{
+				if (!ReadChildren(ioNode))
+					return false;
+			}
+			else if (!SkipValue())
+				return false;
+
+			SkipWhitespace();
+			int c = Get();
+			if ('}' == c)
+				break;
+			if (',' != c)
+				return Fail(L"Expected ',' or '}'");
+		}
+	}
+	else
+		Get();
+	if (!bName)
+		return Fail(L"Element has no name");
+	--m_Depth;
+	return true;
+}
+
+
+bool CJsonReader::ReadAttribs(ElementNodePtr const& ioNode)
+{
+	if (!Expect('{'))
+		return false;
+	SkipWhitespace();
+	if ('}' == Peek())
+	{
+		Get();
+		return true;
+	}
+	std::string name;
+	std::string value;
+	for (;;)
+	{
+		if (!ReadString(name) || !Expect(':'))
+			return false;
+		SkipWhitespace();
+		if ('"' == Peek())
+		{
+			if (!ReadString(value))
+				return false;
+		}
+		else if (!ReadLiteral(value))
+			return false;
+		ioNode->AddAttrib(wxString::FromUTF8(name), wxString::FromUTF8(value));
+		SkipWhitespace();
+		int c = Get();
+		if ('}' == c)
+			return true;
+		if (',' != c)
+			return Fail(L"Expected ',' or '}'");
+	}
+}
+
+
+bool CJsonReader::ReadChildren(ElementNodePtr const& ioNode)
+{
+	if (!Expect('['))
+		return false;
+	SkipWhitespace();
+	if (']' == Peek())
+	{
+		Get();
+		return true;
+	}
+	for (;;)
+	{
+		// Named when its "name" is read.
+		if (!ReadNode(ioNode->AddElementNode(wxString())))
+			return false;
+		SkipWhitespace();
+		int c = Get();
+		if (']' == c)
+			return true;
+		if (',' != c)
+			return Fail(L"Expected ',' or ']'");
+	}
+}
+
+
+bool CJsonReader::SkipValue()
+{
+	SkipWhitespace();
+	std::string str;
+	int c = Peek();
+	if ('"' == c)
+		return ReadString(str);
+	if ('{' != c && '[' != c)
+		return ReadLiteral(str);
+
+	if (JSON_MAX_DEPTH < ++m_Depth)
+		return Fail(L"Too deeply nested");
+	char close = ('{' == c) ? '}' : ']';
+	Get();
+	SkipWhitespace();
+	if (close == Peek())
+		Get();
+	else
+	{
+		for (;;)
+		{
+			if ('}' == close && (!ReadString(str) || !Expect(':')))
+				return false;
+			if (!SkipValue())
+				return false;
+			SkipWhitespace();
+			c = Get();
+			if (close == c)
+				break;
+			if (',' != c)
+				return Fail(L"Expected ','");
+		}
+	}
+	--m_Depth;
+	return true;
+}
+
+
+bool CJsonReader::Fail(wchar_t const* inMsg)
+{
+	if (m_Error.empty())
+		m_Error.Printf(L"JSON: %s (offset %zu)", inMsg, m_Offset + m_Pos);
+	return false;
+}
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+
+bool ARBJson::Save(ElementNodePtr const& inTree, std::ostream& outStream)
+{
+	if (!inTree)
+		return false;
+	CJsonWriter writer(outStream);
+	writer.WriteNode(inTree);
+	return writer.Flush();
+}
+
+
+bool ARBJson::Load(ElementNodePtr const& outTree, std::istream& inStream, wxString& ioErrMsg)
+{
+	if (!outTree)
+		return false;
+	outTree->clear();
+	CJsonReader reader(inStream);
+	bool bOk = reader.ReadNode(outTree);
+	if (bOk && !reader.AtEnd())
+	{
+		ioErrMsg << L"JSON: Unexpected data after the document";
+		bOk = false;
+	}
+	else if (!bOk)
+		ioErrMsg << reader.GetError();
+	if (!bOk)
+		outTree->clear();
+	return bOk;
+}
+
+} // namespace ARB
+} // namespace dconSoft
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Full-text index of the searchable objects in a book.
+ * @author David Connet
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "ARB/ARBSearchIndex.h"
+
+#include "ARB/ARBAgilityRecordBook.h"
+#include <algorithm>
+#include <iterator>
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+using namespace ARBCommon;
+namespace ARB
+{
+
+ARBSearchIndex::ARBSearchIndex()
+	: m_Tokens()
+	, m_Objects()
+{
+}
+
+
+ARBSearchIndex::~ARBSearchIndex()
+{
+}
+
+
+void ARBSearchIndex::GetIndexableObjects(ARBAgilityRecordBook const& inBook, std::vector<ARBBasePtr>& outObjects)
+{
+	outObjects.clear();
+	for (auto const& pDog : inBook.GetDogs())
+	{
+		outObjects.push_back(pDog);
+		for (auto const& pTrial : pDog->GetTrials())
+		{
+			outObjects.push_back(pTrial);
+			for (auto const& pRun : pTrial->GetRuns())
+				outObjects.push_back(pRun);
+		}
+	}
+	for (auto const& pCal : inBook.GetCalendar())
+		outObjects.push_back(pCal);
+	for (auto const& pTraining : inBook.GetTraining())
+		outObjects.push_back(pTraining);
+	for (auto type : {ARBInfoType::Club, ARBInfoType::Judge, ARBInfoType::Location})
+	{
+		for (auto const& pItem : inBook.GetInfo().GetInfo(type))
+			outObjects.push_back(pItem);
+	}
+}
+
+
+void ARBSearchIndex::Tokenize(wxString const& inStr, std::vector<wxString>& outTokens)
+{
+	outTokens.clear();
+	wxString str = inStr.Lower();
+	wxString::const_iterator start = str.end();
+	for (wxString::const_iterator iter = str.begin(); iter != str.end(); ++iter)
+	{
+		if (wxIsalnum(*iter))
+		{
+			if (start == str.end())
+				start = iter;
+		}
+		else if (start != str.end())
+		{
+			outTokens.push_back(wxString(start, iter));
+			start = str.end();
+		}
+	}
+	if (start != str.end())
+		outTokens.push_back(wxString(start, str.end()));
+}
+
+
+void ARBSearchIndex::Clear()
+{
+	m_Tokens.clear();
+	m_Objects.clear();
+}
+
+
+void ARBSearchIndex::Update(ARBBasePtr const& inObject)
+{
+	if (!inObject)
+		return;
+	ARBBase const* pObject = inObject.get();
+	Remove(pObject);
+
+	std::vector<wxString> tokens;
+	std::vector<wxString> words;
+	inObject->ForEachSearchString([&tokens, &words](wxString const& str) {
+		Tokenize(str, words);
+		tokens.insert(tokens.end(), words.begin(), words.end());
+		return true;
+	});
+	std::sort(tokens.begin(), tokens.end());
+	tokens.erase(std::unique(tokens.begin(), tokens.end()), tokens.end());
+
+	for (auto const& token : tokens)
+		m_Tokens[token].insert(pObject);
+	m_Objects[pObject].swap(tokens);
+}
+
+
+void ARBSearchIndex::Remove(ARBBase const* inObject)
+{
+	auto iterObject = m_Objects.find(inObject);
+	if (iterObject == m_Objects.end())
+		return;
+	for (auto const& token : iterObject->second)
+	{
+		auto iterToken = m_Tokens.find(token);
+		if (iterToken != m_Tokens.end())
+		{
+			iterToken->second.erase(inObject);
+			if (iterToken->second.empty())
+				m_Tokens.erase(iterToken);
+		}
+	}
+	m_Objects.erase(iterObject);
+}
+
+
+bool ARBSearchIndex::Find(wxString const& inSearch, std::unordered_set<ARBBase const*>& outObjects) const
+{
+	std::vector<wxString> tokens;
+	Tokenize(inSearch, tokens);
+	if (tokens.empty())
+		return false;
+
+	// A matching string contains the search text. So the text between
+	// separators in the search must be a whole word in the string, the text
+	// before the first separator must end a word and the text after the last
+	// separator must start one. The most selective lookups are done first.
+	ObjectSet result;
+	bool bFirst = true;
+	auto intersect = [&result, &bFirst](ObjectSet const& found) {
+		if (bFirst)
+		{
+			result = found;
+			bFirst = false;
+		}
+		else
+		{
+			ObjectSet both;
+			std::set_intersection(
+				result.begin(),
+				result.end(),
+				found.begin(),
+				found.end(),
+				std::inserter(both, both.end()));
+			result.swap(both);
+		}
+		return !result.empty();
+	};
+
+	bool bMatch = true;
+	for (size_t i = 1; bMatch && i + 1 < tokens.size(); ++i)
+	{
+		ObjectSet found;
+		FindExact(tokens[i], found);
+		bMatch = intersect(found);
+	}
+	if (bMatch && 1 < tokens.size())
+	{
+		ObjectSet found;
+		FindPrefix(tokens.back(), found);
+		bMatch = intersect(found);
+	}
+	if (bMatch)
+	{
+		ObjectSet found;
+		if (1 == tokens.size())
+			FindSubstring(tokens.front(), found);
+		else
+			FindSuffix(tokens.front(), found);
+		bMatch = intersect(found);
+	}
+
+	outObjects.clear();
+	if (bMatch)
+		outObjects.insert(result.begin(), result.end());
+	return true;
+}
+
+
+void ARBSearchIndex::FindExact(wxString const& inToken, ObjectSet& outObjects) const
+{
+	auto iter = m_Tokens.find(inToken);
+	if (iter != m_Tokens.end())
+		outObjects = iter->second;
+}
+
+
+void ARBSearchIndex::FindPrefix(wxString const& inToken, ObjectSet& outObjects) const
+{
+	for (auto iter = m_Tokens.lower_bound(inToken); iter != m_Tokens.end() && iter->first.StartsWith(inToken); ++iter)
+		outObjects.insert(iter->second.begin(), iter->second.end());
+}
+
+
+void ARBSearchIndex::FindSuffix(wxString const& inToken, ObjectSet& outObjects) const
+{
+	for (auto const& token : m_Tokens)
+	{
+		if (token.first.EndsWith(inToken))
+			outObjects.insert(token.second.begin(), token.second.end());
+	}
+}
+
+
+void ARBSearchIndex::FindSubstring(wxString const& inToken, ObjectSet& outObjects) const
+{
+	for (auto const& token : m_Tokens)
+	{
+		if (wxNOT_FOUND != token.first.Find(inToken))
+			outObjects.insert(token.second.begin(), token.second.end());
+	}
+}
+
+} // namespace ARB
+} // namespace dconSoft
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Precomputed sort keys.
+ * @author David Connet
+ *
+ * Revision History
+ * 2026-10-19 Sort keys are locale collation keys.
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "ARB/ARBSortKey.h"
+
+#include <stdexcept>
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+namespace ARB
+{
+
+namespace
+{
+std::locale const& SortLocale()
+{
+	static std::locale const s_Locale = []() {
+		try
+		{
+			return std::locale("");
+		}
+		catch (std::runtime_error const&)
+		{
+			// The environment names a locale the runtime doesn't have.
+			return std::locale::classic();
+		}
+	}();
+	return s_Locale;
+}
+} // namespace
+
+
+std::wstring MakeSortKey(wxString const& inStr)
+{
+	return MakeSortKey(inStr, SortLocale());
+}
+
+
+std::wstring MakeSortKey(wxString const& inStr, std::locale const& inLocale)
+{
+	// Lower first: collations only ignore case at the first level, which
+	// would still order "a" and "A" apart.
+	std::wstring str(inStr.Lower().ToStdWstring());
+	std::collate<wchar_t> const& coll = std::use_facet<std::collate<wchar_t>>(inLocale);
+	return coll.transform(str.data(), str.data() + str.size());
+}
+
+} // namespace ARB
+} // namespace dconSoft
@@ -0,0 +1,1115 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Read and write XLSX and ODS files directly.
+ * @author David Connet
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "ARB/ARBSpreadSheet.h"
+
+#include <wx/filename.h>
+#include <wx/wfstream.h>
+#include <wx/zipstrm.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+// These are macros so they can be pasted into the string literals below.
+#define XML_DECL "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+#define XLSX_NS_MAIN "http://schemas.openxmlformats.org/spreadsheetml/2006/main"
+#define XLSX_NS_PKG_RELS "http://schemas.openxmlformats.org/package/2006/relationships"
+#define XLSX_NS_DOC_RELS "http://schemas.openxmlformats.org/officeDocument/2006/relationships"
+#define ODS_MIMETYPE "application/vnd.oasis.opendocument.spreadsheet"
+
+
+namespace dconSoft
+{
+namespace ARB
+{
+
+namespace
+{
+constexpr size_t BUFFER_SIZE = 64 * 1024;
+constexpr size_t MAX_COLUMN_WIDTH = 60;
+
+char const* const XLSX_CONTENT_TYPES = XML_DECL
+	"<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+	"<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+	"<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+	"<Override PartName=\"/xl/workbook.xml\""
+	" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml\"/>"
+	"<Override PartName=\"/xl/worksheets/sheet1.xml\""
+	" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>"
+	"</Types>";
+
+char const* const XLSX_RELS = XML_DECL
+	"<Relationships xmlns=\"" XLSX_NS_PKG_RELS "\">"
+	"<Relationship Id=\"rId1\" Type=\"" XLSX_NS_DOC_RELS "/officeDocument\" Target=\"xl/workbook.xml\"/>"
+	"</Relationships>";
+
+char const* const XLSX_WORKBOOK = XML_DECL
+	"<workbook xmlns=\"" XLSX_NS_MAIN "\" xmlns:r=\"" XLSX_NS_DOC_RELS "\">"
+	"<sheets><sheet name=\"Sheet1\" sheetId=\"1\" r:id=\"rId1\"/></sheets>"
+	"</workbook>";
+
+char const* const XLSX_WORKBOOK_RELS = XML_DECL
+	"<Relationships xmlns=\"" XLSX_NS_PKG_RELS "\">"
+	"<Relationship Id=\"rId1\" Type=\"" XLSX_NS_DOC_RELS "/worksheet\" Target=\"worksheets/sheet1.xml\"/>"
+	"</Relationships>";
+
+char const* const ODS_MANIFEST = XML_DECL
+	"<manifest:manifest xmlns:manifest=\"urn:oasis:names:tc:opendocument:xmlns:manifest:1.0\""
+	" manifest:version=\"1.2\">"
+	"<manifest:file-entry manifest:full-path=\"/\" manifest:version=\"1.2\" manifest:media-type=\"" ODS_MIMETYPE
+	"\"/>"
+	"<manifest:file-entry manifest:full-path=\"content.xml\" manifest:media-type=\"text/xml\"/>"
+	"</manifest:manifest>";
+
+char const* const ODS_CONTENT_BEGIN = XML_DECL
+	"<office:document-content xmlns:office=\"urn:oasis:names:tc:opendocument:xmlns:office:1.0\""
+	" xmlns:style=\"urn:oasis:names:tc:opendocument:xmlns:style:1.0\""
+	" xmlns:text=\"urn:oasis:names:tc:opendocument:xmlns:text:1.0\""
+	" xmlns:table=\"urn:oasis:names:tc:opendocument:xmlns:table:1.0\""
+	" office:version=\"1.2\">";
+
+
+// Escape text for XML (element content or attribute), dropping characters
+// that cannot appear in XML 1.0 at all.
+void AppendEscaped(std::string& ioBuffer, wxString const& inText)
+{
+	wxScopedCharBuffer utf8 = inText.utf8_str();
+	for (char const* p = utf8.data(); p && *p; ++p)
+	{
+		switch (*p)
+		{
+		case '&':
+			ioBuffer += "&amp;";
+			break;
+		case '<':
+			ioBuffer += "&lt;";
+			break;
+		case '>':
+			ioBuffer += "&gt;";
+			break;
+		case '"':
+			ioBuffer += "&quot;";
+			break;
+		default:
+			if (0x20 <= static_cast<unsigned char>(*p) || '\t' == *p || '\n' == *p || '\r' == *p)
+				ioBuffer += *p;
+			break;
+		}
+	}
+}
+
+
+std::string ColumnName(size_t inCol)
+{
+	std::string name;
+	for (++inCol; 0 < inCol; inCol = (inCol - 1) / 26)
+		name.insert(name.begin(), static_cast<char>('A' + (inCol - 1) % 26));
+	return name;
+}
+
+
+bool PutEntry(wxZipOutputStream& ioZip, wxString const& inName, char const* inData)
+{
+	if (!ioZip.PutNextEntry(inName))
+		return false;
+	size_t len = strlen(inData);
+	ioZip.Write(inData, len);
+	return ioZip.LastWrite() == len;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+// Not strchr: it would also match the terminating '\0'.
+bool IsXmlSpace(char ch)
+{
+	return ' ' == ch || '\t' == ch || '\r' == ch || '\n' == ch;
+}
+
+
+// Just enough of a pull parser to walk spreadsheet parts. Names are
+// compared without their namespace prefix.
+class CXmlScanner
+{
+public:
+	enum class Token
+	{
+		End,
+		Start,
+		EndTag,
+		Text,
+	};
+
+	explicit CXmlScanner(std::string const& inXml)
+		: m_Xml(inXml)
+		, m_Pos(0)
+		, m_Name()
+		, m_Begin(0)
+		, m_End(0)
+		, m_bEmpty(false)
+		, m_bCData(false)
+	{
+	}
+
+	Token Next();
+
+	// Tag name of the last Start/EndTag, without prefix.
+	std::string const& Name() const
+	{
+		return m_Name;
+	}
+	bool IsName(char const* inName) const
+	{
+		return m_Name == inName;
+	}
+	// Last Start was <tag/>.
+	bool IsEmpty() const
+	{
+		return m_bEmpty;
+	}
+	bool GetAttrib(char const* inName, std::string& outValue) const;
+	std::string GetText() const;
+
+	// After a Start, skip past its end tag.
+	void SkipElement();
+
+private:
+	static std::string Decode(char const* inBegin, char const* inEnd);
+	static std::string LocalName(char const* inBegin, char const* inEnd);
+
+	std::string const& m_Xml;
+	size_t m_Pos;
+	std::string m_Name;
+	size_t m_Begin; // Attributes (Start) or text (Text)
+	size_t m_End;
+	bool m_bEmpty;
+	bool m_bCData;
+};
+
+
+CXmlScanner::Token CXmlScanner::Next()
+{
+	size_t const size = m_Xml.size();
+	while (m_Pos < size)
+	{
+		if ('<' != m_Xml[m_Pos])
+		{
+			m_Begin = m_Pos;
+			m_Pos = m_Xml.find('<', m_Pos);
+			if (std::string::npos == m_Pos)
+				m_Pos = size;
+			m_End = m_Pos;
+			m_bCData = false;
+			return Token::Text;
+		}
+		if (0 == m_Xml.compare(m_Pos, 9, "<![CDATA["))
+		{
+			m_Begin = m_Pos + 9;
+			m_End = m_Xml.find("]]>", m_Begin);
+			if (std::string::npos == m_End)
+				break;
+			m_Pos = m_End + 3;
+			m_bCData = true;
+			return Token::Text;
+		}
+		char const* skipTo = nullptr;
+		if (0 == m_Xml.compare(m_Pos, 2, "<?"))
+			skipTo = "?>";
+		else if (0 == m_Xml.compare(m_Pos, 4, "<!--"))
+			skipTo = "-->";
+		else if (0 == m_Xml.compare(m_Pos, 2, "<!"))
+			skipTo = ">";
+		if (skipTo)
+		{
+			m_Pos = m_Xml.find(skipTo, m_Pos);
+			if (std::string::npos == m_Pos)
+				break;
+			m_Pos += strlen(skipTo);
+			continue;
+		}
+
+		bool bEndTag = ('/' == m_Xml[m_Pos + 1]);
+		size_t nameBegin = m_Pos + (bEndTag ? 2 : 1);
+		size_t nameEnd = m_Xml.find_first_of(" \t\r\n/>", nameBegin);
+		if (std::string::npos == nameEnd)
+			break;
+		// '>' may appear in a quoted attribute value.
+		size_t close = nameEnd;
+		char quote = 0;
+		for (; close < size; ++close)
+		{
+			char ch = m_Xml[close];
+			if (quote)
+			{
+				if (ch == quote)
+					quote = 0;
+			}
+			else if ('"' == ch || '\'' == ch)
+				quote = ch;
+			else if ('>' == ch)
+				break;
+		}
+		if (close >= size)
+			break;
+		m_Name = LocalName(m_Xml.data() + nameBegin, m_Xml.data() + nameEnd);
+		m_bEmpty = !bEndTag && '/' == m_Xml[close - 1];
+		m_Begin = nameEnd;
+		m_End = m_bEmpty ? close - 1 : close;
+		m_Pos = close + 1;
+		return bEndTag ? Token::EndTag : Token::Start;
+	}
+	m_Pos = size;
+	return Token::End;
+}
+
+
+bool CXmlScanner::GetAttrib(char const* inName, std::string& outValue) const
+{
+	char const* p = m_Xml.data() + m_Begin;
+	char const* end = m_Xml.data() + m_End;
+	while (p < end)
+	{
+		while (p < end && IsXmlSpace(*p))
+			++p;
+		char const* nameBegin = p;
+		while (p < end && '=' != *p && !IsXmlSpace(*p))
+			++p;
+		char const* nameEnd = p;
+		while (p < end && '=' != *p)
+			++p;
+		while (p < end && '"' != *p && '\'' != *p)
+			++p;
+		if (p >= end)
+			break;
+		char quote = *p++;
+		char const* valueBegin = p;
+		while (p < end && quote != *p)
+			++p;
+		if (LocalName(nameBegin, nameEnd) == inName)
+		{
+			outValue = Decode(valueBegin, p);
+			return true;
+		}
+		++p;
+	}
+	return false;
+}
+
+
+std::string CXmlScanner::GetText() const
+{
+	if (m_bCData)
+		return m_Xml.substr(m_Begin, m_End - m_Begin);
+	return Decode(m_Xml.data() + m_Begin, m_Xml.data() + m_End);
+}
+
+
+void CXmlScanner::SkipElement()
+{
+	if (m_bEmpty)
+		return;
+	int depth = 1;
+	for (Token tok = Next(); Token::End != tok; tok = Next())
+	{
+		if (Token::Start == tok && !m_bEmpty)
+			++depth;
+		else if (Token::EndTag == tok && 0 == --depth)
+			break;
+	}
+}
+
+
+std::string CXmlScanner::Decode(char const* inBegin, char const* inEnd)
+{
+	std::string str;
+	str.reserve(inEnd - inBegin);
+	for (char const* p = inBegin; p < inEnd; ++p)
+	{
+		if ('&' != *p)
+		{
+			str += *p;
+			continue;
+		}
+		char const* semi = p + 1;
+		while (semi < inEnd && ';' != *semi)
+			++semi;
+		if (semi >= inEnd)
+		{
+			str += *p;
+			continue;
+		}
+		std::string entity(p + 1, semi);
+		if ("lt" == entity)
+			str += '<';
+		else if ("gt" == entity)
+			str += '>';
+		else if ("amp" == entity)
+			str += '&';
+		else if ("quot" == entity)
+			str += '"';
+		else if ("apos" == entity)
+			str += '\'';
+		else if (1 < entity.size() && '#' == entity[0])
+		{
+			unsigned long ch;
+			if ('x' == entity[1] || 'X' == entity[1])
+				ch = strtoul(entity.c_str() + 2, nullptr, 16);
+			else
+				ch = strtoul(entity.c_str() + 1, nullptr, 10);
+			if (ch < 0x80)
+				str += static_cast<char>(ch);
+			else if (ch < 0x800)
+			{
+				str += static_cast<char>(0xC0 | (ch >> 6));
+				str += static_cast<char>(0x80 | (ch & 0x3F));
+			}
+			else if (ch < 0x10000)
+			{
+				str += static_cast<char>(0xE0 | (ch >> 12));
+				str += static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+				str += static_cast<char>(0x80 | (ch & 0x3F));
+			}
+			else
+			{
+				str += static_cast<char>(0xF0 | (ch >> 18));
+				str += static_cast<char>(0x80 | ((ch >> 12) & 0x3F));
+				str += static_cast<char>(0x80 | ((ch >> 6) & 0x3F));
+				str += static_cast<char>(0x80 | (ch & 0x3F));
+			}
+		}
+		else
+			str.append(p, semi + 1);
+		p = semi;
+	}
+	return str;
+}
+
+
+std::string CXmlScanner::LocalName(char const* inBegin, char const* inEnd)
+{
+	char const* colon = static_cast<char const*>(memchr(inBegin, ':', inEnd - inBegin));
+	return std::string(colon ? colon + 1 : inBegin, inEnd);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+typedef std::map<wxString, std::unique_ptr<wxZipEntry>> ZipEntries;
+
+
+bool ReadEntry(wxZipInputStream& ioZip, ZipEntries const& inEntries, wxString const& inName, std::string& outData)
+{
+	outData.clear();
+	auto iter = inEntries.find(inName);
+	if (iter == inEntries.end() || !ioZip.OpenEntry(*iter->second))
+		return false;
+	if (0 < iter->second->GetSize())
+		outData.reserve(static_cast<size_t>(iter->second->GetSize()));
+	std::vector<char> buffer(BUFFER_SIZE);
+	for (;;)
+	{
+		ioZip.Read(buffer.data(), buffer.size());
+		size_t n = ioZip.LastRead();
+		if (0 == n)
+			break;
+		outData.append(buffer.data(), n);
+	}
+	bool bOk = ioZip.Eof();
+	ioZip.CloseEntry();
+	return bOk;
+}
+
+
+void SetCell(std::vector<std::vector<wxString>>& ioData, size_t inRow, size_t inCol, std::string const& inText)
+{
+	if (inText.empty())
+		return;
+	if (ioData.size() <= inRow)
+		ioData.resize(inRow + 1);
+	std::vector<wxString>& row = ioData[inRow];
+	if (row.size() <= inCol)
+		row.resize(inCol + 1);
+	row[inCol] = wxString::FromUTF8(inText.data(), inText.size());
+}
+
+
+wxString SerialToDate(double inSerial, bool inDate1904)
+{
+	// Days since 1970-01-01.
+	long days = static_cast<long>(std::floor(inSerial));
+	if (inDate1904)
+		days -= 24107;
+	else if (days < 61)
+		days -= 25568; // Excel thinks 1900 was a leap year.
+	else
+		days -= 25569;
+	// Convert to y/m/d (proleptic Gregorian).
+	days += 719468;
+	long era = (0 <= days ? days : days - 146096) / 146097;
+	long doe = days - era * 146097;
+	long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+	long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+	long mp = (5 * doy + 2) / 153;
+	long d = doy - (153 * mp + 2) / 5 + 1;
+	long m = mp < 10 ? mp + 3 : mp - 9;
+	long y = yoe + era * 400 + (m <= 2 ? 1 : 0);
+	return wxString::Format(L"%04ld-%02ld-%02ld", y, m, d);
+}
+
+
+bool IsDateFormat(long inId, std::map<long, std::string> const& inCustom)
+{
+	if ((14 <= inId && inId <= 17) || 22 == inId || (27 <= inId && inId <= 36) || (50 <= inId && inId <= 58))
+		return true;
+	auto iter = inCustom.find(inId);
+	if (iter == inCustom.end())
+		return false;
+	// Ignore quoted text, escaped characters and [] sections (colors, locales).
+	std::string const& code = iter->second;
+	for (size_t i = 0; i < code.size(); ++i)
+	{
+		char ch = code[i];
+		if ('"' == ch)
+			i = code.find('"', i + 1);
+		else if ('[' == ch)
+			i = code.find(']', i + 1);
+		else if ('\\' == ch)
+			++i;
+		else if ('d' == ch || 'D' == ch || 'y' == ch || 'Y' == ch)
+			return true;
+		if (std::string::npos == i)
+			break;
+	}
+	return false;
+}
+
+
+// Collect the text of <t> elements until the end of the current element.
+std::string ReadXlsxText(CXmlScanner& ioScanner)
+{
+	std::string text;
+	int depth = 1;
+	bool bInText = false;
+	for (CXmlScanner::Token tok = ioScanner.Next(); CXmlScanner::Token::End != tok; tok = ioScanner.Next())
+	{
+		if (CXmlScanner::Token::Start == tok)
+		{
+			if (ioScanner.IsName("rPh")) // Phonetic hints
+				ioScanner.SkipElement();
+			else if (!ioScanner.IsEmpty())
+			{
+				++depth;
+				bInText = ioScanner.IsName("t");
+			}
+		}
+		else if (CXmlScanner::Token::EndTag == tok)
+		{
+			bInText = false;
+			if (0 == --depth)
+				break;
+		}
+		else if (bInText)
+			text += ioScanner.GetText();
+	}
+	return text;
+}
+
+
+bool ReadXlsx(wxZipInputStream& ioZip, ZipEntries const& inEntries, std::vector<std::vector<wxString>>& outData)
+{
+	std::string xml;
+	bool bDate1904 = false;
+	std::string sheetId;
+	if (!ReadEntry(ioZip, inEntries, L"xl/workbook.xml", xml))
+		return false;
+	{
+		CXmlScanner scanner(xml);
+		for (CXmlScanner::Token tok = scanner.Next(); CXmlScanner::Token::End != tok; tok = scanner.Next())
+		{
+			if (CXmlScanner::Token::Start != tok)
+				continue;
+			std::string value;
+			if (scanner.IsName("workbookPr") && scanner.GetAttrib("date1904", value))
+				bDate1904 = ("1" == value || "true" == value);
+			else if (scanner.IsName("sheet"))
+			{
+				scanner.GetAttrib("id", sheetId);
+				break;
+			}
+		}
+	}
+
+	wxString sheetName(L"xl/worksheets/sheet1.xml");
+	if (ReadEntry(ioZip, inEntries, L"xl/_rels/workbook.xml.rels", xml))
+	{
+		CXmlScanner scanner(xml);
+		for (CXmlScanner::Token tok = scanner.Next(); CXmlScanner::Token::End != tok; tok = scanner.Next())
+		{
+			std::string id, target;
+			if (CXmlScanner::Token::Start == tok && scanner.IsName("Relationship") && scanner.GetAttrib("Id", id)
+				&& id == sheetId && scanner.GetAttrib("Target", target))
+			{
+				if (!target.empty() && '/' == target[0])
+					sheetName = wxString::FromUTF8(target.c_str() + 1);
+				else
+					sheetName = L"xl/" + wxString::FromUTF8(target.c_str());
+				break;
+			}
+		}
+	}
+
+	std::vector<std::string> sharedStrings;
+	if (ReadEntry(ioZip, inEntries, L"xl/sharedStrings.xml", xml))
+	{
+		CXmlScanner scanner(xml);
+		for (CXmlScanner::Token tok = scanner.Next(); CXmlScanner::Token::End != tok; tok = scanner.Next())
+		{
+			if (CXmlScanner::Token::Start == tok && scanner.IsName("si"))
+				sharedStrings.push_back(scanner.IsEmpty() ? std::string() : ReadXlsxText(scanner));
+		}
+	}
+
+	std::vector<bool> dateStyles;
+	if (ReadEntry(ioZip, inEntries, L"xl/styles.xml", xml))
+	{
+		std::map<long, std::string> formats;
+		bool bInCellXfs = false;
+		CXmlScanner scanner(xml);
+		for (CXmlScanner::Token tok = scanner.Next(); CXmlScanner::Token::End != tok; tok = scanner.Next())
+		{
+			std::string id, code;
+			if (CXmlScanner::Token::EndTag == tok && scanner.IsName("cellXfs"))
+				bInCellXfs = false;
+			else if (CXmlScanner::Token::Start != tok)
+				continue;
+			else if (scanner.IsName("cellXfs"))
+				bInCellXfs = !scanner.IsEmpty();
+			else if (scanner.IsName("numFmt") && scanner.GetAttrib("numFmtId", id) && scanner.GetAttrib("formatCode", code))
+				formats[strtol(id.c_str(), nullptr, 10)] = code;
+			else if (bInCellXfs && scanner.IsName("xf"))
+			{
+				scanner.GetAttrib("numFmtId", id);
+				dateStyles.push_back(IsDateFormat(strtol(id.c_str(), nullptr, 10), formats));
+			}
+		}
+	}
+
+	if (!ReadEntry(ioZip, inEntries, sheetName, xml))
+		return false;
+	CXmlScanner scanner(xml);
+	size_t nRow = 0;
+	size_t nCol = 0;
+	bool bFirstRow = true;
+	for (CXmlScanner::Token tok = scanner.Next(); CXmlScanner::Token::End != tok; tok = scanner.Next())
+	{
+		if (CXmlScanner::Token::Start != tok)
+			continue;
+		std::string value;
+		if (scanner.IsName("row"))
+		{
+			if (scanner.GetAttrib("r", value) && 0 < strtol(value.c_str(), nullptr, 10))
+				nRow = strtol(value.c_str(), nullptr, 10) - 1;
+			else if (!bFirstRow)
+				++nRow;
+			bFirstRow = false;
+			nCol = 0;
+		}
+		else if (scanner.IsName("c"))
+		{
+			if (scanner.GetAttrib("r", value))
+			{
+				size_t col = 0;
+				for (size_t i = 0; i < value.size() && 'A' <= value[i] && value[i] <= 'Z'; ++i)
+					col = col * 26 + (value[i] - 'A' + 1);
+				if (0 < col)
+					nCol = col - 1;
+			}
+			std::string type, style;
+			scanner.GetAttrib("t", type);
+			scanner.GetAttrib("s", style);
+			std::string text;
+			if (!scanner.IsEmpty())
+			{
+				if ("inlineStr" == type)
+					text = ReadXlsxText(scanner);
+				else
+				{
+					int depth = 1;
+					bool bInValue = false;
+					for (tok = scanner.Next(); CXmlScanner::Token::End != tok; tok = scanner.Next())
+					{
+						if (CXmlScanner::Token::Start == tok && !scanner.IsEmpty())
+						{
+							++depth;
+							bInValue = scanner.IsName("v");
+						}
+						else if (CXmlScanner::Token::EndTag == tok)
+						{
+							bInValue = false;
+							if (0 == --depth)
+								break;
+						}
+						else if (bInValue)
+							text += scanner.GetText();
+					}
+				}
+			}
+			if ("s" == type)
+			{
+				size_t idx = strtoul(text.c_str(), nullptr, 10);
+				text = idx < sharedStrings.size() ? sharedStrings[idx] : std::string();
+			}
+			else if ("b" == type)
+				text = ("1" == text) ? "TRUE" : "FALSE";
+			else if ((type.empty() || "n" == type) && !text.empty() && !style.empty())
+			{
+				size_t idx = strtoul(style.c_str(), nullptr, 10);
+				if (idx < dateStyles.size() && dateStyles[idx])
+					text = SerialToDate(strtod(text.c_str(), nullptr), bDate1904).utf8_str().data();
+			}
+			SetCell(outData, nRow, nCol, text);
+			++nCol;
+		}
+	}
+	return true;
+}
+
+
+// Read the content of a cell until its end tag.
+std::string ReadOdsCell(CXmlScanner& ioScanner)
+{
+	std::string text;
+	int depth = 1;
+	int paragraphs = 0;
+	for (CXmlScanner::Token tok = ioScanner.Next(); CXmlScanner::Token::End != tok; tok = ioScanner.Next())
+	{
+		if (CXmlScanner::Token::Start == tok)
+		{
+			std::string value;
+			if (ioScanner.IsName("annotation"))
+			{
+				ioScanner.SkipElement();
+				continue;
+			}
+			if (ioScanner.IsName("p") || ioScanner.IsName("h"))
+			{
+				if (0 < paragraphs++)
+					text += '\n';
+			}
+			else if (ioScanner.IsName("s"))
+			{
+				long count = 1;
+				if (ioScanner.GetAttrib("c", value))
+					count = strtol(value.c_str(), nullptr, 10);
+				text.append(0 < count ? count : 1, ' ');
+			}
+			else if (ioScanner.IsName("tab"))
+				text += '\t';
+			else if (ioScanner.IsName("line-break"))
+				text += '\n';
+			if (!ioScanner.IsEmpty())
+				++depth;
+		}
+		else if (CXmlScanner::Token::EndTag == tok)
+		{
+			if (0 == --depth)
+				break;
+		}
+		else if (1 < depth)
+			text += ioScanner.GetText();
+	}
+	return text;
+}
+
+
+bool ReadOds(wxZipInputStream& ioZip, ZipEntries const& inEntries, std::vector<std::vector<wxString>>& outData)
+{
+	std::string xml;
+	if (!ReadEntry(ioZip, inEntries, L"content.xml", xml))
+		return false;
+	CXmlScanner scanner(xml);
+	bool bInTable = false;
+	size_t nRow = 0;
+	size_t nCol = 0;
+	size_t nRowRepeat = 1;
+	std::vector<std::pair<size_t, std::string>> cells;
+	for (CXmlScanner::Token tok = scanner.Next(); CXmlScanner::Token::End != tok; tok = scanner.Next())
+	{
+		std::string value;
+		if (CXmlScanner::Token::EndTag == tok)
+		{
+			if (!bInTable)
+				continue;
+			if (scanner.IsName("table"))
+				break; // Only the first sheet.
+			if (scanner.IsName("table-row"))
+			{
+				// Empty rows are often repeated to the end of the sheet, so
+				// only repeat rows that have something in them.
+				if (!cells.empty())
+				{
+					for (size_t r = 0; r < nRowRepeat; ++r)
+					{
+						for (auto const& cell : cells)
+							SetCell(outData, nRow + r, cell.first, cell.second);
+					}
+				}
+				nRow += nRowRepeat;
+			}
+			continue;
+		}
+		if (CXmlScanner::Token::Start != tok)
+			continue;
+		if (scanner.IsName("table"))
+			bInTable = true;
+		else if (!bInTable)
+			continue;
+		else if (scanner.IsName("table-row"))
+		{
+			nRowRepeat = 1;
+			if (scanner.GetAttrib("number-rows-repeated", value) && 0 < strtol(value.c_str(), nullptr, 10))
+				nRowRepeat = strtol(value.c_str(), nullptr, 10);
+			nCol = 0;
+			cells.clear();
+			if (scanner.IsEmpty())
+				nRow += nRowRepeat;
+		}
+		else if (scanner.IsName("table-cell") || scanner.IsName("covered-table-cell"))
+		{
+			size_t nColRepeat = 1;
+			if (scanner.GetAttrib("number-columns-repeated", value) && 0 < strtol(value.c_str(), nullptr, 10))
+				nColRepeat = strtol(value.c_str(), nullptr, 10);
+			std::string type, dateValue, numValue;
+			scanner.GetAttrib("value-type", type);
+			scanner.GetAttrib("date-value", dateValue);
+			scanner.GetAttrib("value", numValue);
+			std::string text;
+			if (!scanner.IsEmpty())
+				text = ReadOdsCell(scanner);
+			if ("date" == type && 10 <= dateValue.size())
+				text = dateValue.substr(0, 10);
+			else if (text.empty() && !numValue.empty())
+				text = numValue;
+			if (!text.empty())
+			{
+				for (size_t c = 0; c < nColRepeat; ++c)
+					cells.push_back(std::make_pair(nCol + c, text));
+			}
+			nCol += nColRepeat;
+		}
+	}
+	return true;
+}
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+
+ARBSpreadSheetWriter::ARBSpreadSheetWriter(ARBSpreadSheetFormat inFormat, wxOutputStream& ioStream)
+	: m_Format(inFormat)
+	, m_Zip(std::make_unique<wxZipOutputStream>(ioStream))
+	, m_Widths()
+	, m_Buffer()
+	, m_Row(0)
+	, m_bStarted(false)
+	, m_bOk(true)
+{
+}
+
+
+ARBSpreadSheetWriter::~ARBSpreadSheetWriter()
+{
+	Close();
+}
+
+
+void ARBSpreadSheetWriter::SetColumnWidths(std::vector<size_t> const& inWidths)
+{
+	assert(!m_bStarted);
+	m_Widths = inWidths;
+}
+
+
+bool ARBSpreadSheetWriter::AddRow(std::vector<wxString> const& inRow)
+{
+	if (!m_bStarted)
+		Start();
+	if (!m_bOk)
+		return false;
+	++m_Row;
+	if (ARBSpreadSheetFormat::Xlsx == m_Format)
+	{
+		m_Buffer += "<row r=\"";
+		m_Buffer += std::to_string(m_Row);
+		m_Buffer += "\">";
+		for (size_t iCol = 0; iCol < inRow.size(); ++iCol)
+		{
+			if (!inRow[iCol].empty())
+				AppendCellXlsx(inRow[iCol], iCol);
+		}
+		m_Buffer += "</row>";
+	}
+	else
+	{
+		m_Buffer += "<table:table-row>";
+		size_t nEmpty = 0;
+		bool bHasCell = false;
+		for (auto const& text : inRow)
+		{
+			if (text.empty())
+			{
+				++nEmpty;
+				continue;
+			}
+			if (1 == nEmpty)
+				m_Buffer += "<table:table-cell/>";
+			else if (1 < nEmpty)
+			{
+				m_Buffer += "<table:table-cell table:number-columns-repeated=\"";
+				m_Buffer += std::to_string(nEmpty);
+				m_Buffer += "\"/>";
+			}
+			nEmpty = 0;
+			AppendCellOds(text);
+			bHasCell = true;
+		}
+		if (!bHasCell)
+			m_Buffer += "<table:table-cell/>";
+		m_Buffer += "</table:table-row>";
+	}
+	if (BUFFER_SIZE <= m_Buffer.size())
+	{
+		m_bOk = Write(m_Buffer);
+		m_Buffer.clear();
+	}
+	return m_bOk;
+}
+
+
+bool ARBSpreadSheetWriter::Close()
+{
+	if (!m_Zip)
+		return m_bOk;
+	if (!m_bStarted)
+		Start();
+	if (m_bOk)
+	{
+		if (ARBSpreadSheetFormat::Xlsx == m_Format)
+			m_Buffer += "</sheetData></worksheet>";
+		else
+			m_Buffer += "</table:table></office:spreadsheet></office:body></office:document-content>";
+		m_bOk = Write(m_Buffer);
+	}
+	m_Buffer.clear();
+	if (!m_Zip->Close())
+		m_bOk = false;
+	m_Zip.reset();
+	return m_bOk;
+}
+
+
+bool ARBSpreadSheetWriter::Start()
+{
+	m_bStarted = true;
+	// The sheet is the last entry so it can be streamed.
+	if (ARBSpreadSheetFormat::Xlsx == m_Format)
+	{
+		m_bOk = PutEntry(*m_Zip, L"[Content_Types].xml", XLSX_CONTENT_TYPES)
+				&& PutEntry(*m_Zip, L"_rels/.rels", XLSX_RELS) && PutEntry(*m_Zip, L"xl/workbook.xml", XLSX_WORKBOOK)
+				&& PutEntry(*m_Zip, L"xl/_rels/workbook.xml.rels", XLSX_WORKBOOK_RELS)
+				&& m_Zip->PutNextEntry(L"xl/worksheets/sheet1.xml");
+		m_Buffer = XML_DECL "<worksheet xmlns=\"" XLSX_NS_MAIN "\">";
+		if (!m_Widths.empty())
+		{
+			m_Buffer += "<cols>";
+			for (size_t iCol = 0; iCol < m_Widths.size(); ++iCol)
+			{
+				std::string col = std::to_string(iCol + 1);
+				m_Buffer += "<col min=\"" + col + "\" max=\"" + col + "\" width=\"";
+				m_Buffer += std::to_string(std::min(m_Widths[iCol], MAX_COLUMN_WIDTH) + 2);
+				m_Buffer += "\" customWidth=\"1\"/>";
+			}
+			m_Buffer += "</cols>";
+		}
+		m_Buffer += "<sheetData>";
+	}
+	else
+	{
+		// The mimetype must be first and not compressed.
+		wxZipEntry* entry = new wxZipEntry(L"mimetype");
+		entry->SetMethod(wxZIP_METHOD_STORE);
+		m_bOk = m_Zip->PutNextEntry(entry);
+		if (m_bOk)
+		{
+			size_t len = strlen(ODS_MIMETYPE);
+			m_Zip->Write(ODS_MIMETYPE, len);
+			m_bOk = m_Zip->LastWrite() == len;
+		}
+		m_bOk = m_bOk && PutEntry(*m_Zip, L"META-INF/manifest.xml", ODS_MANIFEST) && m_Zip->PutNextEntry(L"content.xml");
+		m_Buffer = ODS_CONTENT_BEGIN;
+		if (!m_Widths.empty())
+		{
+			m_Buffer += "<office:automatic-styles>";
+			for (size_t iCol = 0; iCol < m_Widths.size(); ++iCol)
+			{
+				m_Buffer += "<style:style style:name=\"co" + std::to_string(iCol + 1) + "\" style:family=\"table-column\">";
+				m_Buffer += "<style:table-column-properties style:column-width=\"";
+				m_Buffer += std::to_string((std::min(m_Widths[iCol], MAX_COLUMN_WIDTH) + 2) * 2) + "mm";
+				m_Buffer += "\"/></style:style>";
+			}
+			m_Buffer += "</office:automatic-styles>";
+		}
+		m_Buffer += "<office:body><office:spreadsheet><table:table table:name=\"Sheet1\">";
+		for (size_t iCol = 0; iCol < m_Widths.size(); ++iCol)
+			m_Buffer += "<table:table-column table:style-name=\"co" + std::to_string(iCol + 1) + "\"/>";
+		if (m_Widths.empty())
+			m_Buffer += "<table:table-column/>";
+	}
+	return m_bOk;
+}
+
+
+bool ARBSpreadSheetWriter::Write(std::string const& inData)
+{
+	if (!m_Zip)
+		return false;
+	m_Zip->Write(inData.data(), inData.size());
+	return m_Zip->LastWrite() == inData.size();
+}
+
+
+void ARBSpreadSheetWriter::AppendCellXlsx(wxString const& inText, size_t inCol)
+{
+	m_Buffer += "<c r=\"";
+	m_Buffer += ColumnName(inCol);
+	m_Buffer += std::to_string(m_Row);
+	m_Buffer += "\" t=\"inlineStr\"><is><t";
+	if (wxIsspace(inText[0]) || wxIsspace(inText.Last()) || wxNOT_FOUND != inText.Find(L'\n'))
+		m_Buffer += " xml:space=\"preserve\"";
+	m_Buffer += ">";
+	AppendEscaped(m_Buffer, inText);
+	m_Buffer += "</t></is></c>";
+}
+
+
+void ARBSpreadSheetWriter::AppendCellOds(wxString const& inText)
+{
+	// Whitespace in ODF text collapses, so runs of spaces, tabs and newlines
+	// are written as elements.
+	m_Buffer += "<table:table-cell office:value-type=\"string\"><text:p>";
+	wxString segment;
+	size_t spaces = 0;
+	bool bParaStart = true;
+	auto flushSegment = [this, &segment]() {
+		if (!segment.empty())
+		{
+			AppendEscaped(m_Buffer, segment);
+			segment.clear();
+		}
+	};
+	auto flushSpaces = [this, &segment, &spaces, &bParaStart, &flushSegment](bool bMoreText) {
+		if (0 == spaces)
+			return;
+		if (bMoreText && !bParaStart)
+		{
+			segment += L' ';
+			--spaces;
+		}
+		flushSegment();
+		if (1 == spaces)
+			m_Buffer += "<text:s/>";
+		else if (1 < spaces)
+			m_Buffer += "<text:s text:c=\"" + std::to_string(spaces) + "\"/>";
+		spaces = 0;
+		bParaStart = false;
+	};
+	for (wxString::const_iterator iter = inText.begin(); iter != inText.end(); ++iter)
+	{
+		wxUniChar ch = *iter;
+		if (L' ' == ch)
+		{
+			++spaces;
+			continue;
+		}
+		flushSpaces(L'\n' != ch && L'\r' != ch);
+		if (L'\n' == ch)
+		{
+			flushSegment();
+			m_Buffer += "</text:p><text:p>";
+			bParaStart = true;
+		}
+		else if (L'\t' == ch)
+		{
+			flushSegment();
+			m_Buffer += "<text:tab/>";
+			bParaStart = false;
+		}
+		else if (L'\r' != ch)
+		{
+			segment += ch;
+			bParaStart = false;
+		}
+	}
+	flushSpaces(false);
+	flushSegment();
+	m_Buffer += "</text:p></table:table-cell>";
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+bool ARBSpreadSheetReader::Read(wxInputStream& ioStream, std::vector<std::vector<wxString>>& outData)
+{
+	outData.clear();
+	wxZipInputStream zip(ioStream);
+	if (!zip.IsOk())
+		return false;
+	ZipEntries entries;
+	for (wxZipEntry* entry = zip.GetNextEntry(); entry; entry = zip.GetNextEntry())
+		entries[entry->GetInternalName()].reset(entry);
+
+	bool bOk = false;
+	if (entries.end() != entries.find(L"xl/workbook.xml"))
+		bOk = ReadXlsx(zip, entries, outData);
+	else if (entries.end() != entries.find(L"content.xml"))
+		bOk = ReadOds(zip, entries, outData);
+	if (!bOk)
+		outData.clear();
+	return bOk;
+}
+
+
+bool ARBSpreadSheetReader::Read(wxString const& inFileName, std::vector<std::vector<wxString>>& outData)
+{
+	wxFFileInputStream input(inFileName, L"rb");
+	if (!input.IsOk())
+	{
+		outData.clear();
+		return false;
+	}
+	return Read(input, outData);
+}
+
+
+bool ARBSpreadSheetReader::IsSupportedFile(wxString const& inFileName)
+{
+	wxString ext = wxFileName(inFileName).GetExt().Lower();
+	return L"xlsx" == ext || L"ods" == ext;
+}
+
+} // namespace ARB
+} // namespace dconSoft
@@ -0,0 +1,590 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Export the record book as an SQL script.
+ * @author David Connet
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "ARB/ARBSqlExport.h"
+
+#include "ARB/ARBAgilityRecordBook.h"
+#include "ARB/ARBStructure.h"
+#include <cstring>
+#include <ostream>
+#include <string>
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+using namespace ARBCommon;
+namespace ARB
+{
+
+namespace
+{
+constexpr size_t SQL_BUFFER_SIZE = 64 * 1024;
+// Rows per INSERT statement.
+constexpr int SQL_ROWS_PER_INSERT = 500;
+
+constexpr char const* const sc_Schema[] = {
+	"CREATE TABLE dog (id INTEGER PRIMARY KEY, call_name TEXT, registered_name TEXT, breed TEXT, dob TEXT,"
+	" deceased TEXT, note TEXT)",
+	"CREATE TABLE regnum (dog_id INTEGER REFERENCES dog(id), venue TEXT, number TEXT, height TEXT,"
+	" received INTEGER, note TEXT)",
+	"CREATE TABLE title (dog_id INTEGER REFERENCES dog(id), date TEXT, venue TEXT, name TEXT, instance INTEGER,"
+	" received INTEGER, hidden INTEGER)",
+	"CREATE TABLE existing_points (dog_id INTEGER REFERENCES dog(id), type TEXT, date TEXT, venue TEXT,"
+	" multiq TEXT, division TEXT, level TEXT, event TEXT, subname TEXT, type_name TEXT, points REAL, comment TEXT)",
+	"CREATE TABLE trial (id INTEGER PRIMARY KEY, dog_id INTEGER REFERENCES dog(id), start_date TEXT,"
+	" end_date TEXT, location TEXT, verified INTEGER, note TEXT)",
+	"CREATE TABLE trial_club (trial_id INTEGER REFERENCES trial(id), name TEXT, venue TEXT, primary_club TEXT)",
+	"CREATE TABLE run (id INTEGER PRIMARY KEY, trial_id INTEGER REFERENCES trial(id),"
+	" dog_id INTEGER REFERENCES dog(id), date TEXT, club TEXT, venue TEXT, division TEXT, level TEXT,"
+	" event TEXT, subname TEXT, height TEXT, conditions TEXT, judge TEXT, handler TEXT, q TEXT,"
+	" qualified INTEGER, place INTEGER, in_class INTEGER, dogs_qd INTEGER, scoring TEXT, sct REAL, yards REAL,"
+	" obstacles INTEGER, time REAL, course_faults INTEGER, open_pts INTEGER, need_open_pts INTEGER,"
+	" close_pts INTEGER, need_close_pts INTEGER, bonus_pts REAL, yps REAL, score REAL, title_points REAL,"
+	" speed_points INTEGER, note TEXT)",
+	"CREATE TABLE run_other_points (run_id INTEGER REFERENCES run(id), name TEXT, points REAL)",
+	"CREATE TABLE calendar (id INTEGER PRIMARY KEY, start_date TEXT, end_date TEXT, tentative INTEGER,"
+	" location TEXT, club TEXT, venue TEXT, entered TEXT, opens TEXT, draw TEXT, closes TEXT, premium_url TEXT,"
+	" online_url TEXT, note TEXT)",
+	"CREATE TABLE training (id INTEGER PRIMARY KEY, date TEXT, name TEXT, subname TEXT, note TEXT)",
+};
+// Dropped in reverse order of creation.
+constexpr char const* const sc_Tables[] = {
+	"training",
+	"calendar",
+	"run_other_points",
+	"run",
+	"trial_club",
+	"trial",
+	"existing_points",
+	"title",
+	"regnum",
+	"dog",
+};
+// Created after the data is loaded, which is faster than maintaining them.
+constexpr char const* const sc_Indices[] = {
+	"CREATE INDEX regnum_dog ON regnum(dog_id)",
+	"CREATE INDEX title_dog ON title(dog_id)",
+	"CREATE INDEX existing_points_dog ON existing_points(dog_id)",
+	"CREATE INDEX trial_dog ON trial(dog_id)",
+	"CREATE INDEX trial_club_trial ON trial_club(trial_id)",
+	"CREATE INDEX run_trial ON run(trial_id)",
+	"CREATE INDEX run_dog ON run(dog_id)",
+	"CREATE INDEX run_date ON run(date)",
+	"CREATE INDEX run_judge ON run(judge)",
+	"CREATE INDEX run_event ON run(venue, event, division, level)",
+	"CREATE INDEX run_other_points_run ON run_other_points(run_id)",
+	"CREATE INDEX calendar_start ON calendar(start_date)",
+	"CREATE INDEX training_date ON training(date)",
+};
+
+
+char const* QName(ARB_Q const& inQ)
+{
+	switch (static_cast<Q>(inQ))
+	{
+	case Q::UNK:
+		break;
+	case Q::NA:
+		return "NA";
+	case Q::DNR:
+		return "DNR";
+	case Q::E:
+		return "E";
+	case Q::NQ:
+		return "NQ";
+	case Q::Q:
+		return "Q";
+	case Q::SuperQ:
+		return "SQ";
+	case Q::FEO:
+		return "FEO";
+	}
+	return nullptr;
+}
+
+
+char const* ScoringName(ARBScoringType inType)
+{
+	switch (inType)
+	{
+	case ARBScoringType::Unknown:
+		break;
+	case ARBScoringType::ByTime:
+		return "Time";
+	case ARBScoringType::ByOpenClose:
+		return "OpenClose";
+	case ARBScoringType::ByPoints:
+		return "Points";
+	case ARBScoringType::BySpeed:
+		return "Speed";
+	case ARBScoringType::ByPass:
+		return "Pass";
+	}
+	return nullptr;
+}
+
+
+char const* PointsName(ARBExistingPointType inType)
+{
+	switch (inType)
+	{
+	case ARBExistingPointType::Unknown:
+		break;
+	case ARBExistingPointType::OtherPoints:
+		return "Other";
+	case ARBExistingPointType::Lifetime:
+		return "Lifetime";
+	case ARBExistingPointType::Title:
+		return "Title";
+	case ARBExistingPointType::Speed:
+		return "Speed";
+	case ARBExistingPointType::MQ:
+		return "MQ";
+	case ARBExistingPointType::SQ:
+		return "SQ";
+	}
+	return nullptr;
+}
+
+
+char const* EnteredName(ARBCalendarEntry inEntry)
+{
+	switch (inEntry)
+	{
+	case ARBCalendarEntry::Not:
+		return "Not";
+	case ARBCalendarEntry::Entered:
+		return "Entered";
+	case ARBCalendarEntry::Pending:
+		return "Pending";
+	case ARBCalendarEntry::Planning:
+		return "Planning";
+	}
+	return nullptr;
+}
+
+
+/**
+ * Buffers the script and batches rows into multi-row INSERTs. Parsing one
+ * large statement is much faster than parsing one per row.
+ */
+class CSqlWriter
+{
+public:
+	explicit CSqlWriter(std::ostream& ioStream)
+		: m_ioStream(ioStream)
+		, m_Buffer()
+		, m_Table(nullptr)
+		, m_nRows(0)
+		, m_bFirstValue(true)
+	{
+		m_Buffer.reserve(SQL_BUFFER_SIZE + 1024);
+	}
+
+	void Statement(char const* inSql)
+	{
+		EndInsert();
+		m_Buffer += inSql;
+		m_Buffer += ";\n";
+	}
+
+	void Row(char const* inTable);
+	void EndInsert();
+	bool Flush();
+
+	CSqlWriter& Null()
+	{
+		Separator();
+		m_Buffer += "NULL";
+		return *this;
+	}
+	CSqlWriter& Text(char const* inText)
+	{
+		if (!inText)
+			return Null();
+		Separator();
+		m_Buffer += '\'';
+		m_Buffer += inText;
+		m_Buffer += '\'';
+		return *this;
+	}
+	CSqlWriter& Text(wxString const& inText);
+	CSqlWriter& Date(ARBDate const& inDate)
+	{
+		if (!inDate.IsValid())
+			return Null();
+		return Text(inDate.GetString(ARBDateFormat::ISO));
+	}
+	CSqlWriter& Int(long long inVal)
+	{
+		Separator();
+		m_Buffer += std::to_string(inVal);
+		return *this;
+	}
+	CSqlWriter& Bool(bool inVal)
+	{
+		return Int(inVal ? 1 : 0);
+	}
+	CSqlWriter& Real(double inVal)
+	{
+		Separator();
+		// Locale independent.
+		m_Buffer += wxString::FromCDouble(inVal).utf8_string();
+		return *this;
+	}
+
+private:
+	void Separator()
+	{
+		if (!m_bFirstValue)
+			m_Buffer += ',';
+		m_bFirstValue = false;
+	}
+
+	std::ostream& m_ioStream;
+	std::string m_Buffer;
+	char const* m_Table;
+	int m_nRows;
+	bool m_bFirstValue;
+};
+
+
+void CSqlWriter::Row(char const* inTable)
+{
+	if (m_Table && (0 != strcmp(m_Table, inTable) || SQL_ROWS_PER_INSERT <= m_nRows))
+		EndInsert();
+	if (!m_Table)
+	{
+		if (SQL_BUFFER_SIZE <= m_Buffer.length())
+			Flush();
+		m_Table = inTable;
+		m_Buffer += "INSERT INTO ";
+		m_Buffer += inTable;
+		m_Buffer += " VALUES\n(";
+	}
+	else
+		m_Buffer += "),\n(";
+	++m_nRows;
+	m_bFirstValue = true;
+}
+
+
+void CSqlWriter::EndInsert()
+{
+	if (m_Table)
+	{
+		m_Buffer += ");\n";
+		m_Table = nullptr;
+		m_nRows = 0;
+	}
+}
+
+
+bool CSqlWriter::Flush()
+{
+	if (!m_Buffer.empty())
+	{
+		m_ioStream.write(m_Buffer.c_str(), m_Buffer.length());
+		m_Buffer.clear();
+	}
+	return m_ioStream.good();
+}
+
+
+CSqlWriter& CSqlWriter::Text(wxString const& inText)
+{
+	if (inText.empty())
+		return Null();
+	Separator();
+	std::string str(inText.utf8_string());
+	m_Buffer += '\'';
+	size_t start = 0;
+	for (size_t pos = str.find('\''); std::string::npos != pos; pos = str.find('\'', start))
+	{
+		m_Buffer.append(str, start, pos + 1 - start);
+		m_Buffer += '\'';
+		start = pos + 1;
+	}
+	m_Buffer.append(str, start, std::string::npos);
+	m_Buffer += '\'';
+	return *this;
+}
+} // namespace
+
+/////////////////////////////////////////////////////////////////////////////
+
+bool ARBSqlExport::Write(ARBAgilityRecordBook const& inBook, bool inTableInYPS, std::ostream& outStream)
+{
+	CSqlWriter sql(outStream);
+	sql.Statement("BEGIN TRANSACTION");
+	for (auto table : sc_Tables)
+	{
+		std::string drop("DROP TABLE IF EXISTS ");
+		drop += table;
+		sql.Statement(drop.c_str());
+	}
+	for (auto create : sc_Schema)
+		sql.Statement(create);
+
+	// Children are written after their parents so the ids can be assigned
+	// here. Each table is written in one pass to keep the INSERTs large.
+	long long idDog = 0;
+	for (auto const& dog : inBook.GetDogs())
+	{
+		sql.Row("dog");
+		sql.Int(++idDog)
+			.Text(dog->GetCallName())
+			.Text(dog->GetRegisteredName())
+			.Text(dog->GetBreed())
+			.Date(dog->GetDOB())
+			.Date(dog->GetDeceased())
+			.Text(dog->GetNote());
+	}
+	idDog = 0;
+	for (auto const& dog : inBook.GetDogs())
+	{
+		++idDog;
+		for (auto const& regnum : dog->GetRegNums())
+		{
+			sql.Row("regnum");
+			sql.Int(idDog)
+				.Text(regnum->GetVenue())
+				.Text(regnum->GetNumber())
+				.Text(regnum->GetHeight())
+				.Bool(regnum->GetReceived())
+				.Text(regnum->GetNote());
+		}
+	}
+	idDog = 0;
+	for (auto const& dog : inBook.GetDogs())
+	{
+		++idDog;
+		for (auto const& title : dog->GetTitles())
+		{
+			sql.Row("title");
+			sql.Int(idDog)
+				.Date(title->GetDate())
+				.Text(title->GetVenue())
+				.Text(title->GetRawName())
+				.Int(title->GetInstance())
+				.Bool(title->GetReceived())
+				.Bool(title->IsHidden());
+		}
+	}
+	idDog = 0;
+	for (auto const& dog : inBook.GetDogs())
+	{
+		++idDog;
+		for (auto const& pts : dog->GetExistingPoints())
+		{
+			sql.Row("existing_points");
+			sql.Int(idDog)
+				.Text(PointsName(pts->GetType()))
+				.Date(pts->GetDate())
+				.Text(pts->GetVenue())
+				.Text(pts->GetMultiQ())
+				.Text(pts->GetDivision())
+				.Text(pts->GetLevel())
+				.Text(pts->GetEvent())
+				.Text(pts->GetSubName())
+				.Text(pts->GetTypeName())
+				.Real(pts->GetPoints())
+				.Text(pts->GetComment());
+		}
+	}
+
+	long long idTrial = 0;
+	idDog = 0;
+	for (auto const& dog : inBook.GetDogs())
+	{
+		++idDog;
+		for (auto const& trial : dog->GetTrials())
+		{
+			sql.Row("trial");
+			sql.Int(++idTrial)
+				.Int(idDog)
+				.Date(trial->GetStartDate())
+				.Date(trial->GetEndDate())
+				.Text(trial->GetLocation())
+				.Bool(trial->IsVerified())
+				.Text(trial->GetNote());
+		}
+	}
+	idTrial = 0;
+	for (auto const& dog : inBook.GetDogs())
+	{
+		for (auto const& trial : dog->GetTrials())
+		{
+			++idTrial;
+			for (auto const& club : trial->GetClubs())
+			{
+				ARBDogClubPtr primary = club->GetPrimaryClub();
+				sql.Row("trial_club");
+				sql.Int(idTrial).Text(club->GetName()).Text(club->GetVenue());
+				if (primary)
+					sql.Text(primary->GetName());
+				else
+					sql.Null();
+			}
+		}
+	}
+
+	long long idRun = 0;
+	idTrial = 0;
+	idDog = 0;
+	for (auto const& dog : inBook.GetDogs())
+	{
+		++idDog;
+		for (auto const& trial : dog->GetTrials())
+		{
+			++idTrial;
+			for (auto const& run : trial->GetRuns())
+			{
+				ARBDogClubPtr club = run->GetClub();
+				ARBConfigScoringPtr pScoring;
+				if (club)
+				{
+					inBook.GetConfig().GetVenues().FindEvent(
+						club->GetVenue(),
+						run->GetEvent(),
+						run->GetDivision(),
+						run->GetLevel(),
+						run->GetDate(),
+						nullptr,
+						&pScoring);
+				}
+				ARBDogRunScoring const& scoring = run->GetScoring();
+
+				sql.Row("run");
+				sql.Int(++idRun).Int(idTrial).Int(idDog).Date(run->GetDate());
+				if (club)
+					sql.Text(club->GetName()).Text(club->GetVenue());
+				else
+					sql.Null().Null();
+				sql.Text(run->GetDivision())
+					.Text(run->GetLevel())
+					.Text(run->GetEvent())
+					.Text(run->GetSubName())
+					.Text(run->GetHeight())
+					.Text(run->GetConditions())
+					.Text(run->GetJudge())
+					.Text(run->GetHandler())
+					.Text(QName(run->GetQ()))
+					.Bool(run->GetQ().Qualified())
+					.Int(run->GetPlace());
+				if (0 <= run->GetInClass())
+					sql.Int(run->GetInClass());
+				else
+					sql.Null();
+				if (0 <= run->GetDogsQd())
+					sql.Int(run->GetDogsQd());
+				else
+					sql.Null();
+				sql.Text(ScoringName(scoring.GetType()))
+					.Real(scoring.GetSCT())
+					.Real(scoring.GetYards())
+					.Int(scoring.GetObstacles())
+					.Real(scoring.GetTime())
+					.Int(scoring.GetCourseFaults())
+					.Int(scoring.GetOpenPts())
+					.Int(scoring.GetNeedOpenPts())
+					.Int(scoring.GetClosePts())
+					.Int(scoring.GetNeedClosePts())
+					.Real(scoring.GetBonusTitlePts());
+				double yps;
+				if (scoring.GetYPS(inTableInYPS, yps))
+					sql.Real(yps);
+				else
+					sql.Null();
+				if (pScoring)
+				{
+					sql.Real(run->GetScore(pScoring));
+					if (run->GetQ().Qualified())
+					{
+						sql.Real(run->GetTitlePoints(pScoring));
+						if (pScoring->HasSpeedPts())
+							sql.Int(run->GetSpeedPoints(pScoring));
+						else
+							sql.Null();
+					}
+					else
+						sql.Null().Null();
+				}
+				else
+					sql.Null().Null().Null();
+				sql.Text(run->GetNote());
+			}
+		}
+	}
+	idRun = 0;
+	for (auto const& dog : inBook.GetDogs())
+	{
+		for (auto const& trial : dog->GetTrials())
+		{
+			for (auto const& run : trial->GetRuns())
+			{
+				++idRun;
+				for (auto const& other : run->GetOtherPoints())
+				{
+					sql.Row("run_other_points");
+					sql.Int(idRun).Text(other->GetName()).Real(other->GetPoints());
+				}
+			}
+		}
+	}
+
+	long long id = 0;
+	for (auto const& cal : inBook.GetCalendar())
+	{
+		sql.Row("calendar");
+		sql.Int(++id)
+			.Date(cal->GetStartDate())
+			.Date(cal->GetEndDate())
+			.Bool(cal->IsTentative())
+			.Text(cal->GetLocation())
+			.Text(cal->GetClub())
+			.Text(cal->GetVenue())
+			.Text(EnteredName(cal->GetEntered()))
+			.Date(cal->GetOpeningDate())
+			.Date(cal->GetDrawDate())
+			.Date(cal->GetClosingDate())
+			.Text(cal->GetPremiumURL())
+			.Text(cal->GetOnlineURL())
+			.Text(cal->GetNote());
+	}
+	id = 0;
+	for (auto const& training : inBook.GetTraining())
+	{
+		sql.Row("training");
+		sql.Int(++id)
+			.Date(training->GetDate())
+			.Text(training->GetName())
+			.Text(training->GetSubName())
+			.Text(training->GetNote());
+	}
+
+	for (auto index : sc_Indices)
+		sql.Statement(index);
+	sql.Statement("COMMIT");
+	return sql.Flush();
+}
+
+} // namespace ARB
+} // namespace dconSoft
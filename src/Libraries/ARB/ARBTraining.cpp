@@ -10,6 +10,8 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ForEachSearchString.
+ * 2026-10-19 Sort using precomputed keys.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
  * 2005-06-25 Cleaned up reference counting when returning a pointer.
@@ -27,6 +29,7 @@
 
 #include "ARB/ARBAgilityRecordBook.h"
 #include "ARB/ARBLocalization.h"
+#include "ARB/ARBSortKey.h"
 #include "ARBCommon/Element.h"
 #include <algorithm>
 
@@ -140,30 +143,25 @@ bool ARBTraining::operator==(ARBTraining const& rhs) const
 
 size_t ARBTraining::GetSearchStrings(std::set<wxString>& ioStrings) const
 {
-	size_t nItems = 0;
+	return CollectSearchStrings(*this, ioStrings);
+}
 
-	ioStrings.insert(m_Date.GetString(ARBDateFormat::SlashMDY));
-	++nItems;
 
-	if (0 < m_Name.length())
-	{
-		ioStrings.insert(m_Name);
-		++nItems;
-	}
+bool ARBTraining::ForEachSearchString(ARBSearchStringCallback const& inCallback) const
+{
+	if (!inCallback(m_Date.GetString(ARBDateFormat::SlashMDY)))
+		return false;
 
-	if (0 < m_SubName.length())
-	{
-		ioStrings.insert(m_SubName);
-		++nItems;
-	}
+	if (0 < m_Name.length() && !inCallback(m_Name))
+		return false;
 
-	if (0 < m_Note.length())
-	{
-		ioStrings.insert(m_Note);
-		++nItems;
-	}
+	if (0 < m_SubName.length() && !inCallback(m_SubName))
+		return false;
+
+	if (0 < m_Note.length() && !inCallback(m_Note))
+		return false;
 
-	return nItems;
+	return true;
 }
 
 
@@ -230,9 +228,10 @@ void ARBTrainingList::sort()
 {
 	if (2 > size())
 		return;
-	std::stable_sort(begin(), end(), [](ARBTrainingPtr const& one, ARBTrainingPtr const& two) {
-		return one->GetDate() < two->GetDate();
-	});
+	SortByKey(
+		*this,
+		[](ARBTrainingPtr const& inTraining) { return inTraining->GetDate(); },
+		[](ARBDate const& one, ARBDate const& two) { return one < two; });
 }
 
 
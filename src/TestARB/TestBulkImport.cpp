@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Test ARBBulkImport class
+ * @author David Connet
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "TestLib.h"
+
+#include "ARB/ARBAgilityRecordBook.h"
+#include "ARB/ARBBulkImport.h"
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+using namespace ARB;
+using namespace ARBCommon;
+
+namespace
+{
+ARBDogPtr CreateDog(wxString const& inRegName, wxString const& inCallName)
+{
+	ARBDogPtr dog = ARBDog::New();
+	dog->SetRegisteredName(inRegName);
+	dog->SetCallName(inCallName);
+	return dog;
+}
+
+
+ARBDogTrialPtr CreateTrial(wxString const& inLocation, ARBDate const& inDate)
+{
+	ARBDogTrialPtr trial = ARBDogTrial::New();
+	trial->SetLocation(inLocation);
+	trial->GetClubs().AddClub(L"Club", L"AKC");
+	ARBDogRunPtr run = ARBDogRun::New();
+	run->SetDate(inDate);
+	trial->GetRuns().AddRun(run);
+	return trial;
+}
+} // namespace
+
+
+TEST_CASE("BulkImport")
+{
+	SECTION("FindDog")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBAgilityRecordBook book;
+			ARBDogPtr dogA = CreateDog(L"Reg A", L"A");
+			ARBDogPtr dogB = CreateDog(L"Reg B", L"B");
+			book.GetDogs().AddDog(dogA);
+			book.GetDogs().AddDog(dogB);
+
+			ARBBulkImport bulk(book);
+			REQUIRE(dogA == bulk.FindDog(L"Reg A", L"A"));
+			REQUIRE(!bulk.FindDog(L"Reg A", L"B"));
+			REQUIRE(dogB == bulk.FindDog(L"Reg B", L""));
+			REQUIRE(dogB == bulk.FindDog(L"", L"B"));
+			REQUIRE(!bulk.FindDog(L"", L""));
+
+			ARBDogPtr dogC = CreateDog(L"", L"C");
+			bulk.AddDog(dogC);
+			REQUIRE(3u == book.GetDogs().size());
+			REQUIRE(dogC == bulk.FindDog(L"", L"C"));
+			REQUIRE(1u == bulk.GetModifiedDogs().size());
+		}
+	}
+
+
+	SECTION("FindTrial")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBAgilityRecordBook book;
+			ARBDogPtr dog = CreateDog(L"", L"A");
+			book.GetDogs().AddDog(dog);
+			ARBDogTrialPtr trial = CreateTrial(L"Here", ARBDate(2006, 9, 4));
+			dog->GetTrials().AddTrial(trial);
+
+			ARBBulkImport bulk(book);
+			std::vector<wxString> clubs(1, L"Club");
+			std::vector<wxString> venues(1, L"AKC");
+			REQUIRE(trial == bulk.FindTrial(dog, ARBDate(2006, 9, 4), L"Here", clubs, venues));
+			// The next day joins the trial.
+			REQUIRE(trial == bulk.FindTrial(dog, ARBDate(2006, 9, 5), L"Here", clubs, venues));
+			REQUIRE(!bulk.FindTrial(dog, ARBDate(2006, 9, 7), L"Here", clubs, venues));
+			REQUIRE(!bulk.FindTrial(dog, ARBDate(2006, 9, 4), L"There", clubs, venues));
+			venues[0] = L"USDAA";
+			REQUIRE(!bulk.FindTrial(dog, ARBDate(2006, 9, 4), L"Here", clubs, venues));
+
+			ARBDogTrialPtr trial2 = ARBDogTrial::New();
+			trial2->SetLocation(L"Here");
+			trial2->GetClubs().AddClub(L"Club", L"USDAA");
+			bulk.AddTrial(dog, trial2);
+			ARBDogRunPtr run = ARBDogRun::New();
+			run->SetDate(ARBDate(2006, 9, 1));
+			bulk.AddRun(dog, trial2, run);
+			REQUIRE(trial2 == bulk.FindTrial(dog, ARBDate(2006, 9, 1), L"Here", clubs, venues));
+
+			// Nothing is sorted until the end.
+			REQUIRE(trial == *dog->GetTrials().begin());
+			bulk.Finish(false);
+			REQUIRE(trial2 == *dog->GetTrials().begin());
+		}
+	}
+
+
+	SECTION("MergeDog")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBAgilityRecordBook book;
+			ARBDogPtr dog = CreateDog(L"", L"A");
+			dog->GetTrials().AddTrial(CreateTrial(L"Here", ARBDate(2006, 9, 4)));
+			book.GetDogs().AddDog(dog);
+
+			ARBDogPtr dogImport = CreateDog(L"", L"A");
+			dogImport->GetTrials().AddTrial(CreateTrial(L"Here", ARBDate(2006, 9, 4)));
+			dogImport->GetTrials().AddTrial(CreateTrial(L"There", ARBDate(2006, 9, 11)));
+			ARBDogPtr dogNew = CreateDog(L"", L"B");
+
+			ARBBulkImport bulk(book);
+			ARBBulkImport::MergeCounts counts;
+			bulk.MergeDog(dogImport, counts);
+			bulk.MergeDog(dogNew, counts);
+			REQUIRE(1 == counts.dogs);
+			REQUIRE(1 == counts.trials);
+			REQUIRE(2u == book.GetDogs().size());
+			REQUIRE(2u == dog->GetTrials().size());
+
+			// Merging again finds everything.
+			ARBBulkImport::MergeCounts again;
+			bulk.MergeDog(dogImport, again);
+			REQUIRE(0 == again.dogs);
+			REQUIRE(0 == again.trials);
+
+			bulk.Finish(true);
+			REQUIRE(L"There" == (*dog->GetTrials().begin())->GetLocation());
+			REQUIRE(2u == bulk.GetModifiedDogs().size());
+		}
+	}
+}
+
+} // namespace dconSoft
@@ -10,6 +10,9 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added FindCalendar index tests.
+ * 2026-10-19 Added iCalendar import tests.
+ * 2026-10-19 Added iCalendar feed and folding tests.
  * 2017-11-09 Convert from UnitTest++ to Catch
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2008-01-13 Created
@@ -19,6 +22,7 @@
 #include "TestLib.h"
 
 #include "ARB/ARBCalendar.h"
+#include "ARB/ARBConfig.h"
 #include "ARB/ARBStructure.h"
 #include "ARBCommon/Element.h"
 #include "ARBCommon/StringUtil.h"
@@ -487,6 +491,72 @@ TEST_CASE("CalendarList")
 	}
 
 
+	SECTION("FindIndex")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBCalendarList callist;
+			for (int i = 0; i < 20; ++i)
+			{
+				ARBCalendarPtr cal = ARBCalendar::New();
+				cal->SetStartDate(ARBDate(2006, 9, 1 + i));
+				cal->SetEndDate(ARBDate(2006, 9, 2 + i));
+				cal->SetClub(L"PASA");
+				cal->SetVenue(L"ASCA");
+				REQUIRE(callist.AddCalendar(cal));
+			}
+			ARBCalendarPtr probe = callist[5]->Clone();
+			probe->SetLocation(L"Elsewhere");
+			ARBCalendarPtr found;
+			REQUIRE(callist.FindCalendar(probe, false, &found));
+			REQUIRE(found.get() == callist[5].get());
+			REQUIRE(!callist.FindCalendar(probe, true));
+
+			// Entries added after the index was built.
+			ARBCalendarPtr cal = callist[0]->Clone();
+			cal->SetClub(L"Bay Team");
+			REQUIRE(callist.AddCalendar(cal));
+			REQUIRE(callist.FindCalendar(cal->Clone(), true, &found));
+			REQUIRE(found.get() == cal.get());
+
+			// Entries changed in place.
+			callist[5]->SetClub(L"Changed");
+			REQUIRE(!callist.FindCalendar(probe, false));
+			probe->SetClub(L"Changed");
+			REQUIRE(callist.FindCalendar(probe, false, &found));
+			REQUIRE(found.get() == callist[5].get());
+
+			// Deleted and trimmed entries.
+			REQUIRE(callist.DeleteCalendar(cal->Clone()));
+			REQUIRE(!callist.FindCalendar(cal, false));
+			REQUIRE(10 == callist.TrimEntries(ARBDate(2006, 9, 12)));
+			REQUIRE(10u == callist.size());
+			REQUIRE(!callist.FindCalendar(probe, false));
+
+			// The first match in list order wins.
+			ARBCalendarPtr dup = callist[0]->Clone();
+			dup->SetNote(L"Duplicate");
+			REQUIRE(callist.AddCalendar(dup));
+			REQUIRE(callist.FindCalendar(dup, false, &found));
+			REQUIRE(found.get() == callist[0].get());
+			REQUIRE(callist.FindCalendar(dup, true, &found));
+			REQUIRE(found.get() == dup.get());
+
+			// Cloning over a list of the same size replaces its index.
+			ARBCalendarList callist2;
+			REQUIRE(callist.size() == callist.Clone(callist2));
+			REQUIRE(callist2.FindCalendar(dup, true));
+			callist[0]->SetClub(L"Cloned");
+			REQUIRE(callist.size() == callist.Clone(callist2));
+			REQUIRE(callist2.FindCalendar(callist[0]->Clone(), true, &found));
+			REQUIRE(found.get() == callist2[0].get());
+
+			callist.clear();
+			REQUIRE(!callist.FindCalendar(dup, false));
+		}
+	}
+
+
 	SECTION("AddDelete")
 	{
 		if (!g_bMicroTest)
@@ -635,6 +705,223 @@ END:VCALENDAR";
 			REQUIRE(StripICal(str2, "UID") == k_iCal2);
 		}
 	}
+
+
+	SECTION("ICalFold")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBCalendarPtr cal = ARBCalendar::New();
+			cal->SetStartDate(ARBDate(2006, 9, 4));
+			cal->SetEndDate(ARBDate(2006, 9, 5));
+			cal->SetLocation(L"Hollister; CA");
+			wxString note;
+			for (int i = 0; i < 40; ++i)
+				note << L"caf\x00e9, ";
+			cal->SetNote(note);
+
+			std::stringstream outData;
+			ICalendarPtr iCalendar = ICalendar::iCalendarBegin(outData, 2);
+			cal->iCalendar(iCalendar, 0);
+			iCalendar.reset();
+			std::string str = outData.str();
+			REQUIRE(std::string::npos != str.find("LOCATION:Hollister\\; CA\r\n"));
+			size_t nLines = 0;
+			for (size_t pos = 0, end = str.find("\r\n"); std::string::npos != end; end = str.find("\r\n", pos))
+			{
+				// 75 octets, not counting the CRLF.
+				REQUIRE(end - pos <= 75);
+				// Folding must not split an escape or a UTF-8 character.
+				REQUIRE('\\' != str[end - 1]);
+				REQUIRE(0x80 != (static_cast<unsigned char>(str[end + 2]) & 0xc0));
+				pos = end + 2;
+				++nLines;
+			}
+			REQUIRE(15u < nLines);
+		}
+	}
+
+
+	SECTION("ICalFeed")
+	{
+		if (!g_bMicroTest)
+		{
+			std::vector<ARBCalendarPtr> entries;
+			for (int i = 0; i < 2; ++i)
+			{
+				ARBCalendarPtr cal = ARBCalendar::New();
+				cal->SetStartDate(ARBDate(2006, 9, 4 + i * 7));
+				cal->SetEndDate(ARBDate(2006, 9, 5 + i * 7));
+				cal->SetLocation(L"Hollister");
+				cal->SetClub(L"PASA");
+				cal->SetVenue(L"ASCA");
+				entries.push_back(cal);
+			}
+
+			std::string feed1;
+			REQUIRE(ICalendar::iCalendarFeed(std::string(), entries, 0, feed1));
+			REQUIRE(std::string::npos != feed1.find("X-ARB-FINGERPRINT:"));
+
+			// Nothing changed: the feed is reproduced exactly (DTSTAMP too).
+			std::string feed2;
+			REQUIRE(!ICalendar::iCalendarFeed(feed1, entries, 0, feed2));
+			REQUIRE(feed1 == feed2);
+
+			// Only the changed entry is regenerated.
+			entries[1]->SetNote(L"Changed");
+			std::string feed3;
+			REQUIRE(ICalendar::iCalendarFeed(feed1, entries, 0, feed3));
+			size_t end1 = feed1.find("END:VEVENT\r\n");
+			REQUIRE(feed1.substr(0, end1) == feed3.substr(0, end1));
+			REQUIRE(std::string::npos != feed3.find("Changed"));
+
+			// Removed entries are dropped.
+			entries.pop_back();
+			std::string feed4;
+			REQUIRE(ICalendar::iCalendarFeed(feed3, entries, 0, feed4));
+			REQUIRE(std::string::npos == feed4.find("Changed"));
+		}
+	}
+
+
+	SECTION("ICalRead")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBConfig config;
+			config.GetVenues().AddVenue(L"ASCA");
+
+			// Round trip our own export (v1 and v2).
+			ARBCalendarPtr cal = ARBCalendar::New();
+			cal->SetStartDate(ARBDate(2006, 9, 4));
+			cal->SetEndDate(ARBDate(2006, 9, 5));
+			cal->SetLocation(L"Hollister; CA");
+			cal->SetClub(L"Bay Team");
+			cal->SetVenue(L"ASCA");
+			cal->SetEntered(ARBCalendarEntry::Planning);
+			cal->SetOpeningDate(ARBDate(2006, 8, 1));
+			cal->SetNote(L"Bring a chair");
+			for (int version = 1; version <= 2; ++version)
+			{
+				std::stringstream data;
+				ICalendarPtr iCalendar = ICalendar::iCalendarBegin(data, version);
+				cal->iCalendar(iCalendar, 0);
+				iCalendar.reset();
+				std::vector<ARBCalendarPtr> events;
+				REQUIRE(1u == ICalendar::iCalendarRead(data, config, [&events](ARBCalendarPtr const& inCal) {
+							events.push_back(inCal);
+							return true;
+						}));
+				REQUIRE(ARBDate(2006, 9, 4) == events[0]->GetStartDate());
+				REQUIRE(ARBDate(2006, 9, 5) == events[0]->GetEndDate());
+				REQUIRE(L"ASCA" == events[0]->GetVenue());
+				REQUIRE(L"Bay Team" == events[0]->GetClub());
+				REQUIRE(L"Hollister; CA" == events[0]->GetLocation());
+				REQUIRE(ARBCalendarEntry::Planning == events[0]->GetEntered());
+				REQUIRE(ARBDate(2006, 8, 1) == events[0]->GetOpeningDate());
+				REQUIRE(L"Bring a chair" == events[0]->GetNote());
+			}
+
+			// Other calendars: folding, escapes, times, nested alarms.
+			std::stringstream data(
+				"BEGIN:VCALENDAR\r\n"
+				"VERSION:2.0\r\n"
+				"BEGIN:VEVENT\r\n"
+				"UID:1234@example.com\r\n"
+				"DTSTART;TZID=America/Los_Angeles:20070310T080000\r\n"
+				"DTEND;TZID=America/Los_Angeles:20070311T170000\r\n"
+				"SUMMARY:Fun\r\n"
+				" Match\r\n"
+				"DESCRIPTION:Line1\\nLine2\\, more\r\n"
+				"STATUS:TENTATIVE\r\n"
+				"BEGIN:VALARM\r\n"
+				"DESCRIPTION:Reminder\r\n"
+				"END:VALARM\r\n"
+				"END:VEVENT\r\n"
+				"BEGIN:VEVENT\r\n"
+				"DTSTART;VALUE=DATE:20070401\r\n"
+				"DURATION:P3D\r\n"
+				"SUMMARY:ASCA Bay Team\r\n"
+				"END:VEVENT\r\n"
+				"BEGIN:VEVENT\r\n"
+				"SUMMARY:No date\r\n"
+				"END:VEVENT\r\n"
+				"END:VCALENDAR\r\n");
+			std::vector<ARBCalendarPtr> events;
+			REQUIRE(2u == ICalendar::iCalendarRead(data, config, [&events](ARBCalendarPtr const& inCal) {
+						events.push_back(inCal);
+						return true;
+					}));
+			REQUIRE(ARBDate(2007, 3, 10) == events[0]->GetStartDate());
+			REQUIRE(ARBDate(2007, 3, 11) == events[0]->GetEndDate());
+			REQUIRE(L"" == events[0]->GetVenue());
+			REQUIRE(L"FunMatch" == events[0]->GetClub());
+			REQUIRE(L"Line1\nLine2, more" == events[0]->GetNote());
+			REQUIRE(events[0]->IsTentative());
+			REQUIRE(ARBDate(2007, 4, 1) == events[1]->GetStartDate());
+			REQUIRE(ARBDate(2007, 4, 3) == events[1]->GetEndDate());
+			REQUIRE(L"ASCA" == events[1]->GetVenue());
+			REQUIRE(L"Bay Team" == events[1]->GetClub());
+		}
+	}
+
+
+	SECTION("ICalImport")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBConfig config;
+			config.GetVenues().AddVenue(L"ASCA");
+			std::vector<ARBCalendarPtr> entries;
+			for (int i = 0; i < 3; ++i)
+			{
+				ARBCalendarPtr cal = ARBCalendar::New();
+				cal->SetStartDate(ARBDate(2006, 9, 4 + i * 7));
+				cal->SetEndDate(ARBDate(2006, 9, 5 + i * 7));
+				cal->SetLocation(L"Hollister");
+				cal->SetClub(L"PASA");
+				cal->SetVenue(L"ASCA");
+				entries.push_back(cal);
+			}
+			std::string feed;
+			ICalendar::iCalendarFeed(std::string(), entries, 0, feed);
+
+			ARBCalendarList callist;
+			callist.AddCalendar(entries[0]->Clone());
+			long nAdded = 0;
+			long nUpdated = 0;
+			long nDuplicate = 0;
+			long nSkipped = 0;
+			std::stringstream data(feed);
+			REQUIRE(callist.ImportICalendar(
+				data,
+				config,
+				ARBDate(2006, 9, 10),
+				nAdded,
+				nUpdated,
+				nDuplicate,
+				nSkipped));
+			REQUIRE(3u == callist.size());
+			REQUIRE(2 == nAdded);
+			REQUIRE(0 == nUpdated);
+			REQUIRE(1 == nDuplicate);
+			REQUIRE(0 == nSkipped);
+
+			// Importing again changes nothing.
+			nAdded = nUpdated = nDuplicate = nSkipped = 0;
+			std::stringstream data2(feed);
+			REQUIRE(!callist.ImportICalendar(
+				data2,
+				config,
+				ARBDate(2006, 9, 20),
+				nAdded,
+				nUpdated,
+				nDuplicate,
+				nSkipped));
+			REQUIRE(3u == callist.size());
+			REQUIRE(3 == nDuplicate);
+		}
+	}
 }
 
 } // namespace dconSoft
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added InsertRun/RepositionRun tests.
  * 2019-01-17 Add some sanity tests for GetLifetimePoints.
  * 2017-11-09 Convert from UnitTest++ to Catch
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
@@ -414,6 +415,63 @@ TEST_CASE("DogRunList")
 	}
 
 
+	SECTION("InsertRun")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBDogRunList runs;
+			ARBDogRunPtr run1 = ARBDogRun::New();
+			run1->SetDate(ARBDate(2026, 3, 1));
+			ARBDogRunPtr run2 = ARBDogRun::New();
+			run2->SetDate(ARBDate(2026, 3, 3));
+			ARBDogRunPtr run3 = ARBDogRun::New();
+			run3->SetDate(ARBDate(2026, 3, 2));
+			ARBDogRunPtr run4 = ARBDogRun::New();
+			run4->SetDate(ARBDate(2026, 3, 2));
+			REQUIRE(runs.InsertRun(run1));
+			REQUIRE(runs.InsertRun(run2));
+			REQUIRE(runs.InsertRun(run3));
+			REQUIRE(runs.InsertRun(run4));
+			REQUIRE(!runs.InsertRun(ARBDogRunPtr()));
+			REQUIRE(4u == runs.size());
+			// Same order AddRun+sort would produce.
+			REQUIRE(runs[0] == run1);
+			REQUIRE(runs[1] == run3);
+			REQUIRE(runs[2] == run4);
+			REQUIRE(runs[3] == run2);
+		}
+	}
+
+
+	SECTION("RepositionRun")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBDogRunList runs;
+			ARBDogRunPtr run1 = ARBDogRun::New();
+			run1->SetDate(ARBDate(2026, 3, 1));
+			ARBDogRunPtr run2 = ARBDogRun::New();
+			run2->SetDate(ARBDate(2026, 3, 2));
+			ARBDogRunPtr run3 = ARBDogRun::New();
+			run3->SetDate(ARBDate(2026, 3, 3));
+			runs.AddRun(run1);
+			runs.AddRun(run2);
+			runs.AddRun(run3);
+			run1->SetDate(ARBDate(2026, 3, 4));
+			REQUIRE(runs.RepositionRun(run1));
+			REQUIRE(runs[0] == run2);
+			REQUIRE(runs[1] == run3);
+			REQUIRE(runs[2] == run1);
+			// Still in order, nothing moves.
+			run3->SetDate(ARBDate(2026, 3, 2));
+			REQUIRE(runs.RepositionRun(run3));
+			REQUIRE(runs[0] == run2);
+			REQUIRE(runs[1] == run3);
+			REQUIRE(!runs.RepositionRun(ARBDogRun::New()));
+		}
+	}
+
+
 	SECTION("DeleteRun")
 	{
 		if (!g_bMicroTest)
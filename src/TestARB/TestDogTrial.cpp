@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added sorted insertion tests.
  * 2017-11-09 Convert from UnitTest++ to Catch
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2008-01-18 Created empty file
@@ -379,6 +380,54 @@ TEST_CASE("DogTrialList")
 	}
 
 
+	SECTION("AddTrialSorted")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBDogTrialList trials;
+			ARBDogTrialPtr trial1 = ARBDogTrial::New();
+			trial1->SetDefaultDate(ARBDate(2026, 3, 1));
+			ARBDogTrialPtr trial2 = ARBDogTrial::New();
+			trial2->SetDefaultDate(ARBDate(2026, 3, 8));
+			ARBDogTrialPtr trial3 = ARBDogTrial::New();
+			trial3->SetDefaultDate(ARBDate(2026, 3, 4));
+			REQUIRE(trials.AddTrial(trial1, false));
+			REQUIRE(trials.AddTrial(trial2, false));
+			REQUIRE(trials.AddTrial(trial3, false));
+			REQUIRE(3u == trials.size());
+			// Must match a full sort.
+			ARBDogTrialList sorted(trials);
+			sorted.sort(false);
+			REQUIRE(trials[0] == sorted[0]);
+			REQUIRE(trials[1] == sorted[1]);
+			REQUIRE(trials[2] == sorted[2]);
+			REQUIRE(trials[0] == trial2);
+			REQUIRE(trials[2] == trial1);
+		}
+	}
+
+
+	SECTION("RepositionTrial")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBDogTrialList trials;
+			ARBDogTrialPtr trial1 = ARBDogTrial::New();
+			trial1->SetDefaultDate(ARBDate(2026, 3, 1));
+			ARBDogTrialPtr trial2 = ARBDogTrial::New();
+			trial2->SetDefaultDate(ARBDate(2026, 3, 8));
+			trials.AddTrial(trial1, true);
+			trials.AddTrial(trial2, true);
+			REQUIRE(trials[0] == trial1);
+			trial1->SetDefaultDate(ARBDate(2026, 3, 9));
+			REQUIRE(trials.RepositionTrial(trial1, true));
+			REQUIRE(trials[0] == trial2);
+			REQUIRE(trials[1] == trial1);
+			REQUIRE(!trials.RepositionTrial(ARBDogTrial::New(), true));
+		}
+	}
+
+
 	SECTION("DeleteTrial")
 	{
 		if (!g_bMicroTest)
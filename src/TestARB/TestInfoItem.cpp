@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added SearchStrings test.
  * 2017-11-09 Convert from UnitTest++ to Catch
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2008-01-13 Created
@@ -137,6 +138,28 @@ TEST_CASE("InfoItem")
 	}
 
 
+	SECTION("SearchStrings")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBInfoItemPtr info1 = ARBInfoItem::New();
+			info1->SetName(L"A");
+			std::set<wxString> strings;
+			REQUIRE(1u == info1->GetSearchStrings(strings));
+			info1->SetComment(L"Comment");
+			REQUIRE(2u == info1->GetSearchStrings(strings));
+			REQUIRE(2u == strings.size());
+
+			size_t nVisited = 0;
+			REQUIRE(!info1->ForEachSearchString([&nVisited](wxString const& str) {
+				++nVisited;
+				return str != L"A";
+			}));
+			REQUIRE(1u == nVisited);
+		}
+	}
+
+
 	SECTION("Load")
 	{
 		if (!g_bMicroTest)
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Test ARBJson class
+ * @author David Connet
+ *
+ * Revision History
+ * 2026-10-19 Round-trip a book with dogs, trials, runs, titles and points.
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "TestLib.h"
+
+#include "ConfigHandler.h"
+#include "TestARB.h"
+
+#include "ARB/ARBAgilityRecordBook.h"
+#include "ARB/ARBJson.h"
+#include "ARBCommon/Element.h"
+#include <sstream>
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+using namespace ARB;
+using namespace ARBCommon;
+
+namespace
+{
+std::string SaveXML(ElementNodePtr const& inTree)
+{
+	std::stringstream data;
+	REQUIRE(inTree->SaveXML(data));
+	return data.str();
+}
+
+
+ElementNodePtr SaveBook(ARBAgilityRecordBook const& inBook)
+{
+	ElementNodePtr tree(ElementNode::New());
+	REQUIRE(inBook.Save(tree, L"1.0.0.0", true, true, true, true, true));
+	return tree;
+}
+
+
+ElementNodePtr RoundTrip(ElementNodePtr const& inTree)
+{
+	std::stringstream json;
+	REQUIRE(ARBJson::Save(inTree, json));
+	ElementNodePtr tree(ElementNode::New());
+	wxString errMsg;
+	REQUIRE(ARBJson::Load(tree, json, errMsg));
+	REQUIRE(errMsg.empty());
+	return tree;
+}
+
+
+bool LoadJson(char const* inData, wxString& outErrMsg)
+{
+	std::stringstream json(inData);
+	ElementNodePtr tree(ElementNode::New());
+	return ARBJson::Load(tree, json, outErrMsg);
+}
+} // namespace
+
+
+TEST_CASE("Json")
+{
+	SECTION("Escapes")
+	{
+		ElementNodePtr tree(ElementNode::New(L"Root"));
+		tree->AddAttrib(L"Quote", L"\"a\\b\"/");
+		ElementNodePtr node = tree->AddElementNode(L"Note");
+		node->SetValue(L"line1\nline2\ttab \x00e9t\x00e9 \x0001");
+		tree->AddElementNode(L"Empty");
+
+		std::stringstream json;
+		REQUIRE(ARBJson::Save(tree, json));
+		REQUIRE(
+			json.str()
+			== "{\"name\":\"Root\",\"attrib\":{\"Quote\":\"\\\"a\\\\b\\\"/\"},\"children\":["
+			   "{\"name\":\"Note\",\"value\":\"line1\\nline2\\ttab \xc3\xa9t\xc3\xa9 \\u0001\"},"
+			   "{\"name\":\"Empty\"}]}");
+
+		std::stringstream json2;
+		REQUIRE(ARBJson::Save(RoundTrip(tree), json2));
+		REQUIRE(json.str() == json2.str());
+	}
+
+
+	SECTION("Parse")
+	{
+		std::stringstream json(
+			" {\"children\" : [ {\"name\":\"a\", \"value\":\"\\u00e9\\ud83d\\ude00\\/\"} ],\n"
+			"\"unknown\":[1, {\"x\":null}, \"y\"], \"attrib\":{\"n\":42, \"b\":true}, \"name\":\"Root\"}\r\n");
+		ElementNodePtr tree(ElementNode::New());
+		wxString errMsg;
+		REQUIRE(ARBJson::Load(tree, json, errMsg));
+		REQUIRE(tree->GetName() == L"Root");
+		wxString value;
+		REQUIRE(ARBAttribLookup::Found == tree->GetAttrib(L"n", value));
+		REQUIRE(value == L"42");
+		REQUIRE(ARBAttribLookup::Found == tree->GetAttrib(L"b", value));
+		REQUIRE(value == L"true");
+		REQUIRE(1 == tree->GetElementCount());
+		REQUIRE(tree->GetElementNode(0)->GetName() == L"a");
+		REQUIRE(tree->GetElementNode(0)->GetValue() == wxString::FromUTF8("\xc3\xa9\xf0\x9f\x98\x80/"));
+	}
+
+
+	SECTION("Errors")
+	{
+		wxString errMsg;
+		REQUIRE(!LoadJson("", errMsg));
+		REQUIRE(!errMsg.empty());
+		errMsg.clear();
+		REQUIRE(!LoadJson("{\"value\":\"x\"}", errMsg));
+		REQUIRE(!errMsg.empty());
+		errMsg.clear();
+		REQUIRE(!LoadJson("{\"name\":\"x\"", errMsg));
+		REQUIRE(!errMsg.empty());
+		errMsg.clear();
+		REQUIRE(!LoadJson("{\"name\":\"x\nx\"}", errMsg));
+		REQUIRE(!errMsg.empty());
+		errMsg.clear();
+		REQUIRE(!LoadJson("{\"name\":\"x\"} {}", errMsg));
+		REQUIRE(!errMsg.empty());
+		errMsg.clear();
+		std::string deep;
+		for (int i = 0; i < 200; ++i)
+			deep += "{\"name\":\"x\",\"children\":[";
+		REQUIRE(!LoadJson(deep.c_str(), errMsg));
+		REQUIRE(!errMsg.empty());
+	}
+
+
+	SECTION("Configs")
+	{
+		if (!g_bMicroTest)
+		{
+			for (size_t i = 0; i < gc_NumConfigs; ++i)
+			{
+				ElementNodePtr tree = LoadXMLData(i);
+				REQUIRE(tree);
+				REQUIRE(SaveXML(tree) == SaveXML(RoundTrip(tree)));
+			}
+		}
+	}
+
+
+	SECTION("Book")
+	{
+		if (!g_bMicroTest)
+		{
+			CConfigHandler handler;
+			ARBAgilityRecordBook book;
+			book.Default(&handler);
+			ARBCalendarPtr cal = ARBCalendar::New();
+			cal->SetStartDate(ARBDate(2006, 9, 4));
+			cal->SetEndDate(ARBDate(2006, 9, 5));
+			cal->SetVenue(L"AKC");
+			cal->SetClub(L"Club \"Quoted\"");
+			cal->SetNote(L"Two\nlines");
+			book.GetCalendar().AddCalendar(cal);
+			ARBTrainingPtr train = ARBTraining::New();
+			train->SetDate(ARBDate(2006, 9, 1));
+			train->SetName(L"Weaves");
+			book.GetTraining().AddTraining(train);
+
+			ARBDogPtr dog = ARBDog::New();
+			dog->SetCallName(L"Wolf");
+			dog->SetRegisteredName(L"Wolf \"the\" <Dog>");
+			book.GetDogs().AddDog(dog);
+			ARBConfigTitlePtr configTitle;
+			REQUIRE(book.GetConfig().GetVenues().FindTitle(L"AKC", L"MX", &configTitle));
+			ARBDogTitlePtr title = ARBDogTitle::New();
+			title->SetDate(ARBDate(2012, 9, 2));
+			title->SetVenue(L"AKC");
+			title->SetName(L"MX", 1, configTitle);
+			dog->GetTitles().AddTitle(title);
+			ARBDogExistingPointsPtr existing = ARBDogExistingPoints::New();
+			existing->SetType(ARBExistingPointType::Title);
+			existing->SetDate(ARBDate(2012, 1, 1));
+			existing->SetVenue(L"AKC");
+			existing->SetDivision(L"Regular");
+			existing->SetLevel(L"Master");
+			existing->SetEvent(L"Standard");
+			existing->SetPoints(3);
+			existing->SetComment(L"Before\tARB");
+			dog->GetExistingPoints().AddExistingPoints(existing);
+			ARBDogTrialPtr trial = ARBDogTrial::New();
+			trial->SetLocation(L"Here");
+			ARBDogClubPtr club;
+			trial->GetClubs().AddClub(L"Club", L"AKC", &club);
+			dog->GetTrials().AddTrial(trial);
+			for (int i = 0; i < 2; ++i)
+			{
+				ARBDogRunPtr run = ARBDogRun::New();
+				run->SetDate(ARBDate(2012, 9, 1) + i);
+				run->SetClub(club);
+				run->SetDivision(L"Regular");
+				run->SetLevel(L"Master");
+				run->SetEvent(L"Standard");
+				run->SetJudge(L"O'Brien");
+				run->SetQ(0 == i ? Q::Q : Q::NQ);
+				run->GetScoring().SetType(ARBScoringType::ByTime, false);
+				run->GetScoring().SetSCT(50.0);
+				run->GetScoring().SetYards(180.0);
+				run->GetScoring().SetTime(40.12 + i);
+				run->SetNote(L"Run \x00e9\nnote");
+				trial->GetRuns().AddRun(run);
+			}
+
+			// The JSON round trip gives the same tree...
+			ElementNodePtr tree = SaveBook(book);
+			ElementNodePtr tree2 = RoundTrip(tree);
+			REQUIRE(SaveXML(tree) == SaveXML(tree2));
+
+			// ...which loads the same book as the tree saved for XML.
+			wxString errMsg;
+			ARBErrorCallback err(errMsg);
+			ARBAgilityRecordBook bookXml;
+			REQUIRE(bookXml.Load(tree, err));
+			ARBAgilityRecordBook bookJson;
+			REQUIRE(bookJson.Load(tree2, err));
+			REQUIRE(errMsg.empty());
+			REQUIRE(1u == bookJson.GetDogs().size());
+			ARBDogPtr dogJson = *bookJson.GetDogs().begin();
+			REQUIRE(1u == dogJson->GetTitles().size());
+			REQUIRE(1u == dogJson->GetExistingPoints().size());
+			REQUIRE(1u == dogJson->GetTrials().size());
+			REQUIRE(2u == (*dogJson->GetTrials().begin())->GetRuns().size());
+			REQUIRE(**bookXml.GetDogs().begin() == *dogJson);
+			REQUIRE(SaveXML(SaveBook(bookXml)) == SaveXML(SaveBook(bookJson)));
+		}
+	}
+}
+
+} // namespace dconSoft
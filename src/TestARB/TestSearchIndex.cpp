@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Test ARBSearchIndex class
+ * @author David Connet
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "TestLib.h"
+
+#include "ARB/ARBInfoItem.h"
+#include "ARB/ARBSearchIndex.h"
+#include "ARB/ARBTraining.h"
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+using namespace ARB;
+using namespace ARBCommon;
+
+namespace
+{
+ARBTrainingPtr CreateTraining(wxString const& inName, wxString const& inNote)
+{
+	ARBTrainingPtr train = ARBTraining::New();
+	train->SetDate(ARBDate(2006, 9, 4));
+	train->SetName(inName);
+	train->SetNote(inNote);
+	return train;
+}
+} // namespace
+
+
+TEST_CASE("SearchIndex")
+{
+	SECTION("Tokenize")
+	{
+		if (!g_bMicroTest)
+		{
+			std::vector<wxString> tokens;
+			ARBSearchIndex::Tokenize(L"  Hello, World-42 ", tokens);
+			REQUIRE(3u == tokens.size());
+			REQUIRE(L"hello" == tokens[0]);
+			REQUIRE(L"world" == tokens[1]);
+			REQUIRE(L"42" == tokens[2]);
+
+			ARBSearchIndex::Tokenize(L" -- ", tokens);
+			REQUIRE(tokens.empty());
+		}
+	}
+
+
+	SECTION("Find")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBTrainingPtr train1 = CreateTraining(L"Weave poles", L"Fast entry");
+			ARBTrainingPtr train2 = CreateTraining(L"Contacts", L"Running A-frame");
+			ARBSearchIndex index;
+			index.Update(train1);
+			index.Update(train2);
+			REQUIRE(2u == index.GetCount());
+
+			std::unordered_set<ARBBase const*> found;
+			// Case insensitive, anywhere in a word.
+			REQUIRE(index.Find(L"WEAV", found));
+			REQUIRE(1u == found.size());
+			REQUIRE(0 < found.count(train1.get()));
+			REQUIRE(index.Find(L"nt", found));
+			REQUIRE(2u == found.size());
+			// Multiple words: suffix, exact, prefix.
+			REQUIRE(index.Find(L"ing a-fra", found));
+			REQUIRE(1u == found.size());
+			REQUIRE(0 < found.count(train2.get()));
+			REQUIRE(index.Find(L"weave entry", found));
+			REQUIRE(1u == found.size());
+			REQUIRE(index.Find(L"xyzzy", found));
+			REQUIRE(found.empty());
+			// Nothing to look up.
+			REQUIRE(!index.Find(L" - ", found));
+		}
+	}
+
+
+	SECTION("Update")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBTrainingPtr train = CreateTraining(L"Weave poles", L"");
+			ARBSearchIndex index;
+			index.Update(train);
+			train->SetName(L"Tunnels");
+			index.Update(train);
+			REQUIRE(1u == index.GetCount());
+
+			std::unordered_set<ARBBase const*> found;
+			REQUIRE(index.Find(L"weave", found));
+			REQUIRE(found.empty());
+			REQUIRE(index.Find(L"tunnel", found));
+			REQUIRE(1u == found.size());
+
+			index.Remove(train.get());
+			REQUIRE(0u == index.GetCount());
+			REQUIRE(index.Find(L"tunnel", found));
+			REQUIRE(found.empty());
+		}
+	}
+
+
+	SECTION("InfoItem")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBInfoItemPtr item = ARBInfoItem::New();
+			item->SetName(L"Judge Smith");
+			item->SetComment(L"Likes tight courses");
+			ARBSearchIndex index;
+			index.Update(item);
+
+			std::unordered_set<ARBBase const*> found;
+			REQUIRE(index.Find(L"tight cour", found));
+			REQUIRE(1u == found.size());
+		}
+	}
+}
+
+} // namespace dconSoft
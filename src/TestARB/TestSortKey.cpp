@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Test sort key functions
+ * @author David Connet
+ *
+ * Revision History
+ * 2026-10-19 Added collation tests.
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "TestLib.h"
+
+#include "ARB/ARBSortKey.h"
+#include "ARBCommon/StringUtil.h"
+#include <stdexcept>
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+using namespace ARB;
+using namespace ARBCommon;
+
+namespace
+{
+int Sign(int val)
+{
+	return (0 < val) - (val < 0);
+}
+} // namespace
+
+
+TEST_CASE("SortKey")
+{
+	SECTION("MatchesCompareNoCase")
+	{
+		if (!g_bMicroTest)
+		{
+			// The classic locale collates by code point, like CompareNoCase.
+			wxString strs[] = {L"", L"a", L"A", L"abc", L"ABD", L"Abc ", L"b", L"Z", L"z1"};
+			for (auto const& str1 : strs)
+			{
+				for (auto const& str2 : strs)
+				{
+					REQUIRE(
+						Sign(StringUtil::CompareNoCase(str1, str2))
+						== Sign(CompareSortKey(
+							MakeSortKey(str1, std::locale::classic()),
+							MakeSortKey(str2, std::locale::classic()))));
+				}
+			}
+		}
+	}
+
+
+	SECTION("Collation")
+	{
+		if (!g_bMicroTest)
+		{
+			std::locale loc;
+			bool bHasLocale = true;
+			try
+			{
+				loc = std::locale("en_US.UTF-8");
+			}
+			catch (std::runtime_error const&)
+			{
+				bHasLocale = false; // Not installed.
+			}
+			if (bHasLocale)
+			{
+				std::wstring keyE = MakeSortKey(L"\x00c9" L"cole", loc);
+				REQUIRE(CompareSortKey(MakeSortKey(L"ecole", loc), keyE) <= 0);
+				REQUIRE(CompareSortKey(keyE, MakeSortKey(L"Ferme", loc)) < 0);
+				REQUIRE(CompareSortKey(keyE, MakeSortKey(L"zoo", loc)) < 0);
+				REQUIRE(0 == CompareSortKey(MakeSortKey(L"Abc", loc), MakeSortKey(L"aBC", loc)));
+			}
+		}
+	}
+
+
+	SECTION("SortByKey")
+	{
+		if (!g_bMicroTest)
+		{
+			std::vector<wxString> items{L"b", L"C", L"a", L"B", L"c"};
+			int nKeys = 0;
+			SortByKey(
+				items,
+				[&nKeys](wxString const& item) {
+					++nKeys;
+					return MakeSortKey(item);
+				},
+				[](std::wstring const& one, std::wstring const& two) { return CompareSortKey(one, two) < 0; });
+			REQUIRE(5 == nKeys);
+			REQUIRE(5u == items.size());
+			// Stable: "b" and "B" keep their relative order.
+			REQUIRE(items[0] == L"a");
+			REQUIRE(items[1] == L"b");
+			REQUIRE(items[2] == L"B");
+			REQUIRE(items[3] == L"C");
+			REQUIRE(items[4] == L"c");
+		}
+	}
+
+
+	SECTION("Cache")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBSortKeyCache cache;
+			int nCalls = 0;
+			auto get = [&nCalls]() {
+				++nCalls;
+				return wxString(L"Hello");
+			};
+			std::wstring key = MakeSortKey(L"hello");
+			REQUIRE(cache.Get(1, get) == key);
+			REQUIRE(cache.Get(1, get) == key);
+			REQUIRE(1 == nCalls);
+			cache.Clear();
+			REQUIRE(cache.Get(1, get) == key);
+			REQUIRE(2 == nCalls);
+		}
+	}
+}
+
+} // namespace dconSoft
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Test ARBSpreadSheetReader/Writer classes
+ * @author David Connet
+ *
+ * Revision History
+ * 2026-10-19 Read Excel and Calc fixture files.
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "TestLib.h"
+
+#include "ARB/ARBSpreadSheet.h"
+#include "LibARBWin/ResourceManager.h"
+#include <wx/mstream.h>
+#include <sstream>
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+using namespace ARB;
+using namespace ARBWin;
+
+namespace
+{
+std::vector<std::vector<wxString>> RoundTrip(ARBSpreadSheetFormat inFormat, std::vector<std::vector<wxString>> const& inData)
+{
+	wxMemoryOutputStream output;
+	{
+		ARBSpreadSheetWriter writer(inFormat, output);
+		writer.SetColumnWidths(std::vector<size_t>(3, 10));
+		for (auto const& row : inData)
+			REQUIRE(writer.AddRow(row));
+		REQUIRE(writer.Close());
+	}
+	wxMemoryInputStream input(output);
+	std::vector<std::vector<wxString>> data;
+	REQUIRE(ARBSpreadSheetReader::Read(input, data));
+	return data;
+}
+
+
+void TestRoundTrip(ARBSpreadSheetFormat inFormat)
+{
+	std::vector<std::vector<wxString>> data;
+	data.push_back({L"Date", L"Event", L"Notes"});
+	data.push_back({L"2006-09-04", L"Jumpers", L"<a> & \"b\""});
+	data.push_back({}); // Empty row in the middle
+	data.push_back({L"", L"  two  spaces ", L"line1\nline2\tend"});
+	data.push_back({L"", L"", L"\x00e9t\x00e9"});
+	REQUIRE(data == RoundTrip(inFormat, data));
+
+	// Trailing empty cells are dropped.
+	std::vector<std::vector<wxString>> trailing;
+	trailing.push_back({L"a", L"", L""});
+	std::vector<std::vector<wxString>> result = RoundTrip(inFormat, trailing);
+	REQUIRE(1u == result.size());
+	REQUIRE(1u == result[0].size());
+	REQUIRE(L"a" == result[0][0]);
+}
+
+
+// Fixtures are in res/ (see CompileDatList.txt).
+std::vector<std::vector<wxString>> ReadFixture(wchar_t const* inName)
+{
+	std::stringstream file;
+	REQUIRE(CResourceManager::Get()->LoadFile(inName, file));
+	std::string str = file.str();
+	wxMemoryInputStream input(str.data(), str.size());
+	std::vector<std::vector<wxString>> data;
+	REQUIRE(ARBSpreadSheetReader::Read(input, data));
+	return data;
+}
+
+
+// Excel and Calc: shared strings (including rich text and phonetic runs),
+// builtin and custom date formats, numbers with non-date custom formats,
+// booleans, formula strings and a missing row. The data is on the first
+// sheet of the workbook, which is not sheet1.xml.
+void TestExcelFixture(wchar_t const* inName)
+{
+	std::vector<std::vector<wxString>> data = ReadFixture(inName);
+	REQUIRE(5u == data.size());
+	REQUIRE(data[0] == std::vector<wxString>({L"Date", L"Event", L"Score", L"Notes"}));
+	REQUIRE(data[1] == std::vector<wxString>({L"2006-09-04", L"Jumpers", L"95.5", L"Clean run"}));
+	REQUIRE(data[2] == std::vector<wxString>({L"2019-02-28", L"Standard", L"100", L"TRUE"}));
+	REQUIRE(data[3].empty());
+	REQUIRE(data[4] == std::vector<wxString>({L"3.5", L"2006-09-04", L"", L"A & B <c>", L"2", L"A & B <c>!"}));
+}
+} // namespace
+
+
+TEST_CASE("SpreadSheet")
+{
+	SECTION("Xlsx")
+	{
+		if (!g_bMicroTest)
+		{
+			TestRoundTrip(ARBSpreadSheetFormat::Xlsx);
+		}
+	}
+
+
+	SECTION("Ods")
+	{
+		if (!g_bMicroTest)
+		{
+			TestRoundTrip(ARBSpreadSheetFormat::Ods);
+		}
+	}
+
+
+	SECTION("ExcelXlsx")
+	{
+		if (!g_bMicroTest)
+		{
+			TestExcelFixture(L"SpreadSheetExcel.xlsx");
+		}
+	}
+
+
+	SECTION("Excel1904")
+	{
+		if (!g_bMicroTest)
+		{
+			// Same dates as above, stored as 1904 serial numbers.
+			TestExcelFixture(L"SpreadSheetExcel1904.xlsx");
+		}
+	}
+
+
+	SECTION("CalcXlsx")
+	{
+		if (!g_bMicroTest)
+		{
+			std::vector<std::vector<wxString>> data = ReadFixture(L"SpreadSheetCalc.xlsx");
+			REQUIRE(2u == data.size());
+			REQUIRE(data[0] == std::vector<wxString>({L"Date", L"Event"}));
+			REQUIRE(data[1] == std::vector<wxString>({L"2006-09-04", L"Jumpers", L"line1\nline2"}));
+		}
+	}
+
+
+	SECTION("CalcOds")
+	{
+		if (!g_bMicroTest)
+		{
+			// Repeated columns/rows with content are expanded, the empty
+			// rows Calc pads the sheet with are not. Only the first sheet
+			// is read.
+			std::vector<std::vector<wxString>> data = ReadFixture(L"SpreadSheetCalc.ods");
+			REQUIRE(7u == data.size());
+			REQUIRE(data[0] == std::vector<wxString>({L"Date", L"Event", L"Score", L"Notes"}));
+			REQUIRE(data[1] == std::vector<wxString>({L"2006-09-04", L"Jumpers", L"95.5", L"Clean  run"}));
+			REQUIRE(data[2] == std::vector<wxString>({L"2019-02-28", L"", L"x", L"x"}));
+			REQUIRE(data[3].empty());
+			REQUIRE(data[4].empty());
+			REQUIRE(data[5] == std::vector<wxString>({L"same"}));
+			REQUIRE(data[6] == std::vector<wxString>({L"same"}));
+		}
+	}
+
+
+	SECTION("Bad")
+	{
+		if (!g_bMicroTest)
+		{
+			char const data[] = "Not a zip file";
+			wxMemoryInputStream input(data, sizeof(data));
+			std::vector<std::vector<wxString>> cells;
+			REQUIRE(!ARBSpreadSheetReader::Read(input, cells));
+			REQUIRE(cells.empty());
+		}
+	}
+
+
+	SECTION("IsSupported")
+	{
+		if (!g_bMicroTest)
+		{
+			REQUIRE(ARBSpreadSheetReader::IsSupportedFile(L"c:\\dir\\file.XLSX"));
+			REQUIRE(ARBSpreadSheetReader::IsSupportedFile(L"file.ods"));
+			REQUIRE(!ARBSpreadSheetReader::IsSupportedFile(L"file.xls"));
+			REQUIRE(!ARBSpreadSheetReader::IsSupportedFile(L"file.csv"));
+		}
+	}
+}
+
+} // namespace dconSoft
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) David Connet. All Rights Reserved.
+ *
+ * License: See License.txt
+ */
+
+/**
+ * @file
+ * @brief Test ARBSqlExport class
+ * @author David Connet
+ *
+ * Revision History
+ * 2026-10-19 Created
+ */
+
+#include "stdafx.h"
+#include "TestLib.h"
+
+#include "ConfigHandler.h"
+
+#include "ARB/ARBAgilityRecordBook.h"
+#include "ARB/ARBSqlExport.h"
+#include <sstream>
+
+#ifdef __WXMSW__
+#include <wx/msw/msvcrt.h>
+#endif
+
+
+namespace dconSoft
+{
+using namespace ARB;
+using namespace ARBCommon;
+
+namespace
+{
+size_t Count(std::string const& inData, std::string const& inFind)
+{
+	size_t n = 0;
+	for (size_t pos = inData.find(inFind); std::string::npos != pos; pos = inData.find(inFind, pos + 1))
+		++n;
+	return n;
+}
+} // namespace
+
+
+TEST_CASE("SqlExport")
+{
+	SECTION("Empty")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBAgilityRecordBook book;
+			std::stringstream sql;
+			REQUIRE(ARBSqlExport::Write(book, false, sql));
+			std::string data = sql.str();
+			REQUIRE(0 == data.find("BEGIN TRANSACTION;\n"));
+			REQUIRE(data.length() - 8 == data.rfind("COMMIT;\n"));
+			REQUIRE(1u == Count(data, "CREATE TABLE run "));
+			REQUIRE(1u == Count(data, "DROP TABLE IF EXISTS run;"));
+			REQUIRE(0u == Count(data, "INSERT INTO"));
+		}
+	}
+
+
+	SECTION("Book")
+	{
+		if (!g_bMicroTest)
+		{
+			CConfigHandler handler;
+			ARBAgilityRecordBook book;
+			book.Default(&handler);
+
+			ARBDogPtr dog = ARBDog::New();
+			dog->SetCallName(L"Dog's name");
+			book.GetDogs().AddDog(dog);
+			ARBDogTrialPtr trial = ARBDogTrial::New();
+			trial->SetLocation(L"Here");
+			ARBDogClubPtr club;
+			trial->GetClubs().AddClub(L"Club", L"AKC", &club);
+			dog->GetTrials().AddTrial(trial);
+			ARBDogRunPtr run = ARBDogRun::New();
+			run->SetDate(ARBDate(2006, 9, 4));
+			run->SetClub(club);
+			run->SetJudge(L"O'Brien");
+			run->SetQ(Q::Q);
+			trial->GetRuns().AddRun(run);
+
+			ARBCalendarPtr cal = ARBCalendar::New();
+			cal->SetStartDate(ARBDate(2006, 10, 1));
+			cal->SetEndDate(ARBDate(2006, 10, 2));
+			book.GetCalendar().AddCalendar(cal);
+			for (int i = 0; i < 501; ++i)
+			{
+				ARBTrainingPtr train = ARBTraining::New();
+				train->SetDate(ARBDate(2006, 9, 1) + i);
+				book.GetTraining().AddTraining(train);
+			}
+
+			std::stringstream sql;
+			REQUIRE(ARBSqlExport::Write(book, false, sql));
+			std::string data = sql.str();
+			REQUIRE(1u == Count(data, "INSERT INTO dog VALUES\n(1,'Dog''s name',NULL,"));
+			REQUIRE(1u == Count(data, "INSERT INTO trial VALUES\n(1,1,'2006-09-04','2006-09-04','Here',0,NULL)"));
+			REQUIRE(1u == Count(data, "INSERT INTO trial_club VALUES\n(1,'Club','AKC',NULL)"));
+			REQUIRE(1u == Count(data, "INSERT INTO run VALUES\n(1,1,1,'2006-09-04','Club','AKC',"));
+			REQUIRE(1u == Count(data, "'O''Brien',NULL,'Q',1,"));
+			REQUIRE(1u == Count(data, "INSERT INTO calendar VALUES\n(1,'2006-10-01','2006-10-02',"));
+			// Inserts are batched.
+			REQUIRE(2u == Count(data, "INSERT INTO training VALUES"));
+			REQUIRE(1u == Count(data, "INSERT INTO training VALUES\n(501,"));
+			REQUIRE(1u == Count(data, "CREATE INDEX run_judge ON run(judge);"));
+		}
+	}
+}
+
+} // namespace dconSoft
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added SearchStrings test.
  * 2017-11-09 Convert from UnitTest++ to Catch
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2008-01-13 Created
@@ -147,6 +148,38 @@ TEST_CASE("Training")
 		}
 	}
 
+
+	SECTION("SearchStrings")
+	{
+		if (!g_bMicroTest)
+		{
+			ARBTrainingPtr train = ARBTraining::New();
+			train->SetDate(ARBDate(2007, 3, 13));
+			train->SetName(L"Name");
+			train->SetNote(L"Note");
+			std::set<wxString> strings;
+			REQUIRE(3u == train->GetSearchStrings(strings));
+			REQUIRE(strings.end() != strings.find(L"3/13/2007"));
+			REQUIRE(strings.end() != strings.find(L"Name"));
+			REQUIRE(strings.end() != strings.find(L"Note"));
+
+			std::vector<wxString> visited;
+			REQUIRE(train->ForEachSearchString([&visited](wxString const& str) {
+				visited.push_back(str);
+				return true;
+			}));
+			REQUIRE(3u == visited.size());
+
+			// Stop at the first match.
+			visited.clear();
+			REQUIRE(!train->ForEachSearchString([&visited](wxString const& str) {
+				visited.push_back(str);
+				return str != L"Name";
+			}));
+			REQUIRE(2u == visited.size());
+		}
+	}
+
 	SECTION("Load")
 	{
 		if (!g_bMicroTest)
@@ -10,6 +10,9 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Find uses the document search index.
+ * 2026-10-19 Find stops at the first matching string.
+ * 2026-10-19 Sort text columns using precomputed keys.
  * 2015-04-22 Specifically use std::abs, on mac it used abs(int).
  * 2011-12-22 Switch to using Bind on wx2.9+.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
@@ -53,6 +56,7 @@
 #include "Wizard.h"
 
 #include "ARB/ARBCalendar.h"
+#include "ARB/ARBSortKey.h"
 #include "ARBCommon/Element.h"
 #include "ARBCommon/StringUtil.h"
 #include "LibARBWin/DlgFind.h"
@@ -101,12 +105,15 @@ public:
 	}
 	wxString OnNeedText(long iCol) const override;
 	void OnNeedListItem(long iCol, wxListItem& info) const override;
+	// Collation key for text columns (IO_CAL_* value, not list column).
+	std::wstring const& GetSortKey(long inColumn) const;
 
 private:
 	bool HighlightOpeningNear(long iCol) const;
 	bool HighlightClosingNear(long iCol) const;
 	CAgilityBookCalendarListView* m_pView;
 	ARBCalendarPtr m_pCal;
+	mutable ARBSortKeyCache m_SortKeys;
 };
 
 
@@ -327,6 +334,26 @@ long CAgilityBookCalendarListView::CSortColumn::LookupColumn(long iCol) const
 }
 
 
+std::wstring const& CAgilityBookCalendarListViewData::GetSortKey(long inColumn) const
+{
+	return m_SortKeys.Get(inColumn, [this, inColumn]() {
+		switch (inColumn)
+		{
+		default:
+			return wxString();
+		case IO_CAL_LOCATION:
+			return m_pCal->GetLocation();
+		case IO_CAL_CLUB:
+			return m_pCal->GetClub();
+		case IO_CAL_VENUE:
+			return m_pCal->GetVenue();
+		case IO_CAL_NOTES:
+			return m_pCal->GetNote();
+		}
+	});
+}
+
+
 struct CalListSortInfo : public SortInfo
 {
 	CAgilityBookCalendarListView* pThis;
@@ -351,7 +378,8 @@ int wxCALLBACK CompareCalendar(CListDataPtr const& item1, CListDataPtr const& it
 		= std::dynamic_pointer_cast<CAgilityBookCalendarListViewData, CListData>(item2);
 	int nRet = 0;
 	int iCol = std::abs(pInfo->nCol);
-	switch (pInfo->pThis->m_Columns[iCol - 1])
+	long column = pInfo->pThis->m_Columns[iCol - 1];
+	switch (column)
 	{
 	case IO_CAL_START_DATE:
 		if (pItem1->GetCalendar()->GetStartDate() < pItem2->GetCalendar()->GetStartDate())
@@ -366,13 +394,10 @@ int wxCALLBACK CompareCalendar(CListDataPtr const& item1, CListDataPtr const& it
 			nRet = 1;
 		break;
 	case IO_CAL_LOCATION:
-		nRet = StringUtil::CompareNoCase(pItem1->GetCalendar()->GetLocation(), pItem2->GetCalendar()->GetLocation());
-		break;
 	case IO_CAL_CLUB:
-		nRet = StringUtil::CompareNoCase(pItem1->GetCalendar()->GetClub(), pItem2->GetCalendar()->GetClub());
-		break;
 	case IO_CAL_VENUE:
-		nRet = StringUtil::CompareNoCase(pItem1->GetCalendar()->GetVenue(), pItem2->GetCalendar()->GetVenue());
+	case IO_CAL_NOTES:
+		nRet = CompareSortKey(pItem1->GetSortKey(column), pItem2->GetSortKey(column));
 		break;
 	case IO_CAL_OPENS:
 	{
@@ -408,9 +433,6 @@ int wxCALLBACK CompareCalendar(CListDataPtr const& item1, CListDataPtr const& it
 			nRet = -1;
 	}
 	break;
-	case IO_CAL_NOTES:
-		nRet = StringUtil::CompareNoCase(pItem1->GetCalendar()->GetNote(), pItem2->GetCalendar()->GetNote());
-		break;
 	default:
 		break;
 	}
@@ -443,36 +465,32 @@ bool CAgilityBookCalendarListView::CFindData::Search(CDlgFind* pDlg)
 		index = 0;
 	else if (index >= m_pView->m_Ctrl->GetItemCount() && !SearchDown())
 		index = m_pView->m_Ctrl->GetItemCount() - 1;
+	// Only items the index says may match need to be compared.
+	std::unordered_set<ARBBase const*> candidates;
+	bool bUseIndex = SearchAll() && m_pView->GetDocument()->GetSearchCandidates(Text(), candidates);
 	for (; !bFound && 0 <= index && index < m_pView->m_Ctrl->GetItemCount(); index += inc)
 	{
-		std::set<wxString> strings;
 		if (SearchAll())
 		{
 			CAgilityBookCalendarListViewDataPtr pData = m_pView->GetItemCalData(index);
-			if (pData)
-				pData->GetCalendar()->GetSearchStrings(strings);
+			if (pData && (!bUseIndex || 0 < candidates.count(pData->GetCalendar().get())))
+				bFound = !pData->GetCalendar()->ForEachSearchString([this](wxString const& str) { return !Compare(str); });
 		}
 		else
 		{
 			long nColumns = m_pView->m_Ctrl->GetColumnCount();
-			for (long i = 0; i < nColumns; ++i)
+			for (long i = 0; !bFound && i < nColumns; ++i)
 			{
 				wxListItem info;
 				info.SetId(index);
 				info.SetMask(wxLIST_MASK_TEXT);
 				info.SetColumn(i);
 				m_pView->m_Ctrl->GetItem(info);
-				strings.insert(info.GetText());
-			}
-		}
-		for (auto const& str : strings)
-		{
-			if (Compare(str))
-			{
-				m_pView->m_Ctrl->SetSelection(index, true);
-				bFound = true;
+				bFound = Compare(info.GetText());
 			}
 		}
+		if (bFound)
+			m_pView->m_Ctrl->SetSelection(index, true);
 	}
 	if (!bFound)
 	{
@@ -1173,12 +1191,13 @@ bool CAgilityBookCalendarListView::OnCmd(int id)
 			CDlgCalendar dlg(pData->GetCalendar(), GetDocument());
 			if (wxID_OK == dlg.ShowModal())
 			{
+				bool bTrimmed = false;
 				if (CAgilityBookOptions::AutoDeleteCalendarEntries()
 					&& pData->GetCalendar()->GetEndDate() < ARBDate::Today())
 				{
 					ARBDate today(ARBDate::Today());
 					today -= CAgilityBookOptions::DaysTillEntryIsPast();
-					GetDocument()->Book().GetCalendar().TrimEntries(today);
+					bTrimmed = 0 < GetDocument()->Book().GetCalendar().TrimEntries(today);
 				}
 				GetDocument()->Book().GetCalendar().sort();
 				if (oldDate != pData->GetCalendar()->GetStartDate())
@@ -1186,7 +1205,10 @@ bool CAgilityBookCalendarListView::OnCmd(int id)
 					GetDocument()->SetCalenderDate(pData->GetCalendar()->GetStartDate());
 				}
 				LoadData();
-				GetDocument()->Modify(true);
+				if (bTrimmed)
+					GetDocument()->Modify(true);
+				else
+					GetDocument()->ModifyObject(pData->GetCalendar());
 				CUpdateHint hint(UPDATE_CALENDAR_VIEW);
 				GetDocument()->UpdateAllViews(this, &hint);
 			}
@@ -10,6 +10,8 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Cache rendered pages, draw the current date on top.
+ * 2026-10-19 Index entries by day, use a sweep to hide overlapping entries.
  * 2016-09-02 Add support for scrolling on touch (or mouse drag).
  * 2013-01-01 Allow the mouse wheel to scroll beyond last entry.
  *            Add better keyboard navigation on Mac.
@@ -54,7 +56,12 @@
 #include "ARB/ARBCalendar.h"
 #include "ARBCommon/StringUtil.h"
 #include "LibARBWin/Logger.h"
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <unordered_map>
 #include <wx/dcbuffer.h>
+#include <wx/dcmemory.h>
 
 #ifdef __WXMSW__
 #include <wx/msw/msvcrt.h>
@@ -72,6 +79,162 @@ namespace
 constexpr int WEEKS_PER_PAGE = 6;
 // In dlgunits
 constexpr int DAY_TEXT_INSET = 1;
+// Rendered pages kept for scrolling back and forth.
+constexpr size_t MAX_CACHED_PAGES = 12;
+
+
+/**
+ * Pens, brushes, colors and options used to draw days, read once per page.
+ */
+struct CDayDrawInfo
+{
+	CDayDrawInfo(wxWindow* pWindow, bool inIsPrinting)
+		: bIsPrinting(inIsPrinting)
+		, bViewOpening(CAgilityBookOptions::ViewAllCalendarOpening())
+		, bViewClosing(CAgilityBookOptions::ViewAllCalendarClosing())
+		, dayTextInset(wxDLG_UNIT_X(pWindow, DAY_TEXT_INSET))
+		, today(ARBDate::Today())
+		, penFrame(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT), 1)
+		, penHilite(wxSystemSettings::GetColour(wxSYS_COLOUR_BTNHILIGHT), 1)
+		, brNull(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW), wxBRUSHSTYLE_TRANSPARENT)
+		, brHighlight(wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHT))
+		, brMenu(wxSystemSettings::GetColour(wxSYS_COLOUR_MENU))
+		, brWorkspace(wxSystemSettings::GetColour(wxSYS_COLOUR_APPWORKSPACE))
+		, clrNotEntered(CAgilityBookOptions::CalendarColor(ARBCalColorItem::NotEntered))
+		, clrPast(CAgilityBookOptions::CalendarColor(ARBCalColorItem::Past))
+		, clrPlanning(CAgilityBookOptions::CalendarColor(ARBCalColorItem::Planning))
+		, clrPending(CAgilityBookOptions::CalendarColor(ARBCalColorItem::Pending))
+		, clrEntered(CAgilityBookOptions::CalendarColor(ARBCalColorItem::Entered))
+		, clrOpening(CAgilityBookOptions::CalendarColor(ARBCalColorItem::Opening))
+		, clrClosing(CAgilityBookOptions::CalendarColor(ARBCalColorItem::Closing))
+	{
+	}
+
+	wxColour const& GetColor(ARBCalColorItem item) const
+	{
+		switch (item)
+		{
+		case ARBCalColorItem::Past:
+			return clrPast;
+		case ARBCalColorItem::Planning:
+			return clrPlanning;
+		case ARBCalColorItem::Pending:
+			return clrPending;
+		case ARBCalColorItem::Entered:
+			return clrEntered;
+		case ARBCalColorItem::Opening:
+			return clrOpening;
+		case ARBCalColorItem::Closing:
+			return clrClosing;
+		default:
+			return clrNotEntered;
+		}
+	}
+
+	bool bIsPrinting;
+	bool bViewOpening;
+	bool bViewClosing;
+	int dayTextInset;
+	ARBDate today;
+	wxPen penFrame;
+	wxPen penHilite;
+	wxBrush brNull;
+	wxBrush brHighlight;
+	wxBrush brMenu;
+	wxBrush brWorkspace;
+	// Colors for current selected date
+	wxColour clrNotEntered;
+	wxColour clrPast;
+	wxColour clrPlanning;
+	wxColour clrPending;
+	wxColour clrEntered;
+	wxColour clrOpening;
+	wxColour clrClosing;
+};
+
+
+/**
+ * Entered entries sorted by start date, for finding whether a date falls in
+ * any of them. Each prefix of the sorted list remembers the two latest end
+ * dates so an entry can be tested against every entered entry but itself.
+ */
+class CEnteredRanges
+{
+public:
+	explicit CEnteredRanges(std::vector<ARBCalendarPtr> const& inEntered)
+		: m_Starts()
+		, m_Latest()
+	{
+		struct Range
+		{
+			ARBDate start;
+			ARBDate end;
+			ARBCalendar const* pCal;
+		};
+		std::vector<Range> ranges;
+		ranges.reserve(inEntered.size());
+		for (auto const& pCal : inEntered)
+		{
+			ARBDate start = pCal->GetStartDate();
+			ARBDate end = pCal->GetEndDate();
+			if (end < start)
+				std::swap(start, end);
+			ranges.push_back({start, end, pCal.get()});
+		}
+		std::sort(ranges.begin(), ranges.end(), [](Range const& one, Range const& two) {
+			return one.start < two.start;
+		});
+
+		m_Starts.reserve(ranges.size());
+		m_Latest.reserve(ranges.size());
+		Latest latest{ARBDate(), nullptr, ARBDate(), false};
+		for (auto const& range : ranges)
+		{
+			if (!latest.pCal1 || latest.end1 < range.end)
+			{
+				if (latest.pCal1)
+				{
+					latest.end2 = latest.end1;
+					latest.bHas2 = true;
+				}
+				latest.end1 = range.end;
+				latest.pCal1 = range.pCal;
+			}
+			else if (!latest.bHas2 || latest.end2 < range.end)
+			{
+				latest.end2 = range.end;
+				latest.bHas2 = true;
+			}
+			m_Starts.push_back(range.start);
+			m_Latest.push_back(latest);
+		}
+	}
+
+	/**
+	 * Is inDate within an entered entry (other than inExclude)?
+	 */
+	bool Contains(ARBDate const& inDate, ARBCalendarPtr const& inExclude) const
+	{
+		size_t n = std::upper_bound(m_Starts.begin(), m_Starts.end(), inDate) - m_Starts.begin();
+		if (0 == n)
+			return false;
+		Latest const& latest = m_Latest[n - 1];
+		if (latest.pCal1 != inExclude.get())
+			return !(latest.end1 < inDate);
+		return latest.bHas2 && !(latest.end2 < inDate);
+	}
+
+private:
+	struct Latest
+	{
+		ARBDate end1;
+		ARBCalendar const* pCal1;
+		ARBDate end2;
+		bool bHas2;
+	};
+	std::vector<ARBDate> m_Starts;
+	std::vector<Latest> m_Latest;
+};
 } // namespace
 
 
@@ -126,8 +289,37 @@ public:
 
 	void LoadData(CAgilityBookDoc* pDoc);
 	void LoadColumns();
+	/// Discard the rendered pages (fonts, colors or options changed).
+	void ClearPages();
 
 private:
+	/// Entries, by julian day.
+	typedef std::unordered_map<long, std::vector<ARBCalendarPtr>> CalendarDays;
+	/// A page rendered without the current date, and what it shows.
+	struct CalendarPage
+	{
+		wxBitmap bitmap;
+		wxString content;
+	};
+
+	void DrawPage(wxDC* pDC, bool bIsPrinting, bool bShowCurrent);
+	void DrawDay(
+		wxDC* pDC,
+		CDayDrawInfo const& info,
+		ARBDate const& curMonth,
+		ARBDate const& day,
+		wxRect const& rect,
+		bool bCurrent);
+	void DrawCurrentDate(wxDC* pDC);
+	wxString GetEntryText(ARBCalendarPtr const& pCal) const;
+	static ARBCalColorItem GetEntryColor(
+		ARBCalendarPtr const& pCal,
+		ARBDate const& day,
+		ARBDate const& today,
+		bool bViewOpening,
+		bool bViewClosing);
+	void GetPageContent(ARBDate const& inFirstDay, wxString& outContent) const;
+
 	void GetWorkingAreas(
 #if wxCHECK_VERSION(3, 3, 0)
 		wxReadOnlyDC* pDC,
@@ -141,6 +333,7 @@ private:
 		int& outDayHeight,
 		bool bIsPrinting);
 	size_t GetEntriesOn(ARBDate const& date, std::vector<ARBCalendarPtr>& entries, bool bGetHidden) const;
+	static void AddToDays(CalendarDays& ioDays, ARBCalendarPtr const& inCal, ARBDate const& inDate);
 	wxRect GetDateRect(ARBDate const& date);
 	void GetDateFromPoint(wxPoint pt, ARBDate& date);
 
@@ -149,6 +342,13 @@ private:
 	std::vector<long> m_Columns;
 	std::vector<ARBCalendarPtr> m_Calendar;
 	std::vector<ARBCalendarPtr> m_CalendarHidden;
+	CalendarDays m_CalendarDays;
+	CalendarDays m_CalendarHiddenDays;
+	// Rendered pages, by julian day of the first day shown. They are only
+	// valid for the client size and date (past entries) they were drawn at.
+	std::map<long, CalendarPage> m_Pages;
+	wxSize m_PageSize;
+	ARBDate m_PageToday;
 	ARBDate m_First; ///< First date, adjusted to Mon of that week.
 	ARBDate m_Last;  ///< Last trial date.
 	int m_nMonths;
@@ -163,6 +363,7 @@ private:
 
 	DECLARE_EVENT_TABLE()
 	void OnPaint(wxPaintEvent& evt);
+	void OnSysColourChanged(wxSysColourChangedEvent& evt);
 	void OnSetFocus(wxFocusEvent& evt);
 	void OnKillFocus(wxFocusEvent& evt);
 };
@@ -173,6 +374,7 @@ wxIMPLEMENT_CLASS(CAgilityBookCalendar, wxWindow)
 
 wxBEGIN_EVENT_TABLE(CAgilityBookCalendar, wxWindow)
 	EVT_PAINT(CAgilityBookCalendar::OnPaint)
+	EVT_SYS_COLOUR_CHANGED(CAgilityBookCalendar::OnSysColourChanged)
 	EVT_SET_FOCUS(CAgilityBookCalendar::OnSetFocus)
 	EVT_KILL_FOCUS(CAgilityBookCalendar::OnKillFocus)
 wxEND_EVENT_TABLE()
@@ -187,6 +389,11 @@ CAgilityBookCalendar::CAgilityBookCalendar(
 	, m_Columns()
 	, m_Calendar()
 	, m_CalendarHidden()
+	, m_CalendarDays()
+	, m_CalendarHiddenDays()
+	, m_Pages()
+	, m_PageSize()
+	, m_PageToday()
 	, m_First()
 	, m_Last()
 	, m_nMonths(0)
@@ -231,34 +438,32 @@ int CAgilityBookCalendar::GetDayHeight()
 
 
 void CAgilityBookCalendar::OnDraw(wxDC* pDC)
+{
+	// If it's not a wxAutoBufferedPaintDC, then assume we're printing (preview or printer)
+	bool bIsPrinting = wxDynamicCast(pDC, wxAutoBufferedPaintDC) ? false : true;
+	DrawPage(pDC, bIsPrinting, true);
+}
+
+
+void CAgilityBookCalendar::ClearPages()
+{
+	m_Pages.clear();
+}
+
+
+void CAgilityBookCalendar::DrawPage(wxDC* pDC, bool bIsPrinting, bool bShowCurrent)
 {
 	if (m_First.IsValid() && m_Last.IsValid())
 	{
-		// If it's not a wxAutoBufferedPaintDC, then assume we're printing (preview or printer)
-		bool bIsPrinting = wxDynamicCast(pDC, wxAutoBufferedPaintDC) ? false : true;
-
-		wxPen penNull(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW), 1, wxPENSTYLE_TRANSPARENT);
-		wxPen penFrame(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT), 1);
+		CDayDrawInfo info(this, bIsPrinting);
 		wxPen penShadow(wxSystemSettings::GetColour(wxSYS_COLOUR_BTNSHADOW), 1);
-		wxPen penHilite(wxSystemSettings::GetColour(wxSYS_COLOUR_BTNHILIGHT), 1);
-		wxBrush brNull(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW), wxBRUSHSTYLE_TRANSPARENT);
 		wxBrush brBtnFace(wxSystemSettings::GetColour(wxSYS_COLOUR_BTNFACE));
-		wxBrush brHighlight(wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHT));
-		wxBrush brMenu(wxSystemSettings::GetColour(wxSYS_COLOUR_MENU));
-		wxBrush brWorkspace(wxSystemSettings::GetColour(wxSYS_COLOUR_APPWORKSPACE));
 
 		pDC->SetTextForeground(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT));
 		pDC->SetTextBackground(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW));
 		pDC->SetBackgroundMode(wxTRANSPARENT);
 
-		// Colors for current selected date
-		wxColour clrNotEntered = CAgilityBookOptions::CalendarColor(ARBCalColorItem::NotEntered);
-		wxColour clrPast = CAgilityBookOptions::CalendarColor(ARBCalColorItem::Past);
-		wxColour clrPlanning = CAgilityBookOptions::CalendarColor(ARBCalColorItem::Planning);
-		wxColour clrPending = CAgilityBookOptions::CalendarColor(ARBCalColorItem::Pending);
-		wxColour clrEntered = CAgilityBookOptions::CalendarColor(ARBCalColorItem::Entered);
-		wxColour clrOpening = CAgilityBookOptions::CalendarColor(ARBCalColorItem::Opening);
-		wxColour clrClosing = CAgilityBookOptions::CalendarColor(ARBCalColorItem::Closing);
+		ARBDayOfWeek firstDayOfWeek = CAgilityBookOptions::GetFirstDayOfWeek();
 
 		// Figure out which month we're on.
 		ARBDate curMonth = FirstDayOfVisibleMonth();
@@ -290,7 +495,7 @@ void CAgilityBookCalendar::OnDraw(wxDC* pDC)
 			pDC->SetFont(m_fontText);
 
 		// Fill the weekday area and frame
-		pDC->SetPen(penFrame);
+		pDC->SetPen(info.penFrame);
 		pDC->SetBrush(brBtnFace);
 		// Note: Rectangles work differently in wxWidgets than Windows. In
 		// Windows, drawing a rectangle does not include the lower right,
@@ -312,16 +517,16 @@ void CAgilityBookCalendar::OnDraw(wxDC* pDC)
 		{
 			{
 				// dow is now the index of the day of week.
-				int dow = (weekStart + iDay).GetDayOfWeek(CAgilityBookOptions::GetFirstDayOfWeek());
+				int dow = (weekStart + iDay).GetDayOfWeek(firstDayOfWeek);
 				// Now translate back to Sun==0
-				dow = (dow + static_cast<int>(CAgilityBookOptions::GetFirstDayOfWeek())) % 7;
+				dow = (dow + static_cast<int>(firstDayOfWeek)) % 7;
 				wxDCClipper clip(*pDC, rect);
 				pDC->DrawLabel(m_Days[dow], rect, wxALIGN_CENTRE);
 			}
 			pDC->SetPen(penShadow);
 			pDC->DrawLine(rect.GetLeft() + 1, rect.GetBottom(), rect.GetRight(), rect.GetBottom());
 			pDC->DrawLine(rect.GetRight(), rect.GetBottom(), rect.GetRight(), rect.GetTop());
-			pDC->SetPen(penHilite);
+			pDC->SetPen(info.penHilite);
 			pDC->DrawLine(rect.GetRight(), rect.GetTop(), rect.GetLeft(), rect.GetTop());
 			pDC->DrawLine(rect.GetLeft(), rect.GetTop(), rect.GetLeft(), rect.GetBottom() + 1);
 			// Offset to next day.
@@ -329,8 +534,6 @@ void CAgilityBookCalendar::OnDraw(wxDC* pDC)
 		}
 
 		// Draw the days
-		int dayTextInset = wxDLG_UNIT_X(this, DAY_TEXT_INSET);
-		ARBDate today = ARBDate::Today();
 		ARBDate day = FirstDayOfWeek(curMonth);
 		int iWeek;
 		for (iWeek = 0; iWeek < WEEKS_PER_PAGE; ++iWeek)
@@ -340,145 +543,10 @@ void CAgilityBookCalendar::OnDraw(wxDC* pDC)
 			rect.y = rCalendar.y + 1;
 			rect.height = height - 1;
 			rect.Offset(0, iWeek * height);
-			rect.Inflate(-dayTextInset, -dayTextInset);
+			rect.Inflate(-info.dayTextInset, -info.dayTextInset);
 			for (iDay = 0; iDay < 7; ++iDay)
 			{
-				// Change background of non-current month days
-				if (!bIsPrinting && m_Current == day)
-				{
-					wxRect r(rect);
-					r.Inflate(dayTextInset + 1, dayTextInset + 1); // +1 for null pen
-					if (wxWindow::DoFindFocus() == this)
-						pDC->SetBrush(brHighlight);
-					else
-						pDC->SetBrush(brMenu);
-					pDC->DrawRectangle(r);
-				}
-				else if (day.GetMonth() != curMonth.GetMonth())
-				{
-					wxRect r(rect);
-					r.Inflate(dayTextInset + 1, dayTextInset + 1);
-					pDC->SetBrush(brWorkspace);
-					pDC->DrawRectangle(r);
-				}
-
-				pDC->SetTextForeground(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT));
-				if (!bIsPrinting)
-				{
-					if (m_Current == day)
-					{
-						if (wxWindow::DoFindFocus() == this)
-							pDC->SetTextForeground(wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHTTEXT));
-						else
-							pDC->SetTextForeground(wxSystemSettings::GetColour(wxSYS_COLOUR_MENUTEXT));
-					}
-				}
-
-				// Display date (only day now, not full date)
-				// wxString str(day.GetString());
-				str.clear();
-				str << day.GetDay();
-				{
-					wxDCClipper clip(*pDC, rect);
-					pDC->DrawLabel(str, rect, wxALIGN_TOP | wxALIGN_RIGHT);
-				}
-
-				// Display entries
-				std::vector<ARBCalendarPtr> entries;
-				if (0 < GetEntriesOn(day, entries, false))
-				{
-					wxRect r(rect);
-					for (std::vector<ARBCalendarPtr>::iterator iter = entries.begin(); iter != entries.end(); ++iter)
-					{
-						r.y += pDC->GetCharHeight();
-						r.height -= pDC->GetCharHeight();
-
-						ARBCalendarPtr pCal = (*iter);
-						str.clear();
-						for (size_t iCol = 0; iCol < m_Columns.size(); ++iCol)
-						{
-							if (0 < iCol)
-								str += L" ";
-							switch (m_Columns[iCol])
-							{
-							case IO_CAL_LOCATION:
-								if (pCal->GetLocation().empty())
-									str += L"?";
-								else
-									str += pCal->GetLocation();
-								break;
-							case IO_CAL_CLUB:
-								if (pCal->GetClub().empty())
-									str += L"?";
-								else
-									str += pCal->GetClub();
-								break;
-							case IO_CAL_VENUE:
-								if (pCal->GetVenue().empty())
-									str += L"?";
-								else
-									str += pCal->GetVenue();
-								break;
-							case IO_CAL_NOTES:
-								if (pCal->GetNote().empty())
-									str += L"?";
-								else
-									str += pCal->GetNote();
-								break;
-							default:
-								break;
-							}
-						}
-						bool bReset = false;
-						wxColour oldText = pDC->GetTextForeground();
-						// Don't change the color on the selected day.
-						// (That whole foreground/background thing)
-						if (m_Current != day)
-						{
-							if (CAgilityBookOptions::ViewAllCalendarOpening() && pCal->GetOpeningDate() == day)
-							{
-								bReset = true;
-								pDC->SetTextForeground(clrOpening);
-							}
-							else if (CAgilityBookOptions::ViewAllCalendarClosing() && pCal->GetClosingDate() == day)
-							{
-								bReset = true;
-								pDC->SetTextForeground(clrClosing);
-							}
-							else if (pCal->IsBefore(today))
-							{
-								bReset = true;
-								pDC->SetTextForeground(clrPast);
-							}
-							else
-							{
-								switch (pCal->GetEntered())
-								{
-								case ARBCalendarEntry::Not:
-									bReset = true;
-									pDC->SetTextForeground(clrNotEntered);
-									break;
-								case ARBCalendarEntry::Planning:
-									bReset = true;
-									pDC->SetTextForeground(clrPlanning);
-									break;
-								case ARBCalendarEntry::Pending:
-									bReset = true;
-									pDC->SetTextForeground(clrPending);
-									break;
-								case ARBCalendarEntry::Entered:
-									bReset = true;
-									pDC->SetTextForeground(clrEntered);
-									break;
-								}
-							}
-						}
-						wxDCClipper clip(*pDC, r);
-						pDC->DrawLabel(str, r, wxALIGN_LEFT);
-						if (bReset)
-							pDC->SetTextForeground(oldText);
-					}
-				}
+				DrawDay(pDC, info, curMonth, day, rect, bShowCurrent && m_Current == day);
 
 				// Get ready for next round
 				rect.Offset(width, 0);
@@ -487,8 +555,8 @@ void CAgilityBookCalendar::OnDraw(wxDC* pDC)
 		}
 
 		// Now draw all frames (do this last so the print preview looks ok)
-		pDC->SetPen(penFrame);
-		pDC->SetBrush(brNull);
+		pDC->SetPen(info.penFrame);
+		pDC->SetBrush(info.brNull);
 		pDC->DrawRectangle(rCalendar);
 		// Vertical lines
 		for (iDay = 1; iDay < 7; ++iDay)
@@ -512,6 +580,201 @@ void CAgilityBookCalendar::OnDraw(wxDC* pDC)
 }
 
 
+void CAgilityBookCalendar::DrawDay(
+	wxDC* pDC,
+	CDayDrawInfo const& info,
+	ARBDate const& curMonth,
+	ARBDate const& day,
+	wxRect const& rect,
+	bool bCurrent)
+{
+	// Change background of non-current month days
+	if (!info.bIsPrinting && bCurrent)
+	{
+		wxRect r(rect);
+		r.Inflate(info.dayTextInset + 1, info.dayTextInset + 1); // +1 for null pen
+		if (wxWindow::DoFindFocus() == this)
+			pDC->SetBrush(info.brHighlight);
+		else
+			pDC->SetBrush(info.brMenu);
+		pDC->DrawRectangle(r);
+	}
+	else if (day.GetMonth() != curMonth.GetMonth())
+	{
+		wxRect r(rect);
+		r.Inflate(info.dayTextInset + 1, info.dayTextInset + 1);
+		pDC->SetBrush(info.brWorkspace);
+		pDC->DrawRectangle(r);
+	}
+
+	pDC->SetTextForeground(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOWTEXT));
+	if (!info.bIsPrinting)
+	{
+		if (bCurrent)
+		{
+			if (wxWindow::DoFindFocus() == this)
+				pDC->SetTextForeground(wxSystemSettings::GetColour(wxSYS_COLOUR_HIGHLIGHTTEXT));
+			else
+				pDC->SetTextForeground(wxSystemSettings::GetColour(wxSYS_COLOUR_MENUTEXT));
+		}
+	}
+
+	// Display date (only day now, not full date)
+	// wxString str(day.GetString());
+	wxString str;
+	str << day.GetDay();
+	{
+		wxDCClipper clip(*pDC, rect);
+		pDC->DrawLabel(str, rect, wxALIGN_TOP | wxALIGN_RIGHT);
+	}
+
+	// Display entries
+	std::vector<ARBCalendarPtr> entries;
+	if (0 < GetEntriesOn(day, entries, false))
+	{
+		wxRect r(rect);
+		for (std::vector<ARBCalendarPtr>::iterator iter = entries.begin(); iter != entries.end(); ++iter)
+		{
+			r.y += pDC->GetCharHeight();
+			r.height -= pDC->GetCharHeight();
+
+			ARBCalendarPtr pCal = (*iter);
+			wxColour oldText = pDC->GetTextForeground();
+			// Don't change the color on the selected day.
+			// (That whole foreground/background thing)
+			if (!bCurrent)
+			{
+				ARBCalColorItem item = GetEntryColor(pCal, day, info.today, info.bViewOpening, info.bViewClosing);
+				pDC->SetTextForeground(info.GetColor(item));
+			}
+			wxDCClipper clip(*pDC, r);
+			pDC->DrawLabel(GetEntryText(pCal), r, wxALIGN_LEFT);
+			if (!bCurrent)
+				pDC->SetTextForeground(oldText);
+		}
+	}
+}
+
+
+void CAgilityBookCalendar::DrawCurrentDate(wxDC* pDC)
+{
+	wxRect rDate = GetDateRect(m_Current);
+	if (rDate.IsEmpty())
+		return;
+
+	CDayDrawInfo info(this, false);
+	ARBDate curMonth = LastDayOfWeek(FirstDayOfVisibleMonth());
+	pDC->SetFont(m_fontText);
+	pDC->SetBackgroundMode(wxTRANSPARENT);
+	// This is the pen DrawPage has selected when it draws the days.
+	pDC->SetPen(info.penHilite);
+	wxRect rect(rDate);
+	rect.Inflate(-info.dayTextInset, -info.dayTextInset);
+	DrawDay(pDC, info, curMonth, m_Current, rect, true);
+
+	// The highlight covers the frame, put it back.
+	rDate.Inflate(1, 1);
+	pDC->SetPen(info.penFrame);
+	pDC->SetBrush(info.brNull);
+	pDC->DrawRectangle(rDate);
+
+	pDC->SetFont(wxNullFont);
+	pDC->SetPen(wxNullPen);
+	pDC->SetBrush(wxNullBrush);
+}
+
+
+wxString CAgilityBookCalendar::GetEntryText(ARBCalendarPtr const& pCal) const
+{
+	wxString str;
+	for (size_t iCol = 0; iCol < m_Columns.size(); ++iCol)
+	{
+		if (0 < iCol)
+			str += L" ";
+		switch (m_Columns[iCol])
+		{
+		case IO_CAL_LOCATION:
+			if (pCal->GetLocation().empty())
+				str += L"?";
+			else
+				str += pCal->GetLocation();
+			break;
+		case IO_CAL_CLUB:
+			if (pCal->GetClub().empty())
+				str += L"?";
+			else
+				str += pCal->GetClub();
+			break;
+		case IO_CAL_VENUE:
+			if (pCal->GetVenue().empty())
+				str += L"?";
+			else
+				str += pCal->GetVenue();
+			break;
+		case IO_CAL_NOTES:
+			if (pCal->GetNote().empty())
+				str += L"?";
+			else
+				str += pCal->GetNote();
+			break;
+		default:
+			break;
+		}
+	}
+	return str;
+}
+
+
+ARBCalColorItem CAgilityBookCalendar::GetEntryColor(
+	ARBCalendarPtr const& pCal,
+	ARBDate const& day,
+	ARBDate const& today,
+	bool bViewOpening,
+	bool bViewClosing)
+{
+	if (bViewOpening && pCal->GetOpeningDate() == day)
+		return ARBCalColorItem::Opening;
+	else if (bViewClosing && pCal->GetClosingDate() == day)
+		return ARBCalColorItem::Closing;
+	else if (pCal->IsBefore(today))
+		return ARBCalColorItem::Past;
+	switch (pCal->GetEntered())
+	{
+	case ARBCalendarEntry::Not:
+		break;
+	case ARBCalendarEntry::Planning:
+		return ARBCalColorItem::Planning;
+	case ARBCalendarEntry::Pending:
+		return ARBCalColorItem::Pending;
+	case ARBCalendarEntry::Entered:
+		return ARBCalColorItem::Entered;
+	}
+	return ARBCalColorItem::NotEntered;
+}
+
+
+void CAgilityBookCalendar::GetPageContent(ARBDate const& inFirstDay, wxString& outContent) const
+{
+	outContent.clear();
+	ARBDate today = ARBDate::Today();
+	bool bViewOpening = CAgilityBookOptions::ViewAllCalendarOpening();
+	bool bViewClosing = CAgilityBookOptions::ViewAllCalendarClosing();
+	std::vector<ARBCalendarPtr> entries;
+	ARBDate day(inFirstDay);
+	for (int iDay = 0; iDay < WEEKS_PER_PAGE * 7; ++iDay, ++day)
+	{
+		if (0 == GetEntriesOn(day, entries, false))
+			continue;
+		outContent << iDay << L':';
+		for (auto const& pCal : entries)
+		{
+			outContent << static_cast<int>(GetEntryColor(pCal, day, today, bViewOpening, bViewClosing)) << L':'
+					   << GetEntryText(pCal) << L'\n';
+		}
+	}
+}
+
+
 ARBDate CAgilityBookCalendar::FirstDayOfWeek(ARBDate const& inDate) const
 {
 	ARBDate date(inDate);
@@ -870,6 +1133,8 @@ void CAgilityBookCalendar::LoadData(CAgilityBookDoc* pDoc)
 	// Clear everything.
 	m_Calendar.clear();
 	m_CalendarHidden.clear();
+	m_CalendarDays.clear();
+	m_CalendarHiddenDays.clear();
 	m_Last = ARBDate::Today();
 	m_First = ARBDate::Today();
 	LoadColumns();
@@ -878,12 +1143,15 @@ void CAgilityBookCalendar::LoadData(CAgilityBookDoc* pDoc)
 	today -= CAgilityBookOptions::DaysTillEntryIsPast();
 	bool bViewAll = CAgilityBookOptions::ViewAllCalendarEntries();
 	bool bHide = CAgilityBookOptions::HideOverlappingCalendarEntries();
+	bool bViewOpening = CAgilityBookOptions::ViewAllCalendarOpening();
+	bool bViewClosing = CAgilityBookOptions::ViewAllCalendarClosing();
 	CCalendarViewFilter filter = CFilterOptions::Options().FilterCalendarView();
 
 	// Add items.
 	std::vector<ARBCalendarPtr> entered;
 	if (bHide)
 		pDoc->Book().GetCalendar().GetAllEntered(entered);
+	CEnteredRanges enteredRanges(entered);
 	for (ARBCalendarList::iterator iter = pDoc->Book().GetCalendar().begin(); iter != pDoc->Book().GetCalendar().end();
 		 ++iter)
 	{
@@ -896,21 +1164,18 @@ void CAgilityBookCalendar::LoadData(CAgilityBookDoc* pDoc)
 			if (pCal->IsBefore(today))
 				bSuppress = true;
 		}
+		// Same as IsRangeOverlapped against each entered entry.
 		if (!bSuppress && bHide)
 		{
-			for (std::vector<ARBCalendarPtr>::const_iterator iterE = entered.begin();
-				 !bSuppress && iterE != entered.end();
-				 ++iterE)
-			{
-				ARBCalendarPtr pEntered = (*iterE);
-				if (pCal != pEntered && pCal->IsRangeOverlapped(pEntered->GetStartDate(), pEntered->GetEndDate()))
-				{
-					bSuppress = true;
-				}
-			}
+			if (enteredRanges.Contains(pCal->GetStartDate(), pCal) || enteredRanges.Contains(pCal->GetEndDate(), pCal))
+				bSuppress = true;
 		}
 		if (bSuppress)
+		{
 			m_CalendarHidden.push_back(pCal);
+			for (ARBDate day = pCal->GetStartDate(); day.IsValid() && !(pCal->GetEndDate() < day); ++day)
+				AddToDays(m_CalendarHiddenDays, pCal, day);
+		}
 		else
 		{
 			bool bAdd = false;
@@ -923,7 +1188,7 @@ void CAgilityBookCalendar::LoadData(CAgilityBookDoc* pDoc)
 			}
 			if (ARBCalendarEntry::Planning == pCal->GetEntered() && filter.ViewPlanning())
 			{
-				if (CAgilityBookOptions::ViewAllCalendarOpening() && pCal->GetOpeningDate().IsValid())
+				if (bViewOpening && pCal->GetOpeningDate().IsValid())
 				{
 					bAdd = true;
 					if (!f.IsValid() || pCal->GetOpeningDate() < f)
@@ -931,7 +1196,7 @@ void CAgilityBookCalendar::LoadData(CAgilityBookDoc* pDoc)
 					if (!l.IsValid() || pCal->GetOpeningDate() > l)
 						l = pCal->GetOpeningDate();
 				}
-				if (CAgilityBookOptions::ViewAllCalendarClosing() && pCal->GetClosingDate().IsValid())
+				if (bViewClosing && pCal->GetClosingDate().IsValid())
 				{
 					bAdd = true;
 					if (!f.IsValid() || pCal->GetClosingDate() < f)
@@ -945,7 +1210,29 @@ void CAgilityBookCalendar::LoadData(CAgilityBookDoc* pDoc)
 			if (l.IsValid() && (!m_Last.IsValid() || l > m_Last))
 				m_Last = l;
 			if (bAdd)
+			{
 				m_Calendar.push_back(pCal);
+				bool bInRange = (ARBCalendarEntry::Not == pCal->GetEntered() && filter.ViewNotEntered())
+								|| (ARBCalendarEntry::Planning == pCal->GetEntered() && filter.ViewPlanning())
+								|| ((ARBCalendarEntry::Pending == pCal->GetEntered()
+									 || ARBCalendarEntry::Entered == pCal->GetEntered())
+									&& filter.ViewEntered());
+				if (bInRange)
+				{
+					for (ARBDate day = pCal->GetStartDate(); day.IsValid() && !(pCal->GetEndDate() < day); ++day)
+						AddToDays(m_CalendarDays, pCal, day);
+				}
+				// Only show opening/closing dates if we're planning on entering
+				if (ARBCalendarEntry::Planning == pCal->GetEntered() && filter.ViewPlanning())
+				{
+					if (bViewOpening && pCal->GetOpeningDate().IsValid()
+						&& !(bInRange && pCal->InRange(pCal->GetOpeningDate())))
+						AddToDays(m_CalendarDays, pCal, pCal->GetOpeningDate());
+					if (bViewClosing && pCal->GetClosingDate().IsValid()
+						&& !(bInRange && pCal->InRange(pCal->GetClosingDate())))
+						AddToDays(m_CalendarDays, pCal, pCal->GetClosingDate());
+				}
+			}
 		}
 	}
 	if (!m_Current.IsValid() || m_Current < m_First)
@@ -971,6 +1258,19 @@ void CAgilityBookCalendar::LoadData(CAgilityBookDoc* pDoc)
 	fontInfo.size *= 3;
 	fontInfo.CreateFont(m_fontMonth);
 
+	// Only pages whose entries changed need to be drawn again.
+	for (auto iterPage = m_Pages.begin(); iterPage != m_Pages.end();)
+	{
+		ARBDate firstDay;
+		firstDay.SetJulianDay(iterPage->first);
+		wxString content;
+		GetPageContent(firstDay, content);
+		if (content == iterPage->second.content)
+			++iterPage;
+		else
+			iterPage = m_Pages.erase(iterPage);
+	}
+
 	// Make sure the current date is visible.
 	ARBDate date(m_Current);
 	m_Current.clear();
@@ -1082,40 +1382,28 @@ size_t CAgilityBookCalendar::GetEntriesOn(ARBDate const& date, std::vector<ARBCa
 	const
 {
 	entries.clear();
-	CCalendarViewFilter filter = CFilterOptions::Options().FilterCalendarView();
-	for (std::vector<ARBCalendarPtr>::const_iterator iter = m_Calendar.begin(); iter != m_Calendar.end(); ++iter)
-	{
-		ARBCalendarPtr pCal = *iter;
-		if (pCal->InRange(date)
-			&& ((ARBCalendarEntry::Not == pCal->GetEntered() && filter.ViewNotEntered())
-				|| (ARBCalendarEntry::Planning == pCal->GetEntered() && filter.ViewPlanning())
-				|| ((ARBCalendarEntry::Pending == pCal->GetEntered() || ARBCalendarEntry::Entered == pCal->GetEntered())
-					&& filter.ViewEntered())))
-		{
-			entries.push_back((*iter));
-		}
-		// Only show opening/closing dates if we're planning on entering
-		else if (ARBCalendarEntry::Planning == pCal->GetEntered() && filter.ViewPlanning())
-		{
-			if ((CAgilityBookOptions::ViewAllCalendarOpening() && pCal->GetOpeningDate() == date)
-				|| (CAgilityBookOptions::ViewAllCalendarClosing() && pCal->GetClosingDate() == date))
-				entries.push_back((*iter));
-		}
-	}
+	auto iter = m_CalendarDays.find(date.GetJulianDay());
+	if (iter != m_CalendarDays.end())
+		entries = iter->second;
 	if (bGetHidden)
 	{
-		for (std::vector<ARBCalendarPtr>::const_iterator iter = m_CalendarHidden.begin();
-			 iter != m_CalendarHidden.end();
-			 ++iter)
-		{
-			if ((*iter)->InRange(date))
-				entries.push_back((*iter));
-		}
+		iter = m_CalendarHiddenDays.find(date.GetJulianDay());
+		if (iter != m_CalendarHiddenDays.end())
+			entries.insert(entries.end(), iter->second.begin(), iter->second.end());
 	}
 	return entries.size();
 }
 
 
+void CAgilityBookCalendar::AddToDays(CalendarDays& ioDays, ARBCalendarPtr const& inCal, ARBDate const& inDate)
+{
+	std::vector<ARBCalendarPtr>& entries = ioDays[inDate.GetJulianDay()];
+	// The opening and closing dates may be the same day.
+	if (entries.empty() || entries.back() != inCal)
+		entries.push_back(inCal);
+}
+
+
 /**
  * Returns the working rect for a date. Borders are handled entirely separately.
  * Note, this is used ONLY on the UI side, not while printing.
@@ -1183,7 +1471,51 @@ void CAgilityBookCalendar::OnPaint(wxPaintEvent& evt)
 	PrepareDC(dc);
 	dc.SetBackground(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW));
 	dc.Clear();
-	OnDraw(&dc);
+	wxSize sz = GetClientSize();
+	if (!m_First.IsValid() || !m_Last.IsValid() || 0 >= sz.x || 0 >= sz.y)
+		return;
+
+	if (sz != m_PageSize || ARBDate::Today() != m_PageToday)
+	{
+		m_Pages.clear();
+		m_PageSize = sz;
+		m_PageToday = ARBDate::Today();
+	}
+
+	ARBDate firstDay = FirstDayOfVisibleMonth();
+	long key = firstDay.GetJulianDay();
+	auto iterPage = m_Pages.find(key);
+	if (iterPage == m_Pages.end())
+	{
+		// Make room by dropping the page furthest from this one.
+		if (m_Pages.size() >= MAX_CACHED_PAGES)
+		{
+			auto iterFar = m_Pages.begin();
+			if (key - iterFar->first < m_Pages.rbegin()->first - key)
+				iterFar = std::prev(m_Pages.end());
+			m_Pages.erase(iterFar);
+		}
+		CalendarPage page;
+		page.bitmap.Create(sz.x, sz.y, dc);
+		{
+			wxMemoryDC dcPage(page.bitmap);
+			dcPage.SetBackground(wxSystemSettings::GetColour(wxSYS_COLOUR_WINDOW));
+			dcPage.Clear();
+			DrawPage(&dcPage, false, false);
+		}
+		GetPageContent(firstDay, page.content);
+		iterPage = m_Pages.insert(std::make_pair(key, page)).first;
+	}
+	dc.DrawBitmap(iterPage->second.bitmap, 0, 0);
+	DrawCurrentDate(&dc);
+}
+
+
+void CAgilityBookCalendar::OnSysColourChanged(wxSysColourChangedEvent& evt)
+{
+	ClearPages();
+	Refresh();
+	evt.Skip();
 }
 
 
@@ -1398,10 +1730,14 @@ void CAgilityBookCalendarView::OnUpdate(wxView* sender, wxObject* inHint)
 		hint = wxDynamicCast(inHint, CUpdateHint);
 	if (!hint || hint->IsSet(UPDATE_CALENDAR_VIEW) || hint->IsEqual(UPDATE_OPTIONS))
 	{
+		// Options may change fonts and colors, not just entries.
+		if (!hint || hint->IsEqual(UPDATE_OPTIONS))
+			m_Ctrl->ClearPages();
 		LoadData();
 	}
 	else if (hint && (hint->IsEqual(UPDATE_CUSTOMIZE) || hint->IsEqual(UPDATE_LANG_CHANGE)))
 	{
+		m_Ctrl->ClearPages();
 		m_Ctrl->LoadColumns();
 	}
 }
@@ -10,6 +10,17 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Optionally write an SQL copy of the book on save.
+ * 2026-10-19 Calendar merges report whether anything changed.
+ * 2026-10-19 Added iCalendar import.
+ * 2026-10-19 Merge imported run data in bulk.
+ * 2026-10-19 Send the edited objects when a trial/run edit was in place.
+ * 2026-10-19 Cache the visibility of each named filter.
+ * 2026-10-19 Only reset the visibility affected by a filter change.
+ * 2026-10-19 Visibility uses the compiled venue filter.
+ * 2026-10-19 Added search index, built during idle time.
+ * 2026-10-19 Find stops at the first matching string.
+ * 2026-10-19 Keep trials/runs sorted on edit instead of resorting.
  * 2023-12-12 Fix wrong view being set current on filter change.
  * 2019-12-26 Fixed file size in properties for new file.
  * 2018-09-15 Refactored how tree/list handle common actions.
@@ -98,6 +109,8 @@
 #include "VersionNumber.h"
 #include "Wizard.h"
 
+#include "ARB/ARBBulkImport.h"
+#include "ARB/ARBSqlExport.h"
 #include "ARBCommon/ARBMsgDigest.h"
 #include "ARBCommon/Element.h"
 #include "ARBCommon/StringUtil.h"
@@ -107,8 +120,11 @@
 #include <wx/config.h>
 #include <wx/file.h>
 #include <wx/filefn.h>
+#include <wx/filename.h>
+#include <wx/stdstream.h>
 #include <wx/wfstream.h>
 #include <algorithm>
+#include <iterator>
 
 #ifdef __WXMSW__
 #include <wx/msw/msvcrt.h>
@@ -174,6 +190,34 @@ void UpdateFutureTrials(ARBConfig const& config, ARBDogPtr const& inDog, ARBDogT
 		*/
 	}
 }
+
+
+// Where a trial and its runs are in the tree and lists, and whether they
+// show. If this is the same before and after an edit, the edit was in place.
+class CTrialLayout
+{
+public:
+	CTrialLayout(ARBDogPtr const& inDog, ARBDogTrialPtr const& inTrial)
+		: m_Index(std::distance(
+			inDog->GetTrials().begin(),
+			std::find(inDog->GetTrials().begin(), inDog->GetTrials().end(), inTrial)))
+		, m_bFiltered(inTrial->IsFiltered())
+		, m_Runs()
+	{
+		for (auto const& pRun : inTrial->GetRuns())
+			m_Runs.push_back(std::make_pair(pRun.get(), pRun->IsFiltered()));
+	}
+
+	bool operator==(CTrialLayout const& rhs) const
+	{
+		return m_Index == rhs.m_Index && m_bFiltered == rhs.m_bFiltered && m_Runs == rhs.m_Runs;
+	}
+
+private:
+	std::ptrdiff_t m_Index;
+	bool m_bFiltered;
+	std::vector<std::pair<ARBDogRun const*, bool>> m_Runs;
+};
 } // namespace
 
 /////////////////////////////////////////////////////////////////////////////
@@ -238,12 +282,21 @@ CAgilityBookDoc::CAgilityBookDoc()
 	: m_Records()
 	, m_StatusData(nullptr)
 	, m_pCurrentDog()
+	, m_SearchIndexState(SearchIndexState::Stale)
+	, m_SearchIndex()
+	, m_SearchIndexPending()
+	, m_visibleFilter()
+	, m_bVisibleHiddenTitles(false)
+	, m_visibilityObjects()
+	, m_visibilityCache()
 {
+	wxGetApp().Bind(wxEVT_IDLE, &CAgilityBookDoc::OnIdle, this);
 }
 
 
 CAgilityBookDoc::~CAgilityBookDoc()
 {
+	wxGetApp().Unbind(wxEVT_IDLE, &CAgilityBookDoc::OnIdle, this);
 }
 
 
@@ -492,8 +545,7 @@ bool CAgilityBookDoc::AddTitle(ARBDogPtr const& inDog)
 		CDlgTitle dlgTitle(Book().GetConfig(), inDog->GetTitles(), ARBDogTitlePtr());
 		if (wxID_OK == dlgTitle.ShowModal())
 		{
-			std::vector<CVenueFilter> venues;
-			CFilterOptions::Options().GetFilterVenue(venues);
+			CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 			ResetVisibility(venues, dlgTitle.GetNewTitle());
 			UpdateFutureTrials(Book().GetConfig(), inDog, dlgTitle.GetNewTitle());
 			CUpdateHint hint(UPDATE_POINTS_VIEW);
@@ -522,14 +574,17 @@ bool CAgilityBookDoc::EditTrial(ARBDogPtr const& inDog, ARBDogTrialPtr const& in
 		pTrial = ARBDogTrialPtr(ARBDogTrial::New());
 	}
 	bool bOk = false;
+	bool bInPlace = false;
+	std::unique_ptr<CTrialLayout> layout;
+	if (!bAdd)
+		layout = std::make_unique<CTrialLayout>(inDog, pTrial);
 	CDlgTrial dlg(this, pTrial, wxGetApp().GetTopWindow());
 	if (wxID_OK == dlg.ShowModal())
 	{
 		CAgilityBookTreeView* pTree = GetTreeView();
 		assert(pTree);
 		bOk = true;
-		std::vector<CVenueFilter> venues;
-		CFilterOptions::Options().GetFilterVenue(venues);
+		CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 		if (bAdd)
 		{
 			if (!inDog->GetTrials().AddTrial(pTrial, !CAgilityBookOptions::GetNewestDatesFirst()))
@@ -563,8 +618,9 @@ bool CAgilityBookDoc::EditTrial(ARBDogPtr const& inDog, ARBDogTrialPtr const& in
 		}
 		else
 		{
-			inDog->GetTrials().sort(!CAgilityBookOptions::GetNewestDatesFirst());
+			inDog->GetTrials().RepositionTrial(pTrial, !CAgilityBookOptions::GetNewestDatesFirst());
 			ResetVisibility(venues, pTrial);
+			bInPlace = (*layout == CTrialLayout(inDog, pTrial));
 			CAgilityBookTreeData* pTrialData = pTree->FindData(pTrial);
 			if (pTrialData)
 				pTree->RefreshItem(pTrialData->GetId());
@@ -576,7 +632,12 @@ bool CAgilityBookDoc::EditTrial(ARBDogPtr const& inDog, ARBDogTrialPtr const& in
 		}
 		// We have to update the tree even when we add above as it may have
 		// caused the trial to be reordered.
-		if (bOk)
+		if (bInPlace)
+		{
+			CUpdateHint hint(UPDATE_POINTS_VIEW | UPDATE_RUNS_VIEW | UPDATE_TREE_VIEW, UpdateChange::Trial, {pTrial});
+			UpdateAllViews(nullptr, &hint);
+		}
+		else if (bOk)
 		{
 			CUpdateHint hint(UPDATE_POINTS_VIEW | UPDATE_RUNS_VIEW | UPDATE_TREE_VIEW);
 			UpdateAllViews(nullptr, &hint);
@@ -646,15 +707,16 @@ bool CAgilityBookDoc::EditRun(ARBDogPtr const& inDog, ARBDogTrialPtr const& inTr
 			date.SetToday();
 		pRun->SetDate(date);
 	}
+	bool bInPlace = false;
+	CTrialLayout layout(inDog, inTrial);
 	CDlgRun dlg(this, inDog, inTrial, pRun);
 	if (wxID_OK == dlg.ShowModal())
 	{
 		bOk = true;
-		std::vector<CVenueFilter> venues;
-		CFilterOptions::Options().GetFilterVenue(venues);
+		CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 		if (bAdd)
 		{
-			if (!inTrial->GetRuns().AddRun(pRun))
+			if (!inTrial->GetRuns().InsertRun(pRun))
 			{
 				bOk = false;
 				wxMessageBox(_("IDS_CREATERUN_FAILED"), _("Agility Record Book"), wxOK | wxCENTRE | wxICON_STOP);
@@ -665,8 +727,7 @@ bool CAgilityBookDoc::EditRun(ARBDogPtr const& inDog, ARBDogTrialPtr const& inTr
 				// The edit dialog does it in OnOK, but we don't add the run
 				// until after the dialog is done.
 				inTrial->SetMultiQs(Book().GetConfig());
-				inTrial->GetRuns().sort();
-				inDog->GetTrials().sort(!CAgilityBookOptions::GetNewestDatesFirst());
+				inDog->GetTrials().RepositionTrial(inTrial, !CAgilityBookOptions::GetNewestDatesFirst());
 				ResetVisibility(venues, inTrial, pRun);
 				// Even though we will reset the tree, go ahead and add/select
 				// the item into the tree here. That will make sure when the
@@ -691,12 +752,19 @@ bool CAgilityBookDoc::EditRun(ARBDogPtr const& inDog, ARBDogTrialPtr const& inTr
 		}
 		else
 		{
-			inDog->GetTrials().sort(!CAgilityBookOptions::GetNewestDatesFirst());
+			inTrial->GetRuns().RepositionRun(pRun);
+			inDog->GetTrials().RepositionTrial(inTrial, !CAgilityBookOptions::GetNewestDatesFirst());
 			ResetVisibility(venues, inTrial, pRun);
+			bInPlace = (layout == CTrialLayout(inDog, inTrial));
 		}
 		// We have to update the tree even when we add above as it may have
 		// caused the trial to be reordered.
-		if (bOk)
+		if (bInPlace)
+		{
+			CUpdateHint hint(UPDATE_POINTS_VIEW | UPDATE_RUNS_VIEW | UPDATE_TREE_VIEW, UpdateChange::Run, {pRun});
+			UpdateAllViews(nullptr, &hint);
+		}
+		else if (bOk)
 		{
 			CUpdateHint hint(UPDATE_POINTS_VIEW | UPDATE_RUNS_VIEW | UPDATE_TREE_VIEW);
 			UpdateAllViews(nullptr, &hint);
@@ -716,7 +784,7 @@ bool CAgilityBookDoc::DeleteRuns(std::vector<ARBDogRunPtr> const& inRuns, bool b
 
 	bool bUpdate = false;
 	unsigned int updateHint = UPDATE_POINTS_VIEW | UPDATE_RUNS_VIEW;
-	std::set<ARBDogPtr> sortTrials;
+	std::vector<std::pair<ARBDogPtr, ARBDogTrialPtr>> moveTrials;
 	std::set<wxTreeItemId> refreshItems;
 
 	for (auto inRun : inRuns)
@@ -745,7 +813,7 @@ bool CAgilityBookDoc::DeleteRuns(std::vector<ARBDogRunPtr> const& inRuns, bool b
 				if (pTrial->GetStartDate() != startDate)
 				{
 					updateHint |= UPDATE_TREE_VIEW;
-					sortTrials.insert(pDog);
+					moveTrials.push_back(std::make_pair(pDog, pTrial));
 				}
 				Modify(true);
 			}
@@ -758,8 +826,9 @@ bool CAgilityBookDoc::DeleteRuns(std::vector<ARBDogRunPtr> const& inRuns, bool b
 		for (auto id : refreshItems)
 			pTree->RefreshItem(id);
 
-		for (auto pDog : sortTrials)
-			pDog->GetTrials().sort(!CAgilityBookOptions::GetNewestDatesFirst());
+		// Repositioning the same trial more than once is harmless.
+		for (auto const& item : moveTrials)
+			item.first->GetTrials().RepositionTrial(item.second, !CAgilityBookOptions::GetNewestDatesFirst());
 
 		CUpdateHint hint(updateHint);
 		UpdateAllViews(nullptr, &hint);
@@ -810,6 +879,8 @@ bool CAgilityBookDoc::SetCalenderDate(ARBDate const& date)
 }
 
 
+// Full sort - only needed after loading or changing the sort order. Edits
+// keep the lists sorted via AddTrial/RepositionTrial and InsertRun/RepositionRun.
 void CAgilityBookDoc::SortDates()
 {
 	bool bDescending = !CAgilityBookOptions::GetNewestDatesFirst();
@@ -863,6 +934,8 @@ bool CAgilityBookDoc::ImportConfiguration(ARBConfig const& update)
 		if (bChanges)
 		{
 			CFilterOptions filterOptions;
+			// The records changed too, so everything must be recomputed.
+			InvalidateVisibility();
 			if (filterOptions.Update(update, configVersionPreUpdate, m_Records.GetConfig()) && ResetVisibility())
 			{
 				iHint |= UPDATE_ALL_VIEW;
@@ -927,6 +1000,7 @@ bool CAgilityBookDoc::ImportARBCalEntry(
 			{
 				m_Records.GetCalendar().AddCalendar(pCal);
 				++nAdded;
+				bModified = true;
 			}
 			else
 				++nSkipped;
@@ -934,7 +1008,10 @@ bool CAgilityBookDoc::ImportARBCalEntry(
 		else
 		{
 			if (calFound->Update(pCal))
+			{
 				++nUpdated;
+				bModified = true;
+			}
 			else
 				++nDuplicate;
 		}
@@ -981,133 +1058,16 @@ bool CAgilityBookDoc::ImportARBRunData(ElementNodePtr const& inTree, wxWindow* p
 	{
 		if (0 < err.m_ErrMsg.size())
 			wxMessageBox(err.m_ErrMsg, _("Agility Record Book"), wxOK | wxCENTRE | wxICON_INFORMATION);
-		int countDog = 0;
-		int countRegNumsAdded = 0;
-		int countRegNumsUpdated = 0;
-		int countExistingPts = 0;
-		int countTitlesAdded = 0;
-		int countTitlesUpdated = 0;
-		int countTrials = 0;
+		ARBBulkImport bulk(m_Records);
+		ARBBulkImport::MergeCounts counts;
 		int countClubs = 0;
 		int countJudges = 0;
 		int countLocations = 0;
 		for (ARBDogList::iterator iterDog = book.GetDogs().begin(); iterDog != book.GetDogs().end(); ++iterDog)
 		{
-			ARBDogPtr pDog = *iterDog;
-			ARBDogPtr pExisting;
-			for (ARBDogList::iterator iterDog2 = m_Records.GetDogs().begin(); iterDog2 != m_Records.GetDogs().end();
-				 ++iterDog2)
-			{
-				if ((*iterDog2)->GetCallName() == pDog->GetCallName())
-				{
-					pExisting = *iterDog2;
-					break;
-				}
-			}
-			if (!pExisting)
-			{
-				++countDog;
-				m_Records.GetDogs().AddDog(pDog);
-			}
-			else if (*pExisting != *pDog)
-			{
-				// If the dog exists, only update the existing points,
-				// registration numbers, titles and trials.
-				if (pExisting->GetRegNums() != pDog->GetRegNums())
-				{
-					for (ARBDogRegNumList::iterator iter = pDog->GetRegNums().begin(); iter != pDog->GetRegNums().end();
-						 ++iter)
-					{
-						ARBDogRegNumPtr pRegNum = *iter;
-						ARBDogRegNumPtr pRegExist;
-						if (pExisting->GetRegNums().FindRegNum(pRegNum->GetVenue(), &pRegExist))
-						{
-							if (*pRegExist != *pRegNum)
-							{
-								++countRegNumsUpdated;
-								*pRegExist = *pRegNum;
-							}
-						}
-						else
-						{
-							++countRegNumsAdded;
-							pExisting->GetRegNums().AddRegNum(pRegNum);
-						}
-					}
-				}
-				if (pExisting->GetExistingPoints() != pDog->GetExistingPoints())
-				{
-					for (ARBDogExistingPointsList::iterator iter = pDog->GetExistingPoints().begin();
-						 iter != pDog->GetExistingPoints().end();
-						 ++iter)
-					{
-						bool bFound = false;
-						for (ARBDogExistingPointsList::iterator iter2 = pExisting->GetExistingPoints().begin();
-							 iter2 != pExisting->GetExistingPoints().end();
-							 ++iter2)
-						{
-							if (*(*iter) == *(*iter2))
-							{
-								bFound = true;
-								break;
-							}
-						}
-						if (!bFound)
-						{
-							++countExistingPts;
-							pExisting->GetExistingPoints().AddExistingPoints((*iter));
-						}
-					}
-				}
-				if (pExisting->GetTitles() != pDog->GetTitles())
-				{
-					for (ARBDogTitleList::iterator iter = pDog->GetTitles().begin(); iter != pDog->GetTitles().end();
-						 ++iter)
-					{
-						ARBDogTitlePtr pTitle = *iter;
-						ARBDogTitlePtr pTitleExist;
-						if (pExisting->GetTitles().FindTitle(pTitle->GetVenue(), pTitle->GetRawName(), &pTitleExist))
-						{
-							if (*pTitle != *pTitleExist)
-							{
-								++countTitlesUpdated;
-								*pTitleExist = *pTitle;
-							}
-						}
-						else
-						{
-							++countTitlesAdded;
-							ARBDogTitlePtr pNewTitle = pTitle->Clone();
-							pExisting->GetTitles().AddTitle(pNewTitle);
-						}
-					}
-				}
-				if (pExisting->GetTrials() != pDog->GetTrials())
-				{
-					for (ARBDogTrialList::iterator iter = pDog->GetTrials().begin(); iter != pDog->GetTrials().end();
-						 ++iter)
-					{
-						bool bFound = false;
-						for (ARBDogTrialList::iterator iter2 = pExisting->GetTrials().begin();
-							 iter2 != pExisting->GetTrials().end();
-							 ++iter2)
-						{
-							if (*(*iter) == *(*iter2))
-							{
-								bFound = true;
-								break;
-							}
-						}
-						if (!bFound)
-						{
-							++countTrials;
-							pExisting->GetTrials().AddTrial((*iter));
-						}
-					}
-				}
-			}
-			pDog->GetTrials().sort(!CAgilityBookOptions::GetNewestDatesFirst());
+			bulk.MergeDog(*iterDog, counts);
 		}
+		bulk.Finish(!CAgilityBookOptions::GetNewestDatesFirst());
 
 		for (ARBInfoItemList::const_iterator iterClub = book.GetInfo().GetInfo(ARBInfoType::Club).begin();
 			 iterClub != book.GetInfo().GetInfo(ARBInfoType::Club).end();
@@ -1142,9 +1102,10 @@ bool CAgilityBookDoc::ImportARBRunData(ElementNodePtr const& inTree, wxWindow* p
 				++countLocations;
 			}
 		}
-		if (0 < countDog || 0 < countRegNumsAdded || 0 < countRegNumsUpdated || 0 < countExistingPts
-			|| 0 < countTitlesAdded || 0 < countTitlesUpdated || 0 < countTrials)
+		if (0 < counts.dogs || 0 < counts.regNumsAdded || 0 < counts.regNumsUpdated || 0 < counts.existingPts
+			|| 0 < counts.titlesAdded || 0 < counts.titlesUpdated || 0 < counts.trials)
 		{
+			ResetVisibility(bulk.GetModifiedDogs());
 			CUpdateHint hint(UPDATE_ALL_VIEW);
 			UpdateAllViews(nullptr, &hint);
 			Modify(true);
@@ -1170,40 +1131,40 @@ bool CAgilityBookDoc::ImportARBRunData(ElementNodePtr const& inTree, wxWindow* p
 		wxString str;
 		str << _("IDS_ADDED") << L" ";
 		bool bAdded = false;
-		if (0 < countDog)
+		if (0 < counts.dogs)
 		{
 			if (bAdded)
 				str << L", ";
 			bAdded = true;
-			str << wxString::Format(_("IDS_ADDED_DOGS"), countDog);
+			str << wxString::Format(_("IDS_ADDED_DOGS"), counts.dogs);
 		}
-		if (0 < countRegNumsAdded)
+		if (0 < counts.regNumsAdded)
 		{
 			if (bAdded)
 				str << L", ";
 			bAdded = true;
-			str << wxString::Format(_("IDS_ADDED_REGNUMS"), countRegNumsAdded);
+			str << wxString::Format(_("IDS_ADDED_REGNUMS"), counts.regNumsAdded);
 		}
-		if (0 < countExistingPts)
+		if (0 < counts.existingPts)
 		{
 			if (bAdded)
 				str << L", ";
 			bAdded = true;
-			str << wxString::Format(_("IDS_ADDED_EXISTINGPTS"), countExistingPts);
+			str << wxString::Format(_("IDS_ADDED_EXISTINGPTS"), counts.existingPts);
 		}
-		if (0 < countTitlesAdded)
+		if (0 < counts.titlesAdded)
 		{
 			if (bAdded)
 				str << L", ";
 			bAdded = true;
-			str << wxString::Format(_("IDS_ADDED_TITLES"), countTitlesAdded);
+			str << wxString::Format(_("IDS_ADDED_TITLES"), counts.titlesAdded);
 		}
-		if (0 < countTrials)
+		if (0 < counts.trials)
 		{
 			if (bAdded)
 				str << L", ";
 			bAdded = true;
-			str << wxString::Format(_("IDS_ADDED_TRIALS"), countTrials);
+			str << wxString::Format(_("IDS_ADDED_TRIALS"), counts.trials);
 		}
 		if (0 < countClubs)
 		{
@@ -1227,23 +1188,23 @@ bool CAgilityBookDoc::ImportARBRunData(ElementNodePtr const& inTree, wxWindow* p
 			str << wxString::Format(_("IDS_ADDED_LOCATIONS"), countLocations);
 		}
 		bAdded = false;
-		if (0 < countRegNumsUpdated)
+		if (0 < counts.regNumsUpdated)
 		{
 			if (bAdded)
 				str << L", ";
 			else
 				str += wxString::Format(L"\n%s ", _("IDS_UPDATED"));
 			bAdded = true;
-			str << wxString::Format(_("IDS_ADDED_REGNUMS"), countRegNumsUpdated);
+			str << wxString::Format(_("IDS_ADDED_REGNUMS"), counts.regNumsUpdated);
 		}
-		if (0 < countTitlesUpdated)
+		if (0 < counts.titlesUpdated)
 		{
 			if (bAdded)
 				str << L", ";
 			else
 				str += wxString::Format(L"\n%s ", _("IDS_UPDATED"));
 			bAdded = true;
-			str << wxString::Format(_("IDS_ADDED_TITLES"), countTitlesUpdated);
+			str << wxString::Format(_("IDS_ADDED_TITLES"), counts.titlesUpdated);
 		}
 		wxMessageBox(str, _("Agility Record Book"), wxOK | wxCENTRE | wxICON_INFORMATION);
 		bOk = true;
@@ -1287,6 +1248,49 @@ bool CAgilityBookDoc::ImportARBCalData(ElementNodePtr const& inTree, wxWindow* p
 }
 
 
+bool CAgilityBookDoc::ImportICalData(wxString const& inFileName, wxWindow* pParent)
+{
+	wxBusyCursor wait;
+	wxFFileInputStream file(inFileName, L"rb");
+	if (!file.IsOk())
+	{
+		wxMessageBox(_("AFX_IDP_FAILED_TO_OPEN_DOC"), _("Agility Record Book"), wxOK | wxCENTRE | wxICON_EXCLAMATION);
+		return false;
+	}
+	wxStdInputStream stdfile(file);
+
+	long nAdded = 0;
+	long nUpdated = 0;
+	long nDuplicate = 0;
+	long nSkipped = 0;
+	ARBDate skipBefore;
+	if (CAgilityBookOptions::AutoDeleteCalendarEntries())
+		skipBefore = ARBDate::Today();
+	if (m_Records.GetCalendar()
+			.ImportICalendar(stdfile, m_Records.GetConfig(), skipBefore, nAdded, nUpdated, nDuplicate, nSkipped))
+	{
+		m_Records.GetCalendar().sort();
+		CUpdateHint hint(UPDATE_CALENDAR_VIEW);
+		UpdateAllViews(nullptr, &hint);
+		Modify(true);
+	}
+
+	auto str = wxString::Format(_("IDS_UPDATED_CAL_ITEMS"), nAdded, nUpdated);
+	wxMessageBox(str, _("Agility Record Book"), wxOK | wxCENTRE | wxICON_INFORMATION);
+	return true;
+}
+
+
+bool CAgilityBookDoc::ExportSQL(wxString const& inFileName) const
+{
+	wxFFileOutputStream file(inFileName, L"wb");
+	if (!file.IsOk())
+		return false;
+	wxStdOutputStream stdfile(file);
+	return ARBSqlExport::Write(m_Records, CAgilityBookOptions::GetTableInYPS(), stdfile);
+}
+
+
 bool CAgilityBookDoc::ImportARBLogData(ElementNodePtr const& inTree, wxWindow* pParent)
 {
 	wxBusyCursor wait;
@@ -1322,40 +1326,164 @@ bool CAgilityBookDoc::ImportARBLogData(ElementNodePtr const& inTree, wxWindow* p
 
 bool CAgilityBookDoc::ResetVisibility()
 {
+	CFilterOptions const& options = CFilterOptions::Options();
+	bool bHiddenTitles = CAgilityBookOptions::GetViewHiddenTitles();
+
 	bool bChanged = false;
-	std::vector<CVenueFilter> venues;
-	CFilterOptions::Options().GetFilterVenue(venues);
+	if (ApplyCachedVisibility(options, bHiddenTitles, bChanged))
+		return bChanged;
+
+	unsigned int changes = FILTER_CHANGE_ALL;
+	if (m_visibleFilter)
+		changes = options.GetVisibilityChanges(*m_visibleFilter);
+	bool bRuns = 0 != (changes & (FILTER_CHANGE_DATES | FILTER_CHANGE_VENUES | FILTER_CHANGE_RUNS));
+	bool bTitles = 0 != (changes & (FILTER_CHANGE_DATES | FILTER_CHANGE_VENUES))
+				   || bHiddenTitles != m_bVisibleHiddenTitles;
+
+	CVenueFilterSet const& venues = options.GetFilterVenueSet();
 	std::set<wxString> names;
-	CFilterOptions::Options().GetTrainingFilterNames(names);
+	options.GetTrainingFilterNames(names);
 
-	for (ARBDogList::iterator iterDogs = m_Records.GetDogs().begin(); iterDogs != m_Records.GetDogs().end(); ++iterDogs)
+	if (bRuns || bTitles)
+	{
+		for (ARBDogList::iterator iterDogs = m_Records.GetDogs().begin(); iterDogs != m_Records.GetDogs().end();
+			 ++iterDogs)
+		{
+			if (bRuns)
+			{
+				for (ARBDogTrialList::iterator iterTrial = (*iterDogs)->GetTrials().begin();
+					 iterTrial != (*iterDogs)->GetTrials().end();
+					 ++iterTrial)
+					bChanged |= ResetVisibility(venues, *iterTrial);
+			}
+			if (bTitles)
+			{
+				for (ARBDogTitleList::iterator iterTitle = (*iterDogs)->GetTitles().begin();
+					 iterTitle != (*iterDogs)->GetTitles().end();
+					 ++iterTitle)
+					bChanged |= ResetVisibility(venues, *iterTitle);
+			}
+		}
+	}
+
+	if (changes & (FILTER_CHANGE_DATES | FILTER_CHANGE_NAMES))
 	{
-		bChanged |= ResetVisibility(venues, *iterDogs);
+		for (ARBTrainingList::iterator iterTraining = m_Records.GetTraining().begin();
+			 iterTraining != m_Records.GetTraining().end();
+			 ++iterTraining)
+		{
+			bChanged |= ResetVisibility(names, *iterTraining);
+		}
 	}
 
-	for (ARBTrainingList::iterator iterTraining = m_Records.GetTraining().begin();
-		 iterTraining != m_Records.GetTraining().end();
-		 ++iterTraining)
+	if (changes & (FILTER_CHANGE_DATES | FILTER_CHANGE_VENUES))
 	{
-		bChanged |= ResetVisibility(names, *iterTraining);
+		for (ARBCalendarList::iterator iterCal = m_Records.GetCalendar().begin();
+			 iterCal != m_Records.GetCalendar().end();
+			 ++iterCal)
+		{
+			ARBCalendarPtr pCal = *iterCal;
+			bool bVis = options.IsCalendarVisible(venues, pCal);
+			if (pCal->IsAnyFiltered() != !bVis)
+			{
+				bChanged = true;
+				pCal->SetFiltered(!bVis);
+			}
+		}
 	}
 
-	for (ARBCalendarList::iterator iterCal = m_Records.GetCalendar().begin(); iterCal != m_Records.GetCalendar().end();
-		 ++iterCal)
+	m_visibleFilter = std::make_shared<CFilterOptions const>(options);
+	m_bVisibleHiddenTitles = bHiddenTitles;
+	CacheVisibility(options);
+	return bChanged;
+}
+
+
+void CAgilityBookDoc::InvalidateVisibility()
+{
+	m_visibleFilter.reset();
+	m_visibilityObjects.clear();
+	m_visibilityCache.clear();
+}
+
+
+bool CAgilityBookDoc::ApplyCachedVisibility(CFilterOptions const& options, bool bHiddenTitles, bool& outChanged)
+{
+	auto iter = m_visibilityCache.find(options.GetCurrentFilter());
+	if (iter == m_visibilityCache.end() || iter->second.bHiddenTitles != bHiddenTitles
+		|| 0 != options.GetVisibilityChanges(*iter->second.filter))
+		return false;
+	std::vector<bool> const& bits = iter->second.bits;
+	assert(bits.size() == 2 * m_visibilityObjects.size());
+	outChanged = false;
+	size_t n = 0;
+	for (auto const& pObject : m_visibilityObjects)
 	{
-		ARBCalendarPtr pCal = *iterCal;
-		bool bVis = CFilterOptions::Options().IsCalendarVisible(venues, pCal);
-		if (pCal->IsAnyFiltered() != !bVis)
+		for (auto type : {ARBFilterType::Full, ARBFilterType::IgnoreQ})
 		{
-			bChanged = true;
-			pCal->SetFiltered(!bVis);
+			if (pObject->IsFiltered(type) != bits[n])
+			{
+				outChanged = true;
+				pObject->SetFiltered(type, bits[n]);
+			}
+			++n;
+		}
+	}
+	m_visibleFilter = iter->second.filter;
+	m_bVisibleHiddenTitles = bHiddenTitles;
+	return true;
+}
+
+
+void CAgilityBookDoc::CacheVisibility(CFilterOptions const& options)
+{
+	// An unnamed filter can't be switched back to.
+	if (options.GetCurrentFilter().empty())
+		return;
+	if (m_visibilityObjects.empty())
+	{
+		for (auto const& pDog : m_Records.GetDogs())
+		{
+			for (auto const& pTrial : pDog->GetTrials())
+			{
+				m_visibilityObjects.push_back(pTrial);
+				for (auto const& pRun : pTrial->GetRuns())
+					m_visibilityObjects.push_back(pRun);
+			}
+			for (auto const& pTitle : pDog->GetTitles())
+				m_visibilityObjects.push_back(pTitle);
 		}
+		for (auto const& pCal : m_Records.GetCalendar())
+			m_visibilityObjects.push_back(pCal);
+		for (auto const& pTraining : m_Records.GetTraining())
+			m_visibilityObjects.push_back(pTraining);
+	}
+	VisibilityCache& cache = m_visibilityCache[options.GetCurrentFilter()];
+	cache.filter = m_visibleFilter;
+	cache.bHiddenTitles = m_bVisibleHiddenTitles;
+	cache.bits.clear();
+	cache.bits.reserve(2 * m_visibilityObjects.size());
+	for (auto const& pObject : m_visibilityObjects)
+	{
+		cache.bits.push_back(pObject->IsFiltered(ARBFilterType::Full));
+		cache.bits.push_back(pObject->IsFiltered(ARBFilterType::IgnoreQ));
 	}
+}
+
+
+bool CAgilityBookDoc::ResetVisibility(std::vector<ARB::ARBDogPtr> const& inDogs)
+{
+	if (inDogs.empty())
+		return false;
+	CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
+	bool bChanged = false;
+	for (auto const& pDog : inDogs)
+		bChanged |= ResetVisibility(venues, pDog);
 	return bChanged;
 }
 
 
-bool CAgilityBookDoc::ResetVisibility(std::vector<CVenueFilter> const& venues, ARB::ARBDogPtr const& inDog)
+bool CAgilityBookDoc::ResetVisibility(CVenueFilterSet const& venues, ARB::ARBDogPtr const& inDog)
 {
 	bool bChanged = false;
 	for (ARBDogTrialList::iterator iterTrial = inDog->GetTrials().begin(); iterTrial != inDog->GetTrials().end();
@@ -1369,7 +1497,7 @@ bool CAgilityBookDoc::ResetVisibility(std::vector<CVenueFilter> const& venues, A
 }
 
 
-bool CAgilityBookDoc::ResetVisibility(std::vector<CVenueFilter> const& venues, ARB::ARBDogTrialPtr const& inTrial)
+bool CAgilityBookDoc::ResetVisibility(CVenueFilterSet const& venues, ARB::ARBDogTrialPtr const& inTrial)
 {
 	bool bChanged = false;
 	bool bVisTrial = CFilterOptions::Options().IsTrialVisible(venues, inTrial);
@@ -1394,7 +1522,7 @@ bool CAgilityBookDoc::ResetVisibility(std::vector<CVenueFilter> const& venues, A
 
 
 bool CAgilityBookDoc::ResetVisibility(
-	std::vector<CVenueFilter> const& venues,
+	CVenueFilterSet const& venues,
 	ARB::ARBDogTrialPtr const& inTrial,
 	ARB::ARBDogRunPtr const& inRun)
 {
@@ -1416,7 +1544,7 @@ bool CAgilityBookDoc::ResetVisibility(
 }
 
 
-bool CAgilityBookDoc::ResetVisibility(std::vector<CVenueFilter> const& venues, ARB::ARBDogTitlePtr const& inTitle)
+bool CAgilityBookDoc::ResetVisibility(CVenueFilterSet const& venues, ARB::ARBDogTitlePtr const& inTitle)
 {
 	bool bChanged = false;
 	bool bVisTitle = CFilterOptions::Options().IsTitleVisible(venues, inTitle);
@@ -1442,6 +1570,82 @@ bool CAgilityBookDoc::ResetVisibility(std::set<wxString> const& names, ARB::ARBT
 }
 
 
+void CAgilityBookDoc::ModifyObjects(std::vector<ARBBasePtr> const& inObjects)
+{
+	// If stale, the whole index will be rebuilt anyway.
+	if (SearchIndexState::Stale != m_SearchIndexState)
+	{
+		for (auto const& pObject : inObjects)
+			m_SearchIndex.Update(pObject);
+	}
+	// Not every caller resets the visibility of the edited objects (and they
+	// may be new), so the next ResetVisibility must look at everything.
+	InvalidateVisibility();
+	wxDocument::Modify(true);
+}
+
+
+void CAgilityBookDoc::Modify(bool mod)
+{
+	// We don't know what changed.
+	if (mod)
+	{
+		InvalidateSearchIndex();
+		InvalidateVisibility();
+	}
+	wxDocument::Modify(mod);
+}
+
+
+bool CAgilityBookDoc::GetSearchCandidates(wxString const& inSearch, std::unordered_set<ARBBase const*>& outCandidates)
+	const
+{
+	if (SearchIndexState::Ready != m_SearchIndexState)
+		return false;
+	return m_SearchIndex.Find(inSearch, outCandidates);
+}
+
+
+void CAgilityBookDoc::InvalidateSearchIndex()
+{
+	m_SearchIndexState = SearchIndexState::Stale;
+	m_SearchIndex.Clear();
+	m_SearchIndexPending.clear();
+}
+
+
+void CAgilityBookDoc::OnIdle(wxIdleEvent& evt)
+{
+	evt.Skip();
+	switch (m_SearchIndexState)
+	{
+	case SearchIndexState::Ready:
+		break;
+
+	case SearchIndexState::Stale:
+		ARBSearchIndex::GetIndexableObjects(m_Records, m_SearchIndexPending);
+		m_SearchIndexState = SearchIndexState::Building;
+		evt.RequestMore();
+		break;
+
+	case SearchIndexState::Building:
+		// Index a slice at a time so the UI stays responsive. Objects edited
+		// in the meantime are updated in place (ModifyObjects) or cause a
+		// restart (Modify), so the pending list never refers to stale data.
+		for (size_t n = 0; n < 250 && !m_SearchIndexPending.empty(); ++n)
+		{
+			m_SearchIndex.Update(m_SearchIndexPending.back());
+			m_SearchIndexPending.pop_back();
+		}
+		if (m_SearchIndexPending.empty())
+			m_SearchIndexState = SearchIndexState::Ready;
+		else
+			evt.RequestMore();
+		break;
+	}
+}
+
+
 bool CAgilityBookDoc::ShowPointsAsHtml(bool bHtml)
 {
 	CTabView* pView = GetTabView();
@@ -1575,6 +1779,8 @@ bool CAgilityBookDoc::DeleteContents()
 	wxGetApp().SetMessageText(msg, CFilterOptions::Options().IsFilterEnabled());
 	wxGetApp().SetMessageText2(msg);
 	m_Records.clear();
+	InvalidateSearchIndex();
+	InvalidateVisibility();
 	return true;
 }
 
@@ -1714,6 +1920,8 @@ bool CAgilityBookDoc::OnOpenDocument(const wxString& filename)
 		ResetVisibility();
 		STACK_TICKLE(stack, L"PostReset");
 
+		InvalidateSearchIndex();
+
 		//
 		// End DoOpenDocument stuff
 		//
@@ -1847,6 +2055,16 @@ bool CAgilityBookDoc::DoSaveDocument(const wxString& filename)
 		{
 			wxConfig::Get()->Write(CFG_SETTINGS_LASTFILE, filename);
 			bOk = true;
+			if (CAgilityBookOptions::GetSQLMirror())
+			{
+				wxFileName sqlFile(filename);
+				sqlFile.SetExt(L"sql");
+				if (!ExportSQL(sqlFile.GetFullPath()))
+				{
+					auto errMsg = wxString::Format(_("IDS_CANNOT_OPEN"), sqlFile.GetFullPath());
+					wxMessageBox(errMsg, _("Agility Record Book"), wxOK | wxCENTRE | wxICON_EXCLAMATION);
+				}
+			}
 		}
 		else
 		{
@@ -1939,35 +2157,32 @@ void CFindInfo::Search(ARBInfoType inType, std::set<wxString> const& inUse, ARBI
 			break;
 		}
 	}
+	std::unordered_set<ARBBase const*> candidates;
+	bool bUseIndex = m_pDoc->GetSearchCandidates(Text(), candidates);
 	for (ARBInfoItemList::const_iterator iterItem = info.GetInfo(inType).begin();
 		 iterItem != info.GetInfo(inType).end();
 		 ++iterItem)
 	{
-		std::set<wxString> strings;
-		if (0 < (*iterItem)->GetSearchStrings(strings))
+		if (bUseIndex && 0 == candidates.count(iterItem->get()))
+			continue;
+		// Stops enumerating at the first match.
+		if (!(*iterItem)->ForEachSearchString([this](wxString const& str) { return !Compare(str); }))
 		{
-			for (auto const& str : strings)
+			// First, see if we've inserted the item name
+			std::vector<CFindItemInfo>::iterator iter2;
+			for (iter2 = m_Items.begin(); iter2 != m_Items.end(); ++iter2)
 			{
-				if (Compare(str))
-				{
-					// First, see if we've inserted the item name
-					std::vector<CFindItemInfo>::iterator iter2;
-					for (iter2 = m_Items.begin(); iter2 != m_Items.end(); ++iter2)
-					{
-						if (iter2->name == (*iterItem)->GetName())
-							break;
-					}
-					CFindItemInfo item;
-					item.type = inType;
-					item.name = (*iterItem)->GetName();
-					item.pItem = *iterItem;
-					if (iter2 != m_Items.end())
-						*iter2 = item;
-					else
-						m_Items.push_back(item);
+				if (iter2->name == (*iterItem)->GetName())
 					break;
-				}
 			}
+			CFindItemInfo item;
+			item.type = inType;
+			item.name = (*iterItem)->GetName();
+			item.pItem = *iterItem;
+			if (iter2 != m_Items.end())
+				*iter2 = item;
+			else
+				m_Items.push_back(item);
 		}
 	}
 }
@@ -2054,8 +2269,7 @@ void CAgilityBookDoc::OnCmd(wxCommandEvent& evt)
 		ARBDogPtr pDog = GetCurrentDog();
 		if (pDog)
 		{
-			std::vector<CVenueFilter> venues;
-			CFilterOptions::Options().GetFilterVenue(venues);
+			CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 
 			wxString preTitles, postTitles;
 			for (ARBConfigVenueList::const_iterator iVenue = m_Records.GetConfig().GetVenues().begin();
@@ -2175,7 +2389,7 @@ void CAgilityBookDoc::OnCmd(wxCommandEvent& evt)
 					pTab->SetCurTab(IDX_PANE_CALENDAR);
 				m_Records.GetCalendar().AddCalendar(cal);
 				m_Records.GetCalendar().sort();
-				Modify(true);
+				ModifyObject(cal);
 				CUpdateHint hint(UPDATE_CALENDAR_VIEW);
 				UpdateAllViews(nullptr, &hint);
 				CAgilityBookCalendarView* pCal = GetCalendarView();
@@ -2198,7 +2412,7 @@ void CAgilityBookDoc::OnCmd(wxCommandEvent& evt)
 				pTab->SetCurTab(IDX_PANE_LOG);
 			m_Records.GetTraining().AddTraining(training);
 			m_Records.GetTraining().sort();
-			Modify(true);
+			ModifyObject(training);
 			CUpdateHint hint(UPDATE_TRAINING_VIEW);
 			UpdateAllViews(nullptr, &hint);
 			CAgilityBookTrainingView* pView = GetTrainingView();
@@ -12,6 +12,13 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added ExportSQL.
+ * 2026-10-19 Added ImportICalData.
+ * 2026-10-19 Reset visibility of a set of dogs.
+ * 2026-10-19 Added edited objects to CUpdateHint.
+ * 2026-10-19 Cache the visibility of each named filter.
+ * 2026-10-19 Only reset the visibility affected by a filter change.
+ * 2026-10-19 Added search index.
  * 2015-10-29 Add Save override.
  * 2012-09-29 Strip the Runs View.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
@@ -33,9 +40,14 @@
  */
 
 #include "ARB/ARBAgilityRecordBook.h"
+#include "ARB/ARBSearchIndex.h"
 #include "ARBCommon/ARBTypes.h"
 #include <wx/docview.h>
+#include <map>
+#include <memory>
 #include <set>
+#include <unordered_set>
+#include <vector>
 
 
 namespace dconSoft
@@ -45,9 +57,10 @@ class CAgilityBookCalendarView;
 class CAgilityBookTrainingView;
 class CAgilityBookRunsView;
 class CAgilityBookTreeView;
+class CFilterOptions;
 class CStatusHandler;
 class CTabView;
-struct CVenueFilter;
+class CVenueFilterSet;
 
 
 // UpdateAllViews() hints: Only the view bits can be or'd. Each item is
@@ -67,12 +80,39 @@ struct CVenueFilter;
 #define UPDATE_ALL_VIEW \
 	(UPDATE_CALENDAR_VIEW | UPDATE_TRAINING_VIEW | UPDATE_POINTS_VIEW | UPDATE_RUNS_VIEW | UPDATE_TREE_VIEW)
 
+// What kind of objects a hint's changed list holds.
+// Only trial and run edits send a changed list so far. Dog, calendar and
+// training edits still send plain hints, which reload the views.
+enum class UpdateChange
+{
+	None,
+	Dog,
+	Trial,
+	Run,
+	Calendar,
+	Training
+};
+
 class CUpdateHint : public wxObject
 {
 public:
 	CUpdateHint(unsigned int hint, ARB::ARBBasePtr const& inObj = ARB::ARBBasePtr())
 		: m_Hint(hint)
 		, m_pObj(inObj)
+		, m_Change(UpdateChange::None)
+		, m_Changed()
+	{
+	}
+	/**
+	 * Objects that were edited in place: nothing was added, deleted, moved
+	 * or filtered. Views affected by the hint bits may refresh just what
+	 * shows these objects instead of reloading.
+	 */
+	CUpdateHint(unsigned int hint, UpdateChange change, std::vector<ARB::ARBBasePtr> const& inChanged)
+		: m_Hint(hint)
+		, m_pObj()
+		, m_Change(change)
+		, m_Changed(inChanged)
 	{
 	}
 	bool IsSet(unsigned int bit) const
@@ -88,10 +128,20 @@ public:
 	{
 		return m_pObj;
 	}
+	UpdateChange GetChange() const
+	{
+		return m_Change;
+	}
+	std::vector<ARB::ARBBasePtr> const& GetChanged() const
+	{
+		return m_Changed;
+	}
 
 private:
 	unsigned int m_Hint;
 	ARB::ARBBasePtr m_pObj;
+	UpdateChange m_Change;
+	std::vector<ARB::ARBBasePtr> m_Changed;
 };
 
 
@@ -154,25 +204,63 @@ public:
 
 	bool ImportARBRunData(ARBCommon::ElementNodePtr const& inTree, wxWindow* pParent);
 	bool ImportARBCalData(ARBCommon::ElementNodePtr const& inTree, wxWindow* pParent);
+	bool ImportICalData(wxString const& inFileName, wxWindow* pParent);
 	bool ImportARBLogData(ARBCommon::ElementNodePtr const& inTree, wxWindow* pParent);
 
+	/**
+	 * Write the book as an SQL script (see ARBSqlExport).
+	 * @param inFileName File to write.
+	 * @return Success.
+	 */
+	bool ExportSQL(wxString const& inFileName) const;
+
 	/**
 	 * Reset the visibility of all objects.
+	 * Only the objects affected by what changed in the filter since the last
+	 * reset are recomputed.
 	 * @return Visibility was changed.
 	 * @post All UI objects will be reset, all pointers to data objects will
 	 *       be deleted. This should not be called from any AgilityBookTreeData
 	 *       object!
 	 */
 	bool ResetVisibility();
-	bool ResetVisibility(std::vector<CVenueFilter> const& venues, ARB::ARBDogPtr const& inDog);
-	bool ResetVisibility(std::vector<CVenueFilter> const& venues, ARB::ARBDogTrialPtr const& inTrial);
+	/**
+	 * Reset the visibility of just some dogs (their trials, runs and titles)
+	 * for the current filter, for instance after an import added to them.
+	 */
+	bool ResetVisibility(std::vector<ARB::ARBDogPtr> const& inDogs);
+	bool ResetVisibility(CVenueFilterSet const& venues, ARB::ARBDogPtr const& inDog);
+	bool ResetVisibility(CVenueFilterSet const& venues, ARB::ARBDogTrialPtr const& inTrial);
 	bool ResetVisibility(
-		std::vector<CVenueFilter> const& venues,
+		CVenueFilterSet const& venues,
 		ARB::ARBDogTrialPtr const& inTrial,
 		ARB::ARBDogRunPtr const& inRun);
-	bool ResetVisibility(std::vector<CVenueFilter> const& venues, ARB::ARBDogTitlePtr const& inTitle);
+	bool ResetVisibility(CVenueFilterSet const& venues, ARB::ARBDogTitlePtr const& inTitle);
 	bool ResetVisibility(std::set<wxString> const& names, ARB::ARBTrainingPtr const& inTraining);
 
+	/**
+	 * Mark the document modified after editing specific objects.
+	 * Modify(true) has to assume anything changed, so it rebuilds the search
+	 * index. This just reindexes the given objects.
+	 * @note Do not use this if objects were deleted.
+	 */
+	void ModifyObjects(std::vector<ARB::ARBBasePtr> const& inObjects);
+	void ModifyObject(ARB::ARBBasePtr const& inObject)
+	{
+		ModifyObjects(std::vector<ARB::ARBBasePtr>(1, inObject));
+	}
+	void Modify(bool mod) override;
+
+	/**
+	 * Get the objects (dogs, trials, runs, calendar, training, info items)
+	 * that may contain a Find string. Candidates still need to be compared.
+	 * @param inSearch Text being searched for.
+	 * @param outCandidates Objects that may match.
+	 * @return false if the index cannot be used (still being built, or the
+	 *         text has no words), in which case everything must be searched.
+	 */
+	bool GetSearchCandidates(wxString const& inSearch, std::unordered_set<ARB::ARBBase const*>& outCandidates) const;
+
 	bool ShowPointsAsHtml(bool bHtml);
 	void BackupFile(wxString const& lpszPathName);
 
@@ -188,10 +276,36 @@ private:
 	bool IsDocumentUpdatable(wxString const& filename) const;
 	wxString GenerateHash(wxString const& filename) const;
 
+	void InvalidateSearchIndex();
+	void OnIdle(wxIdleEvent& evt);
+	void InvalidateVisibility();
+	bool ApplyCachedVisibility(CFilterOptions const& options, bool bHiddenTitles, bool& outChanged);
+	void CacheVisibility(CFilterOptions const& options);
+
 	wxString m_fileHash;
 	ARB::ARBAgilityRecordBook m_Records; ///< The real records.
 	CStatusHandler* m_StatusData;
 	ARB::ARBDogPtr m_pCurrentDog;
+	enum class SearchIndexState
+	{
+		Stale,    ///< Needs to be rebuilt
+		Building, ///< Being built during idle time
+		Ready
+	};
+	SearchIndexState m_SearchIndexState;
+	ARB::ARBSearchIndex m_SearchIndex;
+	std::vector<ARB::ARBBasePtr> m_SearchIndexPending; ///< Objects still to be indexed.
+	std::shared_ptr<CFilterOptions const> m_visibleFilter; ///< Filter used by last ResetVisibility (null: recompute all).
+	bool m_bVisibleHiddenTitles;
+	/// Visibility of all filterable objects as computed by one named filter.
+	struct VisibilityCache
+	{
+		std::shared_ptr<CFilterOptions const> filter; ///< Filter the bits were computed with.
+		bool bHiddenTitles;
+		std::vector<bool> bits; ///< Full and IgnoreQ state of each m_visibilityObjects entry.
+	};
+	std::vector<ARB::ARBBasePtr> m_visibilityObjects; ///< Objects in VisibilityCache order.
+	std::map<wxString, VisibilityCache> m_visibilityCache; ///< Keyed by filter name.
 
 protected:
 	void OnChangedViewList() override;
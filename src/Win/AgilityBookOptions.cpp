@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added SQLMirror
  * 2025-12-06 Added GetExportFilter
  * 2021-06-22 Added AutoUpdateCheckInterval.
  * 2020-01-27 Add alternate row color setting.
@@ -143,6 +144,7 @@ constexpr bool sc_AutoUpdateCheck = true;
 #endif
 constexpr long sc_AutoUpdateCheckInterval = 30;
 constexpr long sc_NumBackup = 3;
+constexpr bool sc_SQLMirror = false;
 constexpr bool sc_ShowPropOnNewTitle = false;
 constexpr bool sc_UseProxy = false;
 constexpr bool sc_UseAltRowColor = true;
@@ -1967,6 +1969,20 @@ void CAgilityBookOptions::SetBackupDirectory(wxString const& dir)
 }
 
 
+bool CAgilityBookOptions::GetSQLMirror()
+{
+	bool val = sc_SQLMirror;
+	wxConfig::Get()->Read(CFG_SETTINGS_SQLMIRROR, &val);
+	return val;
+}
+
+
+void CAgilityBookOptions::SetSQLMirror(bool bSet)
+{
+	wxConfig::Get()->Write(CFG_SETTINGS_SQLMIRROR, bSet);
+}
+
+
 bool CAgilityBookOptions::AutoShowPropertiesOnNewTitle()
 {
 	bool val = sc_ShowPropOnNewTitle;
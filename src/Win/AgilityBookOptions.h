@@ -12,6 +12,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added SQLMirror
  * 2025-12-06 Added GetExportFilter
  * 2020-01-27 Add alternate row color setting.
  * 2013-05-19 Make last div/level/height/handler context aware.
@@ -263,6 +264,8 @@ public:
 	static void SetNumBackupFiles(long nFiles);
 	static wxString GetBackupDirectory();
 	static void SetBackupDirectory(wxString const& dir);
+	static bool GetSQLMirror();
+	static void SetSQLMirror(bool bSet);
 	static bool AutoShowPropertiesOnNewTitle();
 	static void AutoShowPropertiesOnNewTitle(bool bShow);
 	static std::optional<bool> GetDarkMode();
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Regenerate the page at idle time, coalescing updates.
  * 2019-05-28 Suppress href warning when hiding a title.
  * 2019-05-04 Reworked PointsData usage.
  * 2017-08-20 Alter how header is generated/handled.
@@ -34,6 +35,7 @@
 #include "Print.h"
 
 #include "ARBCommon/StringUtil.h"
+#include <wx/stopwatch.h>
 
 #ifdef __WXMSW__
 #include <wx/msw/msvcrt.h>
@@ -82,7 +84,10 @@ void CHtmlWindow::OnLinkClicked(const wxHtmlLinkInfo& link)
 		// need fixing too. Just don't use those in our links.
 		bool bDidIt = false;
 		wxString index(url.substr(ProtocolARB.length()));
-		if (!index.empty())
+		// The page is out of date, the link may not be valid.
+		if (m_pView->EnsureLoaded())
+			bDidIt = true;
+		else if (!index.empty())
 		{
 			m_tag = index;
 			bDidIt = m_pView->m_Items->Details(index);
@@ -138,6 +143,8 @@ CAgilityBookPointsView::CAgilityBookPointsView(CTabView* pTabView, wxDocument* d
 	: CAgilityBookBaseExtraView(pTabView, doc)
 	, m_Ctrl(nullptr)
 	, m_Items(std::make_unique<CPointsDataItems>(GetDocument()))
+	, m_bLoadPending(false)
+	, m_msLoad(-1)
 {
 }
 
@@ -165,6 +172,7 @@ bool CAgilityBookPointsView::Create(
 		wxDefaultPosition,
 		wxDefaultSize,
 		wxNO_BORDER | wxHW_SCROLLBAR_AUTO);
+	m_Ctrl->Bind(wxEVT_IDLE, &CAgilityBookPointsView::OnCtrlIdle, this);
 #if defined(__WXMAC__)
 	m_Ctrl->SetDropTarget(new CFileDropTarget(doc->GetDocumentManager()));
 #endif
@@ -188,6 +196,10 @@ bool CAgilityBookPointsView::IsFiltered() const
 bool CAgilityBookPointsView::GetMessage(wxString& msg) const
 {
 	msg = _("IDS_INDICATOR_BLANK");
+#if defined(_DEBUG) || defined(__WXDEBUG__)
+	if (0 <= m_msLoad)
+		msg = wxString::Format(L"%ld ms", m_msLoad);
+#endif
 	return true;
 }
 
@@ -243,7 +255,10 @@ void CAgilityBookPointsView::OnUpdate(wxView* sender, wxObject* inHint)
 	if (!hint || hint->IsSet(UPDATE_POINTS_VIEW) || hint->IsEqual(UPDATE_CONFIG) || hint->IsEqual(UPDATE_OPTIONS)
 		|| hint->IsEqual(UPDATE_LANG_CHANGE))
 	{
-		LoadData();
+		// Updates tend to come in bunches (and while this page isn't even
+		// shown). The current page stays up until the idle handler
+		// regenerates it once for all of them.
+		m_bLoadPending = true;
 	}
 }
 
@@ -253,16 +268,36 @@ void CAgilityBookPointsView::LoadData()
 	STACK_TRACE(stack, L"CAgilityBookPointsView::LoadData");
 
 	wxBusyCursor wait;
+	m_bLoadPending = false;
+	wxStopWatch timer;
 
 	m_Items->LoadData(GetDocument()->GetCurrentDog());
 	wxString data = m_Items->GetHtml(false, false);
 	m_Ctrl->SetPage(data);
 
+	m_msLoad = timer.Time();
 	if (m_Ctrl->IsShownOnScreen())
 		UpdateMessages();
 }
 
 
+bool CAgilityBookPointsView::EnsureLoaded()
+{
+	if (!m_bLoadPending || !m_Ctrl)
+		return false;
+	LoadData();
+	return true;
+}
+
+
+void CAgilityBookPointsView::OnCtrlIdle(wxIdleEvent& evt)
+{
+	evt.Skip();
+	if (m_bLoadPending && m_Ctrl && m_Ctrl->IsShownOnScreen())
+		LoadData();
+}
+
+
 void CAgilityBookPointsView::OnViewUpdateCmd(wxUpdateUIEvent& evt)
 {
 	switch (evt.GetId())
@@ -292,6 +327,7 @@ void CAgilityBookPointsView::OnViewCmd(wxCommandEvent& evt)
 	{
 	case wxID_COPY:
 	{
+		EnsureLoaded();
 		CClipboardDataWriter clpData;
 		if (clpData.isOkay())
 		{
@@ -318,8 +354,7 @@ void CAgilityBookPointsView::OnViewCmd(wxCommandEvent& evt)
 	case ID_VIEW_HIDDEN:
 	{
 		CAgilityBookOptions::SetViewHiddenTitles(!CAgilityBookOptions::GetViewHiddenTitles());
-		std::vector<CVenueFilter> venues;
-		CFilterOptions::Options().GetFilterVenue(venues);
+		CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 		for (ARBDogList::iterator iterDogs = GetDocument()->Book().GetDogs().begin();
 			 iterDogs != GetDocument()->Book().GetDogs().end();
 			 ++iterDogs)
@@ -350,6 +385,7 @@ void CAgilityBookPointsView::OnViewCmd(wxCommandEvent& evt)
 
 void CAgilityBookPointsView::OnPrintView(wxCommandEvent& evt)
 {
+	EnsureLoaded();
 	wxString text(m_Items->GetHtml(false, true));
 	wxGetApp().GetHtmlPrinter()->PrintText(text);
 }
@@ -357,6 +393,7 @@ void CAgilityBookPointsView::OnPrintView(wxCommandEvent& evt)
 
 void CAgilityBookPointsView::OnPreview(wxCommandEvent& evt)
 {
+	EnsureLoaded();
 	wxString text(m_Items->GetHtml(false, true));
 	wxGetApp().GetHtmlPrinter()->PreviewText(text);
 }
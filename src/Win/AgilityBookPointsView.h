@@ -12,6 +12,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Regenerate the page at idle time, coalescing updates.
  * 2019-05-04 Reworked PointsData usage.
  * 2014-04-23 Scroll to position of clicked link on page load.
  * 2009-02-09 Ported to wxWidgets.
@@ -91,11 +92,17 @@ public:
 
 private:
 	void LoadData();
+	/// Regenerate the page now if an update is waiting.
+	/// @return Whether the page was regenerated.
+	bool EnsureLoaded();
 
 	CHtmlWindow* m_Ctrl;
 	std::unique_ptr<CPointsDataItems> m_Items;
+	bool m_bLoadPending;
+	long m_msLoad; ///< Time taken by the last LoadData (shown in debug builds).
 
 	DECLARE_EVENT_TABLE()
+	void OnCtrlIdle(wxIdleEvent& evt);
 	void OnViewUpdateCmd(wxUpdateUIEvent& evt);
 	void OnViewCmd(wxCommandEvent& evt);
 	void OnPrintView(wxCommandEvent& evt);
@@ -10,6 +10,13 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Use a virtual list control.
+ * 2026-10-19 Refresh just the rows of edited trials/runs when possible.
+ * 2026-10-19 Sort numeric columns using precomputed keys.
+ * 2026-10-19 Cache column text, size columns from a sample of rows.
+ * 2026-10-19 Find uses the document search index.
+ * 2026-10-19 Find stops at the first matching string.
+ * 2026-10-19 Sort text columns using precomputed keys.
  * 2018-09-15 Refactored how tree/list handle common actions.
  * 2017-09-04 Change default DogsInClass to -1 (allows for DNR runs with 0 dogs)
  * 2015-11-27 Use subname for event, if set.
@@ -69,14 +76,20 @@
 #include "Print.h"
 #include "RegItems.h"
 
+#include "ARB/ARBSortKey.h"
 #include "ARB/ARBTypes2.h"
+#include "ARBCommon/ARBMisc.h"
 #include "ARBCommon/Element.h"
 #include "ARBCommon/StringUtil.h"
 #include "LibARBWin/DlgFind.h"
-#include "LibARBWin/ListData.h"
+#include "LibARBWin/Widgets.h"
 #include "LibARBWin/Logger.h"
 #include <wx/config.h>
+#include <wx/imaglist.h>
 #include <algorithm>
+#include <map>
+#include <set>
+#include <unordered_set>
 
 #ifdef __WXMSW__
 #include <wx/msw/msvcrt.h>
@@ -92,7 +105,7 @@ using namespace ARBWin;
 /////////////////////////////////////////////////////////////////////////////
 // CAgilityBookRunsViewData
 
-class CAgilityBookRunsViewData : public CListData
+class CAgilityBookRunsViewData
 {
 	DECLARE_NO_COPY_IMPLEMENTED(CAgilityBookRunsViewData)
 public:
@@ -105,6 +118,11 @@ public:
 		, m_pDog(inDog)
 		, m_pTrial(inTrial)
 		, m_pRun(inRun)
+		, m_Text()
+		, m_bHasText()
+		, m_NumericKeys()
+		, m_bHasScoring(false)
+		, m_pScoring()
 	{
 	}
 	~CAgilityBookRunsViewData()
@@ -126,18 +144,89 @@ public:
 	{
 		return m_pRun;
 	}
-	wxString OnNeedText(long iCol) const override;
-	void OnNeedListItem(long iCol, wxListItem& info) const override;
+	wxString OnNeedText(long iCol) const;
+	int OnNeedIcon() const;
+	// Collation key for text columns (IO_RUNS_* value, not list column).
+	std::wstring const& GetSortKey(long inColumn) const;
+	// Key for the other columns. Runs are ordered by rank, then value. The
+	// rank groups runs a column doesn't apply to (no yards, not placed, ...).
+	struct NumericKey
+	{
+		int rank;
+		double value;
+	};
+	NumericKey const& GetNumericKey(long inColumn) const;
+	// The run (or its trial/dog) was edited, recompute everything.
+	void Invalidate()
+	{
+		m_SortKeys.Clear();
+		m_Text.clear();
+		m_bHasText.clear();
+		m_NumericKeys.clear();
+		m_bHasScoring = false;
+		m_pScoring.reset();
+	}
 
 protected:
 	CAgilityBookRunsView* m_pView;
 	ARBDogPtr m_pDog;
 	ARBDogTrialPtr m_pTrial;
 	ARBDogRunPtr m_pRun;
+	mutable ARBSortKeyCache m_SortKeys;
+	// A new data object is created whenever the list is reloaded. Objects
+	// edited in place are refreshed with Invalidate().
+	mutable std::vector<wxString> m_Text;
+	mutable std::vector<bool> m_bHasText;
+	mutable std::map<long, NumericKey> m_NumericKeys;
+	mutable bool m_bHasScoring;
+	mutable ARBConfigScoringPtr m_pScoring;
+
+private:
+	wxString GetColumnText(long iCol) const;
+	ARBConfigScoringPtr const& GetConfigScoring() const;
 };
 
 
+ARBConfigScoringPtr const& CAgilityBookRunsViewData::GetConfigScoring() const
+{
+	if (!m_bHasScoring)
+	{
+		m_bHasScoring = true;
+		if (m_pRun->GetClub())
+			m_pView->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
+				m_pRun->GetClub()->GetVenue(),
+				m_pRun->GetEvent(),
+				m_pRun->GetDivision(),
+				m_pRun->GetLevel(),
+				m_pRun->GetDate(),
+				nullptr,
+				&m_pScoring);
+	}
+	return m_pScoring;
+}
+
+
 wxString CAgilityBookRunsViewData::OnNeedText(long iCol) const
+{
+	// Painting, sizing, find and print all ask for the same text.
+	if (0 > iCol)
+		return wxString();
+	size_t idx = static_cast<size_t>(iCol);
+	if (idx >= m_bHasText.size())
+	{
+		m_Text.resize(idx + 1);
+		m_bHasText.resize(idx + 1, false);
+	}
+	if (!m_bHasText[idx])
+	{
+		m_Text[idx] = GetColumnText(iCol);
+		m_bHasText[idx] = true;
+	}
+	return m_Text[idx];
+}
+
+
+wxString CAgilityBookRunsViewData::GetColumnText(long iCol) const
 {
 	short val = 0;
 	wxString str;
@@ -255,16 +344,7 @@ wxString CAgilityBookRunsViewData::OnNeedText(long iCol) const
 		case IO_RUNS_TOTAL_FAULTS:
 			if (ARBScoringType::ByTime == m_pRun->GetScoring().GetType())
 			{
-				ARBConfigScoringPtr pScoring;
-				if (m_pRun->GetClub())
-					m_pView->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-						m_pRun->GetClub()->GetVenue(),
-						m_pRun->GetEvent(),
-						m_pRun->GetDivision(),
-						m_pRun->GetLevel(),
-						m_pRun->GetDate(),
-						nullptr,
-						&pScoring);
+				ARBConfigScoringPtr const& pScoring = GetConfigScoring();
 				double faults = m_pRun->GetScoring().GetCourseFaults() + m_pRun->GetScoring().GetTimeFaults(pScoring);
 				str = ARBDouble::ToString(faults, 0);
 			}
@@ -369,16 +449,7 @@ wxString CAgilityBookRunsViewData::OnNeedText(long iCol) const
 		case IO_RUNS_SCORE:
 			if (m_pRun->GetQ().ShouldComputeScore())
 			{
-				ARBConfigScoringPtr pScoring;
-				if (m_pRun->GetClub())
-					m_pView->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-						m_pRun->GetClub()->GetVenue(),
-						m_pRun->GetEvent(),
-						m_pRun->GetDivision(),
-						m_pRun->GetLevel(),
-						m_pRun->GetDate(),
-						nullptr,
-						&pScoring);
+				ARBConfigScoringPtr const& pScoring = GetConfigScoring();
 				if (pScoring)
 				{
 					str = ARBDouble::ToString(m_pRun->GetScore(pScoring));
@@ -390,16 +461,7 @@ wxString CAgilityBookRunsViewData::OnNeedText(long iCol) const
 			double pts = 0;
 			if (m_pRun->GetQ().Qualified())
 			{
-				ARBConfigScoringPtr pScoring;
-				if (m_pRun->GetClub())
-					m_pView->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-						m_pRun->GetClub()->GetVenue(),
-						m_pRun->GetEvent(),
-						m_pRun->GetDivision(),
-						m_pRun->GetLevel(),
-						m_pRun->GetDate(),
-						nullptr,
-						&pScoring);
+				ARBConfigScoringPtr const& pScoring = GetConfigScoring();
 				if (pScoring)
 				{
 					pts = m_pRun->GetTitlePoints(pScoring);
@@ -426,16 +488,7 @@ wxString CAgilityBookRunsViewData::OnNeedText(long iCol) const
 		break;
 		case IO_RUNS_SPEED:
 		{
-			ARBConfigScoringPtr pScoring;
-			if (m_pRun->GetClub())
-				m_pView->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-					m_pRun->GetClub()->GetVenue(),
-					m_pRun->GetEvent(),
-					m_pRun->GetDivision(),
-					m_pRun->GetLevel(),
-					m_pRun->GetDate(),
-					nullptr,
-					&pScoring);
+			ARBConfigScoringPtr const& pScoring = GetConfigScoring();
 			if (pScoring)
 			{
 				if (pScoring->HasSpeedPts() && m_pRun->GetQ().Qualified())
@@ -454,674 +507,595 @@ wxString CAgilityBookRunsViewData::OnNeedText(long iCol) const
 }
 
 
-void CAgilityBookRunsViewData::OnNeedListItem(long iCol, wxListItem& info) const
+int CAgilityBookRunsViewData::OnNeedIcon() const
 {
+	int iImage = -1;
 	if (m_pRun)
 	{
-		info.SetMask(info.GetMask() | wxLIST_MASK_TEXT);
-		info.SetText(OnNeedText(iCol));
-		if (0 == iCol)
-		{
-			int iImage = -1;
-			if (0 < m_pRun->GetCRCDRawMetaData().length())
-				iImage = m_pView->m_imgMap;
-			else if (0 < m_pRun->GetCRCD().length())
-				iImage = m_pView->m_imgCourse;
-			if (0 <= iImage)
-			{
-				info.SetMask(info.GetMask() | wxLIST_MASK_IMAGE);
-				info.SetImage(iImage);
-			}
-		}
-	}
-}
-
-/////////////////////////////////////////////////////////////////////////////
-// List sorting
-
-CAgilityBookRunsView::CSortColumn::CSortColumn(std::vector<long>& inColumns)
-	: m_Columns(inColumns)
-	, m_iCol(1)
-	, m_bIsSorted(false)
-{
-}
-
-
-void CAgilityBookRunsView::CSortColumn::Initialize()
-{
-	wxConfig::Get()->Read(CFG_SORTING_RUNS_ENABLED, &m_bIsSorted);
-
-	long realCol = IO_RUNS_DATE;
-	realCol = wxConfig::Get()->Read(CFG_SORTING_RUNS, realCol);
-	long neg = 1;
-	if (0 > realCol)
-	{
-		neg = -1;
-		realCol *= -1;
-	}
-
-	long col = LookupColumn(realCol);
-	if (0 > m_iCol)
-		col = LookupColumn(IO_RUNS_DATE);
-	m_iCol = col * neg;
-}
-
-
-void CAgilityBookRunsView::CSortColumn::SetSorted(bool bSorted)
-{
-	m_bIsSorted = bSorted;
-	wxConfig::Get()->Write(CFG_SORTING_RUNS_ENABLED, m_bIsSorted);
-}
-
-
-void CAgilityBookRunsView::CSortColumn::SetColumn(long iCol)
-{
-	m_iCol = iCol;
-	if (0 == iCol)
-		return;
-
-	SetSorted(true);
-	long neg = 1;
-	long col = iCol;
-	if (0 > iCol)
-	{
-		neg = -1;
-		col = iCol * -1;
+		if (0 < m_pRun->GetCRCDRawMetaData().length())
+			iImage = m_pView->m_imgMap;
+		else if (0 < m_pRun->GetCRCD().length())
+			iImage = m_pView->m_imgCourse;
 	}
-
-	long realCol = m_Columns[col - 1] * neg;
-	wxConfig::Get()->Write(CFG_SORTING_RUNS, realCol);
+	return iImage;
 }
 
-
-long CAgilityBookRunsView::CSortColumn::LookupColumn(long iCol) const
+std::wstring const& CAgilityBookRunsViewData::GetSortKey(long inColumn) const
 {
-	size_t n = m_Columns.size();
-	for (size_t i = 0; i < n; ++i)
-	{
-		if (m_Columns[i] == iCol)
+	return m_SortKeys.Get(inColumn, [this, inColumn]() {
+		wxString str;
+		switch (inColumn)
 		{
-			return static_cast<long>(i + 1);
+		default:
+			break;
+		case IO_RUNS_REG_NAME:
+			str = m_pDog->GetRegisteredName();
+			break;
+		case IO_RUNS_CALL_NAME:
+			str = m_pDog->GetCallName();
+			break;
+		case IO_RUNS_VENUE:
+		case IO_RUNS_CLUB:
+		{
+			int i = 0;
+			for (ARBDogClubList::const_iterator iter = m_pTrial->GetClubs().begin();
+				 iter != m_pTrial->GetClubs().end();
+				 ++iter, ++i)
+			{
+				if (0 < i)
+					str += L"/";
+				str += IO_RUNS_VENUE == inColumn ? (*iter)->GetVenue() : (*iter)->GetName();
+			}
 		}
-	}
-	return -1;
+		break;
+		case IO_RUNS_LOCATION:
+			str = m_pTrial->GetLocation();
+			break;
+		case IO_RUNS_TRIAL_NOTES:
+			str = m_pTrial->GetNote();
+			break;
+		case IO_RUNS_DIVISION:
+			str = m_pRun->GetDivision();
+			break;
+		case IO_RUNS_LEVEL:
+			str = m_pRun->GetLevel();
+			break;
+		case IO_RUNS_EVENT:
+			str = m_pRun->GetEvent();
+			break;
+		case IO_RUNS_HEIGHT:
+			str = m_pRun->GetHeight();
+			break;
+		case IO_RUNS_JUDGE:
+			str = m_pRun->GetJudge();
+			break;
+		case IO_RUNS_HANDLER:
+			str = m_pRun->GetHandler();
+			break;
+		case IO_RUNS_CONDITIONS:
+			str = m_pRun->GetConditions();
+			break;
+		case IO_RUNS_COMMENTS:
+			str = m_pRun->GetNote();
+			break;
+		case IO_RUNS_FAULTS:
+		{
+			int i = 0;
+			for (ARBDogFaultList::const_iterator iter = m_pRun->GetFaults().begin();
+				 iter != m_pRun->GetFaults().end();
+				 ++i, ++iter)
+			{
+				if (0 < i)
+					str += L", ";
+				str += *iter;
+			}
+		}
+		break;
+		}
+		return str;
+	});
 }
 
 
-struct RunsSortInfo : public SortInfo
+CAgilityBookRunsViewData::NumericKey const& CAgilityBookRunsViewData::GetNumericKey(long inColumn) const
 {
-	CAgilityBookRunsView* pThis;
-
-	RunsSortInfo(CAgilityBookRunsView* This, int nCol)
-		: SortInfo(nCol)
-		, pThis(This)
-	{
-	}
-};
-
-
-int wxCALLBACK CompareRuns(CListDataPtr const& item1, CListDataPtr const& item2, SortInfo const* pSortInfo)
-{
-	RunsSortInfo const* pInfo = dynamic_cast<RunsSortInfo const*>(pSortInfo);
-	assert(pInfo);
-
-	CAgilityBookRunsViewDataPtr pRun1 = std::dynamic_pointer_cast<CAgilityBookRunsViewData, CListData>(item1);
-	CAgilityBookRunsViewDataPtr pRun2 = std::dynamic_pointer_cast<CAgilityBookRunsViewData, CListData>(item2);
-
-	int nRet = 0;
-	int iCol = std::abs(pInfo->nCol);
-	// Col 0 is special: it has the icons. Instead of saving it,
-	// we simply ignore it - so iCol is always off by 1.
-	switch (pInfo->pThis->m_Columns[iCol - 1])
+	auto iter = m_NumericKeys.find(inColumn);
+	if (iter != m_NumericKeys.end())
+		return iter->second;
+
+	NumericKey key{0, 0.0};
+	ARBDogRunScoring const& scoring = m_pRun->GetScoring();
+	// Columns that only apply to some runs: the other runs sort first.
+	auto setIf = [&key](bool bOk, double value) {
+		if (bOk)
+		{
+			key.rank = 1;
+			key.value = value;
+		}
+	};
+	switch (inColumn)
 	{
 	default:
 		break;
-
-	case IO_RUNS_REG_NAME:
-		nRet = StringUtil::CompareNoCase(pRun1->GetDog()->GetRegisteredName(), pRun2->GetDog()->GetRegisteredName());
+	case IO_RUNS_DATE:
+		key.value = static_cast<double>(m_pRun->GetDate().GetJulianDay());
 		break;
-	case IO_RUNS_CALL_NAME:
-		nRet = StringUtil::CompareNoCase(pRun1->GetDog()->GetCallName(), pRun2->GetDog()->GetCallName());
+	case IO_RUNS_COURSE_FAULTS:
+		key.value = scoring.GetCourseFaults();
 		break;
-	case IO_RUNS_DATE:
-		if (pRun1->GetRun()->GetDate() < pRun2->GetRun()->GetDate())
-			nRet = -1;
-		else if (pRun1->GetRun()->GetDate() > pRun2->GetRun()->GetDate())
-			nRet = 1;
+	case IO_RUNS_TIME:
+		key.value = scoring.GetTime();
 		break;
-	case IO_RUNS_VENUE:
+	case IO_RUNS_YARDS:
+		setIf(ARBScoringType::ByTime == scoring.GetType() && 0.0 < scoring.GetYards(), scoring.GetYards());
+		break;
+	case IO_RUNS_MIN_YPS:
 	{
-		wxString str1, str2;
-		int i = 0;
-		ARBDogClubList::const_iterator iter;
-		for (iter = pRun1->GetTrial()->GetClubs().begin(); iter != pRun1->GetTrial()->GetClubs().end(); ++iter, ++i)
-		{
-			if (0 < i)
-				str1 += L"/";
-			str1 += (*iter)->GetVenue();
-		}
-		for (i = 0, iter = pRun2->GetTrial()->GetClubs().begin(); iter != pRun2->GetTrial()->GetClubs().end();
-			 ++iter, ++i)
-		{
-			if (0 < i)
-				str2 += L"/";
-			str2 += (*iter)->GetVenue();
-		}
-		nRet = StringUtil::CompareNoCase(str1, str2);
+		double yps = 0.0;
+		bool bOk = scoring.GetMinYPS(CAgilityBookOptions::GetTableInYPS(), yps);
+		setIf(bOk, yps);
 	}
 	break;
-	case IO_RUNS_CLUB:
+	case IO_RUNS_YPS:
 	{
-		wxString str1, str2;
-		int i = 0;
-		ARBDogClubList::const_iterator iter;
-		for (iter = pRun1->GetTrial()->GetClubs().begin(); iter != pRun1->GetTrial()->GetClubs().end(); ++iter, ++i)
-		{
-			if (0 < i)
-				str1 += L"/";
-			str1 += (*iter)->GetName();
-		}
-		for (i = 0, iter = pRun2->GetTrial()->GetClubs().begin(); iter != pRun2->GetTrial()->GetClubs().end();
-			 ++iter, ++i)
-		{
-			if (0 < i)
-				str2 += L"/";
-			str2 += (*iter)->GetName();
-		}
-		nRet = StringUtil::CompareNoCase(str1, str2);
+		double yps = 0.0;
+		bool bOk = scoring.GetYPS(CAgilityBookOptions::GetTableInYPS(), yps);
+		setIf(bOk, yps);
 	}
 	break;
-	case IO_RUNS_LOCATION:
-		nRet = StringUtil::CompareNoCase(pRun1->GetTrial()->GetLocation(), pRun2->GetTrial()->GetLocation());
-		break;
-	case IO_RUNS_TRIAL_NOTES:
-		nRet = StringUtil::CompareNoCase(pRun1->GetTrial()->GetNote(), pRun2->GetTrial()->GetNote());
-		break;
-	case IO_RUNS_DIVISION:
-		nRet = StringUtil::CompareNoCase(pRun1->GetRun()->GetDivision(), pRun2->GetRun()->GetDivision());
+	case IO_RUNS_OBSTACLES:
+		key.value = scoring.GetObstacles();
 		break;
-	case IO_RUNS_LEVEL:
-		nRet = StringUtil::CompareNoCase(pRun1->GetRun()->GetLevel(), pRun2->GetRun()->GetLevel());
+	case IO_RUNS_OPS:
+	{
+		double ops = 0.0;
+		int prec = 0;
+		bool bOk = scoring.GetObstaclesPS(
+			CAgilityBookOptions::GetTableInYPS(),
+			CAgilityBookOptions::GetRunTimeInOPS(),
+			ops,
+			prec);
+		setIf(bOk, ops);
+	}
+	break;
+	case IO_RUNS_SCT:
+		setIf(ARBScoringType::ByTime == scoring.GetType() && 0.0 < scoring.GetSCT(), scoring.GetSCT());
 		break;
-	case IO_RUNS_EVENT:
-		nRet = StringUtil::CompareNoCase(pRun1->GetRun()->GetEvent(), pRun2->GetRun()->GetEvent());
+	case IO_RUNS_TOTAL_FAULTS:
+		if (ARBScoringType::ByTime == scoring.GetType())
+			setIf(true, scoring.GetCourseFaults() + scoring.GetTimeFaults(GetConfigScoring()));
 		break;
-	case IO_RUNS_HEIGHT:
-		nRet = StringUtil::CompareNoCase(pRun1->GetRun()->GetHeight(), pRun2->GetRun()->GetHeight());
+	case IO_RUNS_REQ_OPENING:
+		setIf(ARBScoringType::ByOpenClose == scoring.GetType(), scoring.GetNeedOpenPts());
 		break;
-	case IO_RUNS_JUDGE:
-		nRet = StringUtil::CompareNoCase(pRun1->GetRun()->GetJudge(), pRun2->GetRun()->GetJudge());
+	case IO_RUNS_REQ_CLOSING:
+		setIf(ARBScoringType::ByOpenClose == scoring.GetType(), scoring.GetNeedClosePts());
 		break;
-	case IO_RUNS_HANDLER:
-		nRet = StringUtil::CompareNoCase(pRun1->GetRun()->GetHandler(), pRun2->GetRun()->GetHandler());
+	case IO_RUNS_OPENING:
+		setIf(ARBScoringType::ByOpenClose == scoring.GetType(), scoring.GetOpenPts());
 		break;
-	case IO_RUNS_CONDITIONS:
-		nRet = StringUtil::CompareNoCase(pRun1->GetRun()->GetConditions(), pRun2->GetRun()->GetConditions());
+	case IO_RUNS_CLOSING:
+		setIf(ARBScoringType::ByOpenClose == scoring.GetType(), scoring.GetClosePts());
 		break;
-	case IO_RUNS_COURSE_FAULTS:
-		if (pRun1->GetRun()->GetScoring().GetCourseFaults() < pRun2->GetRun()->GetScoring().GetCourseFaults())
-			nRet = -1;
-		else if (pRun1->GetRun()->GetScoring().GetCourseFaults() > pRun2->GetRun()->GetScoring().GetCourseFaults())
-			nRet = 1;
+	case IO_RUNS_REQ_POINTS:
+		setIf(ARBScoringType::ByPoints == scoring.GetType(), scoring.GetNeedOpenPts());
 		break;
-	case IO_RUNS_TIME:
-		if (pRun1->GetRun()->GetScoring().GetTime() < pRun2->GetRun()->GetScoring().GetTime())
-			nRet = -1;
-		else if (pRun1->GetRun()->GetScoring().GetTime() > pRun2->GetRun()->GetScoring().GetTime())
-			nRet = 1;
+	case IO_RUNS_POINTS:
+		setIf(ARBScoringType::ByPoints == scoring.GetType(), scoring.GetOpenPts());
 		break;
-	case IO_RUNS_YARDS:
-	{
-		bool bRun1
-			= (ARBScoringType::ByTime == pRun1->GetRun()->GetScoring().GetType()
-			   && 0.0 < pRun1->GetRun()->GetScoring().GetYards());
-		bool bRun2
-			= (ARBScoringType::ByTime == pRun2->GetRun()->GetScoring().GetType()
-			   && 0.0 < pRun2->GetRun()->GetScoring().GetYards());
-		if (bRun1 && bRun2)
-		{
-			if (pRun1->GetRun()->GetScoring().GetYards() < pRun2->GetRun()->GetScoring().GetYards())
-				nRet = -1;
-			else if (pRun1->GetRun()->GetScoring().GetYards() > pRun2->GetRun()->GetScoring().GetYards())
-				nRet = 1;
-		}
-		else if (bRun1)
-			nRet = 1;
-		else if (bRun2)
-			nRet = -1;
-	}
-	break;
-	case IO_RUNS_MIN_YPS:
+	case IO_RUNS_PLACE:
 	{
-		double yps1 = 0.0, yps2 = 0.0;
-		bool bOk1 = pRun1->GetRun()->GetScoring().GetMinYPS(CAgilityBookOptions::GetTableInYPS(), yps1);
-		bool bOk2 = pRun2->GetRun()->GetScoring().GetMinYPS(CAgilityBookOptions::GetTableInYPS(), yps2);
-		if (bOk1 && bOk2)
-		{
-			if (yps1 < yps2)
-				nRet = -1;
-			else if (yps1 > yps2)
-				nRet = 1;
-		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
+		// Placements first, then unplaced (0) and unknown (-1).
+		short place = m_pRun->GetPlace();
+		key.rank = 0 < place ? 0 : 1;
+		key.value = 0 < place ? place : -place;
 	}
 	break;
-	case IO_RUNS_YPS:
-	{
-		double yps1 = 0.0, yps2 = 0.0;
-		bool bOk1 = pRun1->GetRun()->GetScoring().GetYPS(CAgilityBookOptions::GetTableInYPS(), yps1);
-		bool bOk2 = pRun2->GetRun()->GetScoring().GetYPS(CAgilityBookOptions::GetTableInYPS(), yps2);
-		if (bOk1 && bOk2)
+	case IO_RUNS_IN_CLASS:
+		key.value = m_pRun->GetInClass();
+		break;
+	case IO_RUNS_DOGSQD:
+		key.value = m_pRun->GetDogsQd();
+		break;
+	case IO_RUNS_SCORE:
+		// Scored runs, then runs with no scoring method, then the rest.
+		if (m_pRun->GetQ().Qualified() || Q::NQ == m_pRun->GetQ())
 		{
-			if (yps1 < yps2)
-				nRet = -1;
-			else if (yps1 > yps2)
-				nRet = 1;
+			if (GetConfigScoring())
+			{
+				key.rank = 1;
+				key.value = m_pRun->GetScore(GetConfigScoring());
+			}
+			else
+				key.rank = 2;
 		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
+		break;
+	case IO_RUNS_TITLE_POINTS:
+		if (m_pRun->GetQ().Qualified() && GetConfigScoring())
+			key.value = m_pRun->GetTitlePoints(GetConfigScoring());
+		break;
+	case IO_RUNS_SPEED:
+		key.value = -1.0;
+		if (GetConfigScoring() && GetConfigScoring()->HasSpeedPts())
+			key.value = m_pRun->GetSpeedPoints(GetConfigScoring());
+		break;
 	}
-	break;
-	case IO_RUNS_OBSTACLES:
+	return m_NumericKeys.insert(std::make_pair(inColumn, key)).first->second;
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// CAgilityBookRunsListCtrl
+
+// A virtual list: the control only knows how many rows there are. The rows
+// live here and their text/icon is pulled from the row data (which caches
+// it) as rows are drawn, so loading thousands of runs inserts nothing.
+class CAgilityBookRunsListCtrl : public CListCtrl
+{
+	DECLARE_NO_COPY_IMPLEMENTED(CAgilityBookRunsListCtrl)
+public:
+	CAgilityBookRunsListCtrl(wxWindow* parent);
+
+	int AddIcon(wxIcon const& icon)
 	{
-		short ob1 = pRun1->GetRun()->GetScoring().GetObstacles();
-		short ob2 = pRun2->GetRun()->GetScoring().GetObstacles();
-		if (ob1 < ob2)
-			nRet = -1;
-		else if (ob1 > ob2)
-			nRet = 1;
+		return m_ImageList.Add(icon);
 	}
-	break;
-	case IO_RUNS_OPS:
+
+	void SetRows(std::vector<CAgilityBookRunsViewDataPtr>&& rows);
+	CAgilityBookRunsViewDataPtr GetData(long index) const;
+	long FindRow(ARBDogRunPtr const& inRun) const;
+	// Stable sort of the rows, the selection stays with its rows.
+	template <typename Less> void SortRows(Less inLess);
+
+	// 0: no indicator, >0: ascending, <0: descending.
+	void SetColumnSort(long column, int iconDirection);
+	void UpdateAlternateRowColor(bool bUse)
 	{
-		double ops1 = 0.0, ops2 = 0.0;
-		int prec1 = 0, prec2 = 0;
-		bool bOk1 = pRun1->GetRun()->GetScoring().GetObstaclesPS(
-			CAgilityBookOptions::GetTableInYPS(),
-			CAgilityBookOptions::GetRunTimeInOPS(),
-			ops1,
-			prec1);
-		bool bOk2 = pRun2->GetRun()->GetScoring().GetObstaclesPS(
-			CAgilityBookOptions::GetTableInYPS(),
-			CAgilityBookOptions::GetRunTimeInOPS(),
-			ops2,
-			prec2);
-		if (bOk1 && bOk2)
-		{
-			if (ops1 < ops2)
-				nRet = -1;
-			else if (ops1 > ops2)
-				nRet = 1;
-		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
+		EnableAlternateRowColours(bUse);
 	}
-	break;
-	case IO_RUNS_SCT:
-	{
-		bool bOk1 = ARBScoringType::ByTime == pRun1->GetRun()->GetScoring().GetType()
-					&& 0.0 < pRun1->GetRun()->GetScoring().GetSCT();
-		bool bOk2 = ARBScoringType::ByTime == pRun2->GetRun()->GetScoring().GetType()
-					&& 0.0 < pRun2->GetRun()->GetScoring().GetSCT();
-		if (bOk1 && bOk2)
-		{
-			if (pRun1->GetRun()->GetScoring().GetSCT() < pRun2->GetRun()->GetScoring().GetSCT())
-				nRet = -1;
-			else if (pRun1->GetRun()->GetScoring().GetSCT() > pRun2->GetRun()->GetScoring().GetSCT())
-				nRet = 1;
-		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
-	}
-	break;
-	case IO_RUNS_TOTAL_FAULTS:
+
+	long GetSelection(bool bRestrictToSingle = false) const;
+	size_t GetSelection(std::vector<long>& indices) const;
+	void SetSelection(long index, bool bEnsureVisible = false);
+	bool CanSelectAll() const
 	{
-		bool bOk1 = ARBScoringType::ByTime == pRun1->GetRun()->GetScoring().GetType();
-		bool bOk2 = ARBScoringType::ByTime == pRun2->GetRun()->GetScoring().GetType();
-		if (bOk1 && bOk2)
-		{
-			ARBConfigScoringPtr pScoring1;
-			if (pRun1->GetRun()->GetClub())
-				pRun1->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-					pRun1->GetRun()->GetClub()->GetVenue(),
-					pRun1->GetRun()->GetEvent(),
-					pRun1->GetRun()->GetDivision(),
-					pRun1->GetRun()->GetLevel(),
-					pRun1->GetRun()->GetDate(),
-					nullptr,
-					&pScoring1);
-			ARBConfigScoringPtr pScoring2;
-			if (pRun2->GetRun()->GetClub())
-				pRun2->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-					pRun2->GetRun()->GetClub()->GetVenue(),
-					pRun2->GetRun()->GetEvent(),
-					pRun2->GetRun()->GetDivision(),
-					pRun2->GetRun()->GetLevel(),
-					pRun2->GetRun()->GetDate(),
-					nullptr,
-					&pScoring2);
-			double faults1 = pRun1->GetRun()->GetScoring().GetCourseFaults()
-							 + pRun1->GetRun()->GetScoring().GetTimeFaults(pScoring1);
-			double faults2 = pRun2->GetRun()->GetScoring().GetCourseFaults()
-							 + pRun2->GetRun()->GetScoring().GetTimeFaults(pScoring2);
-			if (faults1 < faults2)
-				nRet = -1;
-			else if (faults1 > faults2)
-				nRet = 1;
-		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
+		return 0 < GetItemCount();
 	}
-	break;
-	case IO_RUNS_REQ_OPENING:
+	void SelectAll();
+
+	// Item -1 is the column headers.
+	void GetPrintLine(long item, std::vector<wxString>& line) const;
+	wxString GetPrintDataAsHtmlTable() const;
+
+protected:
+	wxString OnGetItemText(long item, long column) const override;
+	int OnGetItemImage(long item) const override
 	{
-		bool bOk1 = ARBScoringType::ByOpenClose == pRun1->GetRun()->GetScoring().GetType();
-		bool bOk2 = ARBScoringType::ByOpenClose == pRun2->GetRun()->GetScoring().GetType();
-		if (bOk1 && bOk2)
-		{
-			if (pRun1->GetRun()->GetScoring().GetNeedOpenPts() < pRun2->GetRun()->GetScoring().GetNeedOpenPts())
-				nRet = -1;
-			else if (pRun1->GetRun()->GetScoring().GetNeedOpenPts() > pRun2->GetRun()->GetScoring().GetNeedOpenPts())
-				nRet = 1;
-		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
+		return OnGetItemColumnImage(item, 0);
 	}
-	break;
-	case IO_RUNS_REQ_CLOSING:
+	int OnGetItemColumnImage(long item, long column) const override;
+
+private:
+	void ClearSelection();
+
+	std::vector<CAgilityBookRunsViewDataPtr> m_Rows;
+	wxImageList m_ImageList;
+};
+
+
+CAgilityBookRunsListCtrl::CAgilityBookRunsListCtrl(wxWindow* parent)
+	: CListCtrl(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxLC_REPORT | wxLC_VIRTUAL)
+	, m_Rows()
+	, m_ImageList(16, 16)
+{
+	SetImageList(&m_ImageList, wxIMAGE_LIST_SMALL);
+}
+
+
+void CAgilityBookRunsListCtrl::SetRows(std::vector<CAgilityBookRunsViewDataPtr>&& rows)
+{
+	ClearSelection();
+	m_Rows = std::move(rows);
+	SetItemCount(static_cast<long>(m_Rows.size()));
+	if (!m_Rows.empty())
+		RefreshItems(0, static_cast<long>(m_Rows.size()) - 1);
+}
+
+
+CAgilityBookRunsViewDataPtr CAgilityBookRunsListCtrl::GetData(long index) const
+{
+	if (0 <= index && index < static_cast<long>(m_Rows.size()))
+		return m_Rows[index];
+	return CAgilityBookRunsViewDataPtr();
+}
+
+
+long CAgilityBookRunsListCtrl::FindRow(ARBDogRunPtr const& inRun) const
+{
+	// Compare by ptr, not value.
+	for (size_t i = 0; inRun && i < m_Rows.size(); ++i)
 	{
-		bool bOk1 = ARBScoringType::ByOpenClose == pRun1->GetRun()->GetScoring().GetType();
-		bool bOk2 = ARBScoringType::ByOpenClose == pRun2->GetRun()->GetScoring().GetType();
-		if (bOk1 && bOk2)
-		{
-			if (pRun1->GetRun()->GetScoring().GetNeedClosePts() < pRun2->GetRun()->GetScoring().GetNeedClosePts())
-				nRet = -1;
-			else if (pRun1->GetRun()->GetScoring().GetNeedClosePts() > pRun2->GetRun()->GetScoring().GetNeedClosePts())
-				nRet = 1;
-		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
+		if (m_Rows[i]->GetRun() == inRun)
+			return static_cast<long>(i);
 	}
-	break;
-	case IO_RUNS_OPENING:
+	return -1;
+}
+
+
+template <typename Less> void CAgilityBookRunsListCtrl::SortRows(Less inLess)
+{
+	if (m_Rows.empty())
+		return;
+	std::vector<long> indices;
+	std::unordered_set<CAgilityBookRunsViewData const*> selected;
+	GetSelection(indices);
+	for (long index : indices)
+		selected.insert(m_Rows[index].get());
+
+	std::stable_sort(m_Rows.begin(), m_Rows.end(), inLess);
+
+	ClearSelection();
+	for (size_t i = 0; !selected.empty() && i < m_Rows.size(); ++i)
 	{
-		bool bOk1 = ARBScoringType::ByOpenClose == pRun1->GetRun()->GetScoring().GetType();
-		bool bOk2 = ARBScoringType::ByOpenClose == pRun2->GetRun()->GetScoring().GetType();
-		if (bOk1 && bOk2)
-		{
-			if (pRun1->GetRun()->GetScoring().GetOpenPts() < pRun2->GetRun()->GetScoring().GetOpenPts())
-				nRet = -1;
-			else if (pRun1->GetRun()->GetScoring().GetOpenPts() > pRun2->GetRun()->GetScoring().GetOpenPts())
-				nRet = 1;
-		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
+		if (0 < selected.count(m_Rows[i].get()))
+			Select(static_cast<long>(i), true);
 	}
-	break;
-	case IO_RUNS_CLOSING:
+	RefreshItems(0, static_cast<long>(m_Rows.size()) - 1);
+}
+
+
+void CAgilityBookRunsListCtrl::SetColumnSort(long column, int iconDirection)
+{
+	if (0 == iconDirection)
 	{
-		bool bOk1 = ARBScoringType::ByOpenClose == pRun1->GetRun()->GetScoring().GetType();
-		bool bOk2 = ARBScoringType::ByOpenClose == pRun2->GetRun()->GetScoring().GetType();
-		if (bOk1 && bOk2)
-		{
-			if (pRun1->GetRun()->GetScoring().GetClosePts() < pRun2->GetRun()->GetScoring().GetClosePts())
-				nRet = -1;
-			else if (pRun1->GetRun()->GetScoring().GetClosePts() > pRun2->GetRun()->GetScoring().GetClosePts())
-				nRet = 1;
-		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
+		if (GetSortIndicator() == column)
+			RemoveSortIndicator();
 	}
-	break;
-	case IO_RUNS_REQ_POINTS:
+	else
+		ShowSortIndicator(static_cast<int>(column), 0 < iconDirection);
+}
+
+
+long CAgilityBookRunsListCtrl::GetSelection(bool bRestrictToSingle) const
+{
+	if (bRestrictToSingle && 1 != GetSelectedItemCount())
+		return -1;
+	return GetFirstSelected();
+}
+
+
+size_t CAgilityBookRunsListCtrl::GetSelection(std::vector<long>& indices) const
+{
+	indices.clear();
+	for (long index = GetFirstSelected(); 0 <= index; index = GetNextSelected(index))
+		indices.push_back(index);
+	return indices.size();
+}
+
+
+void CAgilityBookRunsListCtrl::SetSelection(long index, bool bEnsureVisible)
+{
+	ClearSelection();
+	if (0 <= index && index < GetItemCount())
 	{
-		bool bOk1 = ARBScoringType::ByPoints == pRun1->GetRun()->GetScoring().GetType();
-		bool bOk2 = ARBScoringType::ByPoints == pRun2->GetRun()->GetScoring().GetType();
-		if (bOk1 && bOk2)
-		{
-			if (pRun1->GetRun()->GetScoring().GetNeedOpenPts() < pRun2->GetRun()->GetScoring().GetNeedOpenPts())
-				nRet = -1;
-			else if (pRun1->GetRun()->GetScoring().GetNeedOpenPts() > pRun2->GetRun()->GetScoring().GetNeedOpenPts())
-				nRet = 1;
-		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
+		Select(index, true);
+		Focus(index);
+		if (bEnsureVisible)
+			EnsureVisible(index);
 	}
-	break;
-	case IO_RUNS_POINTS:
+}
+
+
+void CAgilityBookRunsListCtrl::SelectAll()
+{
+	// -1 sets the state of every item in one call.
+	if (0 < GetItemCount())
+		SetItemState(-1, wxLIST_STATE_SELECTED, wxLIST_STATE_SELECTED);
+}
+
+
+void CAgilityBookRunsListCtrl::ClearSelection()
+{
+	if (0 < GetItemCount())
+		SetItemState(-1, 0, wxLIST_STATE_SELECTED);
+}
+
+
+void CAgilityBookRunsListCtrl::GetPrintLine(long item, std::vector<wxString>& line) const
+{
+	line.clear();
+	int nColumnCount = GetColumnCount();
+	for (int i = 0; i < nColumnCount; ++i)
 	{
-		bool bOk1 = ARBScoringType::ByPoints == pRun1->GetRun()->GetScoring().GetType();
-		bool bOk2 = ARBScoringType::ByPoints == pRun2->GetRun()->GetScoring().GetType();
-		if (bOk1 && bOk2)
+		if (0 > item)
 		{
-			if (pRun1->GetRun()->GetScoring().GetOpenPts() < pRun2->GetRun()->GetScoring().GetOpenPts())
-				nRet = -1;
-			else if (pRun1->GetRun()->GetScoring().GetOpenPts() > pRun2->GetRun()->GetScoring().GetOpenPts())
-				nRet = 1;
+			wxListItem info;
+			info.SetMask(wxLIST_MASK_TEXT);
+			GetColumn(i, info);
+			line.push_back(info.GetText());
 		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
+		else
+			line.push_back(OnGetItemText(item, i));
 	}
-	break;
-	case IO_RUNS_PLACE:
+}
+
+
+wxString CAgilityBookRunsListCtrl::GetPrintDataAsHtmlTable() const
+{
+	wxString data(L"<html><body><table border=\"1\">\n");
+	std::vector<wxString> line;
+	for (long item = -1; item < GetItemCount(); ++item)
 	{
-		short p1 = pRun1->GetRun()->GetPlace();
-		short p2 = pRun2->GetRun()->GetPlace();
-		if (p1 > p2)
-		{
-			if (p2 <= 0)
-				nRet = -1;
-			else
-				nRet = 1;
-		}
-		else if (p1 < p2)
+		GetPrintLine(item, line);
+		data << L"<tr>";
+		for (auto const& cell : line)
 		{
-			if (p1 <= 0)
-				nRet = 1;
+			if (0 > item)
+				data << L"<th>" << SanitizeStringForHTML(cell) << L"</th>";
 			else
-				nRet = -1;
+				data << L"<td>" << SanitizeStringForHTML(cell) << L"</td>";
 		}
+		data << L"</tr>\n";
 	}
-	break;
-	case IO_RUNS_IN_CLASS:
+	data << L"</table></body></html>\n";
+	return data;
+}
+
+
+wxString CAgilityBookRunsListCtrl::OnGetItemText(long item, long column) const
+{
+	CAgilityBookRunsViewDataPtr pData = GetData(item);
+	if (!pData)
+		return wxString();
+	return pData->OnNeedText(column);
+}
+
+
+int CAgilityBookRunsListCtrl::OnGetItemColumnImage(long item, long column) const
+{
+	CAgilityBookRunsViewDataPtr pData = GetData(item);
+	if (!pData || 0 != column)
+		return -1;
+	return pData->OnNeedIcon();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// List sorting
+
+CAgilityBookRunsView::CSortColumn::CSortColumn(std::vector<long>& inColumns)
+	: m_Columns(inColumns)
+	, m_iCol(1)
+	, m_bIsSorted(false)
+{
+}
+
+
+void CAgilityBookRunsView::CSortColumn::Initialize()
+{
+	wxConfig::Get()->Read(CFG_SORTING_RUNS_ENABLED, &m_bIsSorted);
+
+	long realCol = IO_RUNS_DATE;
+	realCol = wxConfig::Get()->Read(CFG_SORTING_RUNS, realCol);
+	long neg = 1;
+	if (0 > realCol)
 	{
-		short p1 = pRun1->GetRun()->GetInClass();
-		short p2 = pRun2->GetRun()->GetInClass();
-		if (p1 < p2)
-			nRet = -1;
-		else if (p1 > p2)
-			nRet = 1;
+		neg = -1;
+		realCol *= -1;
 	}
-	break;
-	case IO_RUNS_DOGSQD:
+
+	long col = LookupColumn(realCol);
+	if (0 > m_iCol)
+		col = LookupColumn(IO_RUNS_DATE);
+	m_iCol = col * neg;
+}
+
+
+void CAgilityBookRunsView::CSortColumn::SetSorted(bool bSorted)
+{
+	m_bIsSorted = bSorted;
+	wxConfig::Get()->Write(CFG_SORTING_RUNS_ENABLED, m_bIsSorted);
+}
+
+
+void CAgilityBookRunsView::CSortColumn::SetColumn(long iCol)
+{
+	m_iCol = iCol;
+	if (0 == iCol)
+		return;
+
+	SetSorted(true);
+	long neg = 1;
+	long col = iCol;
+	if (0 > iCol)
 	{
-		short p1 = pRun1->GetRun()->GetDogsQd();
-		short p2 = pRun2->GetRun()->GetDogsQd();
-		if (p1 < p2)
-			nRet = -1;
-		else if (p1 > p2)
-			nRet = 1;
+		neg = -1;
+		col = iCol * -1;
 	}
-	break;
-	case IO_RUNS_Q:
-		if (pRun1->GetRun()->GetQ() < pRun2->GetRun()->GetQ())
-			nRet = -1;
-		else if (pRun1->GetRun()->GetQ() > pRun2->GetRun()->GetQ())
-			nRet = 1;
-		break;
-	case IO_RUNS_SCORE:
+
+	long realCol = m_Columns[col - 1] * neg;
+	wxConfig::Get()->Write(CFG_SORTING_RUNS, realCol);
+}
+
+
+long CAgilityBookRunsView::CSortColumn::LookupColumn(long iCol) const
+{
+	size_t n = m_Columns.size();
+	for (size_t i = 0; i < n; ++i)
 	{
-		bool bOk1 = (pRun1->GetRun()->GetQ().Qualified() || Q::NQ == pRun1->GetRun()->GetQ());
-		bool bOk2 = (pRun2->GetRun()->GetQ().Qualified() || Q::NQ == pRun2->GetRun()->GetQ());
-		if (bOk1 && bOk2)
+		if (m_Columns[i] == iCol)
 		{
-			ARBConfigScoringPtr pScoring1;
-			if (pRun1->GetRun()->GetClub())
-				pRun1->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-					pRun1->GetRun()->GetClub()->GetVenue(),
-					pRun1->GetRun()->GetEvent(),
-					pRun1->GetRun()->GetDivision(),
-					pRun1->GetRun()->GetLevel(),
-					pRun1->GetRun()->GetDate(),
-					nullptr,
-					&pScoring1);
-			ARBConfigScoringPtr pScoring2;
-			if (pRun2->GetRun()->GetClub())
-				pRun2->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-					pRun2->GetRun()->GetClub()->GetVenue(),
-					pRun2->GetRun()->GetEvent(),
-					pRun2->GetRun()->GetDivision(),
-					pRun2->GetRun()->GetLevel(),
-					pRun2->GetRun()->GetDate(),
-					nullptr,
-					&pScoring2);
-			if (pScoring1 && pScoring2)
-			{
-				if (pRun1->GetRun()->GetScore(pScoring1) < pRun2->GetRun()->GetScore(pScoring2))
-					nRet = -1;
-				else if (pRun1->GetRun()->GetScore(pScoring1) > pRun2->GetRun()->GetScore(pScoring2))
-					nRet = 1;
-			}
-			else if (pScoring1)
-				nRet = -1;
-			else if (pScoring2)
-				nRet = 1;
+			return static_cast<long>(i + 1);
 		}
-		else if (bOk1)
-			nRet = 1;
-		else if (bOk2)
-			nRet = -1;
 	}
-	break;
-	case IO_RUNS_TITLE_POINTS:
+	return -1;
+}
+
+
+struct RunsSortInfo
+{
+	CAgilityBookRunsView const* pThis;
+	long nCol;
+
+	RunsSortInfo(CAgilityBookRunsView const* This, long inCol)
+		: pThis(This)
+		, nCol(inCol)
 	{
-		double pts1 = 0;
-		double pts2 = 0;
-		if (pRun1->GetRun()->GetQ().Qualified())
-		{
-			ARBConfigScoringPtr pScoring;
-			if (pRun1->GetRun()->GetClub())
-				pRun1->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-					pRun1->GetRun()->GetClub()->GetVenue(),
-					pRun1->GetRun()->GetEvent(),
-					pRun1->GetRun()->GetDivision(),
-					pRun1->GetRun()->GetLevel(),
-					pRun1->GetRun()->GetDate(),
-					nullptr,
-					&pScoring);
-			if (pScoring)
-				pts1 = pRun1->GetRun()->GetTitlePoints(pScoring);
-		}
-		if (pRun2->GetRun()->GetQ().Qualified())
-		{
-			ARBConfigScoringPtr pScoring;
-			if (pRun2->GetRun()->GetClub())
-				pRun2->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-					pRun2->GetRun()->GetClub()->GetVenue(),
-					pRun2->GetRun()->GetEvent(),
-					pRun2->GetRun()->GetDivision(),
-					pRun2->GetRun()->GetLevel(),
-					pRun2->GetRun()->GetDate(),
-					nullptr,
-					&pScoring);
-			if (pScoring)
-				pts2 = pRun2->GetRun()->GetTitlePoints(pScoring);
-		}
-		if (pts1 < pts2)
+	}
+};
+
+
+int CompareRuns(
+	CAgilityBookRunsViewData const& run1,
+	CAgilityBookRunsViewData const& run2,
+	RunsSortInfo const& sortInfo)
+{
+	CAgilityBookRunsViewData const* pRun1 = &run1;
+	CAgilityBookRunsViewData const* pRun2 = &run2;
+
+	int nRet = 0;
+	long iCol = std::abs(sortInfo.nCol);
+	// Col 0 is special: it has the icons. Instead of saving it,
+	// we simply ignore it - so iCol is always off by 1.
+	long column = sortInfo.pThis->m_Columns[iCol - 1];
+	switch (column)
+	{
+	default:
+	{
+		CAgilityBookRunsViewData::NumericKey const& key1 = pRun1->GetNumericKey(column);
+		CAgilityBookRunsViewData::NumericKey const& key2 = pRun2->GetNumericKey(column);
+		if (key1.rank != key2.rank)
+			nRet = key1.rank < key2.rank ? -1 : 1;
+		else if (key1.value < key2.value)
 			nRet = -1;
-		else if (pts1 > pts2)
+		else if (key1.value > key2.value)
 			nRet = 1;
 	}
 	break;
+
+	case IO_RUNS_REG_NAME:
+	case IO_RUNS_CALL_NAME:
+	case IO_RUNS_VENUE:
+	case IO_RUNS_CLUB:
+	case IO_RUNS_LOCATION:
+	case IO_RUNS_TRIAL_NOTES:
+	case IO_RUNS_DIVISION:
+	case IO_RUNS_LEVEL:
+	case IO_RUNS_EVENT:
+	case IO_RUNS_HEIGHT:
+	case IO_RUNS_JUDGE:
+	case IO_RUNS_HANDLER:
+	case IO_RUNS_CONDITIONS:
 	case IO_RUNS_COMMENTS:
-		nRet = StringUtil::CompareNoCase(pRun1->GetRun()->GetNote(), pRun2->GetRun()->GetNote());
-		break;
 	case IO_RUNS_FAULTS:
-	{
-		wxString str1, str2;
-		ARBDogFaultList::const_iterator iter;
-		int i = 0;
-		for (iter = pRun1->GetRun()->GetFaults().begin(); iter != pRun1->GetRun()->GetFaults().end(); ++i, ++iter)
-		{
-			if (0 < i)
-				str1 += L", ";
-			str1 += *iter;
-		}
-		for (i = 0, iter = pRun2->GetRun()->GetFaults().begin(); iter != pRun2->GetRun()->GetFaults().end();
-			 ++i, ++iter)
-		{
-			if (0 < i)
-				str2 += L", ";
-			str2 += *iter;
-		}
-		if (str1 < str2)
+		nRet = CompareSortKey(pRun1->GetSortKey(column), pRun2->GetSortKey(column));
+		break;
+	case IO_RUNS_Q:
+		if (pRun1->GetRun()->GetQ() < pRun2->GetRun()->GetQ())
 			nRet = -1;
-		else if (str1 > str2)
-			nRet = 1;
-	}
-	break;
-	case IO_RUNS_SPEED:
-	{
-		ARBConfigScoringPtr pScoring1;
-		if (pRun1->GetRun()->GetClub())
-			pRun1->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-				pRun1->GetRun()->GetClub()->GetVenue(),
-				pRun1->GetRun()->GetEvent(),
-				pRun1->GetRun()->GetDivision(),
-				pRun1->GetRun()->GetLevel(),
-				pRun1->GetRun()->GetDate(),
-				nullptr,
-				&pScoring1);
-		ARBConfigScoringPtr pScoring2;
-		if (pRun2->GetRun()->GetClub())
-			pRun2->GetDocument()->Book().GetConfig().GetVenues().FindEvent(
-				pRun2->GetRun()->GetClub()->GetVenue(),
-				pRun2->GetRun()->GetEvent(),
-				pRun2->GetRun()->GetDivision(),
-				pRun2->GetRun()->GetLevel(),
-				pRun2->GetRun()->GetDate(),
-				nullptr,
-				&pScoring2);
-		int pts1 = -1;
-		int pts2 = -1;
-		if (pScoring1 && pScoring2)
-		{
-			if (pScoring1->HasSpeedPts())
-				pts1 = pRun1->GetRun()->GetSpeedPoints(pScoring1);
-			if (pScoring2->HasSpeedPts())
-				pts2 = pRun2->GetRun()->GetSpeedPoints(pScoring2);
-		}
-		if (pts1 > pts2)
+		else if (pRun1->GetRun()->GetQ() > pRun2->GetRun()->GetQ())
 			nRet = 1;
-		else if (pts1 < pts2)
-			nRet = -1;
-	}
-	break;
+		break;
 	}
-	if (0 > pInfo->nCol)
+	if (0 > sortInfo.nCol)
 		nRet *= -1;
 	return nRet;
 }
@@ -1150,36 +1124,28 @@ bool CAgilityBookRunsView::CFindData::Search(CDlgFind* pDlg)
 		index = 0;
 	else if (index >= m_pView->m_Ctrl->GetItemCount() && !SearchDown())
 		index = m_pView->m_Ctrl->GetItemCount() - 1;
+	// Only items the index says may match need to be compared.
+	std::unordered_set<ARBBase const*> candidates;
+	bool bUseIndex = SearchAll() && m_pView->GetDocument()->GetSearchCandidates(Text(), candidates);
 	for (; !bFound && 0 <= index && index < m_pView->m_Ctrl->GetItemCount(); index += inc)
 	{
-		std::set<wxString> strings;
 		if (SearchAll())
 		{
 			CAgilityBookRunsViewDataPtr pData = m_pView->GetItemRunData(index);
-			if (pData)
-				pData->GetRun()->GetSearchStrings(strings);
+			if (pData && (!bUseIndex || 0 < candidates.count(pData->GetRun().get())))
+				bFound = !pData->GetRun()->ForEachSearchString([this](wxString const& str) { return !Compare(str); });
 		}
 		else
 		{
+			CAgilityBookRunsViewDataPtr pData = m_pView->GetItemRunData(index);
 			long nColumns = m_pView->m_Ctrl->GetColumnCount();
-			for (long i = 0; i < nColumns; ++i)
-			{
-				wxListItem info;
-				info.SetId(index);
-				info.SetMask(wxLIST_MASK_TEXT);
-				info.SetColumn(i);
-				m_pView->m_Ctrl->GetItem(info);
-				strings.insert(info.GetText());
-			}
-		}
-		for (auto const& str : strings)
-		{
-			if (Compare(str))
+			for (long i = 0; pData && !bFound && i < nColumns; ++i)
 			{
-				m_pView->m_Ctrl->SetSelection(index, true);
-				bFound = true;
+				bFound = Compare(pData->OnNeedText(i));
 			}
 		}
+		if (bFound)
+			m_pView->m_Ctrl->SetSelection(index, true);
 	}
 	if (!bFound)
 	{
@@ -1289,7 +1255,7 @@ bool CAgilityBookRunsView::Create(
 	int sizerFlags,
 	int border)
 {
-	m_Ctrl = new CReportListCtrl(parentCtrl, false);
+	m_Ctrl = new CAgilityBookRunsListCtrl(parentCtrl);
 	m_Ctrl->Bind(wxEVT_SET_FOCUS, &CAgilityBookRunsView::OnCtrlSetFocus, this);
 	m_Ctrl->Bind(wxEVT_COMMAND_LIST_COL_CLICK, &CAgilityBookRunsView::OnCtrlColumnClick, this);
 	m_Ctrl->Bind(wxEVT_COMMAND_LIST_ITEM_SELECTED, &CAgilityBookRunsView::OnCtrlItemSelected, this);
@@ -1304,6 +1270,12 @@ bool CAgilityBookRunsView::Create(
 }
 
 
+wxWindow* CAgilityBookRunsView::GetControl()
+{
+	return m_Ctrl;
+}
+
+
 bool CAgilityBookRunsView::PrevPane()
 {
 	if (m_parentPanel)
@@ -1414,6 +1386,10 @@ void CAgilityBookRunsView::OnUpdate(wxView* sender, wxObject* inHint)
 			SetupColumns();
 			bLoad = true;
 		}
+		else if (hint->IsSet(UPDATE_RUNS_VIEW) && UpdateChange::None != hint->GetChange())
+		{
+			RefreshChanged(hint->GetChange(), hint->GetChanged());
+		}
 		else if (hint->IsSet(UPDATE_RUNS_VIEW) || hint->IsEqual(UPDATE_CONFIG) || hint->IsEqual(UPDATE_OPTIONS))
 		{
 			bLoad = true;
@@ -1436,20 +1412,65 @@ void CAgilityBookRunsView::OnUpdate(wxView* sender, wxObject* inHint)
 }
 
 
-void CAgilityBookRunsView::SetSelectedRun(ARBDogRunPtr pRun)
+void CAgilityBookRunsView::RefreshChanged(UpdateChange change, std::vector<ARBBasePtr> const& inChanged)
 {
-	if (pRun)
+	// An edited run may change the multi-Qs of the other runs in its trial,
+	// so all the runs in the trial are refreshed.
+	std::set<ARBBase const*> dogs;
+	std::set<ARBBase const*> trials;
+	for (auto const& pBase : inChanged)
 	{
-		for (int i = 0; i < m_Ctrl->GetItemCount(); ++i)
+		switch (change)
 		{
-			CAgilityBookRunsViewDataPtr pData = GetItemRunData(i);
-			if (pData && pData->GetRun() == pRun)
+		case UpdateChange::Dog:
+			dogs.insert(pBase.get());
+			break;
+		case UpdateChange::Trial:
+			trials.insert(pBase.get());
+			break;
+		case UpdateChange::Run:
+			for (int index = 0; index < m_Ctrl->GetItemCount(); ++index)
 			{
-				m_Ctrl->SetSelection(i, true);
-				break;
+				CAgilityBookRunsViewDataPtr pData = GetItemRunData(index);
+				if (pData && pData->GetRun() == pBase)
+				{
+					trials.insert(pData->GetTrial().get());
+					break;
+				}
 			}
+			break;
+		default:
+			break;
+		}
+	}
+	if (dogs.empty() && trials.empty())
+		return;
+
+	for (int index = 0; index < m_Ctrl->GetItemCount(); ++index)
+	{
+		CAgilityBookRunsViewDataPtr pData = GetItemRunData(index);
+		if (pData && (0 < dogs.count(pData->GetDog().get()) || 0 < trials.count(pData->GetTrial().get())))
+		{
+			pData->Invalidate();
+			m_Ctrl->RefreshItem(index);
 		}
 	}
+	if (m_SortColumn.IsSorted())
+	{
+		SortRuns();
+		if (0 <= m_Ctrl->GetFirstSelected())
+			m_Ctrl->Focus(m_Ctrl->GetFirstSelected());
+	}
+	if (m_Ctrl->IsShownOnScreen())
+		UpdateMessages();
+}
+
+
+void CAgilityBookRunsView::SetSelectedRun(ARBDogRunPtr pRun)
+{
+	long index = m_Ctrl->FindRow(pRun);
+	if (0 <= index)
+		m_Ctrl->SetSelection(index, true);
 }
 
 
@@ -1488,7 +1509,7 @@ CAgilityBookRunsViewDataPtr CAgilityBookRunsView::GetItemRunData(long index) con
 {
 	if (!m_Ctrl)
 		return CAgilityBookRunsViewDataPtr();
-	return std::dynamic_pointer_cast<CAgilityBookRunsViewData, CListData>(m_Ctrl->GetData(index));
+	return m_Ctrl->GetData(index);
 }
 
 
@@ -1572,13 +1593,8 @@ void CAgilityBookRunsView::LoadData()
 	// Reduce flicker.
 	m_Ctrl->Freeze();
 
-	// Clear everything.
-	m_Ctrl->DeleteAllItems();
-	STACK_TICKLE(stack, L"Post DeleteAllItems");
-
-	// Add items.
-	std::vector<CVenueFilter> venues;
-	CFilterOptions::Options().GetFilterVenue(venues);
+	// Collect the rows.
+	CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 	std::list<ARBDogTrialPtr> trials;
 	ARBDogPtr pDog = GetDocument()->GetCurrentDog();
 	ARBDogTrialPtr pCurTrial = GetDocument()->GetCurrentTrial();
@@ -1597,43 +1613,32 @@ void CAgilityBookRunsView::LoadData()
 		}
 	}
 	STACK_TICKLE(stack, L"Post trial search");
-	int nQs = 0;
-	if (0 < trials.size())
-	{
-		int i = 0;
-		for (std::list<ARBDogTrialPtr>::iterator iter = trials.begin(); iter != trials.end(); ++iter)
+	// The list is virtual: the control only gets the row count. A row's text
+	// is computed when it is first asked for, by painting or the column
+	// sizing sample.
+	std::vector<CAgilityBookRunsViewDataPtr> rows;
+	for (std::list<ARBDogTrialPtr>::iterator iter = trials.begin(); iter != trials.end(); ++iter)
+	{
+		ARBDogTrialPtr pTrial = (*iter);
+		for (ARBDogRunList::iterator iterRun = pTrial->GetRuns().begin(); iterRun != pTrial->GetRuns().end();
+			 ++iterRun)
 		{
-			ARBDogTrialPtr pTrial = (*iter);
-			for (ARBDogRunList::iterator iterRun = pTrial->GetRuns().begin(); iterRun != pTrial->GetRuns().end();
-				 ++i, ++iterRun)
-			{
-				ARBDogRunPtr pRun = (*iterRun);
-				if (pRun->IsFiltered())
-					continue;
-				if (pRun->GetQ().Qualified())
-					++nQs;
-
-				long index = m_Ctrl->InsertItem(std::make_shared<CAgilityBookRunsViewData>(this, pDog, pTrial, pRun));
-				// Compare by ptr, not value.
-				if (pCurRun && pCurRun == pRun)
-				{
-					m_Ctrl->Select(index, true);
-				}
-			}
+			ARBDogRunPtr pRun = (*iterRun);
+			if (!pRun->IsFiltered())
+				rows.push_back(std::make_shared<CAgilityBookRunsViewData>(this, pDog, pTrial, pRun));
 		}
 	}
+	m_Ctrl->SetRows(std::move(rows));
 	STACK_TICKLE(stack, L"Post trial insertion");
-	int nColumnCount = m_Ctrl->GetColumnCount();
-	for (int i = 0; i < nColumnCount; ++i)
-		m_Ctrl->SetColumnWidth(i, wxLIST_AUTOSIZE_USEHEADER);
+	SizeColumns();
+	STACK_TICKLE(stack, L"Post column sizing");
 
 	if (m_Ctrl->IsShownOnScreen())
 		UpdateMessages();
 
 	if (m_SortColumn.IsSorted())
 	{
-		RunsSortInfo sortInfo(this, m_SortColumn.GetColumn());
-		m_Ctrl->SortItems(CompareRuns, &sortInfo);
+		SortRuns();
 		if (0 == m_SortColumn.GetColumn())
 			m_Ctrl->SetColumnSort(std::abs(m_SortColumn.GetColumn()), 0);
 		else
@@ -1642,9 +1647,13 @@ void CAgilityBookRunsView::LoadData()
 	else
 		m_Ctrl->SetColumnSort(std::abs(m_SortColumn.GetColumn()), 0);
 
-	// Now make sure the selected item is visible.
-	if (0 <= m_Ctrl->GetFirstSelected())
-		m_Ctrl->Focus(m_Ctrl->GetFirstSelected());
+	// Mirror the selection in the tree, and make sure it is visible.
+	long index = m_Ctrl->FindRow(pCurRun);
+	if (0 <= index)
+	{
+		m_Ctrl->Select(index, true);
+		m_Ctrl->Focus(index);
+	}
 
 	// Cleanup.
 	m_Ctrl->Thaw();
@@ -1654,6 +1663,80 @@ void CAgilityBookRunsView::LoadData()
 }
 
 
+void CAgilityBookRunsView::SortRuns()
+{
+	// Reselecting the sorted rows must not resync the tree.
+	bool bSuppress = m_bSuppressSelect;
+	m_bSuppressSelect = true;
+	RunsSortInfo sortInfo(this, m_SortColumn.GetColumn());
+	m_Ctrl->SortRows([&sortInfo](CAgilityBookRunsViewDataPtr const& one, CAgilityBookRunsViewDataPtr const& two) {
+		return 0 > CompareRuns(*one, *two, sortInfo);
+	});
+	m_bSuppressSelect = bSuppress;
+}
+
+
+// Autosizing measures every cell in a column. With thousands of runs, that
+// is the bulk of the load time, so only measure a sample of the rows: the
+// first and last screenfuls plus an even spread of the rest.
+void CAgilityBookRunsView::SizeColumns()
+{
+	constexpr long nEnds = 50;
+	constexpr long nSpread = 100;
+
+	long nItems = m_Ctrl->GetItemCount();
+	std::vector<long> rows;
+	if (nItems <= 2 * nEnds + nSpread)
+	{
+		for (long i = 0; i < nItems; ++i)
+			rows.push_back(i);
+	}
+	else
+	{
+		for (long i = 0; i < nEnds; ++i)
+		{
+			rows.push_back(i);
+			rows.push_back(nItems - 1 - i);
+		}
+		long step = (nItems - 2 * nEnds) / nSpread;
+		for (long i = 0; i < nSpread; ++i)
+			rows.push_back(nEnds + i * step);
+	}
+	std::vector<CAgilityBookRunsViewDataPtr> data;
+	data.reserve(rows.size());
+	for (long row : rows)
+	{
+		CAgilityBookRunsViewDataPtr pData = GetItemRunData(row);
+		if (pData)
+			data.push_back(pData);
+	}
+
+	int cxImage = 0;
+	int cyImage = 0;
+	wxImageList* pImages = m_Ctrl->GetImageList(wxIMAGE_LIST_SMALL);
+	if (pImages && 0 < pImages->GetImageCount())
+		pImages->GetSize(0, cxImage, cyImage);
+	// Room for the cell margins and the header sort arrow.
+	int const cxPad = 2 * m_Ctrl->GetCharWidth() + cxImage;
+
+	int nColumnCount = m_Ctrl->GetColumnCount();
+	for (int i = 0; i < nColumnCount; ++i)
+	{
+		wxListItem info;
+		info.SetMask(wxLIST_MASK_TEXT);
+		m_Ctrl->GetColumn(i, info);
+		int width = m_Ctrl->GetTextExtent(info.GetText()).GetWidth();
+		for (auto const& pData : data)
+		{
+			wxString str = pData->OnNeedText(i);
+			if (!str.empty())
+				width = std::max(width, m_Ctrl->GetTextExtent(str).GetWidth());
+		}
+		m_Ctrl->SetColumnWidth(i, width + cxPad);
+	}
+}
+
+
 void CAgilityBookRunsView::OnCtrlSetFocus(wxFocusEvent& evt)
 {
 	// We need this as clicking directly in the control does not change
@@ -1677,8 +1760,7 @@ void CAgilityBookRunsView::OnCtrlColumnClick(wxListEvent& evt)
 		if (m_SortColumn.GetColumn() == evt.GetColumn())
 			nBackwards = -1;
 		m_SortColumn.SetColumn(evt.GetColumn() * nBackwards);
-		RunsSortInfo sortInfo(this, m_SortColumn.GetColumn());
-		m_Ctrl->SortItems(CompareRuns, &sortInfo);
+		SortRuns();
 		m_Ctrl->SetColumnSort(std::abs(m_SortColumn.GetColumn()), m_SortColumn.GetColumn());
 
 		if (0 <= m_Ctrl->GetFirstSelected())
@@ -2088,8 +2170,7 @@ bool CAgilityBookRunsView::OnCmd(int id, bool bSilent)
 		m_SortColumn.SetSorted(!m_SortColumn.IsSorted());
 		if (m_SortColumn.IsSorted())
 		{
-			RunsSortInfo sortInfo(this, m_SortColumn.GetColumn());
-			m_Ctrl->SortItems(CompareRuns, &sortInfo);
+			SortRuns();
 			m_Ctrl->SetColumnSort(std::abs(m_SortColumn.GetColumn()), m_SortColumn.GetColumn());
 
 			if (0 <= m_Ctrl->GetFirstSelected())
@@ -12,6 +12,9 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Use a virtual list control.
+ * 2026-10-19 Refresh just the rows of edited trials/runs when possible.
+ * 2026-10-19 Size columns from a sample of rows.
  * 2014-05-21 Enable paste of copied runs.
  * 2014-04-12 Implement unsorting.
  * 2009-02-04 Ported to wxWidgets.
@@ -28,24 +31,26 @@
 #include "CommonView.h"
 
 #include "LibARBWin/DlgFind.h"
-#include "LibARBWin/ReportListCtrl.h"
 #include <wx/docview.h>
+#include <wx/listctrl.h>
 
 
 namespace dconSoft
 {
+class CAgilityBookRunsListCtrl;
 class CAgilityBookRunsView;
 class CAgilityBookRunsViewData;
+struct RunsSortInfo;
 
 typedef std::shared_ptr<CAgilityBookRunsViewData> CAgilityBookRunsViewDataPtr;
 
 
 class CAgilityBookRunsView : public CAgilityBookBaseExtraView
 {
-	friend int wxCALLBACK CompareRuns(
-		ARBWin::CListDataPtr const& item1,
-		ARBWin::CListDataPtr const& item2,
-		ARBWin::SortInfo const* pSortInfo);
+	friend int CompareRuns(
+		CAgilityBookRunsViewData const& run1,
+		CAgilityBookRunsViewData const& run2,
+		RunsSortInfo const& sortInfo);
 	friend class CAgilityBookRunsViewData;
 	DECLARE_CLASS(CAgilityBookRunsView)
 	DECLARE_NO_COPY_IMPLEMENTED(CAgilityBookRunsView)
@@ -63,10 +68,7 @@ public:
 		int proportion = 0,
 		int sizerFlags = 0,
 		int border = 0) override;
-	wxWindow* GetControl() override
-	{
-		return m_Ctrl;
-	}
+	wxWindow* GetControl() override;
 	bool HasPrevPane() const override
 	{
 		return true;
@@ -101,11 +103,14 @@ private:
 	CAgilityBookRunsViewDataPtr GetItemRunData(long index) const;
 	bool GetUnifiedTrial(ARB::ARBDogPtr& pDog, ARB::ARBDogTrialPtr& pTrial, bool bSelectionOnly = true) const;
 	void SetupColumns();
+	void SizeColumns();
+	void SortRuns();
 	void LoadData();
+	void RefreshChanged(UpdateChange change, std::vector<ARB::ARBBasePtr> const& inChanged);
 	void SetSelectedRun(ARB::ARBDogRunPtr pRun);
 	bool OnCmd(int id, bool bSilent = false);
 
-	ARBWin::CReportListCtrl* m_Ctrl;
+	CAgilityBookRunsListCtrl* m_Ctrl;
 	int m_imgCourse;
 	int m_imgMap;
 	bool m_bSuppressSelect;
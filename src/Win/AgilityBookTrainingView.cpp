@@ -10,6 +10,9 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Find uses the document search index.
+ * 2026-10-19 Find stops at the first matching string.
+ * 2026-10-19 Sort text columns using precomputed keys.
  * 2015-04-22 Specifically use std::abs, on mac it used abs(int).
  * 2012-12-29 Update training view properly after a paste.
  * 2011-12-22 Switch to using Bind on wx2.9+.
@@ -45,6 +48,7 @@
 #include "RegItems.h"
 
 #include "ARB/ARBTraining.h"
+#include "ARB/ARBSortKey.h"
 #include "ARBCommon/Element.h"
 #include "ARBCommon/StringUtil.h"
 #include "LibARBWin/DlgFind.h"
@@ -94,10 +98,13 @@ public:
 	}
 	wxString OnNeedText(long iCol) const override;
 	void OnNeedListItem(long iCol, wxListItem& info) const override;
+	// Collation key for text columns (IO_LOG_* value, not list column).
+	std::wstring const& GetSortKey(long inColumn) const;
 
 private:
 	CAgilityBookTrainingView* m_pView;
 	ARBTrainingPtr m_pTraining;
+	mutable ARBSortKeyCache m_SortKeys;
 };
 
 
@@ -200,6 +207,24 @@ long CAgilityBookTrainingView::CSortColumn::LookupColumn(long iCol) const
 }
 
 
+std::wstring const& CAgilityBookTrainingViewData::GetSortKey(long inColumn) const
+{
+	return m_SortKeys.Get(inColumn, [this, inColumn]() {
+		switch (inColumn)
+		{
+		default:
+			return wxString();
+		case IO_LOG_NAME:
+			return m_pTraining->GetName();
+		case IO_LOG_SUBNAME:
+			return m_pTraining->GetSubName();
+		case IO_LOG_NOTES:
+			return m_pTraining->GetNote();
+		}
+	});
+}
+
+
 struct TrainingSortInfo : public SortInfo
 {
 	CAgilityBookTrainingView* pThis;
@@ -225,7 +250,8 @@ int wxCALLBACK CompareTraining(CListDataPtr const& item1, CListDataPtr const& it
 
 	int nRet = 0;
 	int iCol = std::abs(pInfo->nCol);
-	switch (pInfo->pThis->m_Columns[iCol - 1])
+	long column = pInfo->pThis->m_Columns[iCol - 1];
+	switch (column)
 	{
 	case IO_LOG_DATE:
 		if (pItem1->GetTraining()->GetDate() < pItem2->GetTraining()->GetDate())
@@ -234,13 +260,9 @@ int wxCALLBACK CompareTraining(CListDataPtr const& item1, CListDataPtr const& it
 			nRet = 1;
 		break;
 	case IO_LOG_NAME:
-		nRet = StringUtil::CompareNoCase(pItem1->GetTraining()->GetName(), pItem2->GetTraining()->GetName());
-		break;
 	case IO_LOG_SUBNAME:
-		nRet = StringUtil::CompareNoCase(pItem1->GetTraining()->GetSubName(), pItem2->GetTraining()->GetSubName());
-		break;
 	case IO_LOG_NOTES:
-		nRet = StringUtil::CompareNoCase(pItem1->GetTraining()->GetNote(), pItem2->GetTraining()->GetNote());
+		nRet = CompareSortKey(pItem1->GetSortKey(column), pItem2->GetSortKey(column));
 		break;
 	default:
 		break;
@@ -274,36 +296,34 @@ bool CAgilityBookTrainingView::CFindData::Search(CDlgFind* pDlg)
 		index = 0;
 	else if (index >= m_pView->m_Ctrl->GetItemCount() && !SearchDown())
 		index = m_pView->m_Ctrl->GetItemCount() - 1;
+	// Only items the index says may match need to be compared.
+	std::unordered_set<ARBBase const*> candidates;
+	bool bUseIndex = SearchAll() && m_pView->GetDocument()->GetSearchCandidates(Text(), candidates);
 	for (; !bFound && 0 <= index && index < m_pView->m_Ctrl->GetItemCount(); index += inc)
 	{
-		std::set<wxString> strings;
 		if (SearchAll())
 		{
 			CAgilityBookTrainingViewDataPtr pData = m_pView->GetItemTrainingData(index);
-			if (pData)
-				pData->GetTraining()->GetSearchStrings(strings);
+			if (pData && (!bUseIndex || 0 < candidates.count(pData->GetTraining().get())))
+				bFound = !pData->GetTraining()->ForEachSearchString([this](wxString const& str) { return !Compare(str); });
 		}
 		else
 		{
 			long nColumns = m_pView->m_Ctrl->GetColumnCount();
-			for (long i = 0; i < nColumns; ++i)
+			for (long i = 0; !bFound && i < nColumns; ++i)
 			{
 				wxListItem info;
 				info.SetId(index);
 				info.SetMask(wxLIST_MASK_TEXT);
 				info.SetColumn(i);
 				m_pView->m_Ctrl->GetItem(info);
-				strings.insert(info.GetText());
+				bFound = Compare(info.GetText());
 			}
 		}
-		for (auto const& str : strings)
+		if (bFound)
 		{
-			if (Compare(str))
-			{
-				m_pView->m_Ctrl->Select(index, true);
-				m_pView->m_Ctrl->Focus(index);
-				bFound = true;
-			}
+			m_pView->m_Ctrl->Select(index, true);
+			m_pView->m_Ctrl->Focus(index);
 		}
 	}
 	if (!bFound)
@@ -869,7 +889,7 @@ bool CAgilityBookTrainingView::OnCmd(int id)
 			{
 				GetDocument()->Book().GetTraining().sort();
 				LoadData();
-				GetDocument()->Modify(true);
+				GetDocument()->ModifyObject(pData->GetTraining());
 				m_Ctrl->Refresh();
 				int nColumnCount = m_Ctrl->GetColumnCount();
 				for (int i = 0; i < nColumnCount; ++i)
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Keep runs sorted on duplicate instead of resorting.
  * 2021-05-04 Deleting a dog did not properly update views.
  * 2018-09-15 Refactored how tree/list handle common actions.
  * 2015-11-27 Use subname for event, if set.
@@ -661,8 +662,7 @@ bool CAgilityBookTreeDataRun::DoDuplicate()
 		return false;
 	CAgilityBookDoc* pDoc = m_pTree->GetDocument();
 	ARBDogRunPtr pRun = GetRun()->Clone();
-	GetTrial()->GetRuns().AddRun(pRun);
-	GetTrial()->GetRuns().sort();
+	GetTrial()->GetRuns().InsertRun(pRun);
 	CUpdateHint hint(UPDATE_TREE_VIEW | UPDATE_RUNS_VIEW | UPDATE_POINTS_VIEW);
 	pDoc->UpdateAllViews(nullptr, &hint);
 	pDoc->Modify(true);
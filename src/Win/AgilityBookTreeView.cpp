@@ -10,6 +10,11 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Refresh just the edited trial/run nodes when possible.
+ * 2026-10-19 Create trial and run nodes when their parent is expanded.
+ * 2026-10-19 Find uses the document search index.
+ * 2026-10-19 Find stops at the first matching string.
+ * 2026-10-19 Keep trials/runs sorted on paste instead of resorting.
  * 2022-04-15 Use wx DPI support.
  * 2019-01-01 Fix selection on initial load.
  * 2018-09-15 Refactored how tree/list handle common actions.
@@ -98,6 +103,8 @@ void CAgilityBookTreeView::CFindData::FillTree(wxTreeItemId hItem)
 	if (m_pView->m_Ctrl->GetRootItem() != hItem)
 		m_Items.push_back(hItem);
 
+	// Find searches everything, not just what has been expanded.
+	m_pView->LoadChildren(hItem);
 	wxTreeItemIdValue cookie;
 	wxTreeItemId hChildItem = m_pView->m_Ctrl->GetFirstChild(hItem, cookie);
 	while (hChildItem.IsOk())
@@ -161,27 +168,23 @@ bool CAgilityBookTreeView::CFindData::Search(CDlgFind* pDlg)
 		}
 		hItem = GetNextItem();
 	}
+	// Only items the index says may match need to be compared.
+	std::unordered_set<ARBBase const*> candidates;
+	bool bUseIndex = SearchAll() && m_pView->GetDocument()->GetSearchCandidates(Text(), candidates);
 	while (!bFound && hItem.IsOk())
 	{
-		std::set<wxString> strings;
 		if (SearchAll())
 		{
 			CAgilityBookTreeData* pData = m_pView->GetTreeItem(hItem);
-			if (pData)
-				pData->GetARBBase()->GetSearchStrings(strings);
+			if (pData && (!bUseIndex || 0 < candidates.count(pData->GetARBBase().get())))
+				bFound = !pData->GetARBBase()->ForEachSearchString([this](wxString const& str) { return !Compare(str); });
 		}
 		else
 		{
-			strings.insert(m_pView->m_Ctrl->GetItemText(hItem));
-		}
-		for (auto const& str : strings)
-		{
-			if (Compare(str))
-			{
-				m_pView->ChangeSelection(hItem);
-				bFound = true;
-			}
+			bFound = Compare(m_pView->m_Ctrl->GetItemText(hItem));
 		}
+		if (bFound)
+			m_pView->ChangeSelection(hItem);
 		hItem = GetNextItem();
 	}
 	if (!bFound)
@@ -317,6 +320,7 @@ bool CAgilityBookTreeView::Create(
 	m_Ctrl->Bind(wxEVT_COMMAND_TREE_ITEM_MENU, &CAgilityBookTreeView::OnCtrlContextMenu, this);
 	m_Ctrl->Bind(wxEVT_COMMAND_TREE_SEL_CHANGED, &CAgilityBookTreeView::OnCtrlSelectionChanged, this);
 	m_Ctrl->Bind(wxEVT_COMMAND_TREE_ITEM_ACTIVATED, &CAgilityBookTreeView::OnCtrlItemActivated, this);
+	m_Ctrl->Bind(wxEVT_COMMAND_TREE_ITEM_EXPANDING, &CAgilityBookTreeView::OnCtrlItemExpanding, this);
 	m_ImageList.Create(m_Ctrl);
 	m_Ctrl->SetImageList(&m_ImageList);
 #ifdef WX_TREE_HAS_STATE
@@ -384,7 +388,11 @@ void CAgilityBookTreeView::OnUpdate(wxView* sender, wxObject* inHint)
 	CUpdateHint* hint = nullptr;
 	if (inHint)
 		hint = wxDynamicCast(inHint, CUpdateHint);
-	if (!hint || hint->IsSet(UPDATE_TREE_VIEW) || hint->IsEqual(UPDATE_CONFIG) || hint->IsEqual(UPDATE_OPTIONS))
+	if (hint && hint->IsSet(UPDATE_TREE_VIEW) && UpdateChange::None != hint->GetChange())
+	{
+		RefreshChanged(hint->GetChange(), hint->GetChanged());
+	}
+	else if (!hint || hint->IsSet(UPDATE_TREE_VIEW) || hint->IsEqual(UPDATE_CONFIG) || hint->IsEqual(UPDATE_OPTIONS))
 	{
 		LoadData();
 	}
@@ -452,6 +460,34 @@ void CAgilityBookTreeView::RefreshItem(wxTreeItemId item, bool bRecurse)
 }
 
 
+void CAgilityBookTreeView::RefreshChanged(UpdateChange change, std::vector<ARBBasePtr> const& inChanged)
+{
+	for (auto const& pBase : inChanged)
+	{
+		// A run's trial shows the run dates and the multi-Qs in the trial may
+		// have changed, so refresh the whole trial. Nodes that haven't been
+		// loaded yet will get the new text when they are.
+		CAgilityBookTreeData* pData = nullptr;
+		switch (change)
+		{
+		case UpdateChange::Dog:
+		case UpdateChange::Trial:
+			pData = FindData(pBase);
+			break;
+		case UpdateChange::Run:
+			pData = FindData(pBase);
+			if (pData)
+				pData = GetTreeItem(m_Ctrl->GetItemParent(pData->GetId()));
+			break;
+		default:
+			break;
+		}
+		if (pData)
+			RefreshItem(pData->GetId(), true);
+	}
+}
+
+
 CAgilityBookTreeData* CAgilityBookTreeView::GetCurrentTreeItem() const
 {
 	if (m_Ctrl && m_Ctrl->GetSelection().IsOk())
@@ -496,8 +532,9 @@ CAgilityBookTreeData* CAgilityBookTreeView::FindData(wxTreeItemId hItem, ARBBase
 		if (pCheck && pCheck->GetARBBase() == inBase)
 			pData = pCheck;
 	}
-	if (!pData)
+	if (!pData && MayContain(hItem, inBase))
 	{
+		LoadChildren(hItem);
 		wxTreeItemIdValue cookie;
 		wxTreeItemId hChildItem = m_Ctrl->GetFirstChild(hItem, cookie);
 		while (hChildItem.IsOk() && !pData)
@@ -523,8 +560,9 @@ CAgilityBookTreeData* CAgilityBookTreeView::FindData(wxTreeItemId hItem, ARB::AR
 		if (pCheck && pCheck->GetDog() == inDog)
 			pData = pCheck;
 	}
-	if (!pData)
+	if (!pData && MayContain(hItem, inDog))
 	{
+		LoadChildren(hItem);
 		wxTreeItemIdValue cookie;
 		wxTreeItemId hChildItem = m_Ctrl->GetFirstChild(hItem, cookie);
 		while (hChildItem.IsOk() && !pData)
@@ -548,8 +586,9 @@ CAgilityBookTreeData* CAgilityBookTreeView::FindData(wxTreeItemId hItem, ARB::AR
 		if (pCheck && pCheck->GetTrial() == inTrial)
 			pData = pCheck;
 	}
-	if (!pData)
+	if (!pData && MayContain(hItem, inTrial))
 	{
+		LoadChildren(hItem);
 		wxTreeItemIdValue cookie;
 		wxTreeItemId hChildItem = m_Ctrl->GetFirstChild(hItem, cookie);
 		while (hChildItem.IsOk() && !pData)
@@ -573,8 +612,9 @@ CAgilityBookTreeData* CAgilityBookTreeView::FindData(wxTreeItemId hItem, ARB::AR
 		if (pCheck && pCheck->GetRun() == inRun)
 			pData = pCheck;
 	}
-	if (!pData)
+	if (!pData && MayContain(hItem, inRun))
 	{
+		LoadChildren(hItem);
 		wxTreeItemIdValue cookie;
 		wxTreeItemId hChildItem = m_Ctrl->GetFirstChild(hItem, cookie);
 		while (hChildItem.IsOk() && !pData)
@@ -587,6 +627,65 @@ CAgilityBookTreeData* CAgilityBookTreeView::FindData(wxTreeItemId hItem, ARB::AR
 }
 
 
+bool CAgilityBookTreeView::MayContain(wxTreeItemId hItem, ARBBasePtr const& inBase) const
+{
+	if (m_Ctrl->GetRootItem() == hItem)
+		return true;
+	CAgilityBookTreeData* pData = GetTreeItem(hItem);
+	if (!pData)
+		return false;
+	ARBBase const* pBase = inBase.get();
+	auto trialHasRun = [pBase](ARBDogTrialPtr const& inTrial) {
+		for (auto const& pRun : inTrial->GetRuns())
+		{
+			if (pRun.get() == pBase)
+				return true;
+		}
+		return false;
+	};
+	switch (pData->GetType())
+	{
+	case ARBTreeDataType::Dog:
+		for (auto const& pTrial : pData->GetDog()->GetTrials())
+		{
+			if (pTrial.get() == pBase || trialHasRun(pTrial))
+				return true;
+		}
+		break;
+	case ARBTreeDataType::Trial:
+		return trialHasRun(pData->GetTrial());
+	case ARBTreeDataType::Run:
+		break;
+	}
+	return false;
+}
+
+
+void CAgilityBookTreeView::LoadChildren(wxTreeItemId hItem) const
+{
+	if (!m_Ctrl || !hItem.IsOk() || m_Ctrl->GetRootItem() == hItem)
+		return;
+	// Nodes that haven't been loaded are flagged as having children, but don't.
+	if (!m_Ctrl->ItemHasChildren(hItem) || 0 < m_Ctrl->GetChildrenCount(hItem, false))
+		return;
+	CAgilityBookTreeView* pThis = const_cast<CAgilityBookTreeView*>(this);
+	CAgilityBookTreeData* pData = GetTreeItem(hItem);
+	if (pData && ARBTreeDataType::Dog == pData->GetType())
+	{
+		for (auto const& pTrial : pData->GetDog()->GetTrials())
+			pThis->AppendTrial(pTrial, hItem);
+	}
+	else if (pData && ARBTreeDataType::Trial == pData->GetType())
+	{
+		ARBDogTrialPtr pTrial = pData->GetTrial();
+		for (auto const& pRun : pTrial->GetRuns())
+			pThis->AppendRun(pTrial, pRun, hItem);
+	}
+	if (0 == m_Ctrl->GetChildrenCount(hItem, false))
+		m_Ctrl->SetItemHasChildren(hItem, false);
+}
+
+
 wxTreeItemId CAgilityBookTreeView::InsertDog(ARBDogPtr const& inDog, bool bSelect)
 {
 	wxTreeItemId hItem;
@@ -595,11 +694,14 @@ wxTreeItemId CAgilityBookTreeView::InsertDog(ARBDogPtr const& inDog, bool bSelec
 		CAgilityBookTreeDataDog* pDataDog = new CAgilityBookTreeDataDog(this, inDog);
 		int idxImage = pDataDog->OnNeedIcon();
 		hItem = m_Ctrl->AppendItem(m_Ctrl->GetRootItem(), pDataDog->OnNeedText(), idxImage, idxImage, pDataDog);
-		for (ARBDogTrialList::const_iterator iterTrial = inDog->GetTrials().begin();
-			 iterTrial != inDog->GetTrials().end();
-			 ++iterTrial)
+		// Trials are added when the dog is expanded.
+		for (auto const& pTrial : inDog->GetTrials())
 		{
-			InsertTrial((*iterTrial), hItem);
+			if (!pTrial->IsFiltered())
+			{
+				m_Ctrl->SetItemHasChildren(hItem, true);
+				break;
+			}
 		}
 		if (bSelect)
 		{
@@ -611,6 +713,39 @@ wxTreeItemId CAgilityBookTreeView::InsertDog(ARBDogPtr const& inDog, bool bSelec
 
 
 wxTreeItemId CAgilityBookTreeView::InsertTrial(ARBDogTrialPtr const& inTrial, wxTreeItemId hParent)
+{
+	if (!m_Ctrl || !hParent.IsOk())
+		return wxTreeItemId();
+	// If the dog hasn't been loaded yet, loading it picks up the new trial.
+	if (m_Ctrl->ItemHasChildren(hParent) && 0 == m_Ctrl->GetChildrenCount(hParent, false))
+	{
+		LoadChildren(hParent);
+		CAgilityBookTreeData* pData = FindData(hParent, inTrial);
+		return pData ? pData->GetId() : wxTreeItemId();
+	}
+	return AppendTrial(inTrial, hParent);
+}
+
+
+wxTreeItemId CAgilityBookTreeView::InsertRun(
+	ARBDogTrialPtr const& inTrial,
+	ARBDogRunPtr const& inRun,
+	wxTreeItemId hParent)
+{
+	if (!m_Ctrl || !hParent.IsOk())
+		return wxTreeItemId();
+	// If the trial hasn't been loaded yet, loading it picks up the new run.
+	if (m_Ctrl->ItemHasChildren(hParent) && 0 == m_Ctrl->GetChildrenCount(hParent, false))
+	{
+		LoadChildren(hParent);
+		CAgilityBookTreeData* pData = FindData(hParent, inRun);
+		return pData ? pData->GetId() : wxTreeItemId();
+	}
+	return AppendRun(inTrial, inRun, hParent);
+}
+
+
+wxTreeItemId CAgilityBookTreeView::AppendTrial(ARBDogTrialPtr const& inTrial, wxTreeItemId hParent)
 {
 	wxTreeItemId hTrial;
 	if (inTrial && !inTrial->IsFiltered() && m_Ctrl)
@@ -622,17 +757,22 @@ wxTreeItemId CAgilityBookTreeView::InsertTrial(ARBDogTrialPtr const& inTrial, wx
 		int state = pDataTrial->GetTrial()->IsVerified() ? m_idxChecked : m_idxEmpty;
 		m_Ctrl->SetItemState(hTrial, state);
 #endif
-		for (ARBDogRunList::const_iterator iterRun = inTrial->GetRuns().begin(); iterRun != inTrial->GetRuns().end();
-			 ++iterRun)
+		// Runs are added when the trial is expanded.
+		for (auto const& pRun : inTrial->GetRuns())
 		{
-			InsertRun(inTrial, (*iterRun), hTrial);
+			if (!pRun->IsFiltered())
+			{
+				m_Ctrl->SetItemHasChildren(hTrial, true);
+				break;
+			}
 		}
+		m_Ctrl->SetItemHasChildren(hParent, true);
 	}
 	return hTrial;
 }
 
 
-wxTreeItemId CAgilityBookTreeView::InsertRun(
+wxTreeItemId CAgilityBookTreeView::AppendRun(
 	ARBDogTrialPtr const& inTrial,
 	ARBDogRunPtr const& inRun,
 	wxTreeItemId hParent)
@@ -643,6 +783,7 @@ wxTreeItemId CAgilityBookTreeView::InsertRun(
 		CAgilityBookTreeDataRun* pDataRun = new CAgilityBookTreeDataRun(this, inRun);
 		int idxImage = pDataRun->OnNeedIcon();
 		hRun = m_Ctrl->AppendItem(hParent, pDataRun->OnNeedText(), idxImage, idxImage, pDataRun);
+		m_Ctrl->SetItemHasChildren(hParent, true);
 	}
 	return hRun;
 }
@@ -670,8 +811,7 @@ bool CAgilityBookTreeView::PasteDog(bool& bLoaded)
 				{
 					bLoaded = true;
 					pDog->GetTrials().sort(!CAgilityBookOptions::GetNewestDatesFirst());
-					std::vector<CVenueFilter> venues;
-					CFilterOptions::Options().GetFilterVenue(venues);
+					CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 					if (!GetDocument()->Book().GetDogs().AddDog(pDog))
 					{
 						bLoaded = false;
@@ -744,12 +884,11 @@ bool CAgilityBookTreeView::PasteRuns(
 			{
 				size_t nFailed = 0;
 				bLoaded = true;
-				std::vector<CVenueFilter> venues;
-				CFilterOptions::Options().GetFilterVenue(venues);
+				CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 				for (std::vector<ARBDogRunPtr>::iterator iter = runs.begin(); iter != runs.end(); ++iter)
 				{
 					ARBDogRunPtr pRun = *iter;
-					if (!inTrial->GetRuns().AddRun(pRun))
+					if (!inTrial->GetRuns().InsertRun(pRun))
 					{
 						++nFailed;
 						wxMessageBox(
@@ -764,8 +903,7 @@ bool CAgilityBookTreeView::PasteRuns(
 					bLoaded = false;
 				else
 				{
-					inTrial->GetRuns().sort();
-					inDog->GetTrials().sort(!CAgilityBookOptions::GetNewestDatesFirst());
+					inDog->GetTrials().RepositionTrial(inTrial, !CAgilityBookOptions::GetNewestDatesFirst());
 					Freeze();
 					unsigned int iHint = 0;
 					ARBBasePtr pBase;
@@ -991,6 +1129,7 @@ void CAgilityBookTreeView::PrintLine(wxString& data, wxTreeItemId id, int indent
 			data << spaces;
 		data << m_Ctrl->GetItemText(id) << L"<br />\n"; // Note, wxWidgets needs the space before the slash
 	}
+	LoadChildren(id);
 	wxTreeItemIdValue cookie;
 	wxTreeItemId hChildItem = m_Ctrl->GetFirstChild(id, cookie);
 	while (hChildItem.IsOk())
@@ -1090,6 +1229,13 @@ void CAgilityBookTreeView::OnCtrlSelectionChanged(wxTreeEvent& evt)
 }
 
 
+void CAgilityBookTreeView::OnCtrlItemExpanding(wxTreeEvent& evt)
+{
+	LoadChildren(evt.GetItem());
+	evt.Skip();
+}
+
+
 void CAgilityBookTreeView::OnCtrlItemActivated(wxTreeEvent& evt)
 {
 	CAgilityBookTreeData* pData = GetCurrentTreeItem();
@@ -1337,8 +1483,7 @@ bool CAgilityBookTreeView::OnCmd(int id)
 								err))
 						{
 							bLoaded = true;
-							std::vector<CVenueFilter> venues;
-							CFilterOptions::Options().GetFilterVenue(venues);
+							CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 							if (!pDog->GetTrials().AddTrial(pNewTrial, !CAgilityBookOptions::GetNewestDatesFirst()))
 							{
 								bLoaded = false;
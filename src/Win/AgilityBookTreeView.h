@@ -12,6 +12,8 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Refresh just the edited trial/run nodes when possible.
+ * 2026-10-19 Create trial and run nodes when their parent is expanded.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2009-02-08 Ported to wxWidgets.
  * 2008-11-19 Added SelectDog()
@@ -180,6 +182,8 @@ public:
 	}
 	CAgilityBookTreeData* FindData(wxTreeItemId hItem, ARB::ARBDogRunPtr const& inRun) const;
 
+	// Trials and runs are only added to the tree when their parent is
+	// expanded. FindData (and Insert*) create them as needed.
 	wxTreeItemId InsertDog(ARB::ARBDogPtr const& inDog, bool bSelect = false);
 	wxTreeItemId InsertTrial(ARB::ARBDogTrialPtr const& inTrial, wxTreeItemId hParent);
 	wxTreeItemId InsertRun(ARB::ARBDogTrialPtr const& inTrial, ARB::ARBDogRunPtr const& inRun, wxTreeItemId hParent);
@@ -197,7 +201,12 @@ public:
 	wxString GetPrintLine(wxTreeItemId hItem) const;
 
 private:
+	wxTreeItemId AppendTrial(ARB::ARBDogTrialPtr const& inTrial, wxTreeItemId hParent);
+	wxTreeItemId AppendRun(ARB::ARBDogTrialPtr const& inTrial, ARB::ARBDogRunPtr const& inRun, wxTreeItemId hParent);
+	bool MayContain(wxTreeItemId hItem, ARB::ARBBasePtr const& inBase) const;
+	void LoadChildren(wxTreeItemId hItem) const;
 	void UpdateData(wxTreeItemId hItem);
+	void RefreshChanged(UpdateChange change, std::vector<ARB::ARBBasePtr> const& inChanged);
 	void ChangeSelection(wxTreeItemId hItem, bool bEnsureVisible = true);
 	void DoSelectionChange(wxTreeItemId hItem);
 	void LoadData();
@@ -242,6 +251,7 @@ private:
 	void OnCtrlSetFocus(wxFocusEvent& evt);
 	void OnCtrlContextMenu(wxTreeEvent& evt);
 	void OnCtrlSelectionChanged(wxTreeEvent& evt);
+	void OnCtrlItemExpanding(wxTreeEvent& evt);
 	void OnCtrlItemActivated(wxTreeEvent& evt);
 	void OnCtrlKeyDown(wxKeyEvent& evt);
 	void OnViewContextMenu(wxContextMenuEvent& evt);
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Update the search index for just this entry.
  * 2014-12-30 Changed pixels to dialog units.
  * 2012-05-22 Removed killfocus handlers, not needed.
  * 2012-05-07 Added autocompletion to combo boxes.
@@ -944,7 +945,7 @@ void CDlgCalendar::OnOk(wxCommandEvent& evt)
 	}
 	m_pCal->SetNote(m_Notes);
 
-	m_pDoc->Modify(true);
+	m_pDoc->ModifyObject(m_pCal);
 
 	EndDialog(wxID_OK);
 }
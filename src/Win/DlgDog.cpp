@@ -162,8 +162,7 @@ void CDlgDog::OnOk(wxCommandEvent& evt)
 
 	if (refreshTitles || m_viewHidden != CAgilityBookOptions::GetViewHiddenTitles())
 	{
-		std::vector<CVenueFilter> venues;
-		CFilterOptions::Options().GetFilterVenue(venues);
+		CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 		for (ARBDogList::iterator iterDogs = m_pDoc->Book().GetDogs().begin();
 			 iterDogs != m_pDoc->Book().GetDogs().end();
 			 ++iterDogs)
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added option to write an SQL copy on save.
  * 2015-01-01 Changed pixels to dialog units.
  * 2011-12-22 Switch to using Bind on wx2.9+.
  * 2009-02-11 Ported to wxWidgets.
@@ -45,6 +46,7 @@ CDlgOptionsProgram::CDlgOptionsProgram(wxWindow* parent)
 	: wxPanel(parent, wxID_ANY, wxDefaultPosition, wxDefaultSize, wxTAB_TRAVERSAL)
 	, m_bAutoCheck(CAgilityBookOptions::GetAutoUpdateCheck())
 	, m_Backups(CAgilityBookOptions::GetNumBackupFiles())
+	, m_bSQLMirror(CAgilityBookOptions::GetSQLMirror())
 	, m_bAutoShow(CAgilityBookOptions::AutoShowPropertiesOnNewTitle())
 	, m_bShowCosanction(CAgilityBookOptions::ShowCoSanctioning())
 	, m_UseProxy(CAgilityBookOptions::GetUseProxy())
@@ -92,6 +94,17 @@ CDlgOptionsProgram::CDlgOptionsProgram(wxWindow* parent)
 		= new wxStaticText(this, wxID_ANY, _("IDC_OPT_PGM_EDIT_TEXT"), wxDefaultPosition, wxDefaultSize, 0);
 	textBackupHelp->Wrap(wxDLG_UNIT_X(this, 155));
 
+	wxCheckBox* ctrlSQLMirror = new wxCheckBox(
+		this,
+		wxID_ANY,
+		_("IDC_OPT_PGM_SQLMIRROR"),
+		wxDefaultPosition,
+		wxDefaultSize,
+		0,
+		wxGenericValidator(&m_bSQLMirror));
+	ctrlSQLMirror->SetHelpText(_("HIDC_OPT_PGM_SQLMIRROR"));
+	ctrlSQLMirror->SetToolTip(_("HIDC_OPT_PGM_SQLMIRROR"));
+
 	wxCheckBox* ctrlShowDog = new wxCheckBox(
 		this,
 		wxID_ANY,
@@ -248,6 +261,7 @@ CDlgOptionsProgram::CDlgOptionsProgram(wxWindow* parent)
 	sizerBackups->Add(textBackupHelp, 0, wxALIGN_CENTER_VERTICAL);
 
 	bSizer->Add(sizerBackups, 0, wxEXPAND | wxLEFT | wxRIGHT | wxTOP, padding.Controls());
+	bSizer->Add(ctrlSQLMirror, 0, wxLEFT | wxRIGHT | wxTOP, padding.Controls());
 	bSizer->Add(ctrlShowDog, 0, wxLEFT | wxRIGHT | wxTOP, padding.Controls());
 	bSizer->Add(ctrlShowCoSanction, 0, wxLEFT | wxRIGHT | wxTOP, padding.Controls());
 	bSizer->Add(ctrlUseProxy, 0, wxLEFT | wxRIGHT | wxTOP, padding.Controls());
@@ -288,6 +302,7 @@ void CDlgOptionsProgram::Save()
 {
 	CAgilityBookOptions::SetAutoUpdateCheck(m_bAutoCheck);
 	CAgilityBookOptions::SetNumBackupFiles(m_Backups);
+	CAgilityBookOptions::SetSQLMirror(m_bSQLMirror);
 	CAgilityBookOptions::AutoShowPropertiesOnNewTitle(m_bAutoShow);
 	CAgilityBookOptions::SetShowCoSanctioning(m_bShowCosanction);
 	wxString oldProxy(CAgilityBookOptions::GetProxy());
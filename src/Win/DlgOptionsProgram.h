@@ -38,6 +38,7 @@ public:
 private:
 	bool m_bAutoCheck;
 	int m_Backups;
+	bool m_bSQLMirror;
 	bool m_bAutoShow;
 	bool m_bShowCosanction;
 	bool m_UseProxy;
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Update the search index for just this run.
  * 2021-01-07 Separated into multiple files.
  * 2019-09-17 Fix last-entered on hidden fields. Fix run's club on creation.
  * 2019-08-18 Fix Bonus points (couldn't enter double).
@@ -207,7 +208,7 @@ void CDlgRun::OnOk(wxCommandEvent& evt)
 	m_pTrial->SetMultiQs(m_pDoc->Book().GetConfig()); // Note, when adding a new run, this is actually too soon to call
 													  // - the run isn't in the trial yet
 
-	m_pDoc->Modify(true);
+	m_pDoc->ModifyObject(m_pRealRun);
 
 	EndDialog(wxID_OK);
 }
@@ -10,6 +10,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Update the search index for just this entry.
  * 2015-01-01 Changed pixels to dialog units.
  * 2012-05-07 Added autocompletion to combo boxes.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
@@ -196,7 +197,7 @@ void CDlgTraining::OnOk(wxCommandEvent& evt)
 	m_pTraining->SetSubName(m_SubName);
 	m_pTraining->SetNote(m_Notes);
 
-	m_pDoc->Modify(true);
+	m_pDoc->ModifyObject(m_pTraining);
 
 	EndDialog(wxID_OK);
 }
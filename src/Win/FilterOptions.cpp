@@ -10,6 +10,8 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added GetVisibilityChanges.
+ * 2026-10-19 Compile the venue filter into a hashed lookup.
  * 2013-01-11 Fix filters on configuration import.
  * 2011-10-12 Added better filter change detection.
  * 2011-08-10 Added builtin support for an 'all' filter.
@@ -211,6 +213,9 @@ CFilterOptions::CFilterOptions()
 	, m_curFilter()
 	, m_nFilters(0)
 	, m_filters()
+	, m_venueSet()
+	, m_bFilterStart(false)
+	, m_bFilterEnd(false)
 {
 	Load();
 }
@@ -262,6 +267,7 @@ bool CFilterOptions::Update(
 
 	if (bRefresh)
 	{
+		CompileVenues();
 		Save();
 		CFilterOptions::Options().Load();
 	}
@@ -290,6 +296,8 @@ void CFilterOptions::Load()
 	FilterVenue(val, m_venueFilter);
 
 	m_eRuns = static_cast<ARBFilterViewRuns>(wxConfig::Get()->Read(CFG_COMMON_VIEWRUNS, 0L));
+	CompileDates();
+	CompileVenues();
 
 	wxConfig::Get()->Read(CFG_COMMON_VIEWALLNAMES, &m_bViewAllNames, true);
 	val = wxConfig::Get()->Read(CFG_COMMON_FILTERTRAININGNAMES, wxEmptyString);
@@ -333,7 +341,10 @@ void CFilterOptions::Save()
 	data.dateEndDate = m_dateEndDate;
 	data.bViewAllVenues = m_bViewAllVenues;
 	if (m_bViewAllVenues)
+	{
 		m_venueFilter.clear();
+		CompileVenues();
+	}
 	data.venueFilter = m_venueFilter;
 	data.eRuns = m_eRuns;
 	data.bViewAllNames = m_bViewAllNames;
@@ -457,6 +468,8 @@ bool CFilterOptions::SetCurrentFilter(wxString const& inName)
 	m_eRuns = data.eRuns;
 	m_bViewAllNames = data.bViewAllNames;
 	m_nameFilter = data.nameFilter;
+	CompileDates();
+	CompileVenues();
 	return true;
 }
 
@@ -516,20 +529,34 @@ bool CFilterOptions::IsFilterEnabled() const
 }
 
 
+unsigned int CFilterOptions::GetVisibilityChanges(CFilterOptions const& inOld) const
+{
+	unsigned int changes = 0;
+	if (m_bFilterStart != inOld.m_bFilterStart || m_bFilterEnd != inOld.m_bFilterEnd
+		|| (m_bFilterStart && m_dateStartDate != inOld.m_dateStartDate)
+		|| (m_bFilterEnd && m_dateEndDate != inOld.m_dateEndDate))
+		changes |= FILTER_CHANGE_DATES;
+	if (m_bViewAllVenues != inOld.m_bViewAllVenues || (!m_bViewAllVenues && m_venueFilter != inOld.m_venueFilter))
+		changes |= FILTER_CHANGE_VENUES;
+	if (m_eRuns != inOld.m_eRuns)
+		changes |= FILTER_CHANGE_RUNS;
+	if (m_bViewAllNames != inOld.m_bViewAllNames || (!m_bViewAllNames && m_nameFilter != inOld.m_nameFilter))
+		changes |= FILTER_CHANGE_NAMES;
+	return changes;
+}
+
+
 bool CFilterOptions::IsDateVisible(ARBDate const& startDate, ARBDate const& endDate) const
 {
-	if (!m_bAllDates)
-	{
-		if (m_bStartDate && startDate < m_dateStartDate)
-			return false;
-		if (m_bEndDate && endDate > m_dateEndDate)
-			return false;
-	}
+	if (m_bFilterStart && startDate < m_dateStartDate)
+		return false;
+	if (m_bFilterEnd && endDate > m_dateEndDate)
+		return false;
 	return true;
 }
 
 
-bool CFilterOptions::IsTitleVisible(std::vector<CVenueFilter> const& venues, ARBDogTitlePtr const& inTitle) const
+bool CFilterOptions::IsTitleVisible(CVenueFilterSet const& venues, ARBDogTitlePtr const& inTitle) const
 {
 	if (!CAgilityBookOptions::GetViewHiddenTitles() && inTitle->IsHidden())
 		return false;
@@ -539,59 +566,32 @@ bool CFilterOptions::IsTitleVisible(std::vector<CVenueFilter> const& venues, ARB
 }
 
 
-bool CFilterOptions::IsVenueVisible(std::vector<CVenueFilter> const& venues, wxString const& venue) const
+bool CFilterOptions::IsVenueVisible(CVenueFilterSet const& venues, wxString const& venue) const
 {
-	if (!m_bViewAllVenues)
-	{
-		for (std::vector<CVenueFilter>::const_iterator iter = venues.begin(); iter != venues.end(); ++iter)
-		{
-			if ((*iter).venue == venue)
-				return true;
-		}
-		return false;
-	}
-	return true;
+	return m_bViewAllVenues || venues.HasVenue(venue);
 }
 
 
 bool CFilterOptions::IsVenueDivisionVisible(
-	std::vector<CVenueFilter> const& venues,
+	CVenueFilterSet const& venues,
 	wxString const& venue,
 	wxString const& div) const
 {
-	if (!m_bViewAllVenues)
-	{
-		for (std::vector<CVenueFilter>::const_iterator iter = venues.begin(); iter != venues.end(); ++iter)
-		{
-			if ((*iter).venue == venue && (*iter).division == div)
-				return true;
-		}
-		return false;
-	}
-	return true;
+	return m_bViewAllVenues || venues.HasDivision(venue, div);
 }
 
 
 bool CFilterOptions::IsVenueLevelVisible(
-	std::vector<CVenueFilter> const& venues,
+	CVenueFilterSet const& venues,
 	wxString const& venue,
 	wxString const& div,
 	wxString const& level) const
 {
-	if (!m_bViewAllVenues)
-	{
-		for (std::vector<CVenueFilter>::const_iterator iter = venues.begin(); iter != venues.end(); ++iter)
-		{
-			if ((*iter).venue == venue && (*iter).division == div && (*iter).level == level)
-				return true;
-		}
-		return false;
-	}
-	return true;
+	return m_bViewAllVenues || venues.HasLevel(venue, div, level);
 }
 
 
-bool CFilterOptions::IsTrialVisible(std::vector<CVenueFilter> const& venues, ARBDogTrialPtr const& inTrial) const
+bool CFilterOptions::IsTrialVisible(CVenueFilterSet const& venues, ARBDogTrialPtr const& inTrial) const
 {
 	// Yes, it seems backwards, but it is correct.
 	if (!IsDateVisible(inTrial->GetEndDate(), inTrial->GetStartDate()))
@@ -613,7 +613,7 @@ bool CFilterOptions::IsTrialVisible(std::vector<CVenueFilter> const& venues, ARB
 
 // Return type should be the same as ARBBase::m_nFiltered
 unsigned short CFilterOptions::IsRunVisible(
-	std::vector<CVenueFilter> const& venues,
+	CVenueFilterSet const& venues,
 	ARB::ARBDogTrialPtr const& inTrial,
 	ARB::ARBDogRunPtr const& inRun) const
 {
@@ -631,20 +631,11 @@ unsigned short CFilterOptions::IsRunVisible(
 		// of the filter matches too.
 		if (IsDateVisible(inTrial->GetRuns().GetEndDate(), inTrial->GetRuns().GetStartDate()))
 		{
-			for (std::vector<CVenueFilter>::const_iterator iter = venues.begin(); iter != venues.end(); ++iter)
+			for (ARBDogClubList::const_iterator iterClub = inTrial->GetClubs().begin();
+				 iterClub != inTrial->GetClubs().end();
+				 ++iterClub)
 			{
-				bool bCheck = false;
-				for (ARBDogClubList::const_iterator iterClub = inTrial->GetClubs().begin();
-					 iterClub != inTrial->GetClubs().end();
-					 ++iterClub)
-				{
-					if ((*iter).venue == (*iterClub)->GetVenue())
-					{
-						bCheck = true;
-						break;
-					}
-				}
-				if (bCheck && inRun->GetDivision() == (*iter).division && inRun->GetLevel() == (*iter).level)
+				if (venues.HasLevel((*iterClub)->GetVenue(), inRun->GetDivision(), inRun->GetLevel()))
 				{
 					nVisible = GetFilterMask(ARBFilterType::Full) | GetFilterMask(ARBFilterType::IgnoreQ);
 					break;
@@ -670,78 +661,36 @@ unsigned short CFilterOptions::IsRunVisible(
 // set the filtering to hide NADAC novice runs, the asca visibility caused
 // the novice run to appear in the nadac points listing when it shouldn't.
 bool CFilterOptions::IsRunVisible(
-	std::vector<CVenueFilter> const& venues,
+	CVenueFilterSet const& venues,
 	ARB::ARBConfigVenuePtr const& inVenue,
 	ARB::ARBDogTrialPtr const& inTrial,
 	ARB::ARBDogRunPtr const& inRun) const
 {
 	if (1 >= inTrial->GetClubs().size())
 		return true;
-	bool bVisible = true;
-	if (!m_bViewAllVenues)
-	{
-		bVisible = false;
-		for (std::vector<CVenueFilter>::const_iterator iter = venues.begin(); iter != venues.end(); ++iter)
-		{
-			if (inTrial->HasVenue(inVenue->GetName()) && inVenue->GetName() == (*iter).venue
-				&& inRun->GetDivision() == (*iter).division && inRun->GetLevel() == (*iter).level)
-			{
-				bVisible = true;
-				break;
-			}
-		}
-	}
-	return bVisible;
+	if (m_bViewAllVenues)
+		return true;
+	return inTrial->HasVenue(inVenue->GetName())
+		   && venues.HasLevel(inVenue->GetName(), inRun->GetDivision(), inRun->GetLevel());
 }
 
 
-bool CFilterOptions::IsCalendarVisible(std::vector<CVenueFilter> const& venues, ARBCalendarPtr const& inCal) const
+bool CFilterOptions::IsCalendarVisible(CVenueFilterSet const& venues, ARBCalendarPtr const& inCal) const
 {
-	if (!m_bAllDates)
-	{
-		if (m_bStartDate)
-		{
-			if (inCal->GetEndDate() < m_dateStartDate)
-				return false;
-		}
-		if (m_bEndDate)
-		{
-			if (inCal->GetStartDate() > m_dateEndDate)
-				return false;
-		}
-	}
-	bool bVisible = true;
-	if (!m_bViewAllVenues)
-	{
-		bVisible = false;
-		for (std::vector<CVenueFilter>::const_iterator iter = venues.begin(); iter != venues.end(); ++iter)
-		{
-			if (inCal->GetVenue() == (*iter).venue)
-			{
-				bVisible = true;
-				break;
-			}
-		}
-	}
-	return bVisible;
+	if (m_bFilterStart && inCal->GetEndDate() < m_dateStartDate)
+		return false;
+	if (m_bFilterEnd && inCal->GetStartDate() > m_dateEndDate)
+		return false;
+	return IsVenueVisible(venues, inCal->GetVenue());
 }
 
 
 bool CFilterOptions::IsTrainingLogVisible(std::set<wxString> const& names, ARBTrainingPtr const& inTraining) const
 {
-	if (!m_bAllDates)
-	{
-		if (m_bStartDate)
-		{
-			if (inTraining->GetDate() < m_dateStartDate)
-				return false;
-		}
-		if (m_bEndDate)
-		{
-			if (inTraining->GetDate() > m_dateEndDate)
-				return false;
-		}
-	}
+	if (m_bFilterStart && inTraining->GetDate() < m_dateStartDate)
+		return false;
+	if (m_bFilterEnd && inTraining->GetDate() > m_dateEndDate)
+		return false;
 	bool bVisible = true;
 	if (!m_bViewAllNames)
 	{
@@ -772,6 +721,48 @@ bool CFilterOptions::FilterExists(wxString const& inVenue, wxString const& inDiv
 
 /////////////////////////////////////////////////////////////////////////////
 
+CVenueFilterSet::CVenueFilterSet()
+	: m_venues()
+{
+}
+
+
+CVenueFilterSet::CVenueFilterSet(std::vector<CVenueFilter> const& venues)
+	: m_venues()
+{
+	for (std::vector<CVenueFilter>::const_iterator iter = venues.begin(); iter != venues.end(); ++iter)
+		m_venues[(*iter).venue][(*iter).division].insert((*iter).level);
+}
+
+
+bool CVenueFilterSet::HasVenue(wxString const& venue) const
+{
+	return m_venues.find(venue) != m_venues.end();
+}
+
+
+bool CVenueFilterSet::HasDivision(wxString const& venue, wxString const& div) const
+{
+	auto iterVenue = m_venues.find(venue);
+	if (iterVenue == m_venues.end())
+		return false;
+	return iterVenue->second.find(div) != iterVenue->second.end();
+}
+
+
+bool CVenueFilterSet::HasLevel(wxString const& venue, wxString const& div, wxString const& level) const
+{
+	auto iterVenue = m_venues.find(venue);
+	if (iterVenue == m_venues.end())
+		return false;
+	auto iterDiv = iterVenue->second.find(div);
+	if (iterDiv == iterVenue->second.end())
+		return false;
+	return iterDiv->second.find(level) != iterDiv->second.end();
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
 CFilterOptions::CFilterOptionData::CFilterOptionData()
 	: filterName()
 	, calView(eViewNormal)
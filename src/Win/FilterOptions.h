@@ -12,6 +12,8 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added GetVisibilityChanges.
+ * 2026-10-19 Compile the venue filter into a hashed lookup.
  * 2011-08-10 Added builtin support for an 'all' filter.
  * 2009-09-13 Add support for wxWidgets 2.9, deprecate tstring.
  * 2009-01-01 Ported to wxWidgets.
@@ -21,7 +23,10 @@
 #include "ARB/ARBTypes2.h"
 #include "ARBCommon/ARBDate.h"
 #include <set>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
+#include <wx/hashmap.h>
 
 
 namespace dconSoft
@@ -51,6 +56,36 @@ struct CVenueFilter
 };
 
 
+// Parts of a filter that determine visibility (see GetVisibilityChanges)
+#define FILTER_CHANGE_DATES  0x01 ///< Trials, runs, titles, calendar, training
+#define FILTER_CHANGE_VENUES 0x02 ///< Trials, runs, titles, calendar
+#define FILTER_CHANGE_RUNS   0x04 ///< Q/NQ filter: trials, runs
+#define FILTER_CHANGE_NAMES  0x08 ///< Training
+#define FILTER_CHANGE_ALL    0x0f
+
+
+/**
+ * Compiled form of a venue filter. Visibility checks are done for every run
+ * (and in the points loops), so the (venue, division, level) triples are
+ * hashed once when the filter changes instead of scanned on every check.
+ */
+class CVenueFilterSet
+{
+public:
+	CVenueFilterSet();
+	explicit CVenueFilterSet(std::vector<CVenueFilter> const& venues);
+
+	bool HasVenue(wxString const& venue) const;
+	bool HasDivision(wxString const& venue, wxString const& div) const;
+	bool HasLevel(wxString const& venue, wxString const& div, wxString const& level) const;
+
+private:
+	typedef std::unordered_set<wxString, wxStringHash, wxStringEqual> LevelSet;
+	typedef std::unordered_map<wxString, LevelSet, wxStringHash, wxStringEqual> DivisionMap;
+	std::unordered_map<wxString, DivisionMap, wxStringHash, wxStringEqual> m_venues;
+};
+
+
 class CCalendarViewFilter
 {
 	friend class CFilterOptions;
@@ -131,7 +166,21 @@ private:
 	long m_nFilters;
 	std::vector<CFilterOptionData> m_filters;
 
+	// Compiled filter, updated whenever the settings above change.
+	CVenueFilterSet m_venueSet;
+	bool m_bFilterStart;
+	bool m_bFilterEnd;
+
 	std::vector<CFilterOptionData>::iterator FindFilter(wxString const& inName);
+	void CompileDates()
+	{
+		m_bFilterStart = !m_bAllDates && m_bStartDate;
+		m_bFilterEnd = !m_bAllDates && m_bEndDate;
+	}
+	void CompileVenues()
+	{
+		m_venueSet = CVenueFilterSet(m_venueFilter);
+	}
 
 public:
 	static CFilterOptions& Options();
@@ -150,27 +199,33 @@ public:
 
 	// Helper functions
 	bool IsFilterEnabled() const;
+	/**
+	 * Determine what needs its visibility recomputed when changing filters.
+	 * @param inOld Filter the current visibility was computed with.
+	 * @return FILTER_CHANGE_* bits.
+	 */
+	unsigned int GetVisibilityChanges(CFilterOptions const& inOld) const;
 	bool IsDateVisible(ARBCommon::ARBDate const& startDate, ARBCommon::ARBDate const& endDate) const;
-	bool IsTitleVisible(std::vector<CVenueFilter> const& venues, ARB::ARBDogTitlePtr const& inTitle) const;
-	bool IsVenueVisible(std::vector<CVenueFilter> const& venues, wxString const& venue) const;
-	bool IsVenueDivisionVisible(std::vector<CVenueFilter> const& venues, wxString const& venue, wxString const& div)
+	bool IsTitleVisible(CVenueFilterSet const& venues, ARB::ARBDogTitlePtr const& inTitle) const;
+	bool IsVenueVisible(CVenueFilterSet const& venues, wxString const& venue) const;
+	bool IsVenueDivisionVisible(CVenueFilterSet const& venues, wxString const& venue, wxString const& div)
 		const;
 	bool IsVenueLevelVisible(
-		std::vector<CVenueFilter> const& venues,
+		CVenueFilterSet const& venues,
 		wxString const& venue,
 		wxString const& div,
 		wxString const& level) const;
-	bool IsTrialVisible(std::vector<CVenueFilter> const& venues, ARB::ARBDogTrialPtr const& inTrial) const;
+	bool IsTrialVisible(CVenueFilterSet const& venues, ARB::ARBDogTrialPtr const& inTrial) const;
 	unsigned short IsRunVisible(
-		std::vector<CVenueFilter> const& venues,
+		CVenueFilterSet const& venues,
 		ARB::ARBDogTrialPtr const& inTrial,
 		ARB::ARBDogRunPtr const& inRun) const;
 	bool IsRunVisible(
-		std::vector<CVenueFilter> const& venues,
+		CVenueFilterSet const& venues,
 		ARB::ARBConfigVenuePtr const& inVenue,
 		ARB::ARBDogTrialPtr const& inTrial,
 		ARB::ARBDogRunPtr const& inRun) const;
-	bool IsCalendarVisible(std::vector<CVenueFilter> const& venues, ARB::ARBCalendarPtr const& inCal) const;
+	bool IsCalendarVisible(CVenueFilterSet const& venues, ARB::ARBCalendarPtr const& inCal) const;
 	bool IsTrainingLogVisible(std::set<wxString> const& names, ARB::ARBTrainingPtr const& inTraining) const;
 
 	// Filtering: Calendar
@@ -191,6 +246,7 @@ public:
 	void SetViewAllDates(bool bViewAll)
 	{
 		m_bAllDates = bViewAll;
+		CompileDates();
 	}
 	ARBCommon::ARBDate GetStartFilterDate() const
 	{
@@ -207,6 +263,7 @@ public:
 	void SetStartFilterDateSet(bool bSet)
 	{
 		m_bStartDate = bSet;
+		CompileDates();
 	}
 	ARBCommon::ARBDate GetEndFilterDate() const
 	{
@@ -223,6 +280,7 @@ public:
 	void SetEndFilterDateSet(bool bSet)
 	{
 		m_bEndDate = bSet;
+		CompileDates();
 	}
 
 	// Filtering: Runs
@@ -238,9 +296,15 @@ public:
 	{
 		venues = m_venueFilter;
 	}
+	// Compiled form of GetFilterVenue, valid until the filter changes.
+	CVenueFilterSet const& GetFilterVenueSet() const
+	{
+		return m_venueSet;
+	}
 	void SetFilterVenue(std::vector<CVenueFilter> const& venues)
 	{
 		m_venueFilter = venues;
+		CompileVenues();
 	}
 	bool FilterExists(wxString const& inVenue, wxString const& inDiv, wxString const& inLevel) const;
 
@@ -165,8 +165,7 @@ bool CPointsDataTitle::Details(wxString const& link, ARBDogPtr pDog)
 	if (wxID_OK == dlg.ShowModal())
 	{
 		m_pDoc->Modify(true);
-		std::vector<CVenueFilter> venues;
-		CFilterOptions::Options().GetFilterVenue(venues);
+		CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 		m_pDoc->ResetVisibility(venues, m_pTitle);
 		CUpdateHint hint(UPDATE_POINTS_VIEW);
 		m_pDoc->UpdateAllViews(nullptr, &hint);
@@ -535,7 +534,7 @@ private:
 /////////////////////////////////////////////////////////////////////////////
 
 CPointsDataVenue::CPointsDataVenue(
-	std::vector<CVenueFilter> const& venues,
+	CVenueFilterSet const& venues,
 	CAgilityBookDoc* pDoc,
 	ARBDogPtr const& inDog,
 	ARBConfigVenuePtr const inVenue,
@@ -1458,8 +1457,7 @@ void CPointsDataItems::LoadData(ARBDogPtr const& inDog)
 	m_pDog = inDog;
 
 	// Find all visible items and sort them out by venue.
-	std::vector<CVenueFilter> venues;
-	CFilterOptions::Options().GetFilterVenue(venues);
+	CVenueFilterSet const& venues = CFilterOptions::Options().GetFilterVenueSet();
 	CRefTag id;
 
 	// For each venue...
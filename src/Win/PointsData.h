@@ -41,7 +41,7 @@
 namespace dconSoft
 {
 class CAgilityBookDoc;
-struct CVenueFilter;
+class CVenueFilterSet;
 
 
 // See SetupARBPost.h
@@ -386,7 +386,7 @@ class CPointsDataVenue
 	DECLARE_NO_COPY_IMPLEMENTED(CPointsDataVenue)
 public:
 	CPointsDataVenue(
-		std::vector<CVenueFilter> const& venues,
+		CVenueFilterSet const& venues,
 		CAgilityBookDoc* pDoc,
 		ARB::ARBDogPtr const& inDog,
 		ARB::ARBConfigVenuePtr const inVenue,
@@ -327,6 +327,8 @@ inline wxString CFG_SELECTION_DOG(int n)
 #define CFG_SETTINGS_BACKUPFILES		CFG_KEY_SETTINGS L"/BackupFiles"
 //	ST BackupDir
 #define CFG_SETTINGS_BACKUPDIR			CFG_KEY_SETTINGS L"/BackupDir"
+//	DW SQLMirror
+#define CFG_SETTINGS_SQLMIRROR			CFG_KEY_SETTINGS L"/SQLMirror"
 //	DW isLocal (defined in SetupApp.cpp)
 //#define CFG_SETTINGS_ISLOCAL			CFG_KEY_SETTINGS L"/isLocal"
 //	Obsolete(2.0.0.0) DW Lang (LanguageManager.cpp)
@@ -12,6 +12,8 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Added SQL export.
+ * 2026-10-19 Added JSON export.
  * 2009-02-10 Ported to wxWidgets.
  * 2006-02-16 Cleaned up memory usage with smart pointers.
  * 2003-12-10 Created
@@ -50,6 +52,8 @@ constexpr int WIZ_EXPORT_DTD = 12;
 constexpr int WIZ_EXPORT_XML = 13;
 constexpr int WIZ_IMPORT_SETTINGS = 14;
 constexpr int WIZ_EXPORT_SETTINGS = 15;
+constexpr int WIZ_EXPORT_JSON = 16;
+constexpr int WIZ_EXPORT_SQL = 17;
 
 // Note: These numbers should not be changed - they are stored in the registry
 constexpr long WIZARD_RADIO_EXCEL = 0L;
@@ -10,6 +10,8 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Format records once, as they are previewed/exported.
+ * 2026-10-19 Write xlsx/ods files directly instead of driving Excel/Calc.
  * 2026-07-27 Convert to CReportListCtrl for preview. Windows list controls limit the amount of text per column.
  * 2025-12-06 Added filtering (if enabled but no filter active, exports only currennt dog)
  * 2017-09-04 Change default DogsInClass to -1 (allows for DNR runs with 0 dogs)
@@ -49,14 +51,17 @@
 #include "ARB/ARBDogRun.h"
 #include "ARB/ARBDogTrial.h"
 #include "ARB/ARBLocalization.h"
+#include "ARB/ARBSpreadSheet.h"
 #include "ARBCommon/BreakLine.h"
 #include "ARBCommon/StringUtil.h"
 #include "LibARBWin/ARBWinUtilities.h"
 #include "LibARBWin/DlgPadding.h"
-#include "LibARBWin/DlgProgress.h"
 #include "LibARBWin/ListData.h"
 #include "LibARBWin/Logger.h"
 #include "LibARBWin/ReportListCtrl.h"
+#include <algorithm>
+#include <wx/filename.h>
+#include <wx/stream.h>
 #include <wx/valgen.h>
 #include <wx/wfstream.h>
 
@@ -73,6 +78,22 @@ using namespace ARBWin;
 
 namespace
 {
+constexpr size_t MAX_PREVIEW_ROWS = 100;
+
+
+wxString JoinRecord(wchar_t delim, std::vector<wxString> const& cols)
+{
+	wxString line;
+	for (size_t i = 0; i < cols.size(); ++i)
+	{
+		if (0 < i)
+			line += delim;
+		line += WriteCSVField(delim, cols[i]);
+	}
+	return line;
+}
+
+
 class CWizardExportListData : public CListData
 {
 public:
@@ -82,13 +103,7 @@ public:
 		if (colCount == 1)
 		{
 			m_cols.clear();
-			m_cols.push_back(wxString());
-			for (size_t i = 0; i < cols.size(); ++i)
-			{
-				if (0 < i)
-					m_cols[0] += delim;
-				m_cols[0] += WriteCSVField(delim, cols[i]);
-			}
+			m_cols.push_back(JoinRecord(delim, cols));
 		}
 	}
 	wxString OnNeedText(long iCol) const override
@@ -444,884 +459,959 @@ void CWizardExport::UpdateButtons()
 }
 
 
-void CWizardExport::UpdatePreview()
+// Formats the records to export one at a time. The preview only needs the
+// first few, and the export writes each one as it is formatted.
+class CWizardExport::CRecordSource
 {
-	wxBusyCursor wait;
+public:
+	explicit CRecordSource(CWizardExport const& inPage);
 
-	m_ctrlPreview->Freeze();
+	/**
+	 * Column names (the first record written).
+	 */
+	std::vector<wxString> const& GetHeader() const
+	{
+		return m_Header;
+	}
+
+	/**
+	 * Get the next record.
+	 * @param outRecord Formatted fields.
+	 * @return Whether there was a record.
+	 */
+	bool Next(std::vector<wxString>& outRecord);
+
+private:
+	bool NextRun(std::vector<wxString>& outData);
+	ARBCalendarPtr NextCalendar();
+	void FormatRun(
+		ARBDogPtr const& pDog,
+		ARBDogTrialPtr const& pTrial,
+		ARBDogRunPtr const& pRun,
+		ARBConfigScoringPtr const& pScoring,
+		long idxType,
+		std::vector<wxString>& outData) const;
+	void FormatCalendar(ARBCalendarPtr const& pCal, std::vector<wxString>& outData) const;
+	void FormatAppointment(ARBCalendarPtr const& pCal, std::vector<wxString>& outData) const;
+	void FormatTask(ARBCalendarPtr const& pCal, std::vector<wxString>& outData) const;
+	void FormatTraining(ARBTrainingPtr const& pLog, std::vector<wxString>& outData) const;
+
+	CWizardExport const& m_Page;
+	ARBAgilityRecordBook& m_Book;
+	long m_Item;
+	ARBDateFormat m_Format;
+	std::vector<long> m_Columns[IO_TYPE_MAX];
+	std::vector<wxString> m_Header;
+	std::vector<ARBCalendarPtr> const* m_pEntries;
+	size_t m_idxEntry;
+	ARBDogList::const_iterator m_iterDog;
+	ARBDogPtr m_pDog;
+	ARBDogTrialList::const_iterator m_iterTrial;
+	ARBDogTrialPtr m_pTrial;
+	ARBDogRunList::const_iterator m_iterRun;
+	ARBCalendarList::const_iterator m_iterCal;
+	ARBTrainingList::const_iterator m_iterLog;
+};
 
-	// Clear existing preview data.
-	m_ctrlPreview->DeleteAllItems();
-	long nColumnCount = m_ctrlPreview->GetColumnCount();
-	long iCol;
-	for (iCol = 0; iCol < nColumnCount; ++iCol)
-		m_ctrlPreview->DeleteColumn(0);
 
-	// Get export info.
-	ARBDateFormat format = ARBDateFormat::SlashMDY;
-	long idxDateFormat = m_ctrlDateFormat->GetSelection();
+CWizardExport::CRecordSource::CRecordSource(CWizardExport const& inPage)
+	: m_Page(inPage)
+	, m_Book(inPage.m_pDoc->Book())
+	, m_Item(inPage.m_pSheet->GetImportExportItem())
+	, m_Format(ARBDateFormat::SlashMDY)
+	, m_Columns()
+	, m_Header()
+	, m_pEntries(inPage.m_pSheet->GetCalendarEntries())
+	, m_idxEntry(0)
+	, m_iterDog(m_Book.GetDogs().begin())
+	, m_pDog()
+	, m_iterTrial()
+	, m_pTrial()
+	, m_iterRun()
+	, m_iterCal(m_Book.GetCalendar().begin())
+	, m_iterLog(m_Book.GetTraining().begin())
+{
+	long idxDateFormat = inPage.m_ctrlDateFormat->GetSelection();
 	if (wxNOT_FOUND != idxDateFormat)
-		format = static_cast<ARBDateFormat>(reinterpret_cast<size_t>(m_ctrlDateFormat->GetClientData(idxDateFormat)));
-	wchar_t delim = GetDelim();
-	if (WIZARD_RADIO_EXCEL != m_pSheet->GetImportExportStyle() && WIZARD_RADIO_CALC != m_pSheet->GetImportExportStyle()
-		&& 0 == delim)
 	{
-		wxString nodelim(_("IDS_NO_DELIM_SPECIFIED"));
-		m_ctrlPreview->InsertColumn(0, L"");
-		m_ctrlPreview->SetColumnWidth(0, wxLIST_AUTOSIZE_USEHEADER);
-		m_ctrlPreview->Thaw();
-		m_ctrlPreview->Refresh();
-		return;
+		void* data = inPage.m_ctrlDateFormat->GetClientData(idxDateFormat);
+		m_Format = static_cast<ARBDateFormat>(reinterpret_cast<size_t>(data));
 	}
 
 	// Get export columns.
-	CAgilityBookOptions::ColumnOrder order = GetColumnInfo();
-	size_t index;
-	std::vector<long> columns[IO_TYPE_MAX];
-	for (index = 0; index < IO_TYPE_MAX; ++index)
+	CAgilityBookOptions::ColumnOrder order = inPage.GetColumnInfo();
+	for (size_t index = 0; index < IO_TYPE_MAX; ++index)
 	{
-		CDlgAssignColumns::GetColumnOrder(order, index, columns[index]);
+		CDlgAssignColumns::GetColumnOrder(order, index, m_Columns[index]);
 	}
 
 	// Now generate the header information.
 	wxString hdrSep(L"/");
-	if (WIZARD_RADIO_EXCEL == m_pSheet->GetImportExportStyle() || WIZARD_RADIO_CALC == m_pSheet->GetImportExportStyle())
+	if (WIZARD_RADIO_EXCEL == inPage.m_pSheet->GetImportExportStyle()
+		|| WIZARD_RADIO_CALC == inPage.m_pSheet->GetImportExportStyle())
 		hdrSep = L"\r\n";
-	std::vector<wxString> cols;
 
-	switch (m_pSheet->GetImportExportItem())
+	switch (m_Item)
 	{
 	default:
 		break;
 	case WIZ_EXPORT_RUNS:
-		for (index = 0; index < IO_TYPE_MAX; ++index)
+		for (size_t index = 0; index < IO_TYPE_MAX; ++index)
 		{
-			if (0 == columns[index].size())
+			if (0 == m_Columns[index].size())
 				continue;
-			for (iCol = 0; iCol < static_cast<long>(columns[index].size()); ++iCol)
+			for (long iCol = 0; iCol < static_cast<long>(m_Columns[index].size()); ++iCol)
 			{
-				wxString str = CDlgAssignColumns::GetNameFromColumnID(columns[index][iCol]);
-				if (iCol >= static_cast<long>(cols.size()))
-					cols.push_back(str);
+				wxString str = CDlgAssignColumns::GetNameFromColumnID(m_Columns[index][iCol]);
+				if (iCol >= static_cast<long>(m_Header.size()))
+					m_Header.push_back(str);
 				else
 				{
-					if (cols[iCol] != str && 0 < str.length())
-						cols[iCol] += hdrSep + str;
+					if (m_Header[iCol] != str && 0 < str.length())
+						m_Header[iCol] += hdrSep + str;
 				}
 			}
 		}
 		break;
 	case WIZ_EXPORT_CALENDAR:
-		for (index = 0; index < columns[IO_TYPE_CALENDAR].size(); ++index)
+		for (size_t index = 0; index < m_Columns[IO_TYPE_CALENDAR].size(); ++index)
 		{
-			wxString str = CDlgAssignColumns::GetNameFromColumnID(columns[IO_TYPE_CALENDAR][index]);
-			cols.push_back(str);
+			wxString str = CDlgAssignColumns::GetNameFromColumnID(m_Columns[IO_TYPE_CALENDAR][index]);
+			m_Header.push_back(str);
 		}
 		break;
 	case WIZ_EXPORT_CALENDAR_APPT:
-		for (index = 0; index < columns[IO_TYPE_CALENDAR_APPT].size(); ++index)
+		for (size_t index = 0; index < m_Columns[IO_TYPE_CALENDAR_APPT].size(); ++index)
 		{
-			wxString str = CDlgAssignColumns::GetNameFromColumnID(columns[IO_TYPE_CALENDAR_APPT][index]);
-			cols.push_back(str);
+			wxString str = CDlgAssignColumns::GetNameFromColumnID(m_Columns[IO_TYPE_CALENDAR_APPT][index]);
+			m_Header.push_back(str);
 		}
 		break;
 	case WIZ_EXPORT_CALENDAR_TASK:
-		for (index = 0; index < columns[IO_TYPE_CALENDAR_TASK].size(); ++index)
+		for (size_t index = 0; index < m_Columns[IO_TYPE_CALENDAR_TASK].size(); ++index)
 		{
-			wxString str = CDlgAssignColumns::GetNameFromColumnID(columns[IO_TYPE_CALENDAR_TASK][index]);
-			cols.push_back(str);
+			wxString str = CDlgAssignColumns::GetNameFromColumnID(m_Columns[IO_TYPE_CALENDAR_TASK][index]);
+			m_Header.push_back(str);
 		}
 		break;
 
 	case WIZ_EXPORT_LOG:
-		for (index = 0; index < columns[IO_TYPE_TRAINING].size(); ++index)
+		for (size_t index = 0; index < m_Columns[IO_TYPE_TRAINING].size(); ++index)
 		{
-			wxString str = CDlgAssignColumns::GetNameFromColumnID(columns[IO_TYPE_TRAINING][index]);
-			cols.push_back(str);
+			wxString str = CDlgAssignColumns::GetNameFromColumnID(m_Columns[IO_TYPE_TRAINING][index]);
+			m_Header.push_back(str);
 		}
 	}
+}
 
-	// Now start writing the data.
-	if (WIZARD_RADIO_EXCEL == m_pSheet->GetImportExportStyle() || WIZARD_RADIO_CALC == m_pSheet->GetImportExportStyle())
-	{
-		for (iCol = 0; iCol < static_cast<long>(cols.size()); ++iCol)
-			m_ctrlPreview->InsertColumn(iCol, L"");
-		m_ctrlPreview->InsertItem(
-			std::make_shared<CWizardExportListData>(GetDelim(), m_ctrlPreview->GetColumnCount(), cols));
-	}
-	else
-	{
-		m_ctrlPreview->InsertColumn(0, L"");
-		m_ctrlPreview->InsertItem(
-			std::make_shared<CWizardExportListData>(GetDelim(), m_ctrlPreview->GetColumnCount(), cols));
-	}
 
-	switch (m_pSheet->GetImportExportItem())
+bool CWizardExport::CRecordSource::Next(std::vector<wxString>& outRecord)
+{
+	outRecord.clear();
+	switch (m_Item)
 	{
 	default:
 		break;
 
 	case WIZ_EXPORT_RUNS:
-	{
-		for (ARBDogList::const_iterator iterDog = m_pDoc->Book().GetDogs().begin();
-			 iterDog != m_pDoc->Book().GetDogs().end();
-			 ++iterDog)
+		return NextRun(outRecord);
+
+	case WIZ_EXPORT_CALENDAR:
+		if (m_iterCal != m_Book.GetCalendar().end())
+		{
+			FormatCalendar(*m_iterCal++, outRecord);
+			return true;
+		}
+		break;
+
+	case WIZ_EXPORT_CALENDAR_APPT:
+		if (ARBCalendarPtr pCal = NextCalendar())
+		{
+			FormatAppointment(pCal, outRecord);
+			return true;
+		}
+		break;
+
+	case WIZ_EXPORT_CALENDAR_TASK:
+		for (ARBCalendarPtr pCal = NextCalendar(); pCal; pCal = NextCalendar())
 		{
-			ARBDogPtr pDog = *iterDog;
-			if (m_useFilter && pDog != m_pDoc->GetCurrentDog())
+			if (ARBCalendarEntry::Planning != pCal->GetEntered())
 				continue;
-			for (ARBDogTrialList::const_iterator iterTrial = pDog->GetTrials().begin();
-				 iterTrial != pDog->GetTrials().end();
-				 ++iterTrial)
-			{
-				ARBDogTrialPtr pTrial = *iterTrial;
-				if (m_useFilter && pTrial->IsFiltered())
-					continue;
-				for (ARBDogRunList::const_iterator iterRun = pTrial->GetRuns().begin();
-					 iterRun != pTrial->GetRuns().end();
-					 ++iterRun)
-				{
-					ARBDogRunPtr pRun = *iterRun;
-					if (m_useFilter && pRun->IsFiltered())
-						continue;
-					ARBConfigScoringPtr pScoring;
-					if (pRun->GetClub())
-						m_pDoc->Book().GetConfig().GetVenues().FindEvent(
-							pRun->GetClub()->GetVenue(),
-							pRun->GetEvent(),
-							pRun->GetDivision(),
-							pRun->GetLevel(),
-							pRun->GetDate(),
-							nullptr,
-							&pScoring);
-					assert(pScoring);
-					if (pScoring)
-					{
-						long idxType = -1;
-						switch (pScoring->GetScoringStyle())
-						{
-						case ARBScoringStyle::Unknown:
-							break;
-						case ARBScoringStyle::FaultsThenTime:
-						case ARBScoringStyle::Faults100ThenTime:
-						case ARBScoringStyle::Faults200ThenTime:
-						case ARBScoringStyle::TimeNoPlaces:
-						case ARBScoringStyle::TimePlaces:
-						case ARBScoringStyle::PassFail:
-							idxType = IO_TYPE_RUNS_FAULTS_TIME;
-							break;
-						case ARBScoringStyle::OCScoreThenTime:
-							idxType = IO_TYPE_RUNS_OPEN_CLOSE;
-							break;
-						case ARBScoringStyle::ScoreThenTime:
-							idxType = IO_TYPE_RUNS_POINTS;
-							break;
-						case ARBScoringStyle::TimePlusFaults:
-							idxType = IO_TYPE_RUNS_TIME_FAULTS;
-							break;
-						}
-						assert(-1 != idxType);
-						if (0 <= idxType)
-						{
-							std::vector<wxString> data;
-							for (long idx = 0; idx < static_cast<long>(columns[idxType].size()); ++idx)
-							{
-								// Note: All columns must have data written
-								// or export columns won't line up.
-								wxString fld;
-								switch (columns[idxType][idx])
-								{
-								default:
-									data.push_back(wxString());
-									break;
-								case IO_RUNS_REG_NAME:
-									data.push_back(pDog->GetRegisteredName());
-									break;
-								case IO_RUNS_CALL_NAME:
-									data.push_back(pDog->GetCallName());
-									break;
-								case IO_RUNS_DATE:
-									data.push_back(pRun->GetDate().GetString(format));
-									break;
-								case IO_RUNS_VENUE:
-								{
-									long i = 0;
-									for (ARBDogClubList::const_iterator iter = pTrial->GetClubs().begin();
-										 iter != pTrial->GetClubs().end();
-										 ++iter, ++i)
-									{
-										if (0 < i)
-											fld += L"/";
-										fld += (*iter)->GetVenue();
-									}
-									data.push_back(fld);
-								}
-								break;
-								case IO_RUNS_CLUB:
-								{
-									long i = 0;
-									for (ARBDogClubList::const_iterator iter = pTrial->GetClubs().begin();
-										 iter != pTrial->GetClubs().end();
-										 ++iter, ++i)
-									{
-										if (0 < i)
-											fld += L"/";
-										fld += (*iter)->GetName();
-									}
-									data.push_back(fld);
-								}
-								break;
-								case IO_RUNS_LOCATION:
-									data.push_back(pTrial->GetLocation());
-									break;
-								case IO_RUNS_TRIAL_NOTES:
-									data.push_back(pTrial->GetNote());
-									break;
-								case IO_RUNS_DIVISION:
-									data.push_back(pRun->GetDivision());
-									break;
-								case IO_RUNS_LEVEL:
-									data.push_back(pRun->GetLevel());
-									break;
-								case IO_RUNS_EVENT:
-									data.push_back(pRun->GetEvent());
-									break;
-								case IO_RUNS_HEIGHT:
-									data.push_back(pRun->GetHeight());
-									break;
-								case IO_RUNS_JUDGE:
-									data.push_back(pRun->GetJudge());
-									break;
-								case IO_RUNS_HANDLER:
-									data.push_back(pRun->GetHandler());
-									break;
-								case IO_RUNS_CONDITIONS:
-									data.push_back(pRun->GetConditions());
-									break;
-								case IO_RUNS_COURSE_FAULTS:
-									data.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetCourseFaults()));
-									break;
-								case IO_RUNS_TIME:
-									data.push_back(ARBDouble::ToString(pRun->GetScoring().GetTime()));
-									break;
-								case IO_RUNS_YARDS:
-									data.push_back(ARBDouble::ToString(pRun->GetScoring().GetYards(), 3));
-									break;
-								case IO_RUNS_MIN_YPS:
-								{
-									double yps;
-									if (pRun->GetScoring().GetMinYPS(CAgilityBookOptions::GetTableInYPS(), yps))
-									{
-										data.push_back(ARBDouble::ToString(yps, 3));
-									}
-									else
-									{
-										data.push_back(wxString());
-									}
-								}
-								break;
-								case IO_RUNS_YPS:
-								{
-									double yps;
-									if (pRun->GetScoring().GetYPS(CAgilityBookOptions::GetTableInYPS(), yps))
-									{
-										data.push_back(ARBDouble::ToString(yps, 3));
-									}
-									else
-									{
-										data.push_back(wxString());
-									}
-								}
-								break;
-								case IO_RUNS_OBSTACLES:
-								{
-									short ob = pRun->GetScoring().GetObstacles();
-									if (0 < ob)
-									{
-										data.push_back(wxString::Format(L"%hd", ob));
-									}
-									else
-									{
-										data.push_back(wxString());
-									}
-								}
-								break;
-								case IO_RUNS_OPS:
-								{
-									double ops = 0.0;
-									int prec = 2;
-									if (pRun->GetScoring().GetObstaclesPS(
-											CAgilityBookOptions::GetTableInYPS(),
-											CAgilityBookOptions::GetRunTimeInOPS(),
-											ops,
-											prec))
-									{
-										data.push_back(ARBDouble::ToString(ops, prec));
-									}
-									else
-									{
-										data.push_back(wxString());
-									}
-								}
-								break;
-								case IO_RUNS_SCT:
-									data.push_back(ARBDouble::ToString(pRun->GetScoring().GetSCT()));
-									break;
-								case IO_RUNS_TOTAL_FAULTS:
-								{
-									if (ARBScoringType::ByTime == pRun->GetScoring().GetType())
-									{
-										double faults = pRun->GetScoring().GetCourseFaults()
-														+ pRun->GetScoring().GetTimeFaults(pScoring);
-										data.push_back(ARBDouble::ToString(faults, 3));
-									}
-									else
-									{
-										data.push_back(wxString());
-									}
-								}
-								break;
-								case IO_RUNS_REQ_OPENING:
-									data.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetNeedOpenPts()));
-									break;
-								case IO_RUNS_REQ_CLOSING:
-									data.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetNeedClosePts()));
-									break;
-								case IO_RUNS_OPENING:
-									data.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetOpenPts()));
-									break;
-								case IO_RUNS_CLOSING:
-									data.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetClosePts()));
-									break;
-								case IO_RUNS_REQ_POINTS:
-									data.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetNeedOpenPts()));
-									break;
-								case IO_RUNS_POINTS:
-									data.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetOpenPts()));
-									break;
-								case IO_RUNS_PLACE:
-								{
-									short place = pRun->GetPlace();
-									if (0 > place)
-										fld = L"?";
-									else if (0 == place)
-										fld = L"-";
-									else
-										fld = wxString::Format(L"%hd", place);
-									data.push_back(fld);
-								}
-								break;
-								case IO_RUNS_IN_CLASS:
-								{
-									short inClass = pRun->GetInClass();
-									if (0 > inClass)
-										fld = L"?";
-									else
-										fld = wxString::Format(L"%hd", inClass);
-									data.push_back(fld);
-								}
-								break;
-								case IO_RUNS_DOGSQD:
-								{
-									short qd = pRun->GetDogsQd();
-									if (0 > qd)
-										fld = L"?";
-									else
-										fld = wxString::Format(L"%hd", qd);
-									data.push_back(fld);
-								}
-								break;
-								case IO_RUNS_Q:
-									if (pRun->GetQ().Qualified())
-									{
-										std::vector<ARBConfigMultiQPtr> multiQs;
-										if (0 < pRun->GetMultiQs(multiQs))
-										{
-											for (std::vector<ARBConfigMultiQPtr>::iterator iMultiQ = multiQs.begin();
-												 iMultiQ != multiQs.end();
-												 ++iMultiQ)
-											{
-												if (!fld.empty())
-													fld += L"/";
-												fld += (*iMultiQ)->GetShortName();
-											}
-										}
-										if (Q::SuperQ == pRun->GetQ())
-										{
-											if (!fld.empty())
-												fld += L"/";
-											fld += _("IDS_SQ");
-										}
-									}
-									if (fld.empty())
-										fld = pRun->GetQ().str();
-									data.push_back(fld);
-									break;
-								case IO_RUNS_SCORE:
-									if (pRun->GetQ().Qualified() || Q::NQ == pRun->GetQ())
-									{
-										data.push_back(ARBDouble::ToString(pRun->GetScore(pScoring)));
-									}
-									else
-									{
-										data.push_back(wxString());
-									}
-									break;
-								case IO_RUNS_TITLE_POINTS:
-								{
-									double pts = 0.0;
-									if (pRun->GetQ().Qualified())
-										pts = pRun->GetTitlePoints(pScoring);
-									data.push_back(wxString::Format(L"%g", pts));
-								}
-								break;
-								case IO_RUNS_COMMENTS:
-									data.push_back(pRun->GetNote());
-									break;
-								case IO_RUNS_FAULTS:
-								{
-									long i = 0;
-									for (ARBDogFaultList::const_iterator iter = pRun->GetFaults().begin();
-										 iter != pRun->GetFaults().end();
-										 ++iter)
-									{
-										if (0 < i)
-											fld += L"/";
-										fld += *iter;
-									}
-									data.push_back(fld);
-								}
-								break;
-								case IO_RUNS_SPEED:
-									if (pScoring->HasSpeedPts() && pRun->GetQ().Qualified())
-										fld << pRun->GetSpeedPoints(pScoring);
-									data.push_back(fld);
-									break;
-								case IO_RUNS_SUBNAME:
-									data.push_back(pRun->GetSubName());
-									break;
-								}
-							}
-							if (WIZARD_RADIO_EXCEL != m_pSheet->GetImportExportStyle()
-								&& WIZARD_RADIO_CALC != m_pSheet->GetImportExportStyle())
-								m_ctrlPreview->InsertItem(
-									std::make_shared<CWizardExportListData>(
-										GetDelim(),
-										m_ctrlPreview->GetColumnCount(),
-										data));
-						}
-					}
-				}
-			}
+			FormatTask(pCal, outRecord);
+			return true;
+		}
+		break;
+
+	case WIZ_EXPORT_LOG:
+		if (m_iterLog != m_Book.GetTraining().end())
+		{
+			FormatTraining(*m_iterLog++, outRecord);
+			return true;
 		}
+		break;
 	}
-	break;
+	return false;
+}
 
-	case WIZ_EXPORT_CALENDAR:
+
+bool CWizardExport::CRecordSource::NextRun(std::vector<wxString>& outData)
+{
+	bool useFilter = m_Page.m_useFilter;
+	for (;;)
 	{
-		for (ARBCalendarList::const_iterator iterCal = m_pDoc->Book().GetCalendar().begin();
-			 iterCal != m_pDoc->Book().GetCalendar().end();
-			 ++iterCal)
+		if (m_pTrial && m_iterRun != m_pTrial->GetRuns().end())
 		{
-			std::vector<wxString> data;
-			ARBCalendarPtr pCal = *iterCal;
-			for (long idx = 0; idx < static_cast<long>(columns[IO_TYPE_CALENDAR].size()); ++idx)
+			ARBDogRunPtr pRun = *m_iterRun++;
+			if (useFilter && pRun->IsFiltered())
+				continue;
+			ARBConfigScoringPtr pScoring;
+			if (pRun->GetClub())
+				m_Book.GetConfig().GetVenues().FindEvent(
+					pRun->GetClub()->GetVenue(),
+					pRun->GetEvent(),
+					pRun->GetDivision(),
+					pRun->GetLevel(),
+					pRun->GetDate(),
+					nullptr,
+					&pScoring);
+			assert(pScoring);
+			if (!pScoring)
+				continue;
+			long idxType = -1;
+			switch (pScoring->GetScoringStyle())
 			{
-				ARBDate date;
-				switch (columns[IO_TYPE_CALENDAR][idx])
-				{
-				case IO_CAL_START_DATE:
-					data.push_back(pCal->GetStartDate().GetString(format));
-					break;
-				case IO_CAL_END_DATE:
-					data.push_back(pCal->GetEndDate().GetString(format));
-					break;
-				case IO_CAL_TENTATIVE:
-					if (pCal->IsTentative())
-						data.push_back(L"?");
-					else
-						data.push_back(wxString());
-					break;
-				case IO_CAL_ENTERED:
-					switch (pCal->GetEntered())
-					{
-					case ARBCalendarEntry::Not:
-						break;
-					case ARBCalendarEntry::Entered:
-						data.push_back(Localization()->CalendarEntered());
-						break;
-					case ARBCalendarEntry::Pending:
-						data.push_back(Localization()->CalendarPending());
-						break;
-					case ARBCalendarEntry::Planning:
-						data.push_back(Localization()->CalendarPlanning());
-						break;
-					}
-					break;
-				case IO_CAL_LOCATION:
-					data.push_back(pCal->GetLocation());
-					break;
-				case IO_CAL_CLUB:
-					data.push_back(pCal->GetClub());
-					break;
-				case IO_CAL_VENUE:
-					data.push_back(pCal->GetVenue());
-					break;
-				case IO_CAL_OPENS:
-					date = pCal->GetOpeningDate();
-					if (date.IsValid())
-						data.push_back(date.GetString(format));
-					else
-						data.push_back(wxString());
-					break;
-				case IO_CAL_CLOSES:
-					date = pCal->GetClosingDate();
-					if (date.IsValid())
-						data.push_back(date.GetString(format));
-					else
-						data.push_back(wxString());
-					break;
-				case IO_CAL_NOTES:
-					data.push_back(pCal->GetNote());
-					break;
-				case IO_CAL_DRAWS:
-					date = pCal->GetDrawDate();
-					if (date.IsValid())
-						data.push_back(date.GetString(format));
-					else
-						data.push_back(wxString());
-					break;
-				default:
-					break;
-				}
+			case ARBScoringStyle::Unknown:
+				break;
+			case ARBScoringStyle::FaultsThenTime:
+			case ARBScoringStyle::Faults100ThenTime:
+			case ARBScoringStyle::Faults200ThenTime:
+			case ARBScoringStyle::TimeNoPlaces:
+			case ARBScoringStyle::TimePlaces:
+			case ARBScoringStyle::PassFail:
+				idxType = IO_TYPE_RUNS_FAULTS_TIME;
+				break;
+			case ARBScoringStyle::OCScoreThenTime:
+				idxType = IO_TYPE_RUNS_OPEN_CLOSE;
+				break;
+			case ARBScoringStyle::ScoreThenTime:
+				idxType = IO_TYPE_RUNS_POINTS;
+				break;
+			case ARBScoringStyle::TimePlusFaults:
+				idxType = IO_TYPE_RUNS_TIME_FAULTS;
+				break;
 			}
-			if (WIZARD_RADIO_EXCEL != m_pSheet->GetImportExportStyle()
-				&& WIZARD_RADIO_CALC != m_pSheet->GetImportExportStyle())
-				m_ctrlPreview->InsertItem(
-					std::make_shared<CWizardExportListData>(GetDelim(), m_ctrlPreview->GetColumnCount(), data));
+			assert(-1 != idxType);
+			if (0 > idxType)
+				continue;
+			FormatRun(m_pDog, m_pTrial, pRun, pScoring, idxType, outData);
+			return true;
+		}
+		if (m_pDog && m_iterTrial != m_pDog->GetTrials().end())
+		{
+			m_pTrial = *m_iterTrial++;
+			if (useFilter && m_pTrial->IsFiltered())
+				m_pTrial.reset();
+			else
+				m_iterRun = m_pTrial->GetRuns().begin();
+			continue;
 		}
+		m_pTrial.reset();
+		if (m_iterDog == m_Book.GetDogs().end())
+			return false;
+		m_pDog = *m_iterDog++;
+		if (useFilter && m_pDog != m_Page.m_pDoc->GetCurrentDog())
+			m_pDog.reset();
+		else
+			m_iterTrial = m_pDog->GetTrials().begin();
 	}
-	break;
+}
 
-	case WIZ_EXPORT_CALENDAR_APPT:
+
+ARBCalendarPtr CWizardExport::CRecordSource::NextCalendar()
+{
+	// The calendar view may have passed just the selected entries.
+	if (m_pEntries)
 	{
-		std::vector<ARBCalendarPtr> allEntries;
-		std::vector<ARBCalendarPtr>* entries = m_pSheet->GetCalendarEntries();
-		if (!entries)
+		if (m_idxEntry < m_pEntries->size())
+			return (*m_pEntries)[m_idxEntry++];
+	}
+	else if (m_iterCal != m_Book.GetCalendar().end())
+		return *m_iterCal++;
+	return ARBCalendarPtr();
+}
+
+
+void CWizardExport::CRecordSource::FormatRun(
+	ARBDogPtr const& pDog,
+	ARBDogTrialPtr const& pTrial,
+	ARBDogRunPtr const& pRun,
+	ARBConfigScoringPtr const& pScoring,
+	long idxType,
+	std::vector<wxString>& outData) const
+{
+	for (long idx = 0; idx < static_cast<long>(m_Columns[idxType].size()); ++idx)
+	{
+		// Note: All columns must have data written
+		// or export columns won't line up.
+		wxString fld;
+		switch (m_Columns[idxType][idx])
 		{
-			allEntries.reserve(m_pDoc->Book().GetCalendar().size());
-			for (ARBCalendarList::const_iterator iterCal = m_pDoc->Book().GetCalendar().begin();
-				 iterCal != m_pDoc->Book().GetCalendar().end();
-				 ++iterCal)
+		default:
+			outData.push_back(wxString());
+			break;
+		case IO_RUNS_REG_NAME:
+			outData.push_back(pDog->GetRegisteredName());
+			break;
+		case IO_RUNS_CALL_NAME:
+			outData.push_back(pDog->GetCallName());
+			break;
+		case IO_RUNS_DATE:
+			outData.push_back(pRun->GetDate().GetString(m_Format));
+			break;
+		case IO_RUNS_VENUE:
+		{
+			long i = 0;
+			for (ARBDogClubList::const_iterator iter = pTrial->GetClubs().begin();
+				 iter != pTrial->GetClubs().end();
+				 ++iter, ++i)
 			{
-				allEntries.push_back(*iterCal);
+				if (0 < i)
+					fld += L"/";
+				fld += (*iter)->GetVenue();
 			}
-			entries = &allEntries;
+			outData.push_back(fld);
 		}
-		for (std::vector<ARBCalendarPtr>::const_iterator iterCal = entries->begin(); iterCal != entries->end();
-			 ++iterCal)
+		break;
+		case IO_RUNS_CLUB:
 		{
-			std::vector<wxString> data;
-			ARBCalendarPtr pCal = *iterCal;
-			for (long idx = 0; idx < static_cast<long>(columns[IO_TYPE_CALENDAR_APPT].size()); ++idx)
+			long i = 0;
+			for (ARBDogClubList::const_iterator iter = pTrial->GetClubs().begin();
+				 iter != pTrial->GetClubs().end();
+				 ++iter, ++i)
 			{
-				ARBDate date;
-				switch (columns[IO_TYPE_CALENDAR_APPT][idx])
-				{
-				case IO_CAL_APPT_SUBJECT:
-					data.push_back(pCal->GetGenericName());
-					break;
-				case IO_CAL_APPT_START_DATE:
-					data.push_back(pCal->GetStartDate().GetString(format));
-					break;
-				case IO_CAL_APPT_START_TIME:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_END_DATE:
-					data.push_back(pCal->GetEndDate().GetString(format));
-					break;
-				case IO_CAL_APPT_END_TIME:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_ALLDAY:
-					data.push_back(L"1");
-					break;
-				case IO_CAL_APPT_REMINDER:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_REMINDER_DATE:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_REMINDER_TIME:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_ORGANIZER:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_REQ_ATTENDEES:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_OPT_ATTENDEES:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_RESOURCES:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_BILLING:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_CATEGORIES:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_DESCRIPTION:
+				if (0 < i)
+					fld += L"/";
+				fld += (*iter)->GetName();
+			}
+			outData.push_back(fld);
+		}
+		break;
+		case IO_RUNS_LOCATION:
+			outData.push_back(pTrial->GetLocation());
+			break;
+		case IO_RUNS_TRIAL_NOTES:
+			outData.push_back(pTrial->GetNote());
+			break;
+		case IO_RUNS_DIVISION:
+			outData.push_back(pRun->GetDivision());
+			break;
+		case IO_RUNS_LEVEL:
+			outData.push_back(pRun->GetLevel());
+			break;
+		case IO_RUNS_EVENT:
+			outData.push_back(pRun->GetEvent());
+			break;
+		case IO_RUNS_HEIGHT:
+			outData.push_back(pRun->GetHeight());
+			break;
+		case IO_RUNS_JUDGE:
+			outData.push_back(pRun->GetJudge());
+			break;
+		case IO_RUNS_HANDLER:
+			outData.push_back(pRun->GetHandler());
+			break;
+		case IO_RUNS_CONDITIONS:
+			outData.push_back(pRun->GetConditions());
+			break;
+		case IO_RUNS_COURSE_FAULTS:
+			outData.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetCourseFaults()));
+			break;
+		case IO_RUNS_TIME:
+			outData.push_back(ARBDouble::ToString(pRun->GetScoring().GetTime()));
+			break;
+		case IO_RUNS_YARDS:
+			outData.push_back(ARBDouble::ToString(pRun->GetScoring().GetYards(), 3));
+			break;
+		case IO_RUNS_MIN_YPS:
+		{
+			double yps;
+			if (pRun->GetScoring().GetMinYPS(CAgilityBookOptions::GetTableInYPS(), yps))
+			{
+				outData.push_back(ARBDouble::ToString(yps, 3));
+			}
+			else
+			{
+				outData.push_back(wxString());
+			}
+		}
+		break;
+		case IO_RUNS_YPS:
+		{
+			double yps;
+			if (pRun->GetScoring().GetYPS(CAgilityBookOptions::GetTableInYPS(), yps))
+			{
+				outData.push_back(ARBDouble::ToString(yps, 3));
+			}
+			else
+			{
+				outData.push_back(wxString());
+			}
+		}
+		break;
+		case IO_RUNS_OBSTACLES:
+		{
+			short ob = pRun->GetScoring().GetObstacles();
+			if (0 < ob)
+			{
+				outData.push_back(wxString::Format(L"%hd", ob));
+			}
+			else
+			{
+				outData.push_back(wxString());
+			}
+		}
+		break;
+		case IO_RUNS_OPS:
+		{
+			double ops = 0.0;
+			int prec = 2;
+			if (pRun->GetScoring().GetObstaclesPS(
+					CAgilityBookOptions::GetTableInYPS(),
+					CAgilityBookOptions::GetRunTimeInOPS(),
+					ops,
+					prec))
+			{
+				outData.push_back(ARBDouble::ToString(ops, prec));
+			}
+			else
+			{
+				outData.push_back(wxString());
+			}
+		}
+		break;
+		case IO_RUNS_SCT:
+			outData.push_back(ARBDouble::ToString(pRun->GetScoring().GetSCT()));
+			break;
+		case IO_RUNS_TOTAL_FAULTS:
+		{
+			if (ARBScoringType::ByTime == pRun->GetScoring().GetType())
+			{
+				double faults = pRun->GetScoring().GetCourseFaults()
+								+ pRun->GetScoring().GetTimeFaults(pScoring);
+				outData.push_back(ARBDouble::ToString(faults, 3));
+			}
+			else
+			{
+				outData.push_back(wxString());
+			}
+		}
+		break;
+		case IO_RUNS_REQ_OPENING:
+			outData.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetNeedOpenPts()));
+			break;
+		case IO_RUNS_REQ_CLOSING:
+			outData.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetNeedClosePts()));
+			break;
+		case IO_RUNS_OPENING:
+			outData.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetOpenPts()));
+			break;
+		case IO_RUNS_CLOSING:
+			outData.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetClosePts()));
+			break;
+		case IO_RUNS_REQ_POINTS:
+			outData.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetNeedOpenPts()));
+			break;
+		case IO_RUNS_POINTS:
+			outData.push_back(wxString::Format(L"%hd", pRun->GetScoring().GetOpenPts()));
+			break;
+		case IO_RUNS_PLACE:
+		{
+			short place = pRun->GetPlace();
+			if (0 > place)
+				fld = L"?";
+			else if (0 == place)
+				fld = L"-";
+			else
+				fld = wxString::Format(L"%hd", place);
+			outData.push_back(fld);
+		}
+		break;
+		case IO_RUNS_IN_CLASS:
+		{
+			short inClass = pRun->GetInClass();
+			if (0 > inClass)
+				fld = L"?";
+			else
+				fld = wxString::Format(L"%hd", inClass);
+			outData.push_back(fld);
+		}
+		break;
+		case IO_RUNS_DOGSQD:
+		{
+			short qd = pRun->GetDogsQd();
+			if (0 > qd)
+				fld = L"?";
+			else
+				fld = wxString::Format(L"%hd", qd);
+			outData.push_back(fld);
+		}
+		break;
+		case IO_RUNS_Q:
+			if (pRun->GetQ().Qualified())
+			{
+				std::vector<ARBConfigMultiQPtr> multiQs;
+				if (0 < pRun->GetMultiQs(multiQs))
 				{
-					wxString tmp;
-					if (pCal->IsTentative())
-					{
-						tmp += Localization()->CalendarTentative();
-						tmp += L" ";
-					}
-					switch (pCal->GetEntered())
+					for (std::vector<ARBConfigMultiQPtr>::iterator iMultiQ = multiQs.begin();
+						 iMultiQ != multiQs.end();
+						 ++iMultiQ)
 					{
-					case ARBCalendarEntry::Not:
-						tmp += Localization()->CalendarStatusN();
-						tmp += L" ";
-						break;
-					case ARBCalendarEntry::Entered:
-						tmp += Localization()->CalendarStatusE();
-						tmp += L" ";
-						break;
-					case ARBCalendarEntry::Pending:
-						tmp += Localization()->CalendarStatusO();
-						tmp += L" ";
-						break;
-					case ARBCalendarEntry::Planning:
-						tmp += Localization()->CalendarStatusP();
-						tmp += L" ";
-						break;
+						if (!fld.empty())
+							fld += L"/";
+						fld += (*iMultiQ)->GetShortName();
 					}
-					date = pCal->GetOpeningDate();
-					if (date.IsValid())
-					{
-						tmp += Localization()->CalendarOpens();
-						tmp += L" ";
-						tmp += date.GetString(format);
-						tmp += L" ";
-					}
-					date = pCal->GetClosingDate();
-					if (date.IsValid())
-					{
-						tmp += Localization()->CalendarCloses();
-						tmp += L" ";
-						tmp += date.GetString(format);
-						tmp += L" ";
-					}
-					tmp += pCal->GetNote();
-					data.push_back(tmp);
 				}
-				break;
-				case IO_CAL_APPT_LOCATION:
-					data.push_back(pCal->GetLocation());
-					break;
-				case IO_CAL_APPT_MILEAGE:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_PRIORITY:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_PRIVATE:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_SENSITIVITY:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_APPT_SHOW_TIME_AS:
-					data.push_back(wxString());
-					break;
-				default:
-					break;
+				if (Q::SuperQ == pRun->GetQ())
+				{
+					if (!fld.empty())
+						fld += L"/";
+					fld += _("IDS_SQ");
 				}
 			}
-			if (WIZARD_RADIO_EXCEL != m_pSheet->GetImportExportStyle()
-				&& WIZARD_RADIO_CALC != m_pSheet->GetImportExportStyle())
-				m_ctrlPreview->InsertItem(
-					std::make_shared<CWizardExportListData>(GetDelim(), m_ctrlPreview->GetColumnCount(), data));
+			if (fld.empty())
+				fld = pRun->GetQ().str();
+			outData.push_back(fld);
+			break;
+		case IO_RUNS_SCORE:
+			if (pRun->GetQ().Qualified() || Q::NQ == pRun->GetQ())
+			{
+				outData.push_back(ARBDouble::ToString(pRun->GetScore(pScoring)));
+			}
+			else
+			{
+				outData.push_back(wxString());
+			}
+			break;
+		case IO_RUNS_TITLE_POINTS:
+		{
+			double pts = 0.0;
+			if (pRun->GetQ().Qualified())
+				pts = pRun->GetTitlePoints(pScoring);
+			outData.push_back(wxString::Format(L"%g", pts));
+		}
+		break;
+		case IO_RUNS_COMMENTS:
+			outData.push_back(pRun->GetNote());
+			break;
+		case IO_RUNS_FAULTS:
+		{
+			long i = 0;
+			for (ARBDogFaultList::const_iterator iter = pRun->GetFaults().begin();
+				 iter != pRun->GetFaults().end();
+				 ++iter)
+			{
+				if (0 < i)
+					fld += L"/";
+				fld += *iter;
+			}
+			outData.push_back(fld);
+		}
+		break;
+		case IO_RUNS_SPEED:
+			if (pScoring->HasSpeedPts() && pRun->GetQ().Qualified())
+				fld << pRun->GetSpeedPoints(pScoring);
+			outData.push_back(fld);
+			break;
+		case IO_RUNS_SUBNAME:
+			outData.push_back(pRun->GetSubName());
+			break;
 		}
 	}
-	break;
+}
 
-	case WIZ_EXPORT_CALENDAR_TASK:
+
+void CWizardExport::CRecordSource::FormatCalendar(ARBCalendarPtr const& pCal, std::vector<wxString>& outData) const
+{
+	for (long idx = 0; idx < static_cast<long>(m_Columns[IO_TYPE_CALENDAR].size()); ++idx)
 	{
-		std::vector<ARBCalendarPtr> allEntries;
-		std::vector<ARBCalendarPtr>* entries = m_pSheet->GetCalendarEntries();
-		if (!entries)
+		ARBDate date;
+		switch (m_Columns[IO_TYPE_CALENDAR][idx])
 		{
-			allEntries.reserve(m_pDoc->Book().GetCalendar().size());
-			for (ARBCalendarList::const_iterator iterCal = m_pDoc->Book().GetCalendar().begin();
-				 iterCal != m_pDoc->Book().GetCalendar().end();
-				 ++iterCal)
+		case IO_CAL_START_DATE:
+			outData.push_back(pCal->GetStartDate().GetString(m_Format));
+			break;
+		case IO_CAL_END_DATE:
+			outData.push_back(pCal->GetEndDate().GetString(m_Format));
+			break;
+		case IO_CAL_TENTATIVE:
+			if (pCal->IsTentative())
+				outData.push_back(L"?");
+			else
+				outData.push_back(wxString());
+			break;
+		case IO_CAL_ENTERED:
+			switch (pCal->GetEntered())
 			{
-				allEntries.push_back(*iterCal);
+			case ARBCalendarEntry::Not:
+				break;
+			case ARBCalendarEntry::Entered:
+				outData.push_back(Localization()->CalendarEntered());
+				break;
+			case ARBCalendarEntry::Pending:
+				outData.push_back(Localization()->CalendarPending());
+				break;
+			case ARBCalendarEntry::Planning:
+				outData.push_back(Localization()->CalendarPlanning());
+				break;
 			}
-			entries = &allEntries;
+			break;
+		case IO_CAL_LOCATION:
+			outData.push_back(pCal->GetLocation());
+			break;
+		case IO_CAL_CLUB:
+			outData.push_back(pCal->GetClub());
+			break;
+		case IO_CAL_VENUE:
+			outData.push_back(pCal->GetVenue());
+			break;
+		case IO_CAL_OPENS:
+			date = pCal->GetOpeningDate();
+			if (date.IsValid())
+				outData.push_back(date.GetString(m_Format));
+			else
+				outData.push_back(wxString());
+			break;
+		case IO_CAL_CLOSES:
+			date = pCal->GetClosingDate();
+			if (date.IsValid())
+				outData.push_back(date.GetString(m_Format));
+			else
+				outData.push_back(wxString());
+			break;
+		case IO_CAL_NOTES:
+			outData.push_back(pCal->GetNote());
+			break;
+		case IO_CAL_DRAWS:
+			date = pCal->GetDrawDate();
+			if (date.IsValid())
+				outData.push_back(date.GetString(m_Format));
+			else
+				outData.push_back(wxString());
+			break;
+		default:
+			break;
 		}
-		for (std::vector<ARBCalendarPtr>::const_iterator iterCal = entries->begin(); iterCal != entries->end();
-			 ++iterCal)
+	}
+}
+
+
+void CWizardExport::CRecordSource::FormatAppointment(ARBCalendarPtr const& pCal, std::vector<wxString>& outData) const
+{
+	for (long idx = 0; idx < static_cast<long>(m_Columns[IO_TYPE_CALENDAR_APPT].size()); ++idx)
+	{
+		ARBDate date;
+		switch (m_Columns[IO_TYPE_CALENDAR_APPT][idx])
 		{
-			std::vector<wxString> data;
-			ARBCalendarPtr pCal = *iterCal;
-			if (ARBCalendarEntry::Planning != pCal->GetEntered())
-				continue;
-			for (long idx = 0; idx < static_cast<long>(columns[IO_TYPE_CALENDAR_TASK].size()); ++idx)
+		case IO_CAL_APPT_SUBJECT:
+			outData.push_back(pCal->GetGenericName());
+			break;
+		case IO_CAL_APPT_START_DATE:
+			outData.push_back(pCal->GetStartDate().GetString(m_Format));
+			break;
+		case IO_CAL_APPT_START_TIME:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_END_DATE:
+			outData.push_back(pCal->GetEndDate().GetString(m_Format));
+			break;
+		case IO_CAL_APPT_END_TIME:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_ALLDAY:
+			outData.push_back(L"1");
+			break;
+		case IO_CAL_APPT_REMINDER:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_REMINDER_DATE:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_REMINDER_TIME:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_ORGANIZER:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_REQ_ATTENDEES:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_OPT_ATTENDEES:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_RESOURCES:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_BILLING:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_CATEGORIES:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_DESCRIPTION:
+		{
+			wxString tmp;
+			if (pCal->IsTentative())
 			{
-				ARBDate date;
-				ARBDate dateStart = pCal->GetOpeningDate();
-				if (!dateStart.IsValid())
-					dateStart = pCal->GetStartDate();
-				ARBDate dateDue = pCal->GetClosingDate();
-				if (!dateDue.IsValid())
-					dateDue = pCal->GetStartDate();
-				if (dateStart > dateDue)
-					dateStart = dateDue;
-				dateStart -= CAgilityBookOptions::CalendarOpeningNear();
-				switch (columns[IO_TYPE_CALENDAR_TASK][idx])
-				{
-				case IO_CAL_TASK_SUBJECT:
-					data.push_back(pCal->GetGenericName());
-					break;
-				case IO_CAL_TASK_START_DATE:
-					data.push_back(dateStart.GetString(format));
-					break;
-				case IO_CAL_TASK_DUE_DATE:
-					data.push_back(dateDue.GetString(format));
-					break;
-				case IO_CAL_TASK_REMINDER:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_REMINDER_DATE:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_REMINDER_TIME:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_COMPLETED_DATE:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_COMPLETE:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_TOTAL_WORK:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_ACTUAL_WORK:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_BILLING:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_CATEGORIES:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_COMPANIES:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_CONTACTS:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_MILEAGE:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_NOTES:
-				{
-					wxString tmp;
-					if (pCal->IsTentative())
-					{
-						tmp << Localization()->CalendarTentative() << L" ";
-					}
-					date = pCal->GetOpeningDate();
-					if (date.IsValid())
-					{
-						tmp << Localization()->CalendarOpens() << L" " << date.GetString(format) << L" ";
-					}
-					date = pCal->GetClosingDate();
-					if (date.IsValid())
-					{
-						tmp << Localization()->CalendarCloses() << L" " << date.GetString(format) << L" ";
-					}
-					tmp += wxString::Format(
-						_("IDS_TRIAL_DATES"),
-						pCal->GetStartDate().GetString(format),
-						pCal->GetEndDate().GetString(format));
-					tmp << L" " << pCal->GetNote();
-					data.push_back(tmp);
-				}
+				tmp += Localization()->CalendarTentative();
+				tmp += L" ";
+			}
+			switch (pCal->GetEntered())
+			{
+			case ARBCalendarEntry::Not:
+				tmp += Localization()->CalendarStatusN();
+				tmp += L" ";
 				break;
-				case IO_CAL_TASK_PRIORITY:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_PRIVATE:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_ROLE:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_SCH_PRIORITY:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_SENSITIVITY:
-					data.push_back(wxString());
-					break;
-				case IO_CAL_TASK_STATUS:
-					data.push_back(wxString());
-					break;
-				default:
-					break;
-				}
+			case ARBCalendarEntry::Entered:
+				tmp += Localization()->CalendarStatusE();
+				tmp += L" ";
+				break;
+			case ARBCalendarEntry::Pending:
+				tmp += Localization()->CalendarStatusO();
+				tmp += L" ";
+				break;
+			case ARBCalendarEntry::Planning:
+				tmp += Localization()->CalendarStatusP();
+				tmp += L" ";
+				break;
+			}
+			date = pCal->GetOpeningDate();
+			if (date.IsValid())
+			{
+				tmp += Localization()->CalendarOpens();
+				tmp += L" ";
+				tmp += date.GetString(m_Format);
+				tmp += L" ";
 			}
-			if (WIZARD_RADIO_EXCEL != m_pSheet->GetImportExportStyle()
-				&& WIZARD_RADIO_CALC != m_pSheet->GetImportExportStyle())
-				m_ctrlPreview->InsertItem(
-					std::make_shared<CWizardExportListData>(GetDelim(), m_ctrlPreview->GetColumnCount(), data));
+			date = pCal->GetClosingDate();
+			if (date.IsValid())
+			{
+				tmp += Localization()->CalendarCloses();
+				tmp += L" ";
+				tmp += date.GetString(m_Format);
+				tmp += L" ";
+			}
+			tmp += pCal->GetNote();
+			outData.push_back(tmp);
+		}
+		break;
+		case IO_CAL_APPT_LOCATION:
+			outData.push_back(pCal->GetLocation());
+			break;
+		case IO_CAL_APPT_MILEAGE:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_PRIORITY:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_PRIVATE:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_SENSITIVITY:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_APPT_SHOW_TIME_AS:
+			outData.push_back(wxString());
+			break;
+		default:
+			break;
 		}
 	}
-	break;
+}
 
-	case WIZ_EXPORT_LOG:
+
+void CWizardExport::CRecordSource::FormatTask(ARBCalendarPtr const& pCal, std::vector<wxString>& outData) const
+{
+	for (long idx = 0; idx < static_cast<long>(m_Columns[IO_TYPE_CALENDAR_TASK].size()); ++idx)
 	{
-		for (ARBTrainingList::const_iterator iterLog = m_pDoc->Book().GetTraining().begin();
-			 iterLog != m_pDoc->Book().GetTraining().end();
-			 ++iterLog)
+		ARBDate date;
+		ARBDate dateStart = pCal->GetOpeningDate();
+		if (!dateStart.IsValid())
+			dateStart = pCal->GetStartDate();
+		ARBDate dateDue = pCal->GetClosingDate();
+		if (!dateDue.IsValid())
+			dateDue = pCal->GetStartDate();
+		if (dateStart > dateDue)
+			dateStart = dateDue;
+		dateStart -= CAgilityBookOptions::CalendarOpeningNear();
+		switch (m_Columns[IO_TYPE_CALENDAR_TASK][idx])
+		{
+		case IO_CAL_TASK_SUBJECT:
+			outData.push_back(pCal->GetGenericName());
+			break;
+		case IO_CAL_TASK_START_DATE:
+			outData.push_back(dateStart.GetString(m_Format));
+			break;
+		case IO_CAL_TASK_DUE_DATE:
+			outData.push_back(dateDue.GetString(m_Format));
+			break;
+		case IO_CAL_TASK_REMINDER:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_REMINDER_DATE:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_REMINDER_TIME:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_COMPLETED_DATE:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_COMPLETE:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_TOTAL_WORK:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_ACTUAL_WORK:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_BILLING:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_CATEGORIES:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_COMPANIES:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_CONTACTS:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_MILEAGE:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_NOTES:
 		{
-			std::vector<wxString> data;
-			ARBTrainingPtr pLog = *iterLog;
-			for (long idx = 0; idx < static_cast<long>(columns[IO_TYPE_TRAINING].size()); ++idx)
+			wxString tmp;
+			if (pCal->IsTentative())
 			{
-				switch (columns[IO_TYPE_TRAINING][idx])
-				{
-				case IO_LOG_DATE:
-					data.push_back(pLog->GetDate().GetString(format));
-					break;
-				case IO_LOG_NAME:
-					data.push_back(pLog->GetName());
-					break;
-				case IO_LOG_SUBNAME:
-					data.push_back(pLog->GetSubName());
-					break;
-				case IO_LOG_NOTES:
-					data.push_back(pLog->GetNote());
-					break;
-				default:
-					break;
-				}
+				tmp << Localization()->CalendarTentative() << L" ";
+			}
+			date = pCal->GetOpeningDate();
+			if (date.IsValid())
+			{
+				tmp << Localization()->CalendarOpens() << L" " << date.GetString(m_Format) << L" ";
+			}
+			date = pCal->GetClosingDate();
+			if (date.IsValid())
+			{
+				tmp << Localization()->CalendarCloses() << L" " << date.GetString(m_Format) << L" ";
 			}
-			if (WIZARD_RADIO_EXCEL != m_pSheet->GetImportExportStyle()
-				&& WIZARD_RADIO_CALC != m_pSheet->GetImportExportStyle())
-				m_ctrlPreview->InsertItem(
-					std::make_shared<CWizardExportListData>(GetDelim(), m_ctrlPreview->GetColumnCount(), data));
+			tmp += wxString::Format(
+				_("IDS_TRIAL_DATES"),
+				pCal->GetStartDate().GetString(m_Format),
+				pCal->GetEndDate().GetString(m_Format));
+			tmp << L" " << pCal->GetNote();
+			outData.push_back(tmp);
+		}
+		break;
+		case IO_CAL_TASK_PRIORITY:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_PRIVATE:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_ROLE:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_SCH_PRIORITY:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_SENSITIVITY:
+			outData.push_back(wxString());
+			break;
+		case IO_CAL_TASK_STATUS:
+			outData.push_back(wxString());
+			break;
+		default:
+			break;
 		}
 	}
-	break;
+}
+
+
+void CWizardExport::CRecordSource::FormatTraining(ARBTrainingPtr const& pLog, std::vector<wxString>& outData) const
+{
+	for (long idx = 0; idx < static_cast<long>(m_Columns[IO_TYPE_TRAINING].size()); ++idx)
+	{
+		switch (m_Columns[IO_TYPE_TRAINING][idx])
+		{
+		case IO_LOG_DATE:
+			outData.push_back(pLog->GetDate().GetString(m_Format));
+			break;
+		case IO_LOG_NAME:
+			outData.push_back(pLog->GetName());
+			break;
+		case IO_LOG_SUBNAME:
+			outData.push_back(pLog->GetSubName());
+			break;
+		case IO_LOG_NOTES:
+			outData.push_back(pLog->GetNote());
+			break;
+		default:
+			break;
+		}
 	}
+}
+
+
+void CWizardExport::UpdatePreview()
+{
+	wxBusyCursor wait;
+
+	m_ctrlPreview->Freeze();
+
+	// Clear existing preview data.
+	m_ctrlPreview->DeleteAllItems();
+	long nColumnCount = m_ctrlPreview->GetColumnCount();
+	long iCol;
+	for (iCol = 0; iCol < nColumnCount; ++iCol)
+		m_ctrlPreview->DeleteColumn(0);
+
+	wchar_t delim = GetDelim();
+	if (WIZARD_RADIO_EXCEL != m_pSheet->GetImportExportStyle() && WIZARD_RADIO_CALC != m_pSheet->GetImportExportStyle()
+		&& 0 == delim)
+	{
+		wxString nodelim(_("IDS_NO_DELIM_SPECIFIED"));
+		m_ctrlPreview->InsertColumn(0, L"");
+		m_ctrlPreview->SetColumnWidth(0, wxLIST_AUTOSIZE_USEHEADER);
+		m_ctrlPreview->Thaw();
+		m_ctrlPreview->Refresh();
+		return;
+	}
+
+	CRecordSource source(*this);
+	std::vector<wxString> const& cols = source.GetHeader();
+	if (WIZARD_RADIO_EXCEL == m_pSheet->GetImportExportStyle() || WIZARD_RADIO_CALC == m_pSheet->GetImportExportStyle())
+	{
+		for (iCol = 0; iCol < static_cast<long>(cols.size()); ++iCol)
+			m_ctrlPreview->InsertColumn(iCol, L"");
+	}
+	else
+	{
+		m_ctrlPreview->InsertColumn(0, L"");
+	}
+	m_ctrlPreview->InsertItem(
+		std::make_shared<CWizardExportListData>(delim, m_ctrlPreview->GetColumnCount(), cols));
+
+	// The export formats everything again, so only show what can be seen.
+	std::vector<wxString> data;
+	for (size_t nRows = 0; nRows < MAX_PREVIEW_ROWS && source.Next(data); ++nRows)
+	{
+		m_ctrlPreview->InsertItem(
+			std::make_shared<CWizardExportListData>(delim, m_ctrlPreview->GetColumnCount(), data));
+	}
+
 	for (iCol = 0; iCol < static_cast<long>(cols.size()); ++iCol)
 		m_ctrlPreview->SetColumnWidth(iCol, wxLIST_AUTOSIZE_USEHEADER);
 	m_ctrlPreview->Thaw();
@@ -1482,7 +1572,6 @@ bool CWizardExport::DoWizardFinish()
 		m_ctrlDateFormat->SetFocus();
 		return false;
 	}
-	UpdatePreview();
 	if (WIZARD_RADIO_EXCEL != m_pSheet->GetImportExportStyle() && WIZARD_RADIO_CALC != m_pSheet->GetImportExportStyle())
 	{
 		CAgilityBookOptions::SetImportExportDelimiters(false, m_Delim, m_Delimiter);
@@ -1491,54 +1580,58 @@ bool CWizardExport::DoWizardFinish()
 	CAgilityBookOptions::SetImportExportDateFormat(false, format);
 	CAgilityBookOptions::SetExportFilter(m_useFilter);
 
+	// Records are formatted as they are written, nothing is collected first.
+	CRecordSource source(*this);
+	std::vector<wxString> record;
+
 	if (WIZARD_RADIO_EXCEL == m_pSheet->GetImportExportStyle() || WIZARD_RADIO_CALC == m_pSheet->GetImportExportStyle())
 	{
 		CLogger::Log(L"WIZARD: CWizardExport (Excel/Calc)");
-		ISpreadSheetExporterPtr pExporter;
-		if (WIZARD_RADIO_EXCEL == m_pSheet->GetImportExportStyle() && m_pSheet->ExcelHelper())
-			pExporter = m_pSheet->ExcelHelper()->GetExporter();
-		else if (WIZARD_RADIO_CALC == m_pSheet->GetImportExportStyle() && m_pSheet->CalcHelper())
-			pExporter = m_pSheet->CalcHelper()->GetExporter();
-		if (pExporter)
+		bool bExcel = (WIZARD_RADIO_EXCEL == m_pSheet->GetImportExportStyle());
+		wxFileDialog file(
+			this,
+			wxString(), // caption
+			wxString(), // def dir
+			wxString(),
+			bExcel ? _("IDS_FILEEXT_FILTER_XLSX") : _("IDS_FILEEXT_FILTER_OOCALC"),
+			wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+		if (wxID_OK != file.ShowModal())
+			return false;
+		wxFileName filename(file.GetPath());
+		if (!filename.HasExt())
+			filename.SetExt(bExcel ? L"xlsx" : L"ods");
+
+		wxBusyCursor wait;
+		// Size the columns to the data (what AutoFit did in the application).
+		// The preview has the header and the first records.
+		long nColumnCount = m_ctrlPreview->GetColumnCount();
+		std::vector<size_t> widths(nColumnCount, 0);
+		for (long i = 0; i < m_ctrlPreview->GetItemCount(); ++i)
 		{
-			pExporter->AllowAccess(false);
-			long nColumnCount = m_ctrlPreview->GetColumnCount();
-			IDlgProgress* pProgress = IDlgProgress::CreateProgress(1, this);
-			pProgress->EnableCancel(false);
-			pProgress->SetMessage(_("IDS_EXPORTING"));
-			pProgress->SetRange(1, m_ctrlPreview->GetItemCount() * nColumnCount);
-			pProgress->ShowProgress();
-
-			bool bFailed = false;
-			for (long i = 0; !bFailed && i < m_ctrlPreview->GetItemCount(); ++i)
-			{
-				for (long iCol = 0; !bFailed && iCol < nColumnCount; ++iCol)
-				{
-					// Don't use the winapi to get data. That will trucate long lines.
-					auto data = std::dynamic_pointer_cast<CWizardExportListData, CListData>(m_ctrlPreview->GetData(i));
-					wxString line = data->OnNeedText(iCol);
-					bFailed = !pExporter->InsertData(i, iCol, line);
-					// Calc is started visibly, so steal focus back.
-					if (0 == i && 0 == iCol)
-						pProgress->SetForegroundWindow();
-					pProgress->StepIt(1);
-				}
-			}
-			pExporter->AutoFit(0, nColumnCount - 1);
-			pProgress->Dismiss();
-			pExporter->AllowAccess(true);
-			// For testing
-			// pExporter->SetBackColor(2,3,RGB(255,0,0));
-			// pExporter->SetTextColor(2,3,RGB(0,255,0));
-			// pExporter->SetItalic(1,1,true);
-			// pExporter->SetBold(1,2,true);
-			return true;
+			// Don't use the winapi to get data. That will trucate long lines.
+			auto data = std::dynamic_pointer_cast<CWizardExportListData, CListData>(m_ctrlPreview->GetData(i));
+			for (long iCol = 0; iCol < nColumnCount; ++iCol)
+				widths[iCol] = std::max(widths[iCol], data->OnNeedText(iCol).length());
 		}
-		else
+
+		bool bOk = false;
+		wxFFileOutputStream output(filename.GetFullPath(), L"wb");
+		if (output.IsOk())
+		{
+			ARBSpreadSheetWriter writer(bExcel ? ARBSpreadSheetFormat::Xlsx : ARBSpreadSheetFormat::Ods, output);
+			writer.SetColumnWidths(widths);
+			bOk = writer.AddRow(source.GetHeader());
+			while (bOk && source.Next(record))
+				bOk = writer.AddRow(record);
+			bOk = writer.Close() && bOk;
+			bOk = output.Close() && bOk;
+		}
+		if (!bOk)
 		{
 			wxMessageBox(_("IDS_EXPORT_FAILED"), _("Agility Record Book"), wxOK | wxICON_STOP);
 			return false;
 		}
+		return true;
 	}
 	else
 	{
@@ -1556,15 +1649,18 @@ bool CWizardExport::DoWizardFinish()
 			wxFFileOutputStream output(file.GetPath(), L"wb");
 			if (output.IsOk())
 			{
-				for (long i = 0; i < m_ctrlPreview->GetItemCount(); ++i)
-				{
-					// Don't use the winapi to get data. That will trucate long lines.
-					auto data = std::dynamic_pointer_cast<CWizardExportListData, CListData>(m_ctrlPreview->GetData(i));
-					wxString line = data->OnNeedText(0);
+				wxBufferedOutputStream buffered(output, 64 * 1024);
+				wchar_t delim = GetDelim();
+				auto writeLine = [&buffered, delim](std::vector<wxString> const& inRecord) {
+					wxString line = JoinRecord(delim, inRecord);
 					line += L"\r\n";
 					std::string utf8(line.utf8_string());
-					output.Write(utf8.c_str(), utf8.length());
-				}
+					buffered.Write(utf8.c_str(), utf8.length());
+				};
+				writeLine(source.GetHeader());
+				while (source.Next(record))
+					writeLine(record);
+				buffered.Close();
 				output.Close();
 			}
 			return true;
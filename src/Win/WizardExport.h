@@ -12,6 +12,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Format records once, as they are previewed/exported.
  * 2009-06-14 Fix wizard finish (wxEVT_WIZARD_FINISHED is only invoked
  *            _after_ the dialog is destroyed).
  * 2009-02-11 Ported to wxWidgets.
@@ -44,6 +45,8 @@ public:
 	CWizardExport(CWizard* pSheet, CAgilityBookDoc* pDoc, wxWizardPage* prev);
 
 private:
+	class CRecordSource;
+
 	CAgilityBookOptions::ColumnOrder GetColumnInfo() const;
 	wchar_t GetDelim() const;
 	void UpdateButtons();
@@ -10,6 +10,10 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Read xlsx/ods files directly.
+ * 2026-10-19 Import runs in bulk.
+ * 2026-10-19 Parse records independently of the preview control, only
+ *            preview the first rows.
  * 2024-07-30 Fix importing calendar entries with empty dates.
  * 2015-01-01 Changed pixels to dialog units.
  * 2012-07-25 Importing runs with multiple clubs didn't parse venue correctly.
@@ -47,6 +51,8 @@
 #include "DlgAssignColumns.h"
 #include "Wizard.h"
 
+#include "ARB/ARBBulkImport.h"
+#include "ARB/ARBSpreadSheet.h"
 #include "ARBCommon/BreakLine.h"
 #include "ARBCommon/StringUtil.h"
 #include "LibARBWin/ARBWinUtilities.h"
@@ -55,6 +61,7 @@
 #include "LibARBWin/DlgProgress.h"
 #include "LibARBWin/Logger.h"
 #include "LibARBWin/ReportListCtrl.h"
+#include <algorithm>
 #include <wx/spinctrl.h>
 #include <wx/textfile.h>
 
@@ -71,6 +78,81 @@ using namespace ARBWin;
 
 wxIMPLEMENT_CLASS(CWizardImport, wxWizardPageSimple)
 
+namespace
+{
+constexpr size_t MAX_PREVIEW_ROWS = 100;
+} // namespace
+
+
+/**
+ * Parse the imported data into records, one row at a time, starting at the
+ * import start row. Every record has exactly one field per import column.
+ * A text row that cannot be parsed is an empty record (blank row), empty
+ * spreadsheet rows are skipped.
+ */
+class CWizardImport::CRecordReader
+{
+public:
+	CRecordReader(CWizardImport const& inPage, size_t inColumns)
+		: m_Page(inPage)
+		, m_bSpreadSheet(
+			  WIZARD_RADIO_EXCEL == inPage.m_pSheet->GetImportExportStyle()
+			  || WIZARD_RADIO_CALC == inPage.m_pSheet->GetImportExportStyle())
+		, m_Delim(inPage.GetDelim())
+		, m_Columns(inColumns)
+		, m_Next(0 < inPage.m_Row ? static_cast<size_t>(inPage.m_Row - 1) : 0)
+	{
+	}
+
+	/**
+	 * Get the next record.
+	 * @param outRecord Parsed fields.
+	 * @return Whether there was a record.
+	 */
+	bool Next(std::vector<wxString>& outRecord)
+	{
+		if (0 == m_Columns)
+			return false;
+		if (m_bSpreadSheet)
+		{
+			for (; m_Next < m_Page.m_ExcelData.size(); ++m_Next)
+			{
+				std::vector<wxString> const& rowData = m_Page.m_ExcelData[m_Next];
+				if (rowData.empty())
+					continue;
+				outRecord.assign(rowData.begin(), rowData.begin() + std::min(rowData.size(), m_Columns));
+				outRecord.resize(m_Columns);
+				++m_Next;
+				return true;
+			}
+			return false;
+		}
+
+		if (0 == m_Delim || m_Next >= m_Page.m_FileData.size())
+			return false;
+		outRecord.clear();
+		ReadStatus status = ReadCSV(m_Delim, m_Page.m_FileData[m_Next], outRecord);
+		while (ReadStatus::NeedMore == status && m_Next + 1 < m_Page.m_FileData.size())
+		{
+			++m_Next;
+			status = ReadCSV(m_Delim, m_Page.m_FileData[m_Next], outRecord, true);
+		}
+		++m_Next;
+		// Failed - means a blank row
+		if (ReadStatus::Ok != status)
+			outRecord.clear();
+		outRecord.resize(m_Columns);
+		return true;
+	}
+
+private:
+	CWizardImport const& m_Page;
+	bool m_bSpreadSheet;
+	wchar_t m_Delim;
+	size_t m_Columns;
+	size_t m_Next;
+};
+
 
 CWizardImport::CWizardImport(CWizard* pSheet, CAgilityBookDoc* pDoc, wxWizardPage* prev)
 	: wxWizardPageSimple(pSheet, prev)
@@ -413,8 +495,6 @@ bool CWizardImport::DoImportFile()
 	if (wxID_OK == dlg.ShowModal())
 	{
 		m_FileName = dlg.GetPath();
-		auto str = wxString::Format(_("IDS_FILE_PREVIEW"), m_FileName);
-		m_ctrlPreviewFile->SetLabel(str);
 		m_FileData.clear();
 		m_ExcelData.clear();
 		if (WIZARD_RADIO_EXCEL == m_pSheet->GetImportExportStyle()
@@ -425,18 +505,32 @@ bool CWizardImport::DoImportFile()
 				pImporter = m_pSheet->ExcelHelper()->GetImporter();
 			else if (WIZARD_RADIO_CALC == m_pSheet->GetImportExportStyle() && m_pSheet->CalcHelper())
 				pImporter = m_pSheet->CalcHelper()->GetImporter();
-			if (pImporter)
+			// xlsx/ods are read directly, only old .xls files need Excel.
+			if (ARBSpreadSheetReader::IsSupportedFile(m_FileName))
+			{
+				wxBusyCursor wait;
+				if (!ARBSpreadSheetReader::Read(m_FileName, m_ExcelData))
+					wxMessageBox(_("IDS_IMPORT_FAILED"), _("Agility Record Book"), wxOK | wxICON_STOP);
+			}
+			else if (pImporter)
 			{
 				IDlgProgress* pProgress = IDlgProgress::CreateProgress(1, this);
 				pProgress->EnableCancel(false);
-				if (pImporter->OpenFile(m_FileName))
+				bool bOk = pImporter->OpenFile(m_FileName);
+				if (bOk)
 				{
 					pImporter->GetData(m_ExcelData, pProgress);
 				}
 				pProgress->Dismiss();
+				if (!bOk)
+					wxMessageBox(_("IDS_IMPORT_FAILED"), _("Agility Record Book"), wxOK | wxICON_STOP);
 			}
 			else
-				wxMessageBox(_("IDS_IMPORT_FAILED"), _("Agility Record Book"), wxOK | wxICON_STOP);
+			{
+				// The Excel/Calc choices are offered even without the
+				// application, but then only xlsx/ods can be read.
+				wxMessageBox(_("IDS_IMPORT_NEEDS_EXCEL"), _("Agility Record Book"), wxOK | wxICON_STOP);
+			}
 		}
 		else
 		{
@@ -444,7 +538,8 @@ bool CWizardImport::DoImportFile()
 			wxTextFile file;
 			if (file.Open(m_FileName))
 			{
-				for (str = file.GetFirstLine(); !file.Eof(); str = file.GetNextLine())
+				m_FileData.reserve(file.GetLineCount());
+				for (wxString str = file.GetFirstLine(); !file.Eof(); str = file.GetNextLine())
 				{
 					m_FileData.push_back(StringUtil::TrimRight(str));
 				}
@@ -459,28 +554,9 @@ bool CWizardImport::DoImportFile()
 }
 
 
-void CWizardImport::UpdatePreview()
+void CWizardImport::GetColumnHeaders(std::vector<wxString>& outCols) const
 {
-	wxBusyCursor wait;
-	m_ctrlPreview->Freeze();
-
-	// Clear existing preview data.
-	m_ctrlPreview->DeleteAllItems();
-	long nColumnCount = m_ctrlPreview->GetColumnCount();
-	long iCol;
-	for (iCol = 0; iCol < nColumnCount; ++iCol)
-		m_ctrlPreview->DeleteColumn(0);
-
-	wchar_t delim = GetDelim();
-	if (WIZARD_RADIO_EXCEL == m_pSheet->GetImportExportStyle() || WIZARD_RADIO_CALC == m_pSheet->GetImportExportStyle())
-	{
-	}
-	else if (0 == delim)
-	{
-		m_ctrlPreview->Thaw();
-		m_ctrlPreview->Refresh();
-		return;
-	}
+	outCols.clear();
 
 	// Get export columns.
 	CAgilityBookOptions::ColumnOrder order = GetColumnInfo();
@@ -491,8 +567,6 @@ void CWizardImport::UpdatePreview()
 		CDlgAssignColumns::GetColumnOrder(order, index, columns[index]);
 	}
 
-	// Now generate the header information.
-	std::vector<wxString> cols;
 	switch (m_pSheet->GetImportExportItem())
 	{
 	default:
@@ -500,17 +574,15 @@ void CWizardImport::UpdatePreview()
 	case WIZ_IMPORT_RUNS:
 		for (index = 0; index < IO_TYPE_MAX; ++index)
 		{
-			if (0 == columns[index].size())
-				continue;
-			for (iCol = 0; iCol < static_cast<long>(columns[index].size()); ++iCol)
+			for (size_t iCol = 0; iCol < columns[index].size(); ++iCol)
 			{
 				wxString str = CDlgAssignColumns::GetNameFromColumnID(columns[index][iCol]);
-				if (iCol >= static_cast<long>(cols.size()))
-					cols.push_back(str);
+				if (iCol >= outCols.size())
+					outCols.push_back(str);
 				else
 				{
-					if (cols[iCol] != str && 0 < str.length())
-						cols[iCol] += L"/" + str;
+					if (outCols[iCol] != str && 0 < str.length())
+						outCols[iCol] += L"/" + str;
 				}
 			}
 		}
@@ -518,74 +590,73 @@ void CWizardImport::UpdatePreview()
 	case WIZ_IMPORT_CALENDAR:
 		for (index = 0; index < columns[IO_TYPE_CALENDAR].size(); ++index)
 		{
-			cols.push_back(CDlgAssignColumns::GetNameFromColumnID(columns[IO_TYPE_CALENDAR][index]));
+			outCols.push_back(CDlgAssignColumns::GetNameFromColumnID(columns[IO_TYPE_CALENDAR][index]));
 		}
 		break;
 	case WIZ_IMPORT_LOG:
 		for (index = 0; index < columns[IO_TYPE_TRAINING].size(); ++index)
 		{
-			cols.push_back(CDlgAssignColumns::GetNameFromColumnID(columns[IO_TYPE_TRAINING][index]));
+			outCols.push_back(CDlgAssignColumns::GetNameFromColumnID(columns[IO_TYPE_TRAINING][index]));
 		}
 		break;
 	}
+}
+
+
+void CWizardImport::UpdatePreview()
+{
+	wxBusyCursor wait;
+	m_ctrlPreview->Freeze();
+
+	// Clear existing preview data.
+	m_ctrlPreview->DeleteAllItems();
+	long nColumnCount = m_ctrlPreview->GetColumnCount();
+	long iCol;
+	for (iCol = 0; iCol < nColumnCount; ++iCol)
+		m_ctrlPreview->DeleteColumn(0);
+	if (!m_FileName.empty())
+		m_ctrlPreviewFile->SetLabel(wxString::Format(_("IDS_FILE_PREVIEW"), m_FileName));
+
+	if (WIZARD_RADIO_EXCEL == m_pSheet->GetImportExportStyle() || WIZARD_RADIO_CALC == m_pSheet->GetImportExportStyle())
+	{
+	}
+	else if (0 == GetDelim())
+	{
+		m_ctrlPreview->Thaw();
+		m_ctrlPreview->Refresh();
+		return;
+	}
+
+	std::vector<wxString> cols;
+	GetColumnHeaders(cols);
 	for (iCol = 0; iCol < static_cast<long>(cols.size()); ++iCol)
 	{
 		m_ctrlPreview->InsertColumn(iCol, cols[iCol]);
 	}
 
-	if (WIZARD_RADIO_EXCEL == m_pSheet->GetImportExportStyle() || WIZARD_RADIO_CALC == m_pSheet->GetImportExportStyle())
+	// The preview is only a sample, the import re-reads the records.
+	CRecordReader reader(*this, cols.size());
+	std::vector<wxString> record;
+	long iLine = 0;
+	for (; iLine < static_cast<long>(MAX_PREVIEW_ROWS) && reader.Next(record); ++iLine)
 	{
-		long iLine = 0;
-		for (std::vector<std::vector<wxString>>::const_iterator iter = m_ExcelData.begin(); iter != m_ExcelData.end();
-			 ++iter, ++iLine)
+		m_ctrlPreview->InsertItem(iLine, record[0]);
+		for (iCol = 1; iCol < static_cast<long>(record.size()); ++iCol)
 		{
-			if (iLine >= m_Row - 1)
-			{
-				std::vector<wxString> const& rowData = *iter;
-				iCol = 0;
-				long iCurLine = -1;
-				for (std::vector<wxString>::const_iterator iter2 = rowData.begin();
-					 iter2 != rowData.end() && iCol < static_cast<long>(cols.size());
-					 ++iter2, ++iCol)
-				{
-					wxString const& str = *iter2;
-					if (0 == iCol)
-						iCurLine = m_ctrlPreview->InsertItem(iLine, str);
-					else
-						SetListColumnText(m_ctrlPreview, iCurLine, iCol, str);
-				}
-			}
+			if (!record[iCol].empty())
+				SetListColumnText(m_ctrlPreview, iLine, iCol, record[iCol]);
 		}
 	}
-	else
+	if (static_cast<long>(MAX_PREVIEW_ROWS) == iLine && reader.Next(record))
 	{
-		long iLine = 0;
-		for (long iFileLine = m_Row - 1; iFileLine < static_cast<long>(m_FileData.size()); ++iLine, ++iFileLine)
-		{
-			std::vector<wxString> fields;
-			ReadStatus status = ReadCSV(delim, m_FileData[iFileLine], fields);
-			while (ReadStatus::NeedMore == status && iFileLine + 1 < static_cast<long>(m_FileData.size()))
-			{
-				++iFileLine;
-				status = ReadCSV(delim, m_FileData[iFileLine], fields, true);
-			}
-			if (ReadStatus::Ok == status && 0 < fields.size())
-			{
-				m_ctrlPreview->InsertItem(iLine, fields[0]);
-				for (iCol = 1; iCol < static_cast<long>(fields.size()) && iCol < static_cast<long>(cols.size()); ++iCol)
-				{
-					SetListColumnText(m_ctrlPreview, iLine, iCol, fields[iCol]);
-				}
-			}
-			// Failed - means a blank row
-			else
-				m_ctrlPreview->InsertItem(iLine, wxString());
-		}
+		m_ctrlPreviewFile->SetLabel(wxString::Format(_("IDS_FILE_PREVIEW_PARTIAL"), m_FileName, static_cast<int>(iLine)));
 	}
+
 	for (iCol = 0; iCol < static_cast<long>(cols.size()); ++iCol)
 		m_ctrlPreview->SetColumnWidth(iCol, wxLIST_AUTOSIZE_USEHEADER);
 	m_ctrlPreview->Thaw();
 	m_ctrlPreview->Refresh();
+	Layout();
 }
 
 
@@ -805,18 +876,15 @@ bool CWizardImport::DoWizardFinish()
 	long nUpdated = 0;
 	long nDuplicate = 0;
 	long nSkipped = 0;
-	long nColumns = m_ctrlPreview->GetColumnCount();
-	std::set<ARBDogPtr> sortTrials;
+	ARBBulkImport bulk(m_pDoc->Book());
 	bool bSortCal = false;
 	bool bSortLog = false;
-	for (long nItem = 0; nItem < m_ctrlPreview->GetItemCount(); ++nItem)
+	std::vector<wxString> cols;
+	GetColumnHeaders(cols);
+	CRecordReader reader(*this, cols.size());
+	std::vector<wxString> entry;
+	for (long nItem = 0; reader.Next(entry); ++nItem)
 	{
-		std::vector<wxString> entry;
-		entry.reserve(nColumns);
-		for (long i = 0; i < nColumns; ++i)
-		{
-			entry.push_back(GetListColumnText(m_ctrlPreview, nItem, i));
-		}
 		switch (m_pSheet->GetImportExportItem())
 		{
 		default:
@@ -861,13 +929,12 @@ bool CWizardImport::DoWizardFinish()
 			{
 				if (0 <= idxVenue[i] && 0 <= idxEvent[i] && 0 <= idxDiv[i] && 0 <= idxLevel[i] && 0 <= idxDate[i])
 				{
-					m_pDoc->Book().GetConfig().GetVenues().FindEvent(
+					bulk.FindEvent(
 						GetPrimaryVenue(entry[idxVenue[i]]),
 						entry[idxEvent[i]],
 						entry[idxDiv[i]],
 						entry[idxLevel[i]],
 						ARBDate::FromString(entry[idxDate[i]], format),
-						nullptr,
 						&pScoring);
 				}
 			}
@@ -1107,7 +1174,7 @@ bool CWizardImport::DoWizardFinish()
 					errLog += L"\n";
 					pRun.reset();
 				}
-				else if (!m_pDoc->Book().GetConfig().GetVenues().FindEvent(
+				else if (!bulk.FindEvent(
 							 primaryVenue,
 							 pRun->GetEvent(),
 							 pRun->GetDivision(),
@@ -1126,22 +1193,7 @@ bool CWizardImport::DoWizardFinish()
 				ARBDogPtr pDog = m_pDoc->GetCurrentDog();
 				if (0 < nameReg.length() || 0 < nameCall.length())
 				{
-					pDog.reset();
-					for (ARBDogList::iterator iterDog = m_pDoc->Book().GetDogs().begin();
-						 iterDog != m_pDoc->Book().GetDogs().end();
-						 ++iterDog)
-					{
-						ARBDogPtr pDogTmp = *iterDog;
-						if ((0 < nameReg.length() && pDogTmp->GetRegisteredName() == nameReg && 0 < nameCall.length()
-							 && pDogTmp->GetCallName() == nameCall)
-							|| (0 < nameReg.length() && pDogTmp->GetRegisteredName() == nameReg
-								&& 0 == nameCall.length())
-							|| (0 == nameReg.length() && 0 < nameCall.length() && pDogTmp->GetCallName() == nameCall))
-						{
-							pDog = pDogTmp;
-							break;
-						}
-					}
+					pDog = bulk.FindDog(nameReg, nameCall);
 					// Not found, create it.
 					if (!pDog)
 					{
@@ -1153,7 +1205,7 @@ bool CWizardImport::DoWizardFinish()
 							pDog->SetCallName(nameCall);
 						if (0 == nameCall.length() && 0 < nameReg.length())
 							pDog->SetCallName(nameReg);
-						m_pDoc->Book().GetDogs().AddDog(pDog);
+						bulk.AddDog(pDog);
 					}
 				}
 				if (!pDog)
@@ -1162,7 +1214,7 @@ bool CWizardImport::DoWizardFinish()
 					{
 						pDog = ARBDogPtr(ARBDog::New());
 						pDog->SetCallName(L"?");
-						m_pDoc->Book().GetDogs().AddDog(pDog);
+						bulk.AddDog(pDog);
 					}
 					else
 						pDog = *(m_pDoc->Book().GetDogs().begin());
@@ -1184,57 +1236,11 @@ bool CWizardImport::DoWizardFinish()
 					while (clubs.size() < venues.size())
 						clubs.push_back(clubs[clubs.size() - 1]);
 				}
-				ARBDogTrialPtr pTrial;
-				// Loop two times - first time, try to match.
-				// Then stradle the date. We're trying to put multiple
-				// days into a single trial.
-				for (int iLoop = 0; !pTrial && iLoop < 2; ++iLoop)
-				{
-					for (ARBDogTrialList::iterator iterTrial = pDog->GetTrials().begin();
-						 iterTrial != pDog->GetTrials().end();
-						 ++iterTrial)
-					{
-						ARBDogTrialPtr pTrialTmp = *iterTrial;
-						ARBDate startDate = pTrialTmp->GetStartDate();
-						ARBDate endDate = pTrialTmp->GetEndDate();
-						if (1 == iLoop)
-						{
-							--startDate;
-							++endDate;
-						}
-						if (pTrialTmp->GetClubs().size() == venues.size() && pTrialTmp->GetLocation() == trialLocation
-							&& pRun->GetDate().isBetween(startDate, endDate))
-						{
-							bool bOk = true;
-							size_t idx = 0;
-							for (ARBDogClubList::iterator iterClub = pTrialTmp->GetClubs().begin();
-								 iterClub != pTrialTmp->GetClubs().end();
-								 ++iterClub)
-							{
-								ARBDogClubPtr pClub(ARBDogClub::New());
-								pClub->SetName(clubs[idx]);
-								pClub->SetVenue(venues[idx]);
-								if (*pClub != *(*(iterClub)))
-								{
-									bOk = false;
-									break;
-								}
-								++idx;
-							}
-							if (bOk)
-							{
-								pTrial = pTrialTmp;
-								break;
-							}
-						}
-					}
-				}
+				ARBDogTrialPtr pTrial = bulk.FindTrial(pDog, pRun->GetDate(), trialLocation, clubs, venues);
 				if (!pTrial)
 				{
 					// Couldn't find a trial, so make one.
 					pTrial = ARBDogTrialPtr(ARBDogTrial::New());
-					pDog->GetTrials().AddTrial(pTrial);
-					sortTrials.insert(pDog);
 					for (size_t idx = 0; idx < venues.size(); ++idx)
 					{
 						pTrial->GetClubs().AddClub(clubs[idx], venues[idx]);
@@ -1243,10 +1249,9 @@ bool CWizardImport::DoWizardFinish()
 						pTrial->SetLocation(trialLocation);
 					if (0 < trialNotes.length())
 						pTrial->SetNote(trialNotes);
+					bulk.AddTrial(pDog, pTrial);
 				}
-				pTrial->GetRuns().AddRun(pRun);
-				pTrial->SetMultiQs(m_pDoc->Book().GetConfig());
-				pTrial->GetRuns().sort();
+				bulk.AddRun(pDog, pTrial, pRun);
 				++nAdded;
 			}
 			else
@@ -1476,10 +1481,9 @@ bool CWizardImport::DoWizardFinish()
 	if (m_pDoc->ImportARBTrainingEntry(listTraining, nAdded, nUpdated, nDuplicate, nSkipped))
 		bSortLog = true;
 
-	for (std::set<ARBDogPtr>::iterator iterDog = sortTrials.begin(); iterDog != sortTrials.end(); ++iterDog)
-	{
-		(*iterDog)->GetTrials().sort(!CAgilityBookOptions::GetNewestDatesFirst());
-	}
+	bulk.Finish(!CAgilityBookOptions::GetNewestDatesFirst());
+	if (0 < nAdded)
+		m_pDoc->ResetVisibility(bulk.GetModifiedDogs());
 	if (bSortCal)
 		m_pDoc->Book().GetCalendar().sort();
 	if (bSortLog)
@@ -12,6 +12,7 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Parse records independently of the preview control.
  * 2009-06-14 Fix wizard finish (wxEVT_WIZARD_FINISHED is only invoked
  *            _after_ the dialog is destroyed).
  * 2009-02-11 Ported to wxWidgets.
@@ -46,7 +47,10 @@ public:
 	void ResetData();
 
 private:
+	class CRecordReader;
+
 	CAgilityBookOptions::ColumnOrder GetColumnInfo() const;
+	void GetColumnHeaders(std::vector<wxString>& outCols) const;
 	wchar_t GetDelim() const;
 	void UpdateButtons();
 	void UpdatePreview();
@@ -10,6 +10,11 @@
  * @author David Connet
  *
  * Revision History
+ * 2026-10-19 Export the record book as an SQL script.
+ * 2026-10-19 Import/export the record book as JSON.
+ * 2026-10-19 Import calendar entries from iCalendar files.
+ * 2026-10-19 Only regenerate changed entries when re-exporting an iCalendar file.
+ * 2026-10-19 Excel/Calc no longer require the application.
  * 2015-01-01 Changed pixels to dialog units.
  * 2012-03-16 Renamed LoadXML functions, added stream version.
  * 2011-12-22 Switch to using Bind on wx2.9+.
@@ -43,6 +48,7 @@
 #include "VersionNumber.h"
 #include "Wizard.h"
 
+#include "ARB/ARBJson.h"
 #include "ARBCommon/Element.h"
 #include "ARBCommon/StringUtil.h"
 #include "ARBCommon/VersionNum.h"
@@ -50,6 +56,8 @@
 #include "LibARBWin/DlgPadding.h"
 #include "LibARBWin/Logger.h"
 #include <wx/config.h>
+#include <wx/filename.h>
+#include <wx/stdstream.h>
 #include <wx/wfstream.h>
 #include <sstream>
 
@@ -100,37 +108,28 @@ CWizardStart::CWizardStart(CWizard* pSheet, CAgilityBookDoc* pDoc)
 	m_Style = wxConfig::Get()->Read(LAST_STYLE, WIZARD_RADIO_EXCEL);
 	if (-1 == m_Style)
 		m_Style = WIZARD_RADIO_EXCEL;
-	if (WIZARD_RADIO_EXCEL == m_Style && !m_pSheet->ExcelHelper())
-		m_Style = WIZARD_RADIO_SPREADSHEET;
-	if (WIZARD_RADIO_CALC == m_Style && !m_pSheet->CalcHelper())
-		m_Style = WIZARD_RADIO_SPREADSHEET;
 
 	// Controls (these are done first to control tab order)
 
 	wxStaticBox* boxImportExport = new wxStaticBox(this, wxID_ANY, _("IDC_WIZARD_RADIO_BOX"));
-	wxRadioButton* radioExcel = nullptr;
-	if (m_pSheet->ExcelHelper())
-	{
-		radioExcel = new wxRadioButton(
-			this,
-			wxID_ANY,
-			_("IDC_WIZARD_START_EXCEL"),
-			wxDefaultPosition,
-			wxDefaultSize,
-			wxRB_GROUP);
-		radioExcel->Bind(wxEVT_COMMAND_RADIOBUTTON_SELECTED, &CWizardStart::OnWizardStyleExcel, this);
-		radioExcel->SetHelpText(_("HIDC_WIZARD_START_EXCEL"));
-		radioExcel->SetToolTip(_("HIDC_WIZARD_START_EXCEL"));
-	}
-
-	wxRadioButton* radioCalc = nullptr;
-	if (m_pSheet->CalcHelper())
-	{
-		radioCalc = new wxRadioButton(this, wxID_ANY, _("IDC_WIZARD_START_CALC"), wxDefaultPosition, wxDefaultSize, 0);
-		radioCalc->Bind(wxEVT_COMMAND_RADIOBUTTON_SELECTED, &CWizardStart::OnWizardStyleCalc, this);
-		radioCalc->SetHelpText(_("HIDC_WIZARD_START_CALC"));
-		radioCalc->SetToolTip(_("HIDC_WIZARD_START_CALC"));
-	}
+	// xlsx/ods files are read and written directly, so these are always
+	// available (Excel is only needed to import old .xls files).
+	wxRadioButton* radioExcel = new wxRadioButton(
+		this,
+		wxID_ANY,
+		_("IDC_WIZARD_START_EXCEL"),
+		wxDefaultPosition,
+		wxDefaultSize,
+		wxRB_GROUP);
+	radioExcel->Bind(wxEVT_COMMAND_RADIOBUTTON_SELECTED, &CWizardStart::OnWizardStyleExcel, this);
+	radioExcel->SetHelpText(_("HIDC_WIZARD_START_EXCEL"));
+	radioExcel->SetToolTip(_("HIDC_WIZARD_START_EXCEL"));
+
+	wxRadioButton* radioCalc
+		= new wxRadioButton(this, wxID_ANY, _("IDC_WIZARD_START_CALC"), wxDefaultPosition, wxDefaultSize, 0);
+	radioCalc->Bind(wxEVT_COMMAND_RADIOBUTTON_SELECTED, &CWizardStart::OnWizardStyleCalc, this);
+	radioCalc->SetHelpText(_("HIDC_WIZARD_START_CALC"));
+	radioCalc->SetToolTip(_("HIDC_WIZARD_START_CALC"));
 
 	wxRadioButton* radioSpread
 		= new wxRadioButton(this, wxID_ANY, _("IDC_WIZARD_START_SPREADSHEET"), wxDefaultPosition, wxDefaultSize, 0);
@@ -147,16 +146,10 @@ CWizardStart::CWizardStart(CWizard* pSheet, CAgilityBookDoc* pDoc)
 	switch (m_Style)
 	{
 	case WIZARD_RADIO_EXCEL:
-		if (radioExcel)
-			radioExcel->SetValue(true);
-		else
-			radioSpread->SetValue(true);
+		radioExcel->SetValue(true);
 		break;
 	case WIZARD_RADIO_CALC:
-		if (radioCalc)
-			radioCalc->SetValue(true);
-		else
-			radioSpread->SetValue(true);
+		radioCalc->SetValue(true);
 		break;
 	case WIZARD_RADIO_SPREADSHEET:
 		radioSpread->SetValue(true);
@@ -191,10 +184,8 @@ CWizardStart::CWizardStart(CWizard* pSheet, CAgilityBookDoc* pDoc)
 	wxBoxSizer* bSizer = new wxBoxSizer(wxVERTICAL);
 
 	wxStaticBoxSizer* sizerImportExport = new wxStaticBoxSizer(boxImportExport, wxVERTICAL);
-	if (radioExcel)
-		sizerImportExport->Add(radioExcel, 0, wxLEFT | wxRIGHT | wxTOP, padding.Inner());
-	if (radioCalc)
-		sizerImportExport->Add(radioCalc, 0, wxLEFT | wxRIGHT | wxTOP, padding.Inner());
+	sizerImportExport->Add(radioExcel, 0, wxLEFT | wxRIGHT | wxTOP, padding.Inner());
+	sizerImportExport->Add(radioCalc, 0, wxLEFT | wxRIGHT | wxTOP, padding.Inner());
 	sizerImportExport->Add(radioSpread, 0, wxLEFT | wxRIGHT | wxTOP, padding.Inner());
 	sizerImportExport->Add(radioArb, 0, wxALL, padding.Inner());
 	bSizer->Add(sizerImportExport, 0, padding.Inner());
@@ -384,6 +375,24 @@ constexpr struct
 			{WizardPage::None, nullptr, nullptr},
 		},
 	},
+	{
+		WIZ_EXPORT_JSON,
+		{
+			{WizardPage::None, nullptr, nullptr},
+			{WizardPage::None, nullptr, nullptr},
+			{WizardPage::Finish, arbT("IDS_WIZ_EXPORT_JSON"), arbT("IDS_WIZ_EXPORT_JSON_ARB")},
+			{WizardPage::None, nullptr, nullptr},
+		},
+	},
+	{
+		WIZ_EXPORT_SQL,
+		{
+			{WizardPage::None, nullptr, nullptr},
+			{WizardPage::None, nullptr, nullptr},
+			{WizardPage::Finish, arbT("IDS_WIZ_EXPORT_SQL"), arbT("IDS_WIZ_EXPORT_SQL_ARB")},
+			{WizardPage::None, nullptr, nullptr},
+		},
+	},
 };
 constexpr int sc_nItems = sizeof(sc_Items) / sizeof(sc_Items[0]);
 } // namespace
@@ -548,7 +557,7 @@ bool CWizardStart::DoWizardFinish()
 				wxEmptyString, // caption
 				wxEmptyString, // def dir
 				_("IDS_FILEEXT_FNAME_ARB"),
-				_("IDS_FILEEXT_FILTER_ARB"),
+				_("IDS_FILEEXT_FILTER_ARBJSON"),
 				wxFD_OPEN | wxFD_FILE_MUST_EXIST);
 			if (wxID_OK == file.ShowModal())
 			{
@@ -556,7 +565,17 @@ bool CWizardStart::DoWizardFinish()
 				bool bLoadOk = false;
 				{
 					wxBusyCursor wait;
-					bLoadOk = tree->LoadXML(file.GetPath(), errMsg);
+					if (0 == wxFileName(file.GetPath()).GetExt().CmpNoCase(L"json"))
+					{
+						wxFFileInputStream input(file.GetPath(), L"rb");
+						if (input.IsOk())
+						{
+							wxStdInputStream stdinput(input);
+							bLoadOk = ARBJson::Load(tree, stdinput, errMsg);
+						}
+					}
+					else
+						bLoadOk = tree->LoadXML(file.GetPath(), errMsg);
 				}
 				if (!bLoadOk)
 				{
@@ -581,10 +600,15 @@ bool CWizardStart::DoWizardFinish()
 				wxEmptyString, // caption
 				wxEmptyString, // def dir
 				_("IDS_FILEEXT_FNAME_ARB"),
-				_("IDS_FILEEXT_FILTER_ARB"),
+				_("IDS_FILEEXT_FILTER_ARBICS"),
 				wxFD_OPEN | wxFD_FILE_MUST_EXIST);
 			if (wxID_OK == file.ShowModal())
 			{
+				if (0 == wxFileName(file.GetPath()).GetExt().CmpNoCase(L"ics"))
+				{
+					bOk = m_pDoc->ImportICalData(file.GetPath(), this);
+					break;
+				}
 				ElementNodePtr tree(ElementNode::New());
 				bool bLoadOk = false;
 				{
@@ -670,22 +694,49 @@ bool CWizardStart::DoWizardFinish()
 					}
 					entries = &allEntries;
 				}
-				std::stringstream outData;
 				int nWarning = CAgilityBookOptions::CalendarOpeningNear();
-				ICalendarPtr iCalendar = ICalendar::iCalendarBegin(outData, (WIZ_EXPORT_CALENDAR_VCAL == data) ? 1 : 2);
-				for (std::vector<ARBCalendarPtr>::const_iterator iterCal = entries->begin(); iterCal != entries->end();
-					 ++iterCal)
+				std::string feed;
+				bool bWrite = true;
+				if (WIZ_EXPORT_CALENDAR_VCAL == data)
 				{
-					ARBCalendarPtr pCal = *iterCal;
-					pCal->iCalendar(iCalendar, nWarning);
+					std::stringstream outData;
+					ICalendarPtr iCalendar = ICalendar::iCalendarBegin(outData, 1);
+					for (std::vector<ARBCalendarPtr>::const_iterator iterCal = entries->begin();
+						 iterCal != entries->end();
+						 ++iterCal)
+					{
+						ARBCalendarPtr pCal = *iterCal;
+						pCal->iCalendar(iCalendar, nWarning);
+					}
+					iCalendar.reset();
+					feed = outData.str();
 				}
-				iCalendar.reset();
-				wxFFileOutputStream output(file.GetPath(), L"wb");
-				if (output.IsOk())
+				else
 				{
-					std::string const& str = outData.str();
-					output.Write(str.c_str(), str.length());
-					output.Close();
+					// Exporting over a previous export (like a shared club
+					// calendar) only regenerates the entries that changed. If
+					// nothing changed, the file is left alone.
+					std::string previous;
+					if (wxFileName::FileExists(file.GetPath()))
+					{
+						wxFFileInputStream input(file.GetPath(), L"rb");
+						if (input.IsOk() && 0 < input.GetLength())
+						{
+							previous.resize(static_cast<size_t>(input.GetLength()));
+							input.Read(&previous[0], previous.length());
+							previous.resize(input.LastRead());
+						}
+					}
+					bWrite = ICalendar::iCalendarFeed(previous, *entries, nWarning, feed);
+				}
+				if (bWrite)
+				{
+					wxFFileOutputStream output(file.GetPath(), L"wb");
+					if (output.IsOk())
+					{
+						output.Write(feed.c_str(), feed.length());
+						output.Close();
+					}
 				}
 				bOk = true;
 			}
@@ -852,6 +903,80 @@ bool CWizardStart::DoWizardFinish()
 		}
 		break;
 
+		case WIZ_EXPORT_JSON:
+		{
+			CLogger::Log(L"WIZARD: CWizardStart WIZ_EXPORT_JSON");
+			wxString name = m_pDoc->GetFilename();
+			if (name.empty())
+			{
+				name = L"AgilityRecordBook.";
+				name += _("IDS_FILEEXT_DEF_JSON");
+			}
+			else
+			{
+				int iDot = name.Find('.', true);
+				if (0 <= iDot)
+					name = name.Left(iDot + 1) + _("IDS_FILEEXT_DEF_JSON");
+				else
+				{
+					name += L".";
+					name += _("IDS_FILEEXT_DEF_JSON");
+				}
+			}
+			wxFileDialog file(
+				this,
+				wxEmptyString, // caption
+				wxEmptyString, // def dir
+				name,
+				_("IDS_FILEEXT_FILTER_JSON"),
+				wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+			if (wxID_OK == file.ShowModal())
+			{
+				wxBusyCursor wait;
+				CVersionNum ver(ARB_VER_MAJOR, ARB_VER_MINOR, ARB_VER_DOT, ARB_VER_BUILD);
+				wxString verstr = ver.GetVersionString();
+				ElementNodePtr tree(ElementNode::New());
+				if (m_pDoc->Book().Save(tree, verstr, true, true, true, true, true))
+				{
+					wxFFileOutputStream output(file.GetPath(), L"wb");
+					if (output.IsOk())
+					{
+						wxStdOutputStream stdoutput(output);
+						ARBJson::Save(tree, stdoutput);
+					}
+				}
+				bOk = true;
+			}
+		}
+		break;
+
+		case WIZ_EXPORT_SQL:
+		{
+			CLogger::Log(L"WIZARD: CWizardStart WIZ_EXPORT_SQL");
+			wxFileName name(m_pDoc->GetFilename());
+			if (!name.HasName())
+				name.SetName(L"AgilityRecordBook");
+			name.SetExt(_("IDS_FILEEXT_DEF_SQL"));
+			wxFileDialog file(
+				this,
+				wxEmptyString, // caption
+				wxEmptyString, // def dir
+				name.GetFullName(),
+				_("IDS_FILEEXT_FILTER_SQL"),
+				wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+			if (wxID_OK == file.ShowModal())
+			{
+				wxBusyCursor wait;
+				bOk = m_pDoc->ExportSQL(file.GetPath());
+				if (!bOk)
+				{
+					auto msg = wxString::Format(_("IDS_CANNOT_OPEN"), file.GetPath());
+					wxMessageBox(msg, _("Agility Record Book"), wxOK | wxCENTRE | wxICON_EXCLAMATION);
+				}
+			}
+		}
+		break;
+
 		case WIZ_IMPORT_SETTINGS:
 		{
 			CLogger::Log(L"WIZARD: CWizardStart WIZ_IMPORT_SETTINGS");